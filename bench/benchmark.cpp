@@ -0,0 +1,312 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <format>
+#include <fstream>
+#include <vector>
+
+#include "MOS6502.hpp"
+#include "CycleStepper.hpp"
+#include "Recompiled.hpp"
+#include "Disassembler.hpp"
+#include "Assembler.hpp"
+#include "programs.hpp"
+#include "Corpus.hpp"
+#include "OpcodeTable.hpp"
+
+using namespace Emulator;
+
+
+static constexpr Word PROGRAM_START = 0x0200;
+static constexpr size_t DEFAULT_COMMANDS = 20'000'000;
+static constexpr int RUNS = 3;
+
+
+/// the workload program from programs.hpp, with the pointer it reads through
+static ROM workload() {
+    constexpr auto program = program_workload<PROGRAM_START>();
+    constexpr std::array<Byte, 2> jumpTarget{PROGRAM_START & 0xFF, PROGRAM_START >> 8};
+    constexpr std::array<Byte, 2> pointer{0x00, 0x06};
+
+    ROM memory{};
+    memory.load(PROGRAM_START, program);
+    memory.load(0x20, pointer);
+    memory.load(ROM::RESET_LOCATION, jumpTarget);
+    return memory;
+}
+
+
+extern const RecompiledProgram recompiled_firmware;
+
+/// the firmware from test/data, loaded as at build time, whose recompiled code is linked in
+static ROM firmware() {
+    std::ifstream file(FIRMWARE_IMAGE, std::ios::binary);
+    const std::vector<Byte> image{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    ROM memory{};
+    memory.load(0xFF00, image);
+    return memory;
+}
+
+
+/// @return the best rate of the given CPU instantiation over several runs in millions of instructions per second, 0 on failure
+template<class CPU>
+static double measure(const std::string &name, const ROM &memory, size_t commands) {
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        CPU cpu{};
+        cpu.burn(memory);
+        cpu.reset();
+        cpu.max_number_of_commands(commands);
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = cpu.execute();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (!result.has_value() || !std::holds_alternative<typename CPU::StopOnMaxReached>(result.value())) {
+            std::cerr << "the workload stopped unexpectedly\n";
+            return 0;
+        }
+
+        const double seconds = elapsed.count();
+        const double rate = (double)commands / seconds / 1e6;
+        std::cout << std::vformat("{} run {:d}: {:.3f} s, {:.2f} M instructions/s\n", std::make_format_args(name, run, seconds, rate));
+        best = std::max(best, rate);
+    }
+
+    std::cout << std::vformat("{} best: {:.2f} M instructions/s\n", std::make_format_args(name, best));
+    return best;
+}
+
+/// @return the best rate of the cycle-stepped engine over several runs in millions of emulated cycles per second
+static double measure_stepper(const ROM &memory, size_t commands) {
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        MOS6502 cpu{};
+        cpu.burn(memory);
+        cpu.reset();
+        CycleStepper stepper(cpu);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t command = 0; command < commands; command++) stepper.step_command();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        const double seconds = elapsed.count();
+        const double rate = (double)cpu.get_state().cycle / seconds / 1e6;
+        std::cout << std::vformat("cycle stepper run {:d}: {:.3f} s, {:.2f} MHz\n", std::make_format_args(run, seconds, rate));
+        best = std::max(best, rate);
+    }
+
+    std::cout << std::vformat("cycle stepper best: {:.2f} MHz\n", std::make_format_args(best));
+    return best;
+}
+
+
+/**
+ * Runs the firmware from reset to its final BRK until at least the given number of commands are executed,
+ *  by the interpreter or by its recompiled code.
+ * @return the best rate over several runs in millions of instructions per second, 0 on failure
+ */
+static double measure_firmware(bool recompiled, const ROM &memory, size_t commands) {
+    const std::string name = recompiled ? "recompiled firmware" : "interpreted firmware";
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        size_t executed = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        while (executed < commands) {
+            MOS6502 cpu{};
+            cpu.burn(memory);
+            cpu.reset();
+            cpu.stop_on_break(true);
+
+            const auto result = recompiled ? RecompiledRuntime(cpu, recompiled_firmware).execute() : cpu.execute();
+            if (!result.has_value() || !std::holds_alternative<MOS6502::StopOnBreak>(result.value())) {
+                std::cerr << "the firmware stopped unexpectedly\n";
+                return 0;
+            }
+            executed += cpu.get_metrics().snapshot().instructionsRetired;
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        const double seconds = elapsed.count();
+        const double rate = (double)executed / seconds / 1e6;
+        std::cout << std::vformat("{} run {:d}: {:.3f} s, {:.2f} M instructions/s\n", std::make_format_args(name, run, seconds, rate));
+        best = std::max(best, rate);
+    }
+
+    std::cout << std::vformat("{} best: {:.2f} M instructions/s\n", std::make_format_args(name, best));
+    return best;
+}
+
+
+/// 64 KiB of pseudo-random bytes, so that every opcode and addressing mode is disassembled
+static ROM random_image() {
+    std::vector<Byte> bytes(UINT16_MAX + 1);
+    uint32_t seed = 1;
+    for (auto &byte: bytes) {
+        seed = seed * 1103515245 + 12345;
+        byte = seed >> 16;
+    }
+
+    ROM memory{};
+    memory.load(0, bytes);
+    return memory;
+}
+
+/**
+ * Disassembles the whole image over and over until at least the given number of lines are written,
+ *  line by line with description() or by batches into a buffer.
+ * @return the best rate over several runs in millions of lines per second
+ */
+static double measure_disassembly(bool batched, const ROM &memory, size_t lines) {
+    const std::string name = batched ? "batch disassembly" : "description() disassembly";
+    std::vector<char> buffer(1 << 20);
+    std::string text;
+    text.reserve(buffer.size());
+
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        size_t written = 0, characters = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        while (written < lines) {
+            for (size_t address = 0; address <= UINT16_MAX;) {
+                if (batched) {
+                    const auto batch = disassemble(memory, address, SIZE_MAX, buffer);
+                    written += batch.commands;
+                    characters += batch.written;
+                    address = batch.next;
+                    continue;
+                }
+
+                const Byte opCode = memory[(Word)address];
+                const auto length = OPCODES[opCode].length;
+                const Word operand = length == 1 ? 0 : length == 2 ? memory[(Word)(address + 1)] : memory.get_word(address + 1);
+                text += std::vformat("{:04x}  ", std::make_format_args(address));
+                text += description(opCode, operand);
+                text += '\n';
+                written++;
+                address += length;
+                // flushed like the buffer of the batches
+                if (text.size() >= buffer.size() - MAX_LINE_LENGTH) {
+                    characters += text.size();
+                    text.clear();
+                }
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        characters += text.size();
+        text.clear();
+
+        const double seconds = elapsed.count();
+        const double rate = (double)written / seconds / 1e6;
+        std::cout << std::vformat("{} run {:d}: {:.3f} s, {:.2f} M lines/s ({:d} characters)\n",
+                                  std::make_format_args(name, run, seconds, rate, characters));
+        best = std::max(best, rate);
+    }
+
+    std::cout << std::vformat("{} best: {:.2f} M lines/s\n", std::make_format_args(name, best));
+    return best;
+}
+
+
+/// a program of the given number of lines, with forward references, branches and zero page and absolute operands
+static std::string generated_source(size_t lines) {
+    std::string source = ".org $0200\n";
+    for (size_t block = 0; block < lines / 5; block++) {
+        source += std::vformat("block{0}: LDA #{1}\n    BEQ block{0}\n    BNE end{0}\n    JMP block{0}\n"
+                               "end{0}: STA $10 + {1} & $7F, X\n", std::make_format_args(block, block % 256));
+    }
+    return source;
+}
+
+static double measure_assembler(size_t lines) {
+    const std::string source = generated_source(lines);
+    std::vector<Byte> output(UINT16_MAX + 1);
+
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = Assembler::assemble(source, 0x0000, output);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (!result.has_value()) {
+            std::cerr << std::visit([](const auto &error) { return error.to_string(); }, result.error()) << std::endl;
+            return 0;
+        }
+
+        const double seconds = elapsed.count();
+        const double rate = (double)lines / seconds / 1e6;
+        const size_t bytes = result->end - result->start;
+        std::cout << std::vformat("assembler run {:d}: {:.3f} ms, {:.2f} M lines/s ({:d} bytes)\n",
+                                  std::make_format_args(run, seconds * 1e3, rate, bytes));
+        best = std::max(best, rate);
+    }
+
+    std::cout << std::vformat("assembler best: {:.2f} M lines/s\n", std::make_format_args(best));
+    return best;
+}
+
+/// runs every program of the corpus to its end, by the interpreter alone, and checks its output
+static double measure_corpus(const CorpusProgram &program) {
+    const std::string name{program.name};
+    const ROM memory = program.memory();
+
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        MOS6502 cpu{};
+        cpu.burn(memory);
+        cpu.reset();
+        cpu.stop_on_break(true);
+        cpu.accelerate_loops(false);
+        cpu.max_number_of_commands(std::nullopt);
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = cpu.execute();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (!result.has_value() || !std::holds_alternative<MOS6502::StopOnBreak>(result.value()) || !program.succeeded(cpu.get_memory())) {
+            std::cerr << name << " did not produce the expected output\n";
+            return 0;
+        }
+
+        const double seconds = elapsed.count();
+        const uint64_t instructions = cpu.get_metrics().instructionsRetired.load();
+        const double rate = (double)instructions / seconds / 1e6;
+        std::cout << std::vformat("{} run {:d}: {:.3f} s, {:.2f} M instructions/s ({:d} instructions)\n",
+                                  std::make_format_args(name, run, seconds, rate, instructions));
+        best = std::max(best, rate);
+    }
+
+    std::cout << std::vformat("{} best: {:.2f} M instructions/s\n", std::make_format_args(name, best));
+    return best;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t commands = (argc > 1) ? std::stoull(argv[1]) : DEFAULT_COMMANDS;
+    const auto memory = workload();
+
+    if (measure<MOS6502>("exact cycles", memory, commands) == 0) return 1;
+    if (measure<BasicMOS6502<CycleAccounting::NONE>>("no cycles", memory, commands) == 0) return 1;
+    measure_stepper(memory, commands);
+
+    const auto image = firmware();
+    if (measure_firmware(false, image, commands) == 0) return 1;
+    if (measure_firmware(true, image, commands) == 0) return 1;
+
+    const auto randomImage = random_image();
+    // a line takes about as long as a few emulated commands
+    measure_disassembly(false, randomImage, commands / 4);
+    measure_disassembly(true, randomImage, commands / 4);
+
+    // as much as fits the memory
+    if (measure_assembler(25'000) == 0) return 1;
+
+    for (const auto &program: CORPUS)
+        if (measure_corpus(program) == 0) return 1;
+    return 0;
+}
@@ -0,0 +1,107 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <optional>
+#include <string>
+
+#include "FunctionalTest.hpp"
+
+using namespace Emulator;
+
+
+static constexpr auto USAGE =
+        "usage: Emulator_MOS6502_FunctionalTest <image> [options]\n"
+        "\n"
+        "Runs a functional test binary, such as Klaus Dormann's 6502_functional_test.bin, on every engine until it traps\n"
+        "on a branch or a jump to itself, and reports whether it trapped at the success address, with its cycles and time.\n"
+        "Exits with 1 if any engine fails.\n"
+        "\n"
+        "options:\n"
+        "  --origin <address>            address the image is loaded at (default 0x0000)\n"
+        "  --start <address>             address the test starts at (default 0x0400)\n"
+        "  --success <address>           address of the trap reached when every check passed (default 0x3469)\n"
+        "  --max-instructions <n>        fail if there is no trap after n instructions (default 200000000)\n";
+
+
+struct Options {
+    std::filesystem::path image;
+    Word origin = 0;
+    Word start = FUNCTIONAL_TEST_START;
+    Word success = FUNCTIONAL_TEST_SUCCESS;
+    uint64_t maxInstructions = 200'000'000;
+};
+
+
+static std::optional<Options> parse_options(int argc, char *argv[]) {
+    if (argc < 2) return std::nullopt;
+
+    Options options{.image = argv[1]};
+    for (int i = 2; i < argc; i++) {
+        const std::string option = argv[i];
+        if (i + 1 >= argc) return std::nullopt;
+        const std::string value = argv[++i];
+
+        try {
+            if (option == "--max-instructions") {
+                options.maxInstructions = std::stoull(value, nullptr, 0);
+                continue;
+            }
+
+            const unsigned long address = std::stoul(value, nullptr, 0);
+            if (address > 0xFFFF) return std::nullopt;
+            if (option == "--origin") options.origin = address;
+            else if (option == "--start") options.start = address;
+            else if (option == "--success") options.success = address;
+            else return std::nullopt;
+        }
+        catch (const std::logic_error &) {
+            return std::nullopt;
+        }
+    }
+    return options;
+}
+
+
+int main(int argc, char *argv[]) {
+    const auto options = parse_options(argc, argv);
+    if (!options.has_value()) {
+        std::cerr << USAGE;
+        return 2;
+    }
+
+    std::ifstream file(options->image, std::ios::binary);
+    if (!file) {
+        std::cerr << "could not open " << options->image << '\n';
+        return 2;
+    }
+    const std::vector<Byte> image{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    ROM memory{};
+    memory.load(options->origin, image);
+
+    bool passed = true;
+    for (const auto engine: ENGINES) {
+        const auto name = to_string(engine);
+        const auto report = run_to_trap(engine, memory, options->start, options->maxInstructions);
+        if (!report.has_value()) {
+            const auto error = std::visit([](const auto &error) { return error.to_string(); }, report.error());
+            std::cout << std::vformat("{}: failed, {}\n", std::make_format_args(name, error));
+            passed = false;
+            continue;
+        }
+
+        const bool success = report->trap == options->success;
+        const std::string_view outcome = success ? "passed" : "failed";
+        const double seconds = report->elapsed.count();
+        const double rate = (double)report->instructions / seconds / 1e6;
+        std::cout << std::vformat("{}: {}, trapped at {:#06x} after {:d} instructions, {:d} cycles, {:.3f} s ({:.2f} M instructions/s)\n",
+                                  std::make_format_args(name, outcome, report->trap, report->instructions, report->cycles, seconds, rate));
+        passed = passed && success;
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <optional>
+#include <string>
+
+#include "Recompiler.hpp"
+
+using namespace Emulator;
+
+
+static constexpr auto USAGE =
+        "usage: Emulator_MOS6502_Recompiler <image> --output <file> [options]\n"
+        "\n"
+        "Loads a binary image into memory and translates the code reachable from its vectors into a C++ translation unit\n"
+        "defining a RecompiledProgram, to be run by RecompiledRuntime.\n"
+        "\n"
+        "options:\n"
+        "  --origin <address>        address the image is loaded at (default 0x0000)\n"
+        "  --name <identifier>       name of the defined RecompiledProgram (default recompiled_program)\n"
+        "  --entry <address>         also compiles the code reachable from the address; may be repeated\n";
+
+
+struct Options {
+    std::filesystem::path image;
+    std::filesystem::path output;
+    Word origin = 0;
+    std::string name = "recompiled_program";
+    std::vector<Word> entries;
+};
+
+
+static std::optional<Options> parse_options(int argc, char *argv[]) {
+    if (argc < 2) return std::nullopt;
+
+    Options options{.image = argv[1]};
+    for (int i = 2; i < argc; i++) {
+        const std::string option = argv[i];
+        if (i + 1 >= argc) return std::nullopt;
+        const std::string value = argv[++i];
+
+        try {
+            if (option == "--output") options.output = value;
+            else if (option == "--origin") options.origin = std::stoul(value, nullptr, 0);
+            else if (option == "--name") options.name = value;
+            else if (option == "--entry") options.entries.push_back(std::stoul(value, nullptr, 0));
+            else return std::nullopt;
+        }
+        catch (const std::logic_error &e) {
+            return std::nullopt;
+        }
+    }
+    if (options.output.empty()) return std::nullopt;
+    return options;
+}
+
+
+int main(int argc, char *argv[]) {
+    const auto options = parse_options(argc, argv);
+    if (!options.has_value()) {
+        std::cerr << USAGE;
+        return 2;
+    }
+
+    std::ifstream file(options->image, std::ios::binary);
+    if (!file) {
+        std::cerr << "could not open " << options->image << '\n';
+        return 2;
+    }
+    const std::vector<Byte> image{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    ROM memory{};
+    memory.load(options->origin, image);
+
+    Recompiler recompiler(memory);
+    for (const auto entry: options->entries) recompiler.add_entry(entry);
+
+    std::ofstream output(options->output);
+    output << recompiler.translate(options->name);
+    if (!output) {
+        std::cerr << "could not write " << options->output << '\n';
+        return 1;
+    }
+
+    std::cerr << recompiler.commands().size() << " commands compiled\n";
+    return 0;
+}
@@ -0,0 +1,179 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <optional>
+#include <string>
+
+#include "MOS6502.hpp"
+#include "GdbServer.hpp"
+
+using namespace Emulator;
+
+
+static constexpr auto USAGE =
+        "usage: Emulator_MOS6502_Runner <image> [options]\n"
+        "\n"
+        "Loads a binary image into memory, resets the CPU and executes until BRK, JAM, unknown opcode or the command limit.\n"
+        "\n"
+        "options:\n"
+        "  --origin <address>        address the image is loaded at (default 0x0000)\n"
+        "  --start <address>         overwrites the reset vector with the given address\n"
+        "  --max-commands <n>        stop after n commands\n"
+        "  --metrics-file <path>     write metrics in Prometheus text format to this file (atomically replaced)\n"
+        "  --metrics-interval <ms>   export metrics every ms milliseconds while running (default: only at the end)\n";
+
+
+struct Options {
+    std::filesystem::path image;
+    Word origin = 0;
+    std::optional<Word> start;
+    std::optional<size_t> maxCommands;
+    std::optional<std::filesystem::path> metricsFile;
+    std::optional<std::chrono::milliseconds> metricsInterval;
+    std::optional<uint16_t> gdbPort;
+    std::optional<std::string> gdbSocket;
+};
+
+
+static std::optional<Options> parse_options(int argc, char *argv[]) {
+    if (argc < 2) return std::nullopt;
+
+    Options options{.image = argv[1]};
+    for (int i = 2; i < argc; i++) {
+        const std::string option = argv[i];
+        if (i + 1 >= argc) return std::nullopt;
+        const std::string value = argv[++i];
+
+        try {
+            if (option == "--origin") options.origin = std::stoul(value, nullptr, 0);
+            else if (option == "--start") options.start = std::stoul(value, nullptr, 0);
+            else if (option == "--max-commands") options.maxCommands = std::stoull(value, nullptr, 0);
+            else if (option == "--metrics-file") options.metricsFile = value;
+            else if (option == "--metrics-interval") options.metricsInterval = std::chrono::milliseconds(std::stoul(value));
+            else if (option == "--gdb") options.gdbPort = std::stoul(value, nullptr, 0);
+            else if (option == "--gdb-socket") options.gdbSocket = value;
+            else return std::nullopt;
+        }
+        catch (const std::logic_error &e) {
+            return std::nullopt;
+        }
+    }
+    return options;
+}
+
+
+static void export_metrics(const Metrics &metrics, const Options &options) {
+    const auto text = to_prometheus(metrics.snapshot());
+    if (!options.metricsFile.has_value()) {
+        std::cout << text << std::flush;
+        return;
+    }
+
+    // writing to a temporary file first, so that a scraper never sees a partially written file
+    auto temporary = options.metricsFile.value();
+    temporary += ".tmp";
+    std::ofstream(temporary) << text;
+    std::filesystem::rename(temporary, options.metricsFile.value());
+}
+
+
+static int debug(MOS6502 &cpu, const Options &options) {
+    GdbServer server(cpu);
+
+#ifndef _WIN32
+    auto listening = options.gdbSocket.has_value()
+            ? server.listen_unix(options.gdbSocket.value())
+            : server.listen_tcp(options.gdbPort.value());
+#else
+    if (options.gdbSocket.has_value()) {
+        std::cerr << "Unix domain sockets are not supported on this platform\n";
+        return 2;
+    }
+    auto listening = server.listen_tcp(options.gdbPort.value());
+#endif
+    if (!listening.has_value()) {
+        std::cerr << listening.error() << '\n';
+        return 2;
+    }
+
+    std::cerr << "waiting for a debugger connection\n";
+    const auto served = server.serve();
+    if (!served.has_value()) {
+        std::cerr << served.error() << '\n';
+        return 1;
+    }
+
+    export_metrics(cpu.get_metrics(), options);
+    return 0;
+}
+
+
+int main(int argc, char *argv[]) {
+    const auto options = parse_options(argc, argv);
+    if (!options.has_value()) {
+        std::cerr << USAGE;
+        return 2;
+    }
+
+    std::ifstream file(options->image, std::ios::binary);
+    if (!file) {
+        std::cerr << "could not open " << options->image << '\n';
+        return 2;
+    }
+    const std::vector<Byte> image{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    ROM memory{};
+    memory.load(options->origin, image);
+    if (options->start.has_value()) {
+        const WordToBytes buf(options->start.value());
+        memory[ROM::RESET_LOCATION] = buf.low;
+        memory[ROM::RESET_LOCATION + 1] = buf.high;
+    }
+
+    MOS6502 cpu{};
+    cpu.burn(memory);
+    cpu.reset();
+    cpu.stop_on_break(true);
+    cpu.max_number_of_commands(options->maxCommands);
+    if (options->gdbPort.has_value() || options->gdbSocket.has_value()) return debug(cpu, options.value());
+
+    std::atomic<bool> finished = false;
+    std::expected<MOS6502::SuccessfulTermination, MOS6502::ErrorTermination> status;
+    std::thread worker([&cpu, &status, &finished]() {
+        status = cpu.execute();
+        finished.store(true, std::memory_order_release);
+    });
+
+    // metrics are sampled while the CPU is running without any synchronisation with it
+    if (options->metricsInterval.has_value())
+        while (!finished.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(options->metricsInterval.value());
+            export_metrics(cpu.get_metrics(), options.value());
+        }
+    worker.join();
+    export_metrics(cpu.get_metrics(), options.value());
+
+    if (!status.has_value()) {
+        std::visit(Overload{
+                [](MOS6502::UnknownOperation error) {
+                    std::cerr << std::vformat("Could not parse operation at 0x{:04x}\n", std::make_format_args(error.address));
+                },
+                [](MOS6502::Jammed error) {
+                    std::cerr << std::vformat("Processor jammed at 0x{:04x}\n", std::make_format_args(error.address));
+                },
+        }, status.error());
+        return 1;
+    }
+
+    std::cerr << cpu.dump(false) << '\n';
+    return 0;
+}
+
@@ -0,0 +1,110 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <optional>
+#include <string>
+
+#include "SingleStepTests.hpp"
+
+using namespace Emulator;
+
+
+static constexpr auto USAGE =
+        "usage: Emulator_MOS6502_SingleStepTests <file or directory>... [options]\n"
+        "\n"
+        "Runs per-instruction test vectors in the format of the SingleStepTests suite, such as 6502/v1/a9.json,\n"
+        "on both the interpreter and the cycle stepper. A directory stands for every .json file in it.\n"
+        "Exits with 1 if any case fails.\n"
+        "\n"
+        "options:\n"
+        "  --threads <n>                 number of threads running the cases (default: one per core)\n"
+        "  --failures <n>                number of failed cases shown per file (default 10)\n";
+
+
+struct Options {
+    std::vector<std::filesystem::path> files;
+    unsigned threads = 0;
+    size_t failures = 10;
+};
+
+
+static std::optional<Options> parse_options(int argc, char *argv[]) {
+    Options options{};
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (!argument.starts_with("--")) {
+            const std::filesystem::path path = argument;
+            if (!std::filesystem::is_directory(path)) {
+                options.files.push_back(path);
+                continue;
+            }
+
+            std::vector<std::filesystem::path> files;
+            for (const auto &entry: std::filesystem::directory_iterator(path))
+                if (entry.path().extension() == ".json") files.push_back(entry.path());
+            std::ranges::sort(files);
+            options.files.insert(options.files.end(), files.begin(), files.end());
+            continue;
+        }
+
+        if (i + 1 >= argc) return std::nullopt;
+        const std::string value = argv[++i];
+        try {
+            if (argument == "--threads") options.threads = std::stoul(value, nullptr, 0);
+            else if (argument == "--failures") options.failures = std::stoull(value, nullptr, 0);
+            else return std::nullopt;
+        }
+        catch (const std::logic_error &e) {
+            return std::nullopt;
+        }
+    }
+    if (options.files.empty()) return std::nullopt;
+    return options;
+}
+
+
+int main(int argc, char *argv[]) {
+    const auto options = parse_options(argc, argv);
+    if (!options.has_value()) {
+        std::cerr << USAGE;
+        return 2;
+    }
+
+    bool passed = true;
+    size_t cases = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (const auto &path: options->files) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "could not open " << path << '\n';
+            return 2;
+        }
+
+        const auto name = path.filename().string();
+        const auto report = run_single_step_tests(file, options->threads, options->failures);
+        if (!report.has_value()) {
+            std::cerr << std::vformat("{}: {}\n", std::make_format_args(name, report.error().to_string()));
+            return 2;
+        }
+
+        std::cout << std::vformat("{}: {:d} cases, {:d} interpreter failures, {:d} cycle stepper failures\n",
+                                  std::make_format_args(name, report->cases, report->interpreterFailures, report->stepperFailures));
+        for (const auto &failure: report->failures)
+            std::cout << std::vformat("  case {:d} \"{}\": {}\n", std::make_format_args(failure.index, failure.name, failure.difference));
+
+        cases += report->cases;
+        passed = passed && report->interpreterFailures == 0 && report->stepperFailures == 0;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    const double rate = (double)cases / seconds;
+    std::cout << std::vformat("{:d} cases in {:.3f} s ({:.0f} cases/s)\n", std::make_format_args(cases, seconds, rate));
+    return passed ? 0 : 1;
+}
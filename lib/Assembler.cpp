@@ -0,0 +1,21 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "Assembler.hpp"
+
+using namespace Emulator;
+
+
+std::expected<AssembledRange, AssemblyError> Assembler::assemble(std::string_view source, ROM &memory) {
+    return assemble(source, [&memory](Word address, Byte value) { memory.set_byte(address, value); });
+}
+
+std::expected<AssembledRange, AssemblyError> Assembler::assemble(std::string_view source, Word origin, std::span<Byte> output) {
+    return assemble(source, [origin, output](Word address, Byte value) {
+        const size_t offset = address - origin;
+        if (address < origin || offset >= output.size()) return false;
+        output[offset] = value;
+        return true;
+    }, origin);
+}
@@ -0,0 +1,723 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_ASSEMBLER_HPP
+#define EMULATOR_MOS6502_ASSEMBLER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "OpcodeTable.hpp"
+#include "ROM.hpp"
+
+namespace Emulator {
+
+    struct SyntaxError {
+        size_t line;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("Line {:d}: syntax error", std::make_format_args(line));
+        }
+    };
+
+    struct UnknownMnemonic {
+        size_t line;
+        std::string_view mnemonic;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("Line {:d}: unknown mnemonic {}", std::make_format_args(line, mnemonic));
+        }
+    };
+
+    /// the command has no opcode in the addressing mode of the operand
+    struct InvalidAddressing {
+        size_t line;
+        std::string_view mnemonic;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("Line {:d}: {} does not support the addressing of its operand", std::make_format_args(line, mnemonic));
+        }
+    };
+
+    struct UndefinedSymbol {
+        size_t line;
+        std::string_view name;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("Line {:d}: {} is not defined", std::make_format_args(line, name));
+        }
+    };
+
+    struct DuplicateSymbol {
+        size_t line;
+        std::string_view name;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("Line {:d}: {} is already defined", std::make_format_args(line, name));
+        }
+    };
+
+    /// a value not fitting its operand, a branch too far or code past the end of the memory or of the output
+    struct ValueOutOfRange {
+        size_t line;
+        int64_t value;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("Line {:d}: {:d} is out of range", std::make_format_args(line, value));
+        }
+    };
+
+    using AssemblyError = std::variant<SyntaxError, UnknownMnemonic, InvalidAddressing, UndefinedSymbol, DuplicateSymbol, ValueOutOfRange>;
+
+    /// the addresses written by the assembled program
+    struct AssembledRange {
+        /// the lowest address written
+        Word start;
+        /// one past the highest address written, equal to start if nothing is written
+        size_t end;
+    };
+
+
+    /**
+     * Two-pass assembler of 6502 source text, emitting the bytes one at a time to a writer, so that nothing is
+     *  allocated per command. Everything is constexpr, so that programs can be assembled at compile time as well.
+     *
+     * A line is `[label:] [statement] [; comment]`, where the statement is a command, a directive or a constant
+     *  definition `name = expression`. Mnemonics are case-insensitive, symbols are not; undocumented opcodes can be
+     *  used by their names, the documented opcode being chosen whenever there are several.
+     *
+     * Operands: none or `A`, `#value`, `address`, `address,X`, `address,Y`, `(address)`, `(address,X)`, `(address),Y`,
+     *  where an operand starting with a parenthesis is taken as indirect whenever the command supports it.
+     * An address fitting the zero page selects the zero page addressing, unless its value depends on symbols
+     *  defined below it, since the length of the command has to be known in the first pass.
+     *
+     * Expressions: decimal, $hexadecimal, %binary and 'c' numbers, symbols, `*` for the address of the statement,
+     *  unary `-`, `~`, `<` (low byte) and `>` (high byte), binary `* / % + - << >> & ^ |` with the precedence of C,
+     *  and parentheses.
+     *
+     * Directives: `.org address` (the origin until then), `.byte` with values and "strings", `.word` with little-endian words.
+     */
+    class Assembler {
+    public:
+        /**
+         * @param write called with every address written and its byte, in the order of the source; if it returns
+         *  a bool, false stops the assembly with ValueOutOfRange
+         * @param origin address of the source up to its first .org
+         */
+        template<typename Writer>
+        static constexpr std::expected<AssembledRange, AssemblyError> assemble(std::string_view source, Writer &&write, Word origin = 0) {
+            Assembler assembler(source, origin);
+            if (auto result = assembler.pass([](Word, Byte) {}); !result.has_value()) return result;
+            assembler.resolve_deferred();
+            assembler.m_secondPass = true;
+            return assembler.pass(write);
+        }
+
+        /// writes the program to the memory
+        static std::expected<AssembledRange, AssemblyError> assemble(std::string_view source, ROM &memory);
+
+        /**
+         * Writes the program to the output, whose first byte is at the given address, which is the origin of the source too.
+         * The bytes of the output which are not written are left as they are.
+         */
+        static std::expected<AssembledRange, AssemblyError> assemble(std::string_view source, Word origin, std::span<Byte> output);
+
+    private:
+        static constexpr size_t MODES_COUNT = (size_t)AddressingMode::INDIRECT + 1;
+
+        /// the opcode of every mnemonic in every addressing mode, -1 if there is none
+        struct Mnemonic {
+            std::string_view name;
+            std::array<int16_t, MODES_COUNT> opcodes;
+        };
+
+        struct MnemonicTable {
+            std::array<Mnemonic, 256> mnemonics;
+            size_t count;
+        };
+
+        /// built from OPCODES, sorted by name
+        static constexpr MnemonicTable MNEMONICS = [] {
+            MnemonicTable table{};
+            for (size_t opCode = 0; opCode < OPCODES.size(); opCode++) {
+                const auto &info = OPCODES[opCode];
+                size_t index = 0;
+                while (index < table.count && table.mnemonics[index].name != info.mnemonic) index++;
+                if (index == table.count) {
+                    table.mnemonics[table.count].name = info.mnemonic;
+                    table.mnemonics[table.count++].opcodes.fill(-1);
+                }
+
+                auto &known = table.mnemonics[index].opcodes[(size_t)info.mode];
+                if (known < 0 || (info.documented && !OPCODES[known].documented)) known = (int16_t)opCode;
+            }
+            std::ranges::sort(table.mnemonics.begin(), table.mnemonics.begin() + table.count, {}, &Mnemonic::name);
+            return table;
+        }();
+
+        struct Symbol {
+            std::string_view name;
+            int64_t value;
+            size_t line;
+            /// whether it was defined in the first pass, so that it may decide the length of the commands below it
+            bool firstPass;
+        };
+
+        /// a constant depending on symbols defined below it, resolved once the first pass has defined all the labels
+        struct Deferred {
+            std::string_view name;
+            std::string_view expression;
+            size_t line;
+            /// the value of `*` in the expression
+            size_t address;
+        };
+
+        /// value of an expression, undefined in the first pass if it depends on symbols not defined yet
+        struct Value {
+            int64_t value;
+            bool defined;
+            /// whether the value was already known at this line in the first pass
+            bool early;
+        };
+
+        using Status = std::expected<void, AssemblyError>;
+        using Evaluation = std::expected<Value, AssemblyError>;
+
+        constexpr Assembler(std::string_view source, Word origin): m_source{source}, m_origin{origin} {}
+
+        template<typename Writer>
+        constexpr std::expected<AssembledRange, AssemblyError> pass(Writer &&write) {
+            m_address = m_origin;
+            m_line = 0;
+            m_lowest = SIZE_MAX;
+            m_highest = 0;
+
+            for (size_t position = 0; position <= m_source.size();) {
+                size_t end = m_source.find('\n', position);
+                if (end == std::string_view::npos) end = m_source.size();
+                m_line++;
+                if (auto status = statement(m_source.substr(position, end - position), write); !status.has_value())
+                    return std::unexpected(status.error());
+                position = end + 1;
+            }
+
+            if (m_lowest == SIZE_MAX) return AssembledRange{.start = 0, .end = 0};
+            return AssembledRange{.start = (Word)m_lowest, .end = m_highest};
+        }
+
+        /*
+         * Lexical helpers
+         */
+
+        static constexpr bool is_space(char c) noexcept { return c == ' ' || c == '\t' || c == '\r'; }
+        static constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+        static constexpr bool is_letter(char c) noexcept { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+        static constexpr char to_upper(char c) noexcept { return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c; }
+
+        static constexpr std::string_view trim(std::string_view text) noexcept {
+            while (!text.empty() && is_space(text.front())) text.remove_prefix(1);
+            while (!text.empty() && is_space(text.back())) text.remove_suffix(1);
+            return text;
+        }
+
+        static constexpr bool equal_ignoring_case(std::string_view text, std::string_view upper) noexcept {
+            if (text.size() != upper.size()) return false;
+            for (size_t i = 0; i < text.size(); i++) if (to_upper(text[i]) != upper[i]) return false;
+            return true;
+        }
+
+        /// the identifier at the start of the text, empty if there is none
+        static constexpr std::string_view identifier(std::string_view text) noexcept {
+            if (text.empty() || !is_letter(text.front())) return {};
+            size_t length = 1;
+            while (length < text.size() && (is_letter(text[length]) || is_digit(text[length]) || text[length] == '.')) length++;
+            return text.substr(0, length);
+        }
+
+        /// the line without its comment, which may not start within quotes
+        static constexpr std::string_view strip_comment(std::string_view line) noexcept {
+            char quote = 0;
+            for (size_t i = 0; i < line.size(); i++) {
+                if (quote) {
+                    if (line[i] == quote) quote = 0;
+                }
+                else if (line[i] == '"') quote = '"';
+                // a character literal is always three characters long, so that ';' can be one
+                else if (line[i] == '\'') i += 2;
+                else if (line[i] == ';') return line.substr(0, i);
+            }
+            return line;
+        }
+
+        /// splits the text at the commas outside of quotes and parentheses, calling the function with every part
+        template<typename F>
+        static constexpr Status for_each_item(std::string_view text, F &&function) {
+            int depth = 0;
+            char quote = 0;
+            size_t start = 0;
+            for (size_t i = 0; i <= text.size(); i++) {
+                if (i < text.size()) {
+                    const char c = text[i];
+                    if (quote) { if (c == quote) quote = 0; continue; }
+                    if (c == '"') { quote = c; continue; }
+                    if (c == '\'') { i += 2; continue; }
+                    if (c == '(') depth++;
+                    if (c == ')') depth--;
+                    if (c != ',' || depth != 0) continue;
+                }
+                if (auto status = function(trim(text.substr(start, i - start))); !status.has_value()) return status;
+                start = i + 1;
+            }
+            return {};
+        }
+
+        /*
+         * Symbols, kept in an open-addressing hash table
+         */
+
+        static constexpr size_t hash(std::string_view name) noexcept {
+            uint64_t result = 14695981039346656037ull;
+            for (const char c: name) result = (result ^ (unsigned char)c) * 1099511628211ull;
+            return (size_t)result;
+        }
+
+        [[nodiscard]] constexpr const Symbol* find(std::string_view name) const noexcept {
+            if (m_symbols.empty()) return nullptr;
+            for (size_t slot = hash(name) & (m_symbols.size() - 1);; slot = (slot + 1) & (m_symbols.size() - 1)) {
+                if (m_symbols[slot].name.empty()) return nullptr;
+                if (m_symbols[slot].name == name) return &m_symbols[slot];
+            }
+        }
+
+        constexpr Status define(std::string_view name, Value value) {
+            if (!m_secondPass) {
+                if (find(name) != nullptr) return std::unexpected(DuplicateSymbol{.line = m_line, .name = name});
+                if (!value.defined) return {};
+                if (2 * (m_symbolsCount + 1) > m_symbols.size()) grow();
+                insert({.name = name, .value = value.value, .line = m_line, .firstPass = true});
+                m_symbolsCount++;
+                return {};
+            }
+
+            if (const auto *symbol = find(name); symbol != nullptr) {
+                // the lengths of the commands are the same in both passes, so are the addresses
+                if (symbol->line != m_line) return std::unexpected(DuplicateSymbol{.line = m_line, .name = name});
+                return {};
+            }
+            if (2 * (m_symbolsCount + 1) > m_symbols.size()) grow();
+            insert({.name = name, .value = value.value, .line = m_line, .firstPass = false});
+            m_symbolsCount++;
+            return {};
+        }
+
+        /**
+         * Defines the deferred constants whose symbols are all known, over and over until no more can be, so that
+         *  they can be used at any line in the second pass. They are never early, as the commands using them above
+         *  their definitions took the absolute addressing in the first pass. The rest are circular or use undefined
+         *  symbols, which the second pass reports.
+         */
+        constexpr void resolve_deferred() {
+            for (bool resolved = true; resolved;) {
+                resolved = false;
+                for (auto deferred = m_deferred.begin(); deferred != m_deferred.end();) {
+                    m_line = deferred->line;
+                    m_statementAddress = deferred->address;
+                    const auto value = evaluate(deferred->expression);
+                    if (!value.has_value() || !value->defined) {
+                        ++deferred;
+                        continue;
+                    }
+
+                    if (2 * (m_symbolsCount + 1) > m_symbols.size()) grow();
+                    insert({.name = deferred->name, .value = value->value, .line = deferred->line, .firstPass = false});
+                    m_symbolsCount++;
+                    deferred = m_deferred.erase(deferred);
+                    resolved = true;
+                }
+            }
+        }
+
+        constexpr void insert(const Symbol &symbol) noexcept {
+            size_t slot = hash(symbol.name) & (m_symbols.size() - 1);
+            while (!m_symbols[slot].name.empty()) slot = (slot + 1) & (m_symbols.size() - 1);
+            m_symbols[slot] = symbol;
+        }
+
+        constexpr void grow() {
+            std::vector<Symbol> symbols(std::max<size_t>(64, 2 * m_symbols.size()));
+            std::swap(symbols, m_symbols);
+            for (const auto &symbol: symbols) if (!symbol.name.empty()) insert(symbol);
+        }
+
+        /*
+         * Expressions, by recursive descent; every function consumes its part from the front of the text
+         */
+
+        using Binary = int64_t (*)(int64_t, int64_t);
+
+        struct Operator {
+            std::string_view token;
+            int precedence;
+            Binary apply;
+        };
+
+        static constexpr std::array<Operator, 10> OPERATORS{{
+            {"<<", 4, [](int64_t a, int64_t b) { return b < 0 || b > 62 ? 0 : a << b; }},
+            {">>", 4, [](int64_t a, int64_t b) { return b < 0 || b > 62 ? 0 : a >> b; }},
+            {"|", 0, [](int64_t a, int64_t b) { return a | b; }},
+            {"^", 1, [](int64_t a, int64_t b) { return a ^ b; }},
+            {"&", 2, [](int64_t a, int64_t b) { return a & b; }},
+            {"+", 5, [](int64_t a, int64_t b) { return a + b; }},
+            {"-", 5, [](int64_t a, int64_t b) { return a - b; }},
+            {"*", 6, [](int64_t a, int64_t b) { return a * b; }},
+            {"/", 6, [](int64_t a, int64_t b) { return b == 0 ? 0 : a / b; }},
+            {"%", 6, [](int64_t a, int64_t b) { return b == 0 ? 0 : a % b; }},
+        }};
+        static constexpr int LOWEST_PRECEDENCE = 0;
+
+        /// the whole text must be a single expression
+        constexpr Evaluation evaluate(std::string_view text) const {
+            text = trim(text);
+            auto result = binary(text, LOWEST_PRECEDENCE);
+            if (result.has_value() && !trim(text).empty()) return std::unexpected(SyntaxError{.line = m_line});
+            if (result.has_value() && !result->defined && m_secondPass) return std::unexpected(SyntaxError{.line = m_line});
+            return result;
+        }
+
+        constexpr Evaluation binary(std::string_view &text, int precedence) const {
+            auto left = unary(text);
+            if (!left.has_value()) return left;
+
+            while (true) {
+                text = trim(text);
+                const Operator *found = nullptr;
+                for (const auto &candidate: OPERATORS)
+                    if (text.starts_with(candidate.token)) { found = &candidate; break; }
+                if (found == nullptr || found->precedence < precedence) return left;
+
+                text.remove_prefix(found->token.size());
+                auto right = binary(text, found->precedence + 1);
+                if (!right.has_value()) return right;
+                left = Value{.value = found->apply(left->value, right->value), .defined = left->defined && right->defined,
+                             .early = left->early && right->early};
+            }
+        }
+
+        constexpr Evaluation unary(std::string_view &text) const {
+            text = trim(text);
+            if (text.empty()) return std::unexpected(SyntaxError{.line = m_line});
+
+            const char prefix = text.front();
+            if (prefix == '-' || prefix == '~' || prefix == '<' || prefix == '>') {
+                text.remove_prefix(1);
+                auto operand = unary(text);
+                if (!operand.has_value()) return operand;
+                const int64_t value = operand->value;
+                operand->value = prefix == '-' ? -value : prefix == '~' ? ~value : prefix == '<' ? value & 0xFF : (value >> 8) & 0xFF;
+                return operand;
+            }
+            return primary(text);
+        }
+
+        constexpr Evaluation primary(std::string_view &text) const {
+            const char first = text.front();
+            if (first == '(') {
+                text.remove_prefix(1);
+                auto inner = binary(text, LOWEST_PRECEDENCE);
+                text = trim(text);
+                if (!inner.has_value()) return inner;
+                if (text.empty() || text.front() != ')') return std::unexpected(SyntaxError{.line = m_line});
+                text.remove_prefix(1);
+                return inner;
+            }
+            if (first == '*') {
+                text.remove_prefix(1);
+                return Value{.value = (int64_t)m_statementAddress, .defined = true, .early = true};
+            }
+            if (first == '\'') {
+                if (text.size() < 3 || text[2] != '\'') return std::unexpected(SyntaxError{.line = m_line});
+                const int64_t value = (unsigned char)text[1];
+                text.remove_prefix(3);
+                return Value{.value = value, .defined = true, .early = true};
+            }
+            if (first == '$' || first == '%' || is_digit(first)) return number(text);
+
+            const auto name = identifier(text);
+            if (name.empty()) return std::unexpected(SyntaxError{.line = m_line});
+            text.remove_prefix(name.size());
+
+            const auto *symbol = find(name);
+            if (symbol == nullptr) {
+                if (m_secondPass) return std::unexpected(UndefinedSymbol{.line = m_line, .name = name});
+                return Value{.value = 0, .defined = false, .early = false};
+            }
+            return Value{.value = symbol->value, .defined = true, .early = symbol->firstPass && symbol->line < m_line};
+        }
+
+        constexpr Evaluation number(std::string_view &text) const {
+            unsigned base = 10;
+            if (text.front() == '$') base = 16;
+            if (text.front() == '%') base = 2;
+            if (base != 10) text.remove_prefix(1);
+
+            int64_t value = 0;
+            size_t digits = 0;
+            for (; digits < text.size(); digits++) {
+                const char c = to_upper(text[digits]);
+                const unsigned digit = is_digit(c) ? c - '0' : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : base;
+                if (digit >= base) break;
+                value = value * base + digit;
+                if (value > UINT32_MAX) return std::unexpected(ValueOutOfRange{.line = m_line, .value = value});
+            }
+            if (digits == 0 || (digits < text.size() && (is_letter(text[digits]) || is_digit(text[digits]))))
+                return std::unexpected(SyntaxError{.line = m_line});
+            text.remove_prefix(digits);
+            return Value{.value = value, .defined = true, .early = true};
+        }
+
+        /*
+         * Statements
+         */
+
+        template<typename Writer>
+        constexpr Status emit(Writer &&write, int64_t value) {
+            if (m_address > UINT16_MAX) return std::unexpected(ValueOutOfRange{.line = m_line, .value = (int64_t)m_address});
+            if (m_secondPass) {
+                if constexpr (std::is_same_v<decltype(write(Word{}, Byte{})), bool>) {
+                    if (!write((Word)m_address, (Byte)value)) return std::unexpected(ValueOutOfRange{.line = m_line, .value = (int64_t)m_address});
+                }
+                else write((Word)m_address, (Byte)value);
+            }
+            m_lowest = std::min(m_lowest, m_address);
+            m_highest = std::max(m_highest, m_address + 1);
+            m_address++;
+            return {};
+        }
+
+        /// the value must fit the given number of bytes, as unsigned or as signed
+        constexpr Status check_range(Value value, size_t bytes) const {
+            const int64_t limit = (int64_t)1 << (8 * bytes);
+            if (value.defined && (value.value >= limit || value.value < -limit / 2))
+                return std::unexpected(ValueOutOfRange{.line = m_line, .value = value.value});
+            return {};
+        }
+
+        template<typename Writer>
+        constexpr Status statement(std::string_view line, Writer &&write) {
+            line = trim(strip_comment(line));
+            m_statementAddress = m_address;
+
+            // labels, or a constant
+            if (const auto name = identifier(line); !name.empty()) {
+                const auto rest = trim(line.substr(name.size()));
+                if (rest.starts_with(':')) {
+                    if (auto status = define(name, {.value = (int64_t)m_address, .defined = true, .early = true}); !status.has_value())
+                        return status;
+                    line = trim(rest.substr(1));
+                }
+                else if (rest.starts_with('=')) {
+                    const auto value = evaluate(rest.substr(1));
+                    if (!value.has_value()) return std::unexpected(value.error());
+                    if (!value->defined && !m_secondPass && find(name) == nullptr)
+                        m_deferred.push_back({.name = name, .expression = rest.substr(1), .line = m_line, .address = m_statementAddress});
+                    return define(name, value.value());
+                }
+            }
+            if (line.empty()) return {};
+
+            if (line.front() == '.') return directive(line, write);
+            return command(line, write);
+        }
+
+        template<typename Writer>
+        constexpr Status directive(std::string_view line, Writer &&write) {
+            const auto name = identifier(line.substr(1));
+            const auto arguments = trim(line.substr(1 + name.size()));
+
+            if (equal_ignoring_case(name, "ORG")) {
+                const auto value = evaluate(arguments);
+                if (!value.has_value()) return std::unexpected(value.error());
+                // the addresses of everything below depend on it
+                if (!value->early) return std::unexpected(UndefinedSymbol{.line = m_line, .name = arguments});
+                if (value->value < 0 || value->value > UINT16_MAX) return std::unexpected(ValueOutOfRange{.line = m_line, .value = value->value});
+                m_address = (size_t)value->value;
+                return {};
+            }
+
+            const bool bytes = equal_ignoring_case(name, "BYTE");
+            if (!bytes && !equal_ignoring_case(name, "WORD")) return std::unexpected(SyntaxError{.line = m_line});
+
+            return for_each_item(arguments, [&](std::string_view item) -> Status {
+                if (bytes && item.size() >= 2 && item.front() == '"' && item.back() == '"') {
+                    for (const char c: item.substr(1, item.size() - 2))
+                        if (auto status = emit(write, (unsigned char)c); !status.has_value()) return status;
+                    return {};
+                }
+
+                const auto value = evaluate(item);
+                if (!value.has_value()) return std::unexpected(value.error());
+                if (auto status = check_range(value.value(), bytes ? 1 : 2); !status.has_value()) return status;
+                if (auto status = emit(write, value->value & 0xFF); !status.has_value()) return status;
+                if (!bytes) return emit(write, (value->value >> 8) & 0xFF);
+                return {};
+            });
+        }
+
+        template<typename Writer>
+        constexpr Status command(std::string_view line, Writer &&write) {
+            const auto name = identifier(line);
+            if (name.empty()) return std::unexpected(SyntaxError{.line = m_line});
+            std::string_view operand = trim(line.substr(name.size()));
+
+            // the mnemonics are sorted and upper case
+            char upper[4]{};
+            if (name.size() > std::size(upper)) return std::unexpected(UnknownMnemonic{.line = m_line, .mnemonic = name});
+            for (size_t i = 0; i < name.size(); i++) upper[i] = to_upper(name[i]);
+            const std::string_view key(upper, name.size());
+            const auto *end = MNEMONICS.mnemonics.begin() + MNEMONICS.count;
+            const auto *mnemonic = std::ranges::lower_bound(MNEMONICS.mnemonics.begin(), end, key, {}, &Mnemonic::name);
+            if (mnemonic == end || mnemonic->name != key) return std::unexpected(UnknownMnemonic{.line = m_line, .mnemonic = name});
+
+            const auto &opcodes = mnemonic->opcodes;
+            const auto supports = [&](AddressingMode mode) { return opcodes[(size_t)mode] >= 0; };
+            const auto invalid = [&]() -> Status { return std::unexpected(InvalidAddressing{.line = m_line, .mnemonic = name}); };
+
+            if (operand.empty() || equal_ignoring_case(operand, "A")) {
+                if (supports(AddressingMode::ACCUMULATOR)) return encode(write, opcodes[(size_t)AddressingMode::ACCUMULATOR], {});
+                if (operand.empty() && supports(AddressingMode::IMPLICIT)) return encode(write, opcodes[(size_t)AddressingMode::IMPLICIT], {});
+                return invalid();
+            }
+
+            if (operand.front() == '#') {
+                if (!supports(AddressingMode::IMMEDIATE)) return invalid();
+                const auto value = evaluate(operand.substr(1));
+                if (!value.has_value()) return std::unexpected(value.error());
+                if (auto status = check_range(value.value(), 1); !status.has_value()) return status;
+                return encode(write, opcodes[(size_t)AddressingMode::IMMEDIATE], value.value());
+            }
+
+            if (supports(AddressingMode::RELATIVE)) {
+                const auto target = evaluate(operand);
+                if (!target.has_value()) return std::unexpected(target.error());
+                const int64_t offset = target->value - (int64_t)(m_address + 2);
+                if (target->defined && (offset < INT8_MIN || offset > INT8_MAX))
+                    return std::unexpected(ValueOutOfRange{.line = m_line, .value = offset});
+                return encode(write, opcodes[(size_t)AddressingMode::RELATIVE], {.value = offset, .defined = target->defined, .early = true});
+            }
+
+            // the index register, if any, follows the last comma
+            char index = 0;
+            if (const auto comma = operand.rfind(','); comma != std::string_view::npos) {
+                const auto suffix = trim(operand.substr(comma + 1));
+                const auto beforeClose = suffix.ends_with(')') ? trim(suffix.substr(0, suffix.size() - 1)) : suffix;
+                if (equal_ignoring_case(beforeClose, "X") || equal_ignoring_case(beforeClose, "Y")) {
+                    index = to_upper(beforeClose.front());
+                    // "(address,X)" keeps its closing parenthesis, to be recognized below
+                    operand = trim(operand.substr(0, comma));
+                    if (suffix.ends_with(')')) {
+                        if (index != 'X' || !operand.starts_with('(')) return std::unexpected(SyntaxError{.line = m_line});
+                        if (!supports(AddressingMode::INDIRECT_X)) return invalid();
+                        return encode_address(write, name, opcodes, operand.substr(1), AddressingMode::INDIRECT_X, AddressingMode::INDIRECT_X);
+                    }
+                }
+            }
+
+            if (operand.starts_with('(') && operand.ends_with(')')) {
+                const auto inner = operand.substr(1, operand.size() - 2);
+                if (index == 'Y' && supports(AddressingMode::INDIRECT_Y))
+                    return encode_address(write, name, opcodes, inner, AddressingMode::INDIRECT_Y, AddressingMode::INDIRECT_Y);
+                if (index == 0 && supports(AddressingMode::INDIRECT))
+                    return encode_address(write, name, opcodes, inner, AddressingMode::INDIRECT, AddressingMode::INDIRECT);
+            }
+
+            if (index == 'X') return encode_address(write, name, opcodes, operand, AddressingMode::ZERO_PAGE_X, AddressingMode::ABSOLUTE_X);
+            if (index == 'Y') return encode_address(write, name, opcodes, operand, AddressingMode::ZERO_PAGE_Y, AddressingMode::ABSOLUTE_Y);
+            return encode_address(write, name, opcodes, operand, AddressingMode::ZERO_PAGE, AddressingMode::ABSOLUTE);
+        }
+
+        /// chooses the zero page mode if the address fits it and is known in the first pass already
+        template<typename Writer>
+        constexpr Status encode_address(Writer &&write, std::string_view name, const std::array<int16_t, MODES_COUNT> &opcodes, std::string_view operand,
+                                        AddressingMode zeroPage, AddressingMode absolute) {
+            const auto value = evaluate(operand);
+            if (!value.has_value()) return std::unexpected(value.error());
+
+            const bool hasZeroPage = opcodes[(size_t)zeroPage] >= 0, hasAbsolute = opcodes[(size_t)absolute] >= 0;
+            if (!hasZeroPage && !hasAbsolute) return std::unexpected(InvalidAddressing{.line = m_line, .mnemonic = name});
+
+            const bool fits = value->early && value->value >= 0 && value->value <= UINT8_MAX;
+            const auto mode = hasZeroPage && (fits || !hasAbsolute) ? zeroPage : absolute;
+            if (value->defined && (value->value < 0 || value->value >= (int64_t)1 << (8 * operand_length(mode))))
+                return std::unexpected(ValueOutOfRange{.line = m_line, .value = value->value});
+            return encode(write, opcodes[(size_t)mode], value.value());
+        }
+
+        template<typename Writer>
+        constexpr Status encode(Writer &&write, int16_t opCode, Value operand) {
+            if (auto status = emit(write, opCode); !status.has_value()) return status;
+            for (size_t i = 0; i < operand_length(OPCODES[opCode].mode); i++)
+                if (auto status = emit(write, (operand.value >> (8 * i)) & 0xFF); !status.has_value()) return status;
+            return {};
+        }
+
+        std::string_view m_source;
+        Word m_origin;
+        bool m_secondPass = false;
+        size_t m_line = 0;
+        /// may reach past the end of the memory, which is an error only if anything is written there
+        size_t m_address = 0;
+        size_t m_statementAddress = 0;
+        size_t m_lowest = SIZE_MAX, m_highest = 0;
+
+        std::vector<Symbol> m_symbols;
+        size_t m_symbolsCount = 0;
+        std::vector<Deferred> m_deferred;
+    };
+
+
+    /// source text usable as a template argument, e.g. `constexpr AssemblySource SOURCE{"NOP"};`
+    template<size_t N>
+    struct AssemblySource {
+        char text[N]{};
+
+        consteval AssemblySource(const char (&literal)[N]) noexcept { std::copy_n(literal, N, text); }
+
+        [[nodiscard]] constexpr std::string_view view() const noexcept { return {text, N - 1}; }
+    };
+
+    /// not constexpr, so that a program failing to assemble at compile time stops the compilation with a call to it
+    inline void program_failed_to_assemble(const AssemblyError &) noexcept {}
+
+    /**
+     * Assembles the source at compile time into an image from the lowest to the highest address written,
+     *  the gaps between the sections at different .org addresses being filled with zeros.
+     * A source which does not assemble is a compilation error.
+     *
+     * @tparam origin address of the source up to its first .org
+     */
+    template<AssemblySource source, Word origin = 0>
+    consteval auto assembled() {
+        constexpr auto range = [] {
+            const auto result = Assembler::assemble(source.view(), [](Word, Byte) {}, origin);
+            if (!result.has_value()) program_failed_to_assemble(result.error());
+            return result.value_or(AssembledRange{.start = 0, .end = 0});
+        }();
+
+        std::array<Byte, range.end - range.start> image{};
+        (void)Assembler::assemble(source.view(), [&image](Word address, Byte value) { image[address - range.start] = value; }, origin);
+        return image;
+    }
+
+}
+
+#endif //EMULATOR_MOS6502_ASSEMBLER_HPP
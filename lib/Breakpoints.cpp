@@ -0,0 +1,50 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <utility>
+
+#include "Breakpoints.hpp"
+
+
+std::string Emulator::to_string(Emulator::Access access) {
+    switch (access) {
+        case Access::READ:       return "read";
+        case Access::WRITE:      return "write";
+        case Access::READ_WRITE: return "read/write";
+    }
+    std::unreachable();
+}
+
+void Emulator::Breakpoints::set_breakpoint(Emulator::Word address, Emulator::Breakpoints::Condition condition) {
+    m_execution[address] = true;
+    if (condition) m_conditions[address] = std::move(condition);
+    else m_conditions.erase(address);
+}
+
+void Emulator::Breakpoints::clear_breakpoint(Emulator::Word address) {
+    m_execution[address] = false;
+    m_conditions.erase(address);
+}
+
+void Emulator::Breakpoints::set_watchpoint(Emulator::Word address, Emulator::Access access) {
+    if ((Byte)access & (Byte)Access::READ) m_read[address] = true;
+    if ((Byte)access & (Byte)Access::WRITE) m_write[address] = true;
+}
+
+void Emulator::Breakpoints::clear_watchpoint(Emulator::Word address, Emulator::Access access) {
+    if ((Byte)access & (Byte)Access::READ) m_read[address] = false;
+    if ((Byte)access & (Byte)Access::WRITE) m_write[address] = false;
+}
+
+void Emulator::Breakpoints::clear() noexcept {
+    m_execution.reset();
+    m_read.reset();
+    m_write.reset();
+    m_conditions.clear();
+}
+
+bool Emulator::Breakpoints::condition_holds(Emulator::Word address) const {
+    const auto condition = m_conditions.find(address);
+    return condition == m_conditions.end() || condition->second();
+}
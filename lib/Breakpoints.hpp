@@ -0,0 +1,66 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_BREAKPOINTS_HPP
+#define EMULATOR_MOS6502_BREAKPOINTS_HPP
+
+#include <bitset>
+#include <string>
+#include <functional>
+#include <unordered_map>
+
+#include "MOS6502_definitions.hpp"
+
+namespace Emulator {
+
+    enum class Access: Byte { READ = 1, WRITE = 2, READ_WRITE = READ | WRITE };
+
+    std::string to_string(Access access);
+
+
+    /**
+     * Execution breakpoints and memory watchpoints of a CPU.
+     * Each kind is a bitmap over the whole address space, so checking an address is a single bit test
+     *  and a program without breakpoints runs at full speed.
+     */
+    class Breakpoints {
+    public:
+        /**
+         * Condition of a breakpoint, evaluated right before the command at its address is executed.
+         * It captures whatever it inspects, usually the CPU itself, so that breakpoints work with any CPU instantiation.
+         */
+        using Condition = std::function<bool()>;
+
+        /// execution stops before the command at the given address, if there is no condition or it holds
+        void set_breakpoint(Word address, Condition condition = nullptr);
+        void clear_breakpoint(Word address);
+
+        /// execution stops after the command that read or wrote the given address
+        void set_watchpoint(Word address, Access access = Access::READ_WRITE);
+        void clear_watchpoint(Word address, Access access = Access::READ_WRITE);
+
+        void clear() noexcept;
+
+        [[nodiscard]] bool is_breakpoint(Word address) const noexcept { return m_execution[address]; }
+        [[nodiscard]] bool is_read_watched(Word address) const noexcept { return m_read[address]; }
+        [[nodiscard]] bool is_write_watched(Word address) const noexcept { return m_write[address]; }
+
+        [[nodiscard]] bool any() const noexcept { return m_execution.any() || m_read.any() || m_write.any(); }
+
+        /// true if the breakpoint at the given address is unconditional or its condition holds
+        [[nodiscard]] bool condition_holds(Word address) const;
+
+    private:
+        static constexpr size_t ADDRESS_SPACE_SIZE = UINT16_MAX + 1;
+
+        std::bitset<ADDRESS_SPACE_SIZE> m_execution;
+        std::bitset<ADDRESS_SPACE_SIZE> m_read;
+        std::bitset<ADDRESS_SPACE_SIZE> m_write;
+
+        std::unordered_map<Word, Condition> m_conditions;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_BREAKPOINTS_HPP
@@ -0,0 +1,239 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <algorithm>
+#include <span>
+#include <utility>
+
+#include "ControlFlow.hpp"
+#include "OpcodeTable.hpp"
+#include "Microcode.hpp"
+
+
+Emulator::ControlFlowGraph::ControlFlowGraph(const ROM &image): m_image{image} {
+    for (const Word vector: {ROM::RESET_LOCATION, ROM::INTERRUPT_HANDLER, ROM::BRK_HANDLER})
+        reach(m_image.get_word(vector));
+    analyze();
+}
+
+void Emulator::ControlFlowGraph::add_entry(Word address) {
+    reach(address);
+    analyze();
+}
+
+std::vector<Emulator::Word> Emulator::ControlFlowGraph::commands() const {
+    std::vector<Word> result;
+    for (size_t address = 0; address <= UINT16_MAX; address++)
+        if (m_commands[address]) result.push_back(address);
+    return result;
+}
+
+auto Emulator::ControlFlowGraph::block_of(Word address) const noexcept -> const BasicBlock* {
+    if (!m_commands[address]) return nullptr;
+    auto block = m_blocks.upper_bound(address);
+    if (block == m_blocks.begin()) return nullptr;
+    block--;
+    return address <= block->second.last ? &block->second : nullptr;
+}
+
+std::optional<Emulator::Word> Emulator::ControlFlowGraph::indirect_target(Word jump) const {
+    const auto target = m_resolved.find(jump);
+    if (target == m_resolved.end()) return std::nullopt;
+    return target->second;
+}
+
+void Emulator::ControlFlowGraph::reach(Word address) {
+    m_leaders[address] = true;
+    m_pending.push_back(address);
+}
+
+void Emulator::ControlFlowGraph::explore() {
+    while (!m_pending.empty()) {
+        const Word address = m_pending.back();
+        m_pending.pop_back();
+        if (m_commands[address]) continue;
+        m_commands[address] = true;
+
+        const Byte opCode = std::as_const(m_image)[address];
+        const auto &info = OPCODES[opCode];
+        const Word next = address + info.length;
+        const Word operand = m_image.get_word(address + 1);
+        note_writes(address);
+
+        switch (MICROCODE[opCode].mnemonic) {
+            case Mnemonic::JAM:
+            case Mnemonic::RTS:
+            case Mnemonic::RTI:
+                break;
+            case Mnemonic::BRK:
+                reach(m_image.get_word(ROM::BRK_HANDLER));
+                break;
+            case Mnemonic::JMP:
+                if (info.mode == AddressingMode::ABSOLUTE) reach(operand);
+                else m_indirectJumps.push_back(address);
+                break;
+            case Mnemonic::JSR:
+                m_subroutines.insert(operand);
+                m_returnSites[operand].push_back(next);
+                reach(operand);
+                reach(next);
+                break;
+            default:
+                if (info.mode == AddressingMode::RELATIVE) {
+                    reach(next + (char)WordToBytes(operand).low);
+                    reach(next);
+                    break;
+                }
+                // a command following more than one other command starts a block
+                if (m_fallenInto[next]) m_leaders[next] = true;
+                m_fallenInto[next] = true;
+                m_pending.push_back(next);
+        }
+    }
+}
+
+void Emulator::ControlFlowGraph::note_writes(Word address) {
+    const Byte opCode = std::as_const(m_image)[address];
+    const auto &code = MICROCODE[opCode];
+    const auto cycles = std::span(code.cycles.begin(), code.length);
+    if (std::ranges::find(cycles, MicroOp::OPERATE_WRITE) == cycles.end() && std::ranges::find(cycles, MicroOp::WRITE) == cycles.end())
+        return;
+
+    const Word operand = m_image.get_word(address + 1);
+    switch (OPCODES[opCode].mode) {
+        case AddressingMode::ZERO_PAGE:
+            m_written[WordToBytes(operand).low] = true;
+            break;
+        case AddressingMode::ABSOLUTE:
+            m_written[operand] = true;
+            break;
+        case AddressingMode::ZERO_PAGE_X:
+        case AddressingMode::ZERO_PAGE_Y:
+            for (Word offset = 0; offset <= UINT8_MAX; offset++) m_written[offset] = true;
+            break;
+        case AddressingMode::ABSOLUTE_X:
+        case AddressingMode::ABSOLUTE_Y:
+            for (Word offset = 0; offset <= UINT8_MAX; offset++) m_written[(Word)(operand + offset)] = true;
+            break;
+        default:
+            m_writesAnywhere = true;
+    }
+}
+
+void Emulator::ControlFlowGraph::analyze() {
+    // the pointers are checked once everything else is explored, since the code found later might write them
+    bool reached = true;
+    while (reached) {
+        explore();
+        reached = false;
+        for (; m_checkedJumps < m_indirectJumps.size(); m_checkedJumps++) {
+            const Word jump = m_indirectJumps[m_checkedJumps];
+            const Word pointer = m_image.get_word(jump + 1);
+            // the high byte of the target is read from the same page as the low one
+            const Word high = (pointer & 0xFF00) | (Byte)(pointer + 1);
+            if (may_be_written(pointer) || may_be_written(high)) continue;
+
+            const Word target = std::as_const(m_image)[pointer] | std::as_const(m_image)[high] << 8;
+            m_resolved[jump] = target;
+            reach(target);
+            reached = true;
+        }
+    }
+    std::erase_if(m_resolved, [this](const auto &resolved) {
+        const Word pointer = m_image.get_word(resolved.first + 1);
+        return may_be_written(pointer) || may_be_written((pointer & 0xFF00) | (Byte)(pointer + 1));
+    });
+
+    build_blocks();
+    pair_returns();
+}
+
+void Emulator::ControlFlowGraph::build_blocks() {
+    m_blocks.clear();
+    for (size_t start = 0; start <= UINT16_MAX; start++) {
+        if (!m_leaders[start] || !m_commands[start]) continue;
+
+        BasicBlock block{.start = (Word)start, .last = (Word)start, .successors = {}};
+        while (true) {
+            const Byte opCode = std::as_const(m_image)[block.last];
+            const auto &info = OPCODES[opCode];
+            const Word next = block.last + info.length;
+            const Word operand = m_image.get_word(block.last + 1);
+
+            const auto mnemonic = MICROCODE[opCode].mnemonic;
+            if (mnemonic == Mnemonic::JAM || mnemonic == Mnemonic::RTS || mnemonic == Mnemonic::RTI) break;
+            if (mnemonic == Mnemonic::BRK) {
+                block.successors.push_back({.to = m_image.get_word(ROM::BRK_HANDLER), .kind = EdgeKind::INTERRUPT});
+                break;
+            }
+            if (mnemonic == Mnemonic::JSR) {
+                block.successors.push_back({.to = operand, .kind = EdgeKind::CALL});
+                break;
+            }
+            if (mnemonic == Mnemonic::JMP) {
+                if (info.mode == AddressingMode::ABSOLUTE) block.successors.push_back({.to = operand, .kind = EdgeKind::JUMP});
+                else if (const auto target = indirect_target(block.last)) block.successors.push_back({.to = *target, .kind = EdgeKind::INDIRECT_JUMP});
+                break;
+            }
+            if (info.mode == AddressingMode::RELATIVE) {
+                block.successors.push_back({.to = (Word)(next + (char)WordToBytes(operand).low), .kind = EdgeKind::BRANCH});
+                block.successors.push_back({.to = next, .kind = EdgeKind::FALL_THROUGH});
+                break;
+            }
+            if (m_leaders[next]) {
+                block.successors.push_back({.to = next, .kind = EdgeKind::FALL_THROUGH});
+                break;
+            }
+            block.last = next;
+        }
+        m_blocks.emplace(block.start, std::move(block));
+    }
+}
+
+void Emulator::ControlFlowGraph::pair_returns() {
+    // the subroutine every block belongs to, the subroutines whose blocks every subroutine reaches, and its returns
+    std::map<Word, Word> owners;
+    std::map<Word, std::set<Word>> reachedBy;
+    std::map<Word, std::vector<Word>> returns;
+
+    for (const Word subroutine: m_subroutines) {
+        std::vector<Word> pending{subroutine};
+        while (!pending.empty()) {
+            const Word start = pending.back();
+            pending.pop_back();
+
+            const auto [owner, owned] = owners.try_emplace(start, subroutine);
+            if (!owned) {
+                if (owner->second != subroutine) reachedBy[owner->second].insert(subroutine);
+                continue;
+            }
+
+            const auto &block = m_blocks.at(start);
+            const auto mnemonic = MICROCODE[std::as_const(m_image)[block.last]].mnemonic;
+            if (mnemonic == Mnemonic::RTS) returns[subroutine].push_back(start);
+            // the called subroutine is assumed to return
+            if (mnemonic == Mnemonic::JSR) pending.push_back(block.last + 3);
+
+            for (const auto &edge: block.successors)
+                if (edge.kind != EdgeKind::CALL && edge.kind != EdgeKind::INTERRUPT) pending.push_back(edge.to);
+        }
+    }
+
+    for (const auto &[subroutine, blocks]: returns) {
+        // the returns of a subroutine are shared with every subroutine continuing into it
+        std::set<Word> callees{subroutine};
+        std::vector<Word> pending{subroutine};
+        while (!pending.empty()) {
+            const Word callee = pending.back();
+            pending.pop_back();
+            for (const Word other: reachedBy[callee])
+                if (callees.insert(other).second) pending.push_back(other);
+        }
+
+        std::set<Word> sites;
+        for (const Word callee: callees) sites.insert(m_returnSites[callee].begin(), m_returnSites[callee].end());
+        for (const Word start: blocks)
+            for (const Word site: sites) m_blocks.at(start).successors.push_back({.to = site, .kind = EdgeKind::RETURN});
+    }
+}
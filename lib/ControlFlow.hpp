@@ -0,0 +1,136 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_CONTROLFLOW_HPP
+#define EMULATOR_MOS6502_CONTROLFLOW_HPP
+
+#include <bitset>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "ROM.hpp"
+
+namespace Emulator {
+
+    enum class EdgeKind {
+        /// to the following command, the block ending before a command some other control transfer reaches
+        FALL_THROUGH,
+        /// to the target of a taken branch
+        BRANCH,
+        JUMP,
+        /// JMP (indirect) whose pointer is never written, so that its target is known
+        INDIRECT_JUMP,
+        /// from JSR to the subroutine
+        CALL,
+        /// from RTS to the command following a JSR to the subroutine the RTS belongs to
+        RETURN,
+        /// from BRK to the interrupt handler
+        INTERRUPT
+    };
+
+    struct Edge {
+        Word to;
+        EdgeKind kind;
+    };
+
+    /// commands executed one after another, only the first of them reached by any control transfer
+    struct BasicBlock {
+        Word start;
+        /// address of the last command, which is the only one that may transfer control elsewhere
+        Word last;
+        std::vector<Edge> successors;
+    };
+
+
+    /**
+     * Static analysis of the code of a ROM image: which bytes start commands reachable from the reset, NMI and
+     *  IRQ/BRK vectors, and how the basic blocks of these commands are connected.
+     *
+     * Commands are decoded by the opcode table, as MOS6502 decodes them, and followed through every static control
+     *  transfer. JSR is assumed to return to the following command, which is connected to the RTS of the subroutine
+     *  by a RETURN edge. A subroutine consists of the blocks reachable from its entry without calls; a block shared
+     *  by several subroutines belongs to the one reaching it first, and returns to the callers of all of them.
+     *
+     * The target of JMP (indirect) is known if no reachable command may write its pointer: stores with an indirect
+     *  address may write anywhere, the indexed ones anywhere within the reach of the index, and the stack page is
+     *  written by interrupts. A target found before a write to the pointer was discovered stays reachable, but loses
+     *  its edge. RTI, RTS outside of subroutines and the vectors of the interrupts are not followed.
+     *
+     * Every byte is decoded at most once, so that the analysis takes time linear in the size of the image.
+     */
+    class ControlFlowGraph {
+    public:
+        /// analyzes the code reachable from the vectors of the image
+        explicit ControlFlowGraph(const ROM &image);
+
+        /// also analyzes the code reachable from the given address, for entries not referenced by the vectors
+        void add_entry(Word address);
+
+        /// whether a reachable command starts at the address
+        [[nodiscard]] bool is_command(Word address) const noexcept { return m_commands[address]; }
+
+        /// addresses of the reachable commands in ascending order
+        [[nodiscard]] std::vector<Word> commands() const;
+
+        /// blocks by the address of their first command
+        [[nodiscard]] const std::map<Word, BasicBlock>& blocks() const noexcept { return m_blocks; }
+
+        /// the block containing the command at the given address, if it is reachable
+        [[nodiscard]] const BasicBlock* block_of(Word address) const noexcept;
+
+        /// entries of the subroutines called by JSR
+        [[nodiscard]] const std::set<Word>& subroutines() const noexcept { return m_subroutines; }
+
+        /// target of the JMP (indirect) at the given address, if its pointer is never written
+        [[nodiscard]] std::optional<Word> indirect_target(Word jump) const;
+
+    private:
+        /// the address starts a block and is to be explored
+        void reach(Word address);
+
+        /// decodes the commands reachable from the pending addresses
+        void explore();
+
+        /// notes the bytes the command at the given address may write
+        void note_writes(Word address);
+
+        [[nodiscard]] bool may_be_written(Word address) const noexcept {
+            return m_writesAnywhere || m_written[address] || ROM::is_in_stack(address);
+        }
+
+        /// resolves the indirect jumps, explores their targets and connects everything into blocks
+        void analyze();
+
+        void build_blocks();
+        void pair_returns();
+
+        ROM m_image;
+
+        std::vector<Word> m_pending;
+        std::bitset<UINT16_MAX + 1> m_commands;
+        /// commands starting blocks
+        std::bitset<UINT16_MAX + 1> m_leaders;
+
+        std::bitset<UINT16_MAX + 1> m_written;
+        bool m_writesAnywhere = false;
+
+        /// commands following a JSR by the subroutine called
+        std::map<Word, std::vector<Word>> m_returnSites;
+        std::set<Word> m_subroutines;
+        /// commands reached by falling through, to find the ones reached so by more than one command
+        std::bitset<UINT16_MAX + 1> m_fallenInto;
+
+        std::vector<Word> m_indirectJumps;
+        /// indirect jumps checked for being resolvable, all of them discovered earlier than the rest
+        size_t m_checkedJumps = 0;
+        std::map<Word, Word> m_resolved;
+
+        std::map<Word, BasicBlock> m_blocks;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_CONTROLFLOW_HPP
@@ -0,0 +1,24 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <algorithm>
+#include <utility>
+
+#include "Corpus.hpp"
+
+using namespace Emulator;
+
+
+ROM CorpusProgram::memory() const {
+    ROM result{};
+    result.load(CORPUS_ORIGIN, image);
+    result.load(ROM::RESET_LOCATION, std::array<Byte, 2>{CORPUS_ORIGIN & 0xFF, CORPUS_ORIGIN >> 8});
+    return result;
+}
+
+bool CorpusProgram::succeeded(const ROM &memory) const noexcept {
+    for (size_t i = 0; i < expected.size(); i++)
+        if (memory[(Word)(resultAddress + i)] != expected[i]) return false;
+    return true;
+}
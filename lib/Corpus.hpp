@@ -0,0 +1,784 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_CORPUS_HPP
+#define EMULATOR_MOS6502_CORPUS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "Assembler.hpp"
+#include "ROM.hpp"
+
+namespace Emulator {
+
+    /*
+     * Standard workloads with realistic instruction mixes, assembled at compile time. Every program starts at
+     *  CORPUS_ORIGIN, generates its own input, stops on BRK and leaves its output at a fixed place in the memory.
+     * The expected outputs are computed at compile time by the same algorithms written in C++.
+     */
+
+    inline constexpr Word CORPUS_ORIGIN = 0x0200;
+
+    /// the pseudo-random bytes the programs generate their input with: x = 5x + 1 (mod 256)
+    constexpr Byte next_random(Byte x) noexcept { return (Byte)(5 * x + 1); }
+
+
+    /// counts the primes below 8192
+    inline constexpr AssemblySource SIEVE_SOURCE{R"(
+N = 8192
+FLAGS = $1000           ; a byte per number, zero while it may be prime
+ptr = $10
+count = $12
+number = $14
+RESULT = $F0
+        LDA #<FLAGS
+        STA ptr
+        LDA #>FLAGS
+        STA ptr+1
+        LDX #>N
+        LDY #0
+        TYA
+clear:  STA (ptr),Y
+        INY
+        BNE clear
+        INC ptr+1
+        DEX
+        BNE clear
+
+        STA count
+        STA count+1
+        STA number+1
+        LDA #2
+        STA number
+next:   CLC                     ; ptr = FLAGS + number
+        LDA number
+        ADC #<FLAGS
+        STA ptr
+        LDA number+1
+        ADC #>FLAGS
+        STA ptr+1
+        LDA (ptr),Y
+        BNE composite
+        INC count
+        BNE multiple
+        INC count+1
+multiple:
+        CLC                     ; mark every multiple of the prime
+        LDA ptr
+        ADC number
+        STA ptr
+        LDA ptr+1
+        ADC number+1
+        STA ptr+1
+        CMP #>(FLAGS + N)
+        BCS composite
+        LDA #1
+        STA (ptr),Y
+        BNE multiple
+composite:
+        INC number
+        BNE checked
+        INC number+1
+checked:
+        LDA number+1
+        CMP #>N
+        BCC next
+
+        LDA count
+        STA RESULT
+        LDA count+1
+        STA RESULT+1
+        BRK
+)"};
+
+    inline constexpr auto SIEVE_EXPECTED = [] {
+        std::array<bool, 8192> composite{};
+        unsigned count = 0;
+        for (size_t number = 2; number < composite.size(); number++) {
+            if (composite[number]) continue;
+            count++;
+            for (size_t multiple = 2 * number; multiple < composite.size(); multiple += number) composite[multiple] = true;
+        }
+        return std::array<Byte, 2>{(Byte)count, (Byte)(count >> 8)};
+    }();
+
+
+    /// CRC-32 (the one of zlib) of 1 KiB of pseudo-random bytes, computed a bit at a time
+    inline constexpr AssemblySource CRC32_SOURCE{R"(
+SIZE = 1024
+DATA = $1000
+seed = $10
+ptr = $11
+crc = $13               ; 4 bytes, little-endian
+pages = $17
+RESULT = $F0
+        LDA #99
+        STA seed
+        LDA #<DATA
+        STA ptr
+        LDA #>DATA
+        STA ptr+1
+        LDX #>SIZE
+        LDY #0
+fill:   LDA seed
+        ASL
+        ASL
+        CLC
+        ADC seed
+        CLC
+        ADC #1
+        STA seed
+        STA (ptr),Y
+        INY
+        BNE fill
+        INC ptr+1
+        DEX
+        BNE fill
+
+        LDA #$FF
+        STA crc
+        STA crc+1
+        STA crc+2
+        STA crc+3
+        LDA #>DATA
+        STA ptr+1
+        LDA #>SIZE
+        STA pages
+byte:   LDA (ptr),Y
+        EOR crc
+        STA crc
+        LDX #8
+shift:  LSR crc+3
+        ROR crc+2
+        ROR crc+1
+        ROR crc
+        BCC shifted
+        LDA crc+3               ; the reflected polynomial $EDB88320
+        EOR #$ED
+        STA crc+3
+        LDA crc+2
+        EOR #$B8
+        STA crc+2
+        LDA crc+1
+        EOR #$83
+        STA crc+1
+        LDA crc
+        EOR #$20
+        STA crc
+shifted:
+        DEX
+        BNE shift
+        INY
+        BNE byte
+        INC ptr+1
+        DEC pages
+        BNE byte
+
+        LDX #3
+result: LDA crc,X
+        EOR #$FF
+        STA RESULT,X
+        DEX
+        BPL result
+        BRK
+)"};
+
+    inline constexpr auto CRC32_EXPECTED = [] {
+        uint32_t crc = 0xFFFFFFFF;
+        Byte seed = 99;
+        for (size_t i = 0; i < 1024; i++) {
+            seed = next_random(seed);
+            crc ^= seed;
+            for (int bit = 0; bit < 8; bit++) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+        crc = ~crc;
+        return std::array<Byte, 4>{(Byte)crc, (Byte)(crc >> 8), (Byte)(crc >> 16), (Byte)(crc >> 24)};
+    }();
+
+
+    /// bubble sort of 200 pseudo-random bytes, in place
+    inline constexpr AssemblySource BUBBLE_SORT_SOURCE{R"(
+SIZE = 200
+DATA = $1000
+seed = $10
+swapped = $11
+        LDA #42
+        STA seed
+        LDX #0
+fill:   LDA seed
+        ASL
+        ASL
+        CLC
+        ADC seed
+        CLC
+        ADC #1
+        STA seed
+        STA DATA,X
+        INX
+        CPX #SIZE
+        BNE fill
+
+pass:   LDA #0
+        STA swapped
+        LDX #0
+compare:
+        LDA DATA,X
+        CMP DATA+1,X
+        BCC ordered
+        BEQ ordered
+        TAY
+        LDA DATA+1,X
+        STA DATA,X
+        TYA
+        STA DATA+1,X
+        LDA #1
+        STA swapped
+ordered:
+        INX
+        CPX #SIZE-1
+        BNE compare
+        LDA swapped
+        BNE pass
+        BRK
+)"};
+
+    /// the data of the sorting programs, sorted
+    template<size_t size>
+    constexpr std::array<Byte, size> sorted_random(Byte seed) noexcept {
+        std::array<Byte, size> data{};
+        for (auto &value: data) value = seed = next_random(seed);
+        std::ranges::sort(data);
+        return data;
+    }
+
+    inline constexpr auto BUBBLE_SORT_EXPECTED = sorted_random<200>(42);
+
+
+    /// quicksort of 256 pseudo-random bytes, in place, with the pending ranges on a stack of its own
+    inline constexpr AssemblySource QUICKSORT_SOURCE{R"(
+DATA = $1100
+LOWS = $1200            ; the stack of ranges still to be sorted
+HIGHS = $1300
+seed = $10
+lo = $11
+hi = $12
+i = $13
+pivot = $14
+depth = $15
+tmp = $16
+        LDA #7
+        STA seed
+        LDX #0
+fill:   LDA seed
+        ASL
+        ASL
+        CLC
+        ADC seed
+        CLC
+        ADC #1
+        STA seed
+        STA DATA,X
+        INX
+        BNE fill
+
+        LDA #0
+        STA depth
+        LDX #255
+        JSR push
+pop:    LDY depth
+        BNE popped
+        BRK
+popped: DEY
+        STY depth
+        LDA LOWS,Y
+        STA lo
+        STA i
+        LDX HIGHS,Y
+        STX hi
+        LDA DATA,X              ; Lomuto partition around the last element
+        STA pivot
+        LDY lo
+partition:
+        CPY hi
+        BEQ placed
+        LDA DATA,Y
+        CMP pivot
+        BCS greater
+        STA tmp
+        LDX i
+        LDA DATA,X
+        STA DATA,Y
+        LDA tmp
+        STA DATA,X
+        INC i
+greater:
+        INY
+        BNE partition
+placed: LDX i
+        LDY hi
+        LDA DATA,X
+        STA tmp
+        LDA DATA,Y
+        STA DATA,X
+        LDA tmp
+        STA DATA,Y
+
+        LDA i                   ; the ranges of a single element are sorted already
+        SEC
+        SBC lo
+        CMP #2
+        BCC right
+        LDA lo
+        LDX i
+        DEX
+        JSR push
+right:  LDA hi
+        SEC
+        SBC i
+        CMP #2
+        BCC pop
+        LDX hi
+        LDA i
+        CLC
+        ADC #1
+        JSR push
+        JMP pop
+
+push:   LDY depth               ; pushes the range from A to X
+        STA LOWS,Y
+        TXA
+        STA HIGHS,Y
+        INC depth
+        RTS
+)"};
+
+    inline constexpr auto QUICKSORT_EXPECTED = sorted_random<256>(7);
+
+
+    /// 256 divisions of 16-bit numbers by shifts and subtractions, summing the quotients and combining the remainders
+    inline constexpr AssemblySource DIVISION_SOURCE{R"(
+num = $10               ; the dividend, replaced by the quotient
+den = $12
+rem = $14
+dividend = $16
+divisor = $18
+sum = $1A
+remainders = $1C
+count = $1E
+RESULT = $F0
+        LDA #0
+        STA sum
+        STA sum+1
+        STA remainders
+        STA remainders+1
+        STA count
+        STA divisor+1
+        LDA #<60000
+        STA dividend
+        LDA #>60000
+        STA dividend+1
+        LDA #7
+        STA divisor
+
+loop:   LDA dividend
+        STA num
+        LDA dividend+1
+        STA num+1
+        LDA divisor
+        STA den
+        LDA divisor+1
+        STA den+1
+        JSR divide
+        CLC
+        LDA sum
+        ADC num
+        STA sum
+        LDA sum+1
+        ADC num+1
+        STA sum+1
+        LDA remainders
+        EOR rem
+        STA remainders
+        LDA remainders+1
+        EOR rem+1
+        STA remainders+1
+        SEC                     ; the next dividend is 200 less
+        LDA dividend
+        SBC #200
+        STA dividend
+        LDA dividend+1
+        SBC #0
+        STA dividend+1
+        CLC                     ; the next divisor is 3 more
+        LDA divisor
+        ADC #3
+        STA divisor
+        LDA divisor+1
+        ADC #0
+        STA divisor+1
+        DEC count
+        BNE loop
+
+        LDX #3
+result: LDA sum,X
+        STA RESULT,X
+        DEX
+        BPL result
+        BRK
+
+divide: LDA #0
+        STA rem
+        STA rem+1
+        LDX #16
+shift:  ASL num
+        ROL num+1
+        ROL rem
+        ROL rem+1
+        LDA rem
+        SEC
+        SBC den
+        TAY
+        LDA rem+1
+        SBC den+1
+        BCC smaller
+        STA rem+1
+        STY rem
+        INC num
+smaller:
+        DEX
+        BNE shift
+        RTS
+)"};
+
+    inline constexpr auto DIVISION_EXPECTED = [] {
+        uint16_t sum = 0, remainders = 0;
+        for (unsigned k = 0; k < 256; k++) {
+            const unsigned dividend = 60000 - 200 * k, divisor = 7 + 3 * k;
+            sum += dividend / divisor;
+            remainders ^= dividend % divisor;
+        }
+        return std::array<Byte, 4>{(Byte)sum, (Byte)(sum >> 8), (Byte)remainders, (Byte)(remainders >> 8)};
+    }();
+
+
+    /// fills 16 KiB, copies them a byte at a time and sums the copy
+    inline constexpr AssemblySource MEMCPY_SOURCE{R"(
+SOURCE = $4000
+TARGET = $8000
+PAGES = 64
+src = $10
+dst = $12
+sum = $14
+RESULT = $F0
+        LDA #0
+        STA src
+        STA dst
+        STA sum
+        STA sum+1
+        LDA #>SOURCE
+        STA src+1
+        LDX #PAGES
+        LDY #0
+fill:   TYA                     ; the low byte of the address exclusive-or the high one
+        EOR src+1
+        STA (src),Y
+        INY
+        BNE fill
+        INC src+1
+        DEX
+        BNE fill
+
+        LDA #>SOURCE
+        STA src+1
+        LDA #>TARGET
+        STA dst+1
+        LDX #PAGES
+copy:   LDA (src),Y
+        STA (dst),Y
+        INY
+        BNE copy
+        INC src+1
+        INC dst+1
+        DEX
+        BNE copy
+
+        LDA #>TARGET
+        STA dst+1
+        LDX #PAGES
+add:    CLC
+        LDA (dst),Y
+        ADC sum
+        STA sum
+        BCC added
+        INC sum+1
+added:  INY
+        BNE add
+        INC dst+1
+        DEX
+        BNE add
+
+        LDA sum
+        STA RESULT
+        LDA sum+1
+        STA RESULT+1
+        BRK
+)"};
+
+    inline constexpr auto MEMCPY_EXPECTED = [] {
+        uint16_t sum = 0;
+        for (unsigned address = 0x4000; address < 0x8000; address++) sum += (address & 0xFF) ^ (address >> 8);
+        return std::array<Byte, 2>{(Byte)sum, (Byte)(sum >> 8)};
+    }();
+
+
+    /**
+     * Adds 7 to a six-digit decimal counter 12345 times, a digit per byte with the carries propagated in software,
+     *  then packs the digits into BCD. The emulated ADC ignores the decimal flag, so SED cannot do it.
+     */
+    inline constexpr AssemblySource BCD_COUNTER_SOURCE{R"(
+STEPS = 12345
+digits = $10            ; 6 bytes, the least significant first
+steps = $16
+RESULT = $F0            ; 3 bytes of BCD, little-endian
+        LDA #0
+        LDX #5
+clear:  STA digits,X
+        DEX
+        BPL clear
+        LDA #<STEPS
+        STA steps
+        LDA #>STEPS
+        STA steps+1
+
+count:  LDX #0
+        LDA #7
+digit:  CLC
+        ADC digits,X
+        CMP #10
+        BCC stored
+        SBC #10                 ; the carry is set by the comparison
+        STA digits,X
+        LDA #1
+        INX
+        BNE digit
+stored: STA digits,X
+        LDA steps
+        BNE borrowed
+        DEC steps+1
+borrowed:
+        DEC steps
+        LDA steps
+        ORA steps+1
+        BNE count
+
+        LDX #0
+        LDY #0
+pack:   LDA digits+1,X
+        ASL
+        ASL
+        ASL
+        ASL
+        ORA digits,X
+        STA RESULT,Y
+        INX
+        INX
+        INY
+        CPY #3
+        BNE pack
+        BRK
+)"};
+
+    inline constexpr auto BCD_COUNTER_EXPECTED = [] {
+        std::array<Byte, 3> bcd{};
+        unsigned value = 7 * 12345;
+        for (auto &digits: bcd) {
+            digits = (Byte)(value % 10 | (value / 10 % 10) << 4);
+            value /= 100;
+        }
+        return bcd;
+    }();
+
+
+    /**
+     * Bytecode interpreter dispatching through a table of handlers, running a program which computes the 30000th
+     *  Fibonacci number modulo 65536 in 16-bit variables.
+     */
+    inline constexpr AssemblySource INTERPRETER_SOURCE{R"(
+OP_HALT = 0
+OP_LOADI = 1            ; acc = word
+OP_LOAD = 2             ; acc = variable
+OP_STORE = 3            ; variable = acc
+OP_ADD = 4              ; acc += variable
+OP_DECJNZ = 5           ; if --variable != 0 jump to word
+ip = $10
+acc = $12
+handler = $14
+VARS = $20              ; 16-bit variables
+        LDA #<code
+        STA ip
+        LDA #>code
+        STA ip+1
+fetch:  LDY #0
+        LDA (ip),Y
+        ASL
+        TAX
+        LDA handlers,X
+        STA handler
+        LDA handlers+1,X
+        STA handler+1
+        JMP (handler)
+
+advance:                        ; by the length of the instruction in A
+        CLC
+        ADC ip
+        STA ip
+        BCC fetch
+        INC ip+1
+        JMP fetch
+
+op_halt:
+        BRK
+op_loadi:
+        INY
+        LDA (ip),Y
+        STA acc
+        INY
+        LDA (ip),Y
+        STA acc+1
+        LDA #3
+        JMP advance
+op_load:
+        INY
+        LDA (ip),Y
+        ASL
+        TAX
+        LDA VARS,X
+        STA acc
+        LDA VARS+1,X
+        STA acc+1
+        LDA #2
+        JMP advance
+op_store:
+        INY
+        LDA (ip),Y
+        ASL
+        TAX
+        LDA acc
+        STA VARS,X
+        LDA acc+1
+        STA VARS+1,X
+        LDA #2
+        JMP advance
+op_add:
+        INY
+        LDA (ip),Y
+        ASL
+        TAX
+        CLC
+        LDA acc
+        ADC VARS,X
+        STA acc
+        LDA acc+1
+        ADC VARS+1,X
+        STA acc+1
+        LDA #2
+        JMP advance
+op_decjnz:
+        INY
+        LDA (ip),Y
+        ASL
+        TAX
+        LDA VARS,X
+        BNE borrowed
+        DEC VARS+1,X
+borrowed:
+        DEC VARS,X
+        LDA VARS,X
+        ORA VARS+1,X
+        BEQ fallthrough
+        INY
+        LDA (ip),Y
+        TAX
+        INY
+        LDA (ip),Y
+        STA ip+1
+        STX ip
+        JMP fetch
+fallthrough:
+        LDA #4
+        JMP advance
+
+handlers:
+        .word op_halt, op_loadi, op_load, op_store, op_add, op_decjnz
+
+code:   .byte OP_LOADI
+        .word 0
+        .byte OP_STORE, 0               ; a = 0
+        .byte OP_LOADI
+        .word 1
+        .byte OP_STORE, 1               ; b = 1
+        .byte OP_LOADI
+        .word 30000
+        .byte OP_STORE, 2               ; n = 30000
+loop:   .byte OP_LOAD, 0, OP_ADD, 1, OP_STORE, 3
+        .byte OP_LOAD, 1, OP_STORE, 0
+        .byte OP_LOAD, 3, OP_STORE, 1   ; a, b = b, a + b
+        .byte OP_DECJNZ, 2
+        .word loop
+        .byte OP_HALT
+)"};
+
+    inline constexpr auto INTERPRETER_EXPECTED = [] {
+        uint16_t a = 0, b = 1;
+        for (unsigned n = 0; n < 30000; n++) {
+            const uint16_t sum = a + b;
+            a = b;
+            b = sum;
+        }
+        return std::array<Byte, 2>{(Byte)a, (Byte)(a >> 8)};
+    }();
+
+
+    struct CorpusProgram {
+        std::string_view name;
+        /// assembled at CORPUS_ORIGIN
+        std::span<const Byte> image;
+        /// where the program leaves its output
+        Word resultAddress;
+        std::span<const Byte> expected;
+
+        /// the memory with the program and the reset vector pointing to it
+        [[nodiscard]] ROM memory() const;
+
+        /// whether the memory left by the program holds the expected output
+        [[nodiscard]] bool succeeded(const ROM &memory) const noexcept;
+    };
+
+    inline constexpr auto SIEVE_IMAGE = assembled<SIEVE_SOURCE, CORPUS_ORIGIN>();
+    inline constexpr auto CRC32_IMAGE = assembled<CRC32_SOURCE, CORPUS_ORIGIN>();
+    inline constexpr auto BUBBLE_SORT_IMAGE = assembled<BUBBLE_SORT_SOURCE, CORPUS_ORIGIN>();
+    inline constexpr auto QUICKSORT_IMAGE = assembled<QUICKSORT_SOURCE, CORPUS_ORIGIN>();
+    inline constexpr auto DIVISION_IMAGE = assembled<DIVISION_SOURCE, CORPUS_ORIGIN>();
+    inline constexpr auto MEMCPY_IMAGE = assembled<MEMCPY_SOURCE, CORPUS_ORIGIN>();
+    inline constexpr auto BCD_COUNTER_IMAGE = assembled<BCD_COUNTER_SOURCE, CORPUS_ORIGIN>();
+    inline constexpr auto INTERPRETER_IMAGE = assembled<INTERPRETER_SOURCE, CORPUS_ORIGIN>();
+
+    inline constexpr std::array<CorpusProgram, 8> CORPUS{{
+        {"sieve",       SIEVE_IMAGE,       0x00F0, SIEVE_EXPECTED},
+        {"crc32",       CRC32_IMAGE,       0x00F0, CRC32_EXPECTED},
+        {"bubble sort", BUBBLE_SORT_IMAGE, 0x1000, BUBBLE_SORT_EXPECTED},
+        {"quicksort",   QUICKSORT_IMAGE,   0x1100, QUICKSORT_EXPECTED},
+        {"division",    DIVISION_IMAGE,    0x00F0, DIVISION_EXPECTED},
+        {"memcpy",      MEMCPY_IMAGE,      0x00F0, MEMCPY_EXPECTED},
+        {"bcd counter", BCD_COUNTER_IMAGE, 0x00F0, BCD_COUNTER_EXPECTED},
+        {"interpreter", INTERPRETER_IMAGE, 0x0020, INTERPRETER_EXPECTED},
+    }};
+
+}
+
+#endif //EMULATOR_MOS6502_CORPUS_HPP
@@ -0,0 +1,320 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "CycleStepper.hpp"
+
+namespace Emulator {
+
+    void CycleStepper::step() noexcept {
+        // every micro-operation and every mnemonic gets a handler of its own, selected by the tables below
+        static constexpr auto microOps = []<size_t ... index>(std::index_sequence<index...>) {
+            return std::array<Handler, MICRO_OPS_COUNT>{&CycleStepper::micro<(MicroOp)index>...};
+        }(std::make_index_sequence<MICRO_OPS_COUNT>{});
+
+        if (m_jammed) [[unlikely]] return;
+
+        // the interrupt lines are polled as the cycle begins, so the last cycle of a command decides what follows it
+        m_cycle = m_cpu.cycle;
+        m_nmiPolled = m_nmiEdge;
+        m_interruptPolled = m_nmiEdge || (m_irqLine && !m_cpu.SR[Flag::INTERRUPT_DISABLE]);
+
+        if (m_step == 0) begin_command();
+        else (this->*microOps[(size_t)m_program->cycles[m_step - 1]])();
+
+        // the arithmetic of the CPU may count cycles on its own, while here every step is exactly one cycle
+        m_cpu.cycle = m_cycle + 1;
+
+        if (++m_step > m_program->length) end_command();
+    }
+
+    void CycleStepper::reset() noexcept {
+        m_program = &MICROCODE[0];
+        m_step = 0;
+        m_irqLine = m_nmiEdge = false;
+        m_interruptPending = m_inInterrupt = false;
+        m_jammed = false;
+    }
+
+    void CycleStepper::operate() noexcept {
+        static constexpr auto mnemonics = []<size_t ... index>(std::index_sequence<index...>) {
+            return std::array<Handler, MNEMONICS.size()>{&CycleStepper::apply<(Mnemonic)index>...};
+        }(std::make_index_sequence<MNEMONICS.size()>{});
+
+        (this->*mnemonics[(size_t)m_program->mnemonic])();
+    }
+
+    void CycleStepper::begin_command() noexcept {
+        m_inInterrupt = std::exchange(m_interruptPending, false);
+        if (m_inInterrupt) {
+            // the opcode is still read, but neither executed nor skipped
+            (void)read(m_cpu.PC);
+            m_program = &INTERRUPT_MICROCODE;
+            return;
+        }
+
+        const Byte opCode = read(m_cpu.PC++);
+        m_program = &MICROCODE[opCode];
+        m_vector = ROM::BRK_HANDLER;
+        if (m_program->mnemonic == Mnemonic::BRK) m_cpu.metrics.breaks.add();
+    }
+
+    void CycleStepper::end_command() noexcept {
+        m_step = 0;
+        if (!m_inInterrupt) m_cpu.metrics.instructionsRetired.add();
+        m_cpu.metrics.cycles.set(m_cpu.cycle);
+
+        m_interruptPending = m_interruptPolled;
+        if (m_interruptPending) {
+            m_vector = m_nmiPolled ? ROM::INTERRUPT_HANDLER : ROM::BRK_HANDLER;
+            if (m_nmiPolled) m_nmiEdge = false;
+        }
+    }
+
+    Byte CycleStepper::read(Word address) noexcept {
+        const Byte value = std::as_const(m_cpu.memory)[address];
+        if (m_busCallback) m_busCallback({.cycle = m_cycle, .address = address, .value = value, .access = Access::READ});
+        return value;
+    }
+
+    void CycleStepper::write(Word address, Byte value) noexcept {
+        m_cpu.memory.set_byte(address, value);
+        if (m_busCallback) m_busCallback({.cycle = m_cycle, .address = address, .value = value, .access = Access::WRITE});
+    }
+
+    void CycleStepper::push(Byte value) noexcept {
+        m_cpu.metrics.stackPushes.add();
+        m_cpu.memory.set_stack_byte(m_cpu.SP, value);
+        if (m_busCallback) m_busCallback({.cycle = m_cycle, .address = (Word)(ROM::STACK_BOTTOM + m_cpu.SP), .value = value, .access = Access::WRITE});
+        m_cpu.SP--;
+    }
+
+    Byte CycleStepper::pull() noexcept {
+        m_cpu.metrics.stackPulls.add();
+        return read(ROM::STACK_BOTTOM + ++m_cpu.SP);
+    }
+
+    void CycleStepper::index(Byte low, Byte high, Byte index) noexcept {
+        m_high = high;
+        m_crossed = index > UINT8_MAX - low;
+        if (m_crossed) m_cpu.metrics.pageCrossings.add();
+        m_address = (Word)(high << 8 | (Byte)(low + index));
+    }
+
+    void CycleStepper::store_and_high_byte(Byte value) noexcept {
+        m_data = value & (m_high + 1);
+        if (m_crossed) m_address = (Word)(m_data << 8 | (m_address & 0xFF));
+    }
+
+    template<MicroOp op>
+    void CycleStepper::micro() noexcept {
+        auto &cpu = m_cpu;
+        using enum MicroOp;
+
+        if constexpr (op == READ_PC_OPERATE) {
+            (void)read(cpu.PC);
+            operate();
+        }
+        else if constexpr (op == READ_PC_MODIFY_ACCUMULATOR) {
+            (void)read(cpu.PC);
+            m_data = cpu.AC;
+            operate();
+            cpu.set_register(Register::AC, m_data);
+        }
+        else if constexpr (op == FETCH_IMMEDIATE_OPERATE) {
+            m_data = read(cpu.PC++);
+            operate();
+        }
+
+        else if constexpr (op == FETCH_ADDRESS_LOW)        m_address = read(cpu.PC++);
+        else if constexpr (op == FETCH_ADDRESS_HIGH)       m_address |= read(cpu.PC++) << 8;
+        else if constexpr (op == FETCH_ADDRESS_HIGH_ADD_X) index((Byte)m_address, read(cpu.PC++), cpu.X);
+        else if constexpr (op == FETCH_ADDRESS_HIGH_ADD_Y) index((Byte)m_address, read(cpu.PC++), cpu.Y);
+        else if constexpr (op == READ_ADD_X) {
+            (void)read(m_address);
+            m_address = (Byte)(m_address + cpu.X);
+        }
+        else if constexpr (op == READ_ADD_Y) {
+            (void)read(m_address);
+            m_address = (Byte)(m_address + cpu.Y);
+        }
+        else if constexpr (op == FETCH_POINTER_LOW) m_low = read(m_address);
+        // the pointer never crosses the page: it wraps within the zero page, and within its page for JMP
+        else if constexpr (op == FETCH_POINTER_HIGH) m_address = (Word)(read((m_address & 0xFF00) | (Byte)(m_address + 1)) << 8 | m_low);
+        else if constexpr (op == FETCH_POINTER_HIGH_ADD_Y) index(m_low, read((Byte)(m_address + 1)), cpu.Y);
+
+        else if constexpr (op == READ_OPERATE) {
+            m_data = read(m_address);
+            operate();
+        }
+        else if constexpr (op == READ_OPERATE_SAME_PAGE) {
+            m_data = read(m_address);
+            if (m_crossed) m_address += 0x100;
+            else {
+                operate();
+                finish();
+            }
+        }
+        else if constexpr (op == READ_FIX_ADDRESS) {
+            (void)read(m_address);
+            if (m_crossed) m_address += 0x100;
+        }
+        else if constexpr (op == READ) m_data = read(m_address);
+        else if constexpr (op == OPERATE_WRITE) {
+            operate();
+            write(m_address, m_data);
+        }
+        else if constexpr (op == WRITE_OPERATE) {
+            write(m_address, m_data);
+            operate();
+        }
+        else if constexpr (op == WRITE) write(m_address, m_data);
+
+        else if constexpr (op == FETCH_OFFSET) {
+            m_data = read(cpu.PC++);
+            operate();
+            if (!m_branchTaken) finish();
+        }
+        else if constexpr (op == BRANCH) {
+            // the next opcode is read while the offset is added to the low byte of PC
+            (void)read(cpu.PC);
+            m_address = cpu.PC + (char)m_data;
+            cpu.PC = (cpu.PC & 0xFF00) | (m_address & 0xFF);
+            if (cpu.PC == m_address) finish();
+        }
+        else if constexpr (op == BRANCH_FIX) {
+            (void)read(cpu.PC);
+            cpu.PC = m_address;
+        }
+
+        else if constexpr (op == JUMP)              cpu.PC = (Word)(read(cpu.PC) << 8 | m_address);
+        else if constexpr (op == JUMP_POINTER_HIGH) cpu.PC = (Word)(read((m_address & 0xFF00) | (Byte)(m_address + 1)) << 8 | m_low);
+        else if constexpr (op == READ_PC)           (void)read(cpu.PC);
+        else if constexpr (op == READ_PC_INCREMENT) (void)read(cpu.PC++);
+        else if constexpr (op == READ_STACK)        (void)read(ROM::STACK_BOTTOM + cpu.SP);
+        else if constexpr (op == PUSH_PCH)          push(WordToBytes(cpu.PC).high);
+        else if constexpr (op == PUSH_PCL)          push(WordToBytes(cpu.PC).low);
+        else if constexpr (op == PUSH_STATUS) {
+            // the pushed status tells BRK apart from the interrupts
+            push(cpu.SR.pushed(!m_inInterrupt));
+        }
+        else if constexpr (op == OPERATE_PUSH) {
+            operate();
+            push(m_data);
+        }
+        else if constexpr (op == PULL_OPERATE) {
+            m_data = pull();
+            operate();
+        }
+        else if constexpr (op == PULL_STATUS) cpu.SR = pull();
+        else if constexpr (op == PULL_PCL)    m_low = pull();
+        else if constexpr (op == PULL_PCH)    cpu.PC = (Word)(pull() << 8 | m_low);
+        else if constexpr (op == VECTOR_LOW) {
+            m_low = read(m_vector);
+            cpu.SR[Flag::INTERRUPT_DISABLE] = SET;
+        }
+        else if constexpr (op == VECTOR_HIGH) cpu.PC = (Word)(read(m_vector + 1) << 8 | m_low);
+        else {
+            static_assert(op == JAM, "unsupported micro-operation");
+            // the processor stays on this command until it is reset
+            (void)read(cpu.PC);
+            cpu.PC--;
+            m_jammed = true;
+        }
+    }
+
+    template<Mnemonic mnemonic>
+    void CycleStepper::apply() noexcept {
+        auto &cpu = m_cpu;
+        using enum Mnemonic;
+
+        // reading
+        if constexpr (mnemonic == ADC)                         cpu.add_to_accumulator(m_data);
+        else if constexpr (mnemonic == AND)                    cpu.and_with_accumulator(m_data);
+        else if constexpr (mnemonic == BIT)                    cpu.bit_test(m_data);
+        else if constexpr (mnemonic == CMP)                    cpu.compare(cpu.AC, m_data);
+        else if constexpr (mnemonic == CPX)                    cpu.compare(cpu.X, m_data);
+        else if constexpr (mnemonic == CPY)                    cpu.compare(cpu.Y, m_data);
+        else if constexpr (mnemonic == EOR)                    cpu.xor_with_accumulator(m_data);
+        else if constexpr (mnemonic == LDA || mnemonic == PLA) cpu.set_register(Register::AC, m_data);
+        else if constexpr (mnemonic == LDX)                    cpu.set_register(Register::X, m_data);
+        else if constexpr (mnemonic == LDY)                    cpu.set_register(Register::Y, m_data);
+        else if constexpr (mnemonic == PLP)                    cpu.set_register(Register::SR, m_data);
+        else if constexpr (mnemonic == ORA)                    cpu.or_with_accumulator(m_data);
+        else if constexpr (mnemonic == SBC || mnemonic == USBC) cpu.subtract_from_accumulator(m_data);
+        else if constexpr (mnemonic == LAX)                    cpu.load_accumulator_and_x(m_data);
+        else if constexpr (mnemonic == LAS) {
+            cpu.SP &= m_data;
+            cpu.load_accumulator_and_x(cpu.SP);
+        }
+        // the immediate commands without a helper of their own are executed by the CPU
+        else if constexpr (mnemonic == ANC) cpu.execute(ANC_Immediate<ANC_IMMEDIATE_0B>{.value = m_data});
+        else if constexpr (mnemonic == ALR) cpu.execute(ALR_Immediate{.value = m_data});
+        else if constexpr (mnemonic == ARR) cpu.execute(ARR_Immediate{.value = m_data});
+        else if constexpr (mnemonic == ANE) cpu.execute(ANE_Immediate{.value = m_data});
+        else if constexpr (mnemonic == LXA) cpu.execute(LXA_Immediate{.value = m_data});
+        else if constexpr (mnemonic == SBX) cpu.execute(SBX_Immediate{.value = m_data});
+
+        // writing
+        else if constexpr (mnemonic == STA || mnemonic == PHA) m_data = cpu.AC;
+        else if constexpr (mnemonic == STX)                    m_data = cpu.X;
+        else if constexpr (mnemonic == STY)                    m_data = cpu.Y;
+        else if constexpr (mnemonic == PHP)                    m_data = cpu.SR.pushed();
+        else if constexpr (mnemonic == SAX)                    m_data = cpu.AC & cpu.X;
+        else if constexpr (mnemonic == SHA)                    store_and_high_byte(cpu.AC & cpu.X);
+        else if constexpr (mnemonic == SHX)                    store_and_high_byte(cpu.X);
+        else if constexpr (mnemonic == SHY)                    store_and_high_byte(cpu.Y);
+        else if constexpr (mnemonic == TAS) {
+            cpu.SP = cpu.AC & cpu.X;
+            store_and_high_byte(cpu.SP);
+        }
+
+        // read-modify-write
+        else if constexpr (mnemonic == ASL) m_data = cpu.shift_left(m_data);
+        else if constexpr (mnemonic == LSR) m_data = cpu.shift_right(m_data);
+        else if constexpr (mnemonic == ROL) m_data = cpu.rotate_left(m_data);
+        else if constexpr (mnemonic == ROR) m_data = cpu.rotate_right(m_data);
+        else if constexpr (mnemonic == INC) m_data = cpu.increment(m_data);
+        else if constexpr (mnemonic == DEC) m_data = cpu.decrement(m_data);
+        else if constexpr (mnemonic == SLO) m_data = cpu.shift_left_then_or(m_data);
+        else if constexpr (mnemonic == RLA) m_data = cpu.rotate_left_then_and(m_data);
+        else if constexpr (mnemonic == SRE) m_data = cpu.shift_right_then_xor(m_data);
+        else if constexpr (mnemonic == RRA) m_data = cpu.rotate_right_then_add(m_data);
+        else if constexpr (mnemonic == DCP) m_data = cpu.decrement_then_compare(m_data);
+        else if constexpr (mnemonic == ISC) m_data = cpu.increment_then_subtract(m_data);
+
+        // branches
+        else if constexpr (mnemonic == BCC) m_branchTaken = !cpu.SR[Flag::CARRY];
+        else if constexpr (mnemonic == BCS) m_branchTaken = cpu.SR[Flag::CARRY];
+        else if constexpr (mnemonic == BNE) m_branchTaken = !cpu.SR[Flag::ZERO];
+        else if constexpr (mnemonic == BEQ) m_branchTaken = cpu.SR[Flag::ZERO];
+        else if constexpr (mnemonic == BPL) m_branchTaken = !cpu.SR[Flag::NEGATIVE];
+        else if constexpr (mnemonic == BMI) m_branchTaken = cpu.SR[Flag::NEGATIVE];
+        else if constexpr (mnemonic == BVC) m_branchTaken = !cpu.SR[Flag::OVERFLOW_F];
+        else if constexpr (mnemonic == BVS) m_branchTaken = cpu.SR[Flag::OVERFLOW_F];
+
+        // implied
+        else if constexpr (mnemonic == CLC) cpu.SR[Flag::CARRY] = CLEAR;
+        else if constexpr (mnemonic == CLD) cpu.SR[Flag::DECIMAL] = CLEAR;
+        else if constexpr (mnemonic == CLI) cpu.SR[Flag::INTERRUPT_DISABLE] = CLEAR;
+        else if constexpr (mnemonic == CLV) cpu.SR[Flag::OVERFLOW_F] = CLEAR;
+        else if constexpr (mnemonic == SEC) cpu.SR[Flag::CARRY] = SET;
+        else if constexpr (mnemonic == SED) cpu.SR[Flag::DECIMAL] = SET;
+        else if constexpr (mnemonic == SEI) cpu.SR[Flag::INTERRUPT_DISABLE] = SET;
+        else if constexpr (mnemonic == DEX) cpu.set_register(Register::X, cpu.X - 1);
+        else if constexpr (mnemonic == DEY) cpu.set_register(Register::Y, cpu.Y - 1);
+        else if constexpr (mnemonic == INX) cpu.set_register(Register::X, cpu.X + 1);
+        else if constexpr (mnemonic == INY) cpu.set_register(Register::Y, cpu.Y + 1);
+        else if constexpr (mnemonic == TAX) cpu.set_register(Register::X, cpu.AC);
+        else if constexpr (mnemonic == TAY) cpu.set_register(Register::Y, cpu.AC);
+        else if constexpr (mnemonic == TSX) cpu.set_register(Register::X, cpu.SP);
+        else if constexpr (mnemonic == TXA) cpu.set_register(Register::AC, cpu.X);
+        else if constexpr (mnemonic == TXS) cpu.set_register(Register::SP, cpu.X);
+        else if constexpr (mnemonic == TYA) cpu.set_register(Register::AC, cpu.Y);
+
+        // NOP reads its operand, if any, without using it; the rest is done by their microcode entirely
+        else static_assert(mnemonic == NOP || mnemonic == BRK || mnemonic == JAM || mnemonic == JMP || mnemonic == JSR
+                           || mnemonic == RTI || mnemonic == RTS, "unsupported mnemonic");
+    }
+
+}
@@ -0,0 +1,133 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_CYCLESTEPPER_HPP
+#define EMULATOR_MOS6502_CYCLESTEPPER_HPP
+
+#include <functional>
+
+#include "MOS6502.hpp"
+#include "Microcode.hpp"
+
+namespace Emulator {
+
+    /**
+     * Alternative engine of a MOS6502 advancing a single bus cycle at a time, for targets depending on the cycle
+     *  at which every read and write happens: dummy reads of indexed addressing, double writes of read-modify-write
+     *  commands and interrupts polled before the last cycle of a command.
+     *
+     * Every command runs through its microcode from MICROCODE. Each micro-operation and each mnemonic is a template
+     *  specialization of a handler, called through tables generated at compile time, so stepping costs two indirect
+     *  calls at most and no virtual ones.
+     *
+     * The engine works on the registers and the memory of the given CPU and reuses its arithmetic, so both engines share
+     *  the semantics of the commands. BRK and the interrupts push the status register and set the interrupt disable
+     *  flag, as the hardware does. Breakpoints and watchpoints are not checked;
+     *  the bus callback sees every access instead.
+     */
+    class CycleStepper {
+    public:
+        /// a single cycle of the bus; the cycle is the value of the cycle counter of the CPU when the access happens
+        struct BusAccess {
+            size_t cycle;
+            Word address;
+            Byte value;
+            Access access;
+
+            bool operator ==(const BusAccess &other) const noexcept = default;
+        };
+
+        using BusCallback = std::function<void(const BusAccess &)>;
+
+        explicit CycleStepper(MOS6502 &cpu) noexcept: m_cpu{cpu} {}
+
+        /// called on every cycle, after the access was made; an empty callback costs a single check per cycle
+        void set_bus_callback(BusCallback callback) { m_busCallback = std::move(callback); }
+
+        /// advances the processor by a single bus cycle; a jammed processor does not advance
+        void step() noexcept;
+
+        void run(size_t cycles) noexcept { for (size_t i = 0; i < cycles && !m_jammed; i++) step(); }
+
+        /// runs the command or the interrupt in progress to its end, or the next one entirely when none is in progress
+        void step_command() noexcept { do step(); while (m_step != 0 && !m_jammed); }
+
+        [[nodiscard]] bool at_command_boundary() const noexcept { return m_step == 0; }
+
+        /// set by JAM until the next reset()
+        [[nodiscard]] bool jammed() const noexcept { return m_jammed; }
+
+        /// level of the IRQ line; it is served after the current command while the interrupt disable flag is clear
+        void set_irq(bool asserted) noexcept { m_irqLine = asserted; }
+
+        /// edge on the NMI line; it is served after the current command regardless of the interrupt disable flag
+        void trigger_nmi() noexcept { m_nmiEdge = true; }
+
+        /// forgets the command in progress and the pending interrupts, for example after the state of the CPU was changed
+        void reset() noexcept;
+
+    private:
+        using Handler = void (CycleStepper::*)() noexcept;
+
+        template<MicroOp op>
+        void micro() noexcept;
+
+        /// applies the mnemonic to the data latch, or produces the value to be written into it
+        template<Mnemonic mnemonic>
+        void apply() noexcept;
+
+        void operate() noexcept;
+
+        void begin_command() noexcept;
+        void end_command() noexcept;
+        /// the command ends with the current cycle, skipping the rest of its microcode
+        void finish() noexcept { m_step = m_program->length; }
+
+        [[nodiscard]] Byte read(Word address) noexcept;
+        void write(Word address, Byte value) noexcept;
+        void push(Byte value) noexcept;
+        [[nodiscard]] Byte pull() noexcept;
+
+        /// adds the index to the low byte of the base, leaving the high byte to be fixed by a later cycle
+        void index(Byte low, Byte high, Byte index) noexcept;
+
+        /**
+         * Stores the value ANDed with the high byte of the base address plus one, as SHA, SHX, SHY and TAS do.
+         * When indexing crosses the page, the high byte of the target address is replaced with the stored value.
+         */
+        void store_and_high_byte(Byte value) noexcept;
+
+        MOS6502 &m_cpu;
+        BusCallback m_busCallback;
+
+        const Microcode *m_program = &MICROCODE[0];
+        /// number of cycles of the current command done, 0 between commands
+        Byte m_step = 0;
+        /// cycle in progress
+        size_t m_cycle = 0;
+
+        // internal latches of the processor
+        Word m_address = 0;
+        Byte m_low = 0;
+        Byte m_high = 0;
+        Byte m_data = 0;
+        bool m_crossed = false;
+        bool m_branchTaken = false;
+
+        // interrupts
+        bool m_irqLine = false;
+        bool m_nmiEdge = false;
+        /// whether an interrupt has to be served, as polled at the start of the cycle
+        bool m_interruptPolled = false;
+        bool m_nmiPolled = false;
+        bool m_interruptPending = false;
+        bool m_inInterrupt = false;
+        Word m_vector = ROM::BRK_HANDLER;
+
+        bool m_jammed = false;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_CYCLESTEPPER_HPP
@@ -0,0 +1,99 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#include "Disassembler.hpp"
+#include "OpcodeTable.hpp"
+
+using namespace Emulator;
+
+
+namespace {
+
+    constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    char* append(char *out, std::string_view text) noexcept {
+        std::memcpy(out, text.data(), text.size());
+        return out + text.size();
+    }
+
+    char* append_hex(char *out, Byte value) noexcept {
+        out[0] = HEX_DIGITS[value >> 4];
+        out[1] = HEX_DIGITS[value & 0xF];
+        return out + 2;
+    }
+
+    char* append_hex(char *out, Word value) noexcept {
+        return append_hex(append_hex(out, (Byte)(value >> 8)), (Byte)value);
+    }
+
+    /// at least the given number of digits, zeros added in front
+    char* append_decimal(char *out, unsigned value, unsigned minimumDigits = 1) noexcept {
+        char digits[3];
+        unsigned count = 0;
+        do {
+            digits[count++] = (char)('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        for (; count < minimumDigits; count++) digits[count] = '0';
+        while (count > 0) *out++ = digits[--count];
+        return out;
+    }
+
+}
+
+
+char* Emulator::write_description(char *out, Byte opCode, Word operand) noexcept {
+    const auto &info = OPCODES[opCode];
+    out = append(out, info.mnemonic);
+
+    switch (info.mode) {
+        case AddressingMode::IMPLICIT:    return out;
+        case AddressingMode::ACCUMULATOR: return append(out, " A");
+        case AddressingMode::IMMEDIATE:   return append_decimal(append(out, " #"), (Byte)operand, 2);
+        case AddressingMode::ZERO_PAGE:   return append_hex(append(out, " $"), (Byte)operand);
+        case AddressingMode::ZERO_PAGE_X: return append(append_hex(append(out, " $"), (Byte)operand), ",X");
+        case AddressingMode::ZERO_PAGE_Y: return append(append_hex(append(out, " $"), (Byte)operand), ",Y");
+        case AddressingMode::RELATIVE: {
+            const int offset = (char)operand;
+            out = append(out, offset < 0 ? " *-" : " *+");
+            return append_decimal(out, offset < 0 ? -offset : offset);
+        }
+        case AddressingMode::ABSOLUTE:    return append_hex(append(out, " $"), operand);
+        case AddressingMode::ABSOLUTE_X:  return append(append_hex(append(out, " $"), operand), ",X");
+        case AddressingMode::ABSOLUTE_Y:  return append(append_hex(append(out, " $"), operand), ",Y");
+        case AddressingMode::INDIRECT:    return append(append_hex(append(out, " ($"), operand), ")");
+        case AddressingMode::INDIRECT_X:  return append(append_hex(append(out, " ($"), operand), ",X)");
+        case AddressingMode::INDIRECT_Y:  return append(append_hex(append(out, " ($"), operand), "),Y");
+    }
+    std::unreachable();
+}
+
+char* Emulator::write_line(char *out, Word address, Byte opCode, Word operand) noexcept {
+    out = append(append_hex(out, address), "  ");
+    out = write_description(out, opCode, operand);
+    *out++ = '\n';
+    return out;
+}
+
+DisassembledBatch Emulator::disassemble(const ROM &memory, size_t start, size_t commands, std::span<char> buffer) noexcept {
+    DisassembledBatch batch{.written = 0, .commands = 0, .next = start};
+    char *out = buffer.data();
+    while (batch.commands < commands && batch.next <= UINT16_MAX && buffer.size() - (out - buffer.data()) >= MAX_LINE_LENGTH) {
+        const Word address = batch.next;
+        const Byte opCode = memory[address];
+        const Byte length = OPCODES[opCode].length;
+        // the bytes after the operand are not a part of it
+        const Word operand = length == 1 ? 0 : length == 2 ? memory[(Word)(address + 1)] : memory.get_word(address + 1);
+
+        out = write_line(out, address, opCode, operand);
+        batch.commands++;
+        batch.next += length;
+    }
+    batch.written = out - buffer.data();
+    return batch;
+}
@@ -0,0 +1,57 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_DISASSEMBLER_HPP
+#define EMULATOR_MOS6502_DISASSEMBLER_HPP
+
+#include <span>
+
+#include "ROM.hpp"
+
+namespace Emulator {
+
+    /*
+     * Disassembly into buffers provided by the caller, without allocating and without parsing format strings,
+     *  for whole images and long traces. The text of a command is exactly the one of description().
+     */
+
+    /// the longest text of a single command, e.g. "SHA ($ffff),Y"
+    constexpr size_t MAX_DESCRIPTION_LENGTH = 16;
+    /// the longest line written by write_line() and disassemble()
+    constexpr size_t MAX_LINE_LENGTH = 4 + 2 + MAX_DESCRIPTION_LENGTH + 1;
+
+    /**
+     * Writes the same text as description(opCode, operand), not terminated by zero.
+     *
+     * @param out where MAX_DESCRIPTION_LENGTH characters may be written
+     * @return the end of the written text
+     */
+    char* write_description(char *out, Byte opCode, Word operand) noexcept;
+
+    /**
+     * Writes the line "ffff  <description>\n" with the address in hexadecimal, not terminated by zero.
+     *
+     * @param out where MAX_LINE_LENGTH characters may be written
+     * @return the end of the written line
+     */
+    char* write_line(char *out, Word address, Byte opCode, Word operand) noexcept;
+
+    struct DisassembledBatch {
+        /// number of characters written to the buffer
+        size_t written;
+        size_t commands;
+        /// address of the command following the last one written, up to the size of the memory
+        size_t next;
+    };
+
+    /**
+     * Writes a line per command for consecutive commands starting at the given address, until the given number
+     *  of commands is written, the next line might not fit the buffer or the end of the memory is reached.
+     * The operand of a command is read from the bytes following its opcode, as far as the command has one.
+     */
+    DisassembledBatch disassemble(const ROM &memory, size_t start, size_t commands, std::span<char> buffer) noexcept;
+
+}
+
+#endif //EMULATOR_MOS6502_DISASSEMBLER_HPP
@@ -0,0 +1,107 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <bit>
+#include <utility>
+
+#include "Disassembly.hpp"
+#include "OpcodeTable.hpp"
+
+
+namespace {
+
+    constexpr size_t MEMORY_SIZE = UINT16_MAX + 1;
+
+}
+
+
+Emulator::Disassembly::Disassembly(const ROM &memory): m_memory{memory} {
+    // the sweep starts there
+    m_anchors[0] = true;
+    disassemble();
+}
+
+Emulator::Word Emulator::Disassembly::address(size_t row) const noexcept {
+    size_t page = 0;
+    for (; page < ROM::PAGES_COUNT - 1 && row >= m_pageCounts[page]; page++) row -= m_pageCounts[page];
+
+    for (size_t word = page * ROM::PAGE_SIZE / 64;; word++) {
+        const auto commands = (size_t)std::popcount(m_starts[word]);
+        if (row < commands) {
+            uint64_t bits = m_starts[word];
+            for (; row > 0; row--) bits &= bits - 1;
+            return word * 64 + std::countr_zero(bits);
+        }
+        row -= commands;
+    }
+}
+
+size_t Emulator::Disassembly::row(Word address) const noexcept {
+    size_t result = 0;
+    for (size_t page = 0; page < address / ROM::PAGE_SIZE; page++) result += m_pageCounts[page];
+    // the commands of the page up to and including the address, the one containing it being the last of them
+    return result + count(address & 0xFF00, address + 1) - 1;
+}
+
+bool Emulator::Disassembly::overlaps(Word start) const noexcept {
+    return next(start) < start + OPCODES[std::as_const(m_memory)[start]].length;
+}
+
+auto Emulator::Disassembly::affected(Word changed) const noexcept -> Window {
+    const Word start = address(row(changed));
+    const auto [end, inserted] = resynchronize(start, changed);
+    return {.start = start, .end = end, .row = row(start), .removed = count(start, end), .inserted = inserted};
+}
+
+auto Emulator::Disassembly::anchored(Word anchor) noexcept -> Window {
+    m_anchors[anchor] = true;
+    return affected(anchor);
+}
+
+void Emulator::Disassembly::apply(const Window &window) noexcept {
+    for (size_t address = window.start; address < window.end; address++) set_command(address, false);
+    for (size_t address = window.start; address < window.end; address = next(address)) set_command(address, true);
+}
+
+void Emulator::Disassembly::disassemble() noexcept {
+    m_starts.fill(0);
+    m_pageCounts.fill(0);
+    m_size = 0;
+    for (size_t address = 0; address < MEMORY_SIZE; address = next(address)) set_command(address, true);
+}
+
+size_t Emulator::Disassembly::next(Word start) const noexcept {
+    const size_t end = start + OPCODES[std::as_const(m_memory)[start]].length;
+    for (size_t address = start + 1; address < end && address < MEMORY_SIZE; address++)
+        if (m_anchors[address]) return address;
+    return end;
+}
+
+std::pair<size_t, size_t> Emulator::Disassembly::resynchronize(Word start, Word changed) const noexcept {
+    // the sweep is deterministic, so once it reaches an old command start past the change, it continues as before
+    size_t address = start, decoded = 0;
+    for (; address < MEMORY_SIZE; address = next(address), decoded++)
+        if (address > changed && is_command(address)) break;
+    return {std::min(address, MEMORY_SIZE), decoded};
+}
+
+size_t Emulator::Disassembly::count(size_t start, size_t end) const noexcept {
+    size_t result = 0;
+    for (size_t address = start; address < end; address++) result += is_command(address);
+    return result;
+}
+
+void Emulator::Disassembly::set_command(Word address, bool value) noexcept {
+    if (is_command(address) == value) return;
+
+    m_starts[address >> 6] ^= uint64_t{1} << (address & 63);
+    if (value) {
+        m_pageCounts[address / ROM::PAGE_SIZE]++;
+        m_size++;
+    }
+    else {
+        m_pageCounts[address / ROM::PAGE_SIZE]--;
+        m_size--;
+    }
+}
@@ -0,0 +1,94 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_DISASSEMBLY_HPP
+#define EMULATOR_MOS6502_DISASSEMBLY_HPP
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+
+#include "ROM.hpp"
+
+namespace Emulator {
+
+    /**
+     * The whole memory decoded into commands by a linear sweep from address 0, a row per command.
+     *
+     * Since code and data are not told apart, the sweep may start commands in the middle of the intended ones.
+     *  Anchors are the addresses known to start a command, e.g. the targets of the vectors: a command running into
+     *  an anchor overlaps it, and the sweep goes on from the anchor, so that the commands after it are decoded right.
+     *
+     * The sweep resynchronizes shortly after a changed byte, so a change only re-decodes the window from the command
+     *  containing the byte up to the first old command start after it. The window is computed by affected() and
+     *  decoded by apply(), so that the rows it removes and inserts can be announced in between.
+     */
+    class Disassembly {
+    public:
+        /// the commands starting at [start, end) are replaced by the ones decoded from the memory as it is now
+        struct Window {
+            Word start;
+            /// exclusive, up to the size of the memory
+            size_t end;
+            /// index of the row of the command at start
+            size_t row;
+            size_t removed;
+            size_t inserted;
+        };
+
+        /// decodes the whole memory, which must outlive the disassembly
+        explicit Disassembly(const ROM &memory);
+
+        /// number of commands, that is of rows
+        [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+        /// address of the command at the given row
+        [[nodiscard]] Word address(size_t row) const noexcept;
+
+        /// row of the command containing the given address
+        [[nodiscard]] size_t row(Word address) const noexcept;
+
+        [[nodiscard]] bool is_command(Word address) const noexcept { return m_starts[address >> 6] >> (address & 63) & 1; }
+
+        [[nodiscard]] bool is_anchor(Word address) const noexcept { return m_anchors[address]; }
+
+        /// whether the command at the given address is cut short by an anchor
+        [[nodiscard]] bool overlaps(Word start) const noexcept;
+
+        /// the window to be re-decoded after the byte at the given address has changed
+        [[nodiscard]] Window affected(Word changed) const noexcept;
+
+        /// the window to be re-decoded after the given address has become an anchor
+        [[nodiscard]] Window anchored(Word anchor) noexcept;
+
+        /// re-decodes the window computed after the last change of the memory or of the anchors
+        void apply(const Window &window) noexcept;
+
+        /// decodes the whole memory from scratch
+        void disassemble() noexcept;
+
+    private:
+        /// where the sweep goes on after the command at the given address, past the end of the memory at most
+        [[nodiscard]] size_t next(Word start) const noexcept;
+
+        /// @return the end of the window starting at the given command start, and the number of commands decoded in it
+        [[nodiscard]] std::pair<size_t, size_t> resynchronize(Word start, Word changed) const noexcept;
+
+        [[nodiscard]] size_t count(size_t start, size_t end) const noexcept;
+
+        void set_command(Word address, bool value) noexcept;
+
+        const ROM &m_memory;
+
+        std::bitset<UINT16_MAX + 1> m_anchors;
+        /// a bit per address, set if a command starts there
+        std::array<uint64_t, (UINT16_MAX + 1) / 64> m_starts{};
+        /// number of commands starting in every page, to find the rows without counting from the start
+        std::array<uint16_t, ROM::PAGES_COUNT> m_pageCounts{};
+        size_t m_size = 0;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_DISASSEMBLY_HPP
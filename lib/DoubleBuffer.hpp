@@ -0,0 +1,79 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_DOUBLEBUFFER_HPP
+#define EMULATOR_MOS6502_DOUBLEBUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Emulator {
+
+    /**
+     * Latest value passed from a single writing thread to a single reading thread without locking either of them.
+     *
+     * The reader reads the front slot, while the writer fills the back one and then swaps them. Neither ever waits:
+     *  if the reader is still reading the back slot, left over from before the previous swap, write() gives up and
+     *  the writer tries again later, so that the reader always sees a complete value.
+     */
+    template<typename T>
+    class DoubleBuffer {
+    public:
+        DoubleBuffer() = default;
+
+        DoubleBuffer(const DoubleBuffer&) = delete;
+        DoubleBuffer& operator =(const DoubleBuffer&) = delete;
+
+        /**
+         * Called by the writing thread only.
+         *
+         * @param fill invoked with the back slot, holding the value written two writes ago
+         * @return whether the value has been written, false if the reader is busy with the slot
+         */
+        template<typename F>
+        bool write(F &&fill) {
+            const uint8_t state = m_state.load(std::memory_order_acquire);
+            const uint8_t back = (state & FRONT) ^ 1;
+            if ((state & READING) && (state & READ_SLOT) >> 2 == back) return false;
+
+            fill(m_slots[back]);
+
+            // only the reader changes the state meanwhile, and it keeps reading the front slot
+            uint8_t expected = state;
+            while (!m_state.compare_exchange_weak(expected, (expected & ~FRONT) | back, std::memory_order_acq_rel));
+            m_written.store(true, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Called by the reading thread only.
+         *
+         * @param use invoked with the value written last, unless nothing has been written yet
+         * @return whether anything has been written
+         */
+        template<typename F>
+        bool read(F &&use) const {
+            if (!m_written.load(std::memory_order_acquire)) return false;
+
+            uint8_t state = m_state.load(std::memory_order_relaxed);
+            while (!m_state.compare_exchange_weak(state, (state & FRONT) | READING | (state & FRONT) << 2, std::memory_order_acq_rel));
+
+            use(static_cast<const T&>(m_slots[state & FRONT]));
+            m_state.fetch_and(~READING, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        /// index of the slot read from, whether it is being read and the index of the slot being read
+        static constexpr uint8_t FRONT = 1, READING = 2, READ_SLOT = 4;
+
+        std::array<T, 2> m_slots{};
+        mutable std::atomic<uint8_t> m_state = 0;
+        std::atomic<bool> m_written = false;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_DOUBLEBUFFER_HPP
@@ -0,0 +1,98 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "Emulation.hpp"
+
+namespace Emulator {
+
+    Emulation::Emulation(const ROM &program, std::chrono::microseconds period): m_period{period} {
+        m_cpu.burn(program);
+        m_cpu.reset();
+        m_cpu.stop_on_break(true);
+        m_cpu.max_number_of_commands(SLICE);
+        m_thread = std::thread(&Emulation::run, this);
+    }
+
+    Emulation::~Emulation() {
+        stop();
+        m_thread.join();
+    }
+
+
+    void Emulation::pause() {
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_request != Request::RUN) return;
+            m_request = Request::PAUSE;
+        }
+        m_cpu.request_stop();
+    }
+
+    void Emulation::resume() {
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_request != Request::PAUSE) return;
+            m_request = Request::RUN;
+        }
+        m_condition.notify_all();
+    }
+
+    void Emulation::stop() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_request = Request::STOP;
+        }
+        m_cpu.request_stop();
+        m_condition.notify_all();
+    }
+
+
+    void Emulation::run() {
+        using Clock = std::chrono::steady_clock;
+
+        publish(false, std::nullopt, true);
+        auto nextPublication = Clock::now() + m_period;
+        std::optional<ExecutionResult> result;
+        while (!result.has_value()) {
+            {
+                std::unique_lock lock(m_mutex);
+                if (m_request == Request::PAUSE) {
+                    publish(true, std::nullopt, true);
+                    m_condition.wait(lock, [this]() { return m_request != Request::PAUSE; });
+                }
+                if (m_request == Request::STOP) {
+                    result = MOS6502::StopOnRequest{.address = m_cpu.PC};
+                    break;
+                }
+            }
+
+            const auto status = m_cpu.execute();
+            // the slice has ended, or the thread has been asked to pause or to stop
+            const bool goesOn = status.has_value() && (std::holds_alternative<MOS6502::StopOnMaxReached>(status.value())
+                                                       || std::holds_alternative<MOS6502::StopOnRequest>(status.value()));
+            if (!goesOn) result = status;
+            // a publication skipped because of the reader is retried after the next slice
+            else if (Clock::now() >= nextPublication && publish(false, std::nullopt, false))
+                nextPublication = Clock::now() + m_period;
+        }
+
+        publish(false, result, true);
+        m_finished.store(true, std::memory_order_release);
+    }
+
+    bool Emulation::publish(bool paused, const std::optional<ExecutionResult> &result, bool force) {
+        const auto fill = [&](Snapshot &snapshot) {
+            snapshot.state = m_cpu.get_state();
+            snapshot.memory = m_cpu.memory;
+            snapshot.instructionsRetired = m_cpu.get_metrics().instructionsRetired.load();
+            snapshot.paused = paused;
+            snapshot.result = result;
+        };
+        if (!force) return m_snapshots.write(fill);
+
+        while (!m_snapshots.write(fill)) std::this_thread::yield();
+        return true;
+    }
+
+}
@@ -0,0 +1,101 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_EMULATION_HPP
+#define EMULATOR_MOS6502_EMULATION_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <expected>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "MOS6502.hpp"
+#include "DoubleBuffer.hpp"
+
+namespace Emulator {
+
+    /**
+     * A program executed by a MOS6502 in a thread of its own, so that the thread starting it, e.g. the one of a GUI,
+     *  is never blocked by it.
+     *
+     * The state of the CPU is published as a Snapshot periodically and whenever execution pauses or finishes,
+     *  and is read through a DoubleBuffer, so that neither thread waits for the other. Execution is paused and
+     *  stopped cooperatively: the CPU is asked to stop before its next command.
+     */
+    class Emulation {
+    public:
+        using ExecutionResult = std::expected<MOS6502::SuccessfulTermination, MOS6502::ErrorTermination>;
+
+        /// the state of the CPU at some moment of the execution
+        struct Snapshot {
+            MOS6502::State state;
+            ROM memory;
+            uint64_t instructionsRetired;
+            bool paused;
+            /// how the execution has finished, nullopt while it goes on
+            std::optional<ExecutionResult> result;
+        };
+
+        /// the default period of publication, 60 times a second
+        static constexpr std::chrono::microseconds DEFAULT_PERIOD{1'000'000 / 60};
+
+        /**
+         * Starts executing the program from its reset location, stopping on BRK.
+         *
+         * @param period the snapshot is published at most once a period while the program is running
+         */
+        explicit Emulation(const ROM &program, std::chrono::microseconds period = DEFAULT_PERIOD);
+        /// stops the execution and waits for it
+        ~Emulation();
+
+        Emulation(const Emulation&) = delete;
+        Emulation& operator =(const Emulation&) = delete;
+
+        /// pauses the execution before the next command; a snapshot of the paused CPU is published
+        void pause();
+        void resume();
+        /// finishes the execution before the next command, with MOS6502::StopOnRequest as its result
+        void stop();
+
+        /**
+         * Called by a single thread, the one reading the snapshots.
+         *
+         * @param use invoked with the snapshot published last, unless none has been published yet
+         * @return whether there has been a snapshot
+         */
+        template<typename F>
+        bool read(F &&use) const { return m_snapshots.read(std::forward<F>(use)); }
+
+        [[nodiscard]] bool finished() const noexcept { return m_finished.load(std::memory_order_acquire); }
+
+    private:
+        enum class Request { RUN, PAUSE, STOP };
+
+        /// commands executed between checks of the requests and of the time
+        static constexpr size_t SLICE = 10'000;
+
+        /// body of the emulation thread
+        void run();
+
+        /// @param force retries until the reader lets the snapshot be published
+        bool publish(bool paused, const std::optional<ExecutionResult> &result, bool force);
+
+        MOS6502 m_cpu;
+        std::chrono::microseconds m_period;
+
+        DoubleBuffer<Snapshot> m_snapshots;
+        std::atomic<bool> m_finished = false;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        Request m_request = Request::RUN;
+
+        std::thread m_thread;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_EMULATION_HPP
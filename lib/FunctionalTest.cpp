@@ -0,0 +1,93 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <utility>
+
+#include "FunctionalTest.hpp"
+#include "MOS6502.hpp"
+#include "CycleStepper.hpp"
+
+using namespace Emulator;
+
+
+namespace {
+
+    /// commands run between the checks for a trap
+    constexpr size_t SLICE = 1000;
+
+    template<typename CPU>
+    void prepare(CPU &cpu, const ROM &image, Word start) noexcept {
+        cpu.burn(image);
+        cpu.set_state({.PC = start, .AC = 0, .X = 0, .Y = 0, .SR = {}, .SP = 0xFF, .cycle = 0});
+    }
+
+    template<typename CPU>
+    Halted halted(const typename CPU::ErrorTermination &error) noexcept {
+        return std::visit([](const auto &termination) { return Halted{.address = termination.address}; }, error);
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    std::expected<TrapReport, TrapError> run_interpreted(const ROM &image, Word start, uint64_t maxInstructions) {
+        using CPU = BasicMOS6502<accounting, variant>;
+        CPU cpu{};
+        prepare(cpu, image, start);
+
+        const auto begin = std::chrono::steady_clock::now();
+        while (cpu.get_metrics().instructionsRetired.load() < maxInstructions) {
+            cpu.max_number_of_commands(SLICE);
+            if (const auto result = cpu.execute(); !result.has_value()) return std::unexpected(halted<CPU>(result.error()));
+
+            // a single command more tells whether it stays in place
+            const Word address = cpu.get_state().PC;
+            cpu.max_number_of_commands(1);
+            if (const auto result = cpu.execute(); !result.has_value()) return std::unexpected(halted<CPU>(result.error()));
+            if (cpu.get_state().PC == address)
+                return TrapReport{.trap = address, .instructions = cpu.get_metrics().instructionsRetired.load(),
+                                  .cycles = cpu.get_state().cycle, .elapsed = std::chrono::steady_clock::now() - begin};
+        }
+        return std::unexpected(NoTrap{.instructions = maxInstructions});
+    }
+
+    std::expected<TrapReport, TrapError> run_stepped(const ROM &image, Word start, uint64_t maxInstructions) {
+        MOS6502 cpu{};
+        prepare(cpu, image, start);
+        CycleStepper stepper(cpu);
+        stepper.reset();
+
+        const auto begin = std::chrono::steady_clock::now();
+        while (cpu.get_metrics().instructionsRetired.load() < maxInstructions) {
+            const Word address = cpu.get_state().PC;
+            stepper.step_command();
+            if (stepper.jammed()) return std::unexpected(Halted{.address = address});
+            if (cpu.get_state().PC == address)
+                return TrapReport{.trap = address, .instructions = cpu.get_metrics().instructionsRetired.load(),
+                                  .cycles = cpu.get_state().cycle, .elapsed = std::chrono::steady_clock::now() - begin};
+        }
+        return std::unexpected(NoTrap{.instructions = maxInstructions});
+    }
+
+}
+
+
+std::string_view Emulator::to_string(Engine engine) noexcept {
+    switch (engine) {
+        case Engine::EXACT_CYCLES:       return "exact cycles";
+        case Engine::INSTRUCTION_CYCLES: return "instruction cycles";
+        case Engine::NO_CYCLES:          return "no cycles";
+        case Engine::CMOS:               return "CMOS";
+        case Engine::CYCLE_STEPPER:      return "cycle stepper";
+    }
+    std::unreachable();
+}
+
+std::expected<TrapReport, TrapError> Emulator::run_to_trap(Engine engine, const ROM &image, Word start, uint64_t maxInstructions) {
+    switch (engine) {
+        case Engine::EXACT_CYCLES:       return run_interpreted<CycleAccounting::EXACT, Variant::NMOS>(image, start, maxInstructions);
+        case Engine::INSTRUCTION_CYCLES: return run_interpreted<CycleAccounting::INSTRUCTION, Variant::NMOS>(image, start, maxInstructions);
+        case Engine::NO_CYCLES:          return run_interpreted<CycleAccounting::NONE, Variant::NMOS>(image, start, maxInstructions);
+        case Engine::CMOS:               return run_interpreted<CycleAccounting::EXACT, Variant::CMOS>(image, start, maxInstructions);
+        case Engine::CYCLE_STEPPER:      return run_stepped(image, start, maxInstructions);
+    }
+    std::unreachable();
+}
@@ -0,0 +1,77 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_FUNCTIONALTEST_HPP
+#define EMULATOR_MOS6502_FUNCTIONALTEST_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "ROM.hpp"
+
+namespace Emulator {
+
+    /*
+     * Conformance programs in the style of Klaus Dormann's 6502 functional test, which report their outcome by
+     *  looping forever on a branch or a jump to itself: at the success address when every check passed, at the
+     *  failed check otherwise.
+     */
+
+    /// the functional test binary as distributed is a 64 KiB image loaded at 0, started at $0400, passing at $3469
+    inline constexpr Word FUNCTIONAL_TEST_START = 0x0400;
+    inline constexpr Word FUNCTIONAL_TEST_SUCCESS = 0x3469;
+
+    /// every way a program can be executed, all of which must agree
+    enum class Engine { EXACT_CYCLES, INSTRUCTION_CYCLES, NO_CYCLES, CMOS, CYCLE_STEPPER };
+
+    inline constexpr std::array ENGINES{Engine::EXACT_CYCLES, Engine::INSTRUCTION_CYCLES, Engine::NO_CYCLES, Engine::CMOS,
+                                        Engine::CYCLE_STEPPER};
+
+    [[nodiscard]] std::string_view to_string(Engine engine) noexcept;
+
+    struct TrapReport {
+        /// address of the command branching or jumping to itself
+        Word trap;
+        uint64_t instructions;
+        /// zero for the engine not counting cycles
+        size_t cycles;
+        std::chrono::duration<double> elapsed;
+    };
+
+    struct NoTrap {
+        uint64_t instructions;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("No trap within {:d} instructions", std::make_format_args(instructions));
+        }
+    };
+
+    /// an unknown opcode or a JAM
+    struct Halted {
+        Word address;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("Halted at {:#06x}", std::make_format_args(address));
+        }
+    };
+
+    using TrapError = std::variant<NoTrap, Halted>;
+
+    /**
+     * Runs the image from the given address with the stack pointer at $FF until it traps.
+     * The interpreting engines run slices of commands with idle loops skipped, checking for a trap between them, so the
+     *  reported instructions and cycles may include up to a slice of repetitions of the trap; the cycle stepper
+     *  checks after every command.
+     */
+    std::expected<TrapReport, TrapError> run_to_trap(Engine engine, const ROM &image, Word start, uint64_t maxInstructions);
+
+}
+
+#endif //EMULATOR_MOS6502_FUNCTIONALTEST_HPP
@@ -0,0 +1,502 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <format>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+#include "GdbServer.hpp"
+
+using namespace Emulator;
+
+
+#ifdef _WIN32
+static void close_socket(intptr_t socket) { closesocket((SOCKET)socket); }
+static int poll_socket(intptr_t socket, int timeout) {
+    WSAPOLLFD descriptor{.fd = (SOCKET)socket, .events = POLLRDNORM};
+    return WSAPoll(&descriptor, 1, timeout);
+}
+#else
+static void close_socket(intptr_t socket) { close((int)socket); }
+static int poll_socket(intptr_t socket, int timeout) {
+    pollfd descriptor{.fd = (int)socket, .events = POLLIN};
+    return poll(&descriptor, 1, timeout);
+}
+#endif
+
+
+static constexpr auto HEX_DIGITS = "0123456789abcdef";
+
+static void append_hex(std::string &result, Byte byte) {
+    result += HEX_DIGITS[byte >> 4];
+    result += HEX_DIGITS[byte & 0xF];
+}
+
+static std::optional<Byte> parse_hex_byte(const std::string &hex, size_t position) {
+    if (position + 2 > hex.size()) return std::nullopt;
+    try {
+        size_t parsed;
+        const auto value = std::stoul(hex.substr(position, 2), &parsed, 16);
+        if (parsed != 2) return std::nullopt;
+        return (Byte)value;
+    }
+    catch (const std::logic_error &e) {
+        return std::nullopt;
+    }
+}
+
+static std::optional<size_t> parse_hex_number(const std::string &hex) {
+    try {
+        size_t parsed;
+        const auto value = std::stoul(hex, &parsed, 16);
+        if (parsed != hex.size()) return std::nullopt;
+        return value;
+    }
+    catch (const std::logic_error &e) {
+        return std::nullopt;
+    }
+}
+
+
+GdbServer::GdbServer(MOS6502 &cpu): m_cpu{cpu} {
+#ifdef _WIN32
+    WSADATA data;
+    WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+    m_cpuThread = std::thread(&GdbServer::run_cpu, this);
+}
+
+GdbServer::~GdbServer() {
+    m_cpu.request_stop();
+    {
+        std::lock_guard lock(m_mutex);
+        m_command = Command::QUIT;
+    }
+    m_condition.notify_all();
+    m_cpuThread.join();
+
+    if (m_connection != INVALID) close_socket(m_connection);
+    if (m_listener != INVALID) close_socket(m_listener);
+#ifdef _WIN32
+    WSACleanup();
+#else
+    if (!m_unixPath.empty()) unlink(m_unixPath.c_str());
+#endif
+}
+
+
+std::expected<void, std::string> GdbServer::listen_tcp(uint16_t port) {
+    const auto listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) return std::unexpected("could not create a socket");
+
+    const int enable = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char*)&enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(listener, (const sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 1) != 0) {
+        close_socket(listener);
+        return std::unexpected(std::vformat("could not listen on port {:d}", std::make_format_args(port)));
+    }
+
+    m_listener = listener;
+    return {};
+}
+
+#ifndef _WIN32
+std::expected<void, std::string> GdbServer::listen_unix(const std::string &path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) return std::unexpected("socket path is too long");
+
+    const auto listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) return std::unexpected("could not create a socket");
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    unlink(path.c_str());
+    if (bind(listener, (const sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 1) != 0) {
+        close_socket(listener);
+        return std::unexpected("could not listen on " + path);
+    }
+
+    m_listener = listener;
+    m_unixPath = path;
+    return {};
+}
+#endif
+
+
+std::expected<void, std::string> GdbServer::serve() {
+    if (m_listener == INVALID) return std::unexpected("the server is not listening");
+
+    const auto connection = accept(m_listener, nullptr, nullptr);
+    if (connection < 0) return std::unexpected("could not accept a connection");
+    m_connection = connection;
+
+    // packets are small and interactive, so they must not be delayed
+    const int enable = 1;
+    setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, (const char*)&enable, sizeof(enable));
+
+    m_acknowledge = true;
+    while (auto packet = receive_packet()) {
+        // an interrupt while the CPU is stopped has nothing to interrupt
+        if (packet.value() == "\x03") continue;
+
+        const bool startNoAck = packet.value() == "QStartNoAckMode";
+        const auto reply = handle(packet.value());
+        if (!reply.has_value()) break;
+        if (!send_packet(reply.value())) break;
+        if (startNoAck) m_acknowledge = false;
+        if (packet.value() == "D") break;
+    }
+
+    close_socket(m_connection);
+    m_connection = INVALID;
+    m_received.clear();
+    return {};
+}
+
+
+void GdbServer::run_cpu() {
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this]() { return m_command != Command::NONE; });
+        const auto command = std::exchange(m_command, Command::NONE);
+        if (command == Command::QUIT) return;
+
+        lock.unlock();
+        m_cpu.max_number_of_commands((command == Command::STEP) ? std::optional<size_t>(1) : std::nullopt);
+        const auto result = m_cpu.execute();
+        lock.lock();
+
+        // a request arriving after execute() stopped for another reason must not stop the next command
+        m_cpu.cancel_stop_request();
+        m_lastResult = result;
+        m_running = false;
+        m_condition.notify_all();
+    }
+}
+
+std::string GdbServer::resume(GdbServer::Command command) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_command = command;
+        m_running = true;
+    }
+    m_condition.notify_all();
+
+    while (true) {
+        {
+            std::unique_lock lock(m_mutex);
+            if (m_condition.wait_for(lock, std::chrono::milliseconds(10), [this]() { return !m_running; }))
+                return stop_reply(m_lastResult);
+        }
+
+        // the debugger may interrupt the program or disconnect while it is running; anything else it sends is kept
+        //  for after the stop
+        if (poll_socket(m_connection, 0) > 0) {
+            char byte;
+            const bool received = recv(m_connection, &byte, 1, 0) == 1;
+            if (received && byte != '\x03') {
+                m_received.push_back(byte);
+                continue;
+            }
+
+            std::lock_guard lock(m_mutex);
+            if (m_running) m_cpu.request_stop();
+        }
+    }
+}
+
+
+std::optional<std::string> GdbServer::handle(const std::string &packet) {
+    if (packet.empty()) return "";
+
+    const auto arguments = packet.substr(1);
+    switch (packet[0]) {
+        case '?': return stop_reply(m_lastResult);
+        case 'g': return read_registers();
+        case 'G': return write_registers(arguments) ? "OK" : "E01";
+        case 'p': {
+            const auto index = parse_hex_number(arguments);
+            const auto value = index.and_then([this](size_t i) { return read_register(i); });
+            return value.value_or("E01");
+        }
+        case 'P': {
+            const auto separator = arguments.find('=');
+            if (separator == std::string::npos) return "E01";
+            const auto index = parse_hex_number(arguments.substr(0, separator));
+            return (index.has_value() && write_register(index.value(), arguments.substr(separator + 1))) ? "OK" : "E01";
+        }
+        case 'm': return read_memory(arguments);
+        case 'M': return write_memory(arguments) ? "OK" : "E01";
+        case 'c': [[fallthrough]];
+        case 's': {
+            if (!arguments.empty()) {
+                const auto address = parse_hex_number(arguments);
+                if (!address.has_value()) return "E01";
+                auto state = m_cpu.get_state();
+                state.PC = (Word)address.value();
+                m_cpu.set_state(state);
+            }
+            return resume((packet[0] == 'c') ? Command::CONTINUE : Command::STEP);
+        }
+        case 'Z': return change_breakpoint(arguments, true) ? "OK" : "";
+        case 'z': return change_breakpoint(arguments, false) ? "OK" : "";
+        case 'H': return "OK";
+        case 'T': return "OK";
+        case 'D': return "OK";
+        case 'k': return std::nullopt;
+        default: break;
+    }
+
+    if (packet.starts_with("qSupported")) return "PacketSize=1000;QStartNoAckMode+;swbreak+;hwbreak+";
+    if (packet == "QStartNoAckMode") return "OK";
+    if (packet == "qAttached") return "1";
+    if (packet == "qC") return "QC1";
+    if (packet == "qfThreadInfo") return "m1";
+    if (packet == "qsThreadInfo") return "l";
+
+    // an empty reply tells the debugger that the packet is not supported
+    return "";
+}
+
+
+std::string GdbServer::read_registers() const {
+    const auto state = m_cpu.get_state();
+
+    std::string result;
+    for (const Byte byte: {state.AC, state.X, state.Y, state.SP, state.SR.to_byte(), (Byte)state.PC, (Byte)(state.PC >> 8)})
+        append_hex(result, byte);
+    return result;
+}
+
+bool GdbServer::write_registers(const std::string &hex) {
+    if (hex.size() != 14) return false;
+    for (size_t i = 0; i < 6; i++)
+        if (!write_register(i, hex.substr(2 * i, (i == 5) ? 4 : 2))) return false;
+    return true;
+}
+
+std::optional<std::string> GdbServer::read_register(size_t index) const {
+    const auto state = m_cpu.get_state();
+
+    std::string result;
+    switch (index) {
+        case 0: append_hex(result, state.AC); break;
+        case 1: append_hex(result, state.X); break;
+        case 2: append_hex(result, state.Y); break;
+        case 3: append_hex(result, state.SP); break;
+        case 4: append_hex(result, state.SR.to_byte()); break;
+        case 5:
+            append_hex(result, (Byte)state.PC);
+            append_hex(result, (Byte)(state.PC >> 8));
+            break;
+        default: return std::nullopt;
+    }
+    return result;
+}
+
+bool GdbServer::write_register(size_t index, const std::string &hex) {
+    auto state = m_cpu.get_state();
+
+    const auto low = parse_hex_byte(hex, 0);
+    if (!low.has_value()) return false;
+
+    switch (index) {
+        case 0: state.AC = low.value(); break;
+        case 1: state.X = low.value(); break;
+        case 2: state.Y = low.value(); break;
+        case 3: state.SP = low.value(); break;
+        case 4: state.SR = low.value(); break;
+        case 5: {
+            const auto high = parse_hex_byte(hex, 2);
+            if (!high.has_value()) return false;
+            state.PC = (Word)(low.value() | high.value() << 8);
+            break;
+        }
+        default: return false;
+    }
+
+    m_cpu.set_state(state);
+    return true;
+}
+
+std::string GdbServer::read_memory(const std::string &arguments) const {
+    const auto separator = arguments.find(',');
+    if (separator == std::string::npos) return "E01";
+    const auto address = parse_hex_number(arguments.substr(0, separator));
+    const auto length = parse_hex_number(arguments.substr(separator + 1));
+    if (!address.has_value() || !length.has_value() || address.value() > UINT16_MAX) return "E01";
+
+    std::string result;
+    // reading wraps around the end of the address space, like the CPU does
+    for (size_t i = 0; i < std::min<size_t>(length.value(), UINT16_MAX + 1); i++)
+        append_hex(result, std::as_const(m_cpu.memory)[(Word)(address.value() + i)]);
+    return result;
+}
+
+bool GdbServer::write_memory(const std::string &arguments) {
+    const auto comma = arguments.find(',');
+    const auto colon = arguments.find(':');
+    if (comma == std::string::npos || colon == std::string::npos || colon < comma) return false;
+
+    const auto address = parse_hex_number(arguments.substr(0, comma));
+    const auto length = parse_hex_number(arguments.substr(comma + 1, colon - comma - 1));
+    const auto data = arguments.substr(colon + 1);
+    if (!address.has_value() || !length.has_value() || address.value() > UINT16_MAX || data.size() != 2 * length.value())
+        return false;
+
+    std::vector<Byte> bytes;
+    for (size_t i = 0; i < length.value(); i++) {
+        const auto byte = parse_hex_byte(data, 2 * i);
+        if (!byte.has_value()) return false;
+        bytes.push_back(byte.value());
+    }
+
+    m_cpu.memory.load((Word)address.value(), bytes);
+    return true;
+}
+
+bool GdbServer::change_breakpoint(const std::string &arguments, bool insert) {
+    // type,address,kind
+    const auto first = arguments.find(',');
+    const auto second = arguments.find(',', first + 1);
+    if (first == std::string::npos || second == std::string::npos) return false;
+
+    const auto type = parse_hex_number(arguments.substr(0, first));
+    const auto address = parse_hex_number(arguments.substr(first + 1, second - first - 1));
+    if (!type.has_value() || !address.has_value() || address.value() > UINT16_MAX) return false;
+
+    auto &breakpoints = m_cpu.get_breakpoints();
+    const auto target = (Word)address.value();
+    switch (type.value()) {
+        // software and hardware breakpoints are the same for the emulator
+        case 0: [[fallthrough]];
+        case 1:
+            if (insert) breakpoints.set_breakpoint(target);
+            else breakpoints.clear_breakpoint(target);
+            return true;
+        case 2: [[fallthrough]];
+        case 3: [[fallthrough]];
+        case 4: {
+            const auto access = (type.value() == 2) ? Access::WRITE : (type.value() == 3) ? Access::READ : Access::READ_WRITE;
+            if (insert) breakpoints.set_watchpoint(target, access);
+            else breakpoints.clear_watchpoint(target, access);
+            return true;
+        }
+        default: return false;
+    }
+}
+
+
+std::string GdbServer::stop_reply(const GdbServer::ExecutionResult &result) {
+    // signal numbers: 2 - SIGINT, 4 - SIGILL, 5 - SIGTRAP
+    if (!result.has_value()) return "S04";
+
+    return std::visit(Overload{
+            [](MOS6502::StopOnBreakpoint) -> std::string { return "T05swbreak:;"; },
+            [](MOS6502::StopOnWatchpoint hit) -> std::string {
+                const auto kind = (hit.access == Access::WRITE) ? "watch" : (hit.access == Access::READ) ? "rwatch" : "awatch";
+                return std::vformat("T05{}:{:04x};", std::make_format_args(kind, hit.accessedAddress));
+            },
+            [](MOS6502::StopOnRequest) -> std::string { return "S02"; },
+            [](auto) -> std::string { return "S05"; }
+    }, result.value());
+}
+
+
+std::optional<char> GdbServer::receive_byte(std::optional<int> timeoutMilliseconds) {
+    if (!m_received.empty()) {
+        const char byte = m_received.front();
+        m_received.pop_front();
+        return byte;
+    }
+    if (timeoutMilliseconds.has_value() && poll_socket(m_connection, timeoutMilliseconds.value()) <= 0) return std::nullopt;
+
+    char byte;
+    if (recv(m_connection, &byte, 1, 0) != 1) return std::nullopt;
+    return byte;
+}
+
+std::optional<std::string> GdbServer::receive_packet() {
+    while (true) {
+        const auto start = receive_byte();
+        if (!start.has_value()) return std::nullopt;
+        if (start.value() == '\x03') return "\x03";
+        if (start.value() != '$') continue;
+
+        std::string data;
+        Byte checksum = 0;
+        while (true) {
+            const auto byte = receive_byte();
+            if (!byte.has_value()) return std::nullopt;
+            if (byte.value() == '#') break;
+            data += byte.value();
+            checksum += byte.value();
+        }
+
+        std::string received;
+        for (int i = 0; i < 2; i++) {
+            const auto byte = receive_byte();
+            if (!byte.has_value()) return std::nullopt;
+            received += byte.value();
+        }
+
+        if (!m_acknowledge) return data;
+        if (parse_hex_byte(received, 0) == checksum) {
+            send_raw("+");
+            return data;
+        }
+        send_raw("-");
+    }
+}
+
+bool GdbServer::send_packet(const std::string &data) {
+    Byte checksum = 0;
+    for (const auto byte: data) checksum += byte;
+
+    std::string packet = "$" + data + "#";
+    append_hex(packet, checksum);
+
+    // retransmitting until the debugger acknowledges the packet
+    for (int attempt = 0; attempt < 3; attempt++) {
+        if (!send_raw(packet)) return false;
+        if (!m_acknowledge) return true;
+
+        std::optional<char> reply;
+        do reply = receive_byte(); while (reply.has_value() && reply.value() != '+' && reply.value() != '-');
+        if (!reply.has_value()) return false;
+        if (reply.value() == '+') return true;
+    }
+    return false;
+}
+
+bool GdbServer::send_raw(const std::string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const auto result = send(m_connection, data.data() + sent, (int)(data.size() - sent), 0);
+        if (result <= 0) return false;
+        sent += result;
+    }
+    return true;
+}
@@ -0,0 +1,104 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_GDBSERVER_HPP
+#define EMULATOR_MOS6502_GDBSERVER_HPP
+
+#include <string>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <expected>
+#include <deque>
+
+#include "MOS6502.hpp"
+
+namespace Emulator {
+
+    /**
+     * Stub of the GDB remote serial protocol driving a MOS6502.
+     *
+     * The CPU executes in its own thread; the protocol is handled in the thread calling serve(), which only touches
+     *  the CPU while it is stopped. The only cost on the execution path is the check of MOS6502::request_stop(),
+     *  used to interrupt a running program.
+     *
+     * Registers, in the order of the 'g' packet: A, X, Y, SP, SR (one byte each), PC (two bytes, little-endian).
+     * Supported packets: ?, g, G, p, P, m, M, c, s, Z0-Z4, z0-z4, k, D, qSupported, qAttached, qC,
+     *  qfThreadInfo/qsThreadInfo, QStartNoAckMode and the interrupt byte 0x03.
+     */
+    class GdbServer {
+    public:
+        explicit GdbServer(MOS6502 &cpu);
+        ~GdbServer();
+
+        GdbServer(const GdbServer&) = delete;
+        GdbServer& operator =(const GdbServer&) = delete;
+
+        /// starts listening on the given TCP port of the loopback interface
+        [[nodiscard]] std::expected<void, std::string> listen_tcp(uint16_t port);
+
+#ifndef _WIN32
+        /// starts listening on a Unix domain socket at the given path
+        [[nodiscard]] std::expected<void, std::string> listen_unix(const std::string &path);
+#endif
+
+        /// accepts a single debugger connection and serves it until it detaches, kills the target or disconnects
+        [[nodiscard]] std::expected<void, std::string> serve();
+
+    private:
+        enum class Command { NONE, CONTINUE, STEP, QUIT };
+
+        using ExecutionResult = std::expected<MOS6502::SuccessfulTermination, MOS6502::ErrorTermination>;
+
+        /// body of the CPU thread: waits for a command, executes it and publishes the result
+        void run_cpu();
+
+        /// resumes the CPU and waits until it stops, forwarding interrupt requests from the debugger
+        std::string resume(Command command);
+
+        /// @return reply to the packet, nullopt if the session must be ended
+        std::optional<std::string> handle(const std::string &packet);
+
+        std::string read_registers() const;
+        bool write_registers(const std::string &hex);
+        std::optional<std::string> read_register(size_t index) const;
+        bool write_register(size_t index, const std::string &hex);
+        std::string read_memory(const std::string &arguments) const;
+        bool write_memory(const std::string &arguments);
+        bool change_breakpoint(const std::string &arguments, bool insert);
+
+        static std::string stop_reply(const ExecutionResult &result);
+
+        /// reads the next packet, skipping acknowledgements; the interrupt byte is returned as a packet of its own
+        std::optional<std::string> receive_packet();
+        bool send_packet(const std::string &data);
+        bool send_raw(const std::string &data);
+        /// @return the next byte from the connection, nullopt when it is closed or no data arrives in time
+        std::optional<char> receive_byte(std::optional<int> timeoutMilliseconds = std::nullopt);
+
+        MOS6502 &m_cpu;
+
+        std::thread m_cpuThread;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        Command m_command = Command::NONE;
+        bool m_running = false;
+        /// a target which has not run yet is reported as stopped by a trap, as a debugger expects after attaching
+        ExecutionResult m_lastResult = MOS6502::StopOnBreak{};
+
+        bool m_acknowledge = true;
+
+        using Socket = intptr_t;
+        static constexpr Socket INVALID = -1;
+        Socket m_listener = INVALID;
+        Socket m_connection = INVALID;
+        /// bytes received while the CPU was running, read before the connection
+        std::deque<char> m_received;
+        std::string m_unixPath;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_GDBSERVER_HPP
@@ -2,18 +2,22 @@
 // Created by Mikhail on 28/08/2023.
 //
 
+#include <algorithm>
+#include <array>
 #include <bitset>
 #include <utility>
 #include <format>
 
 #include "MOS6502.hpp"
+#include "OpcodeTable.hpp"
 
 
 
 namespace Emulator {
 
 
-    void MOS6502::set_register(Register reg, Byte value) {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::set_register(Register reg, Byte value) {
         switch (reg) {
             case Register::AC:
                 AC = value;
@@ -44,7 +48,8 @@ namespace Emulator {
     }
 
 
-    std::string MOS6502::dump(bool include_memory) const {
+    template<CycleAccounting accounting, Variant variant>
+    std::string BasicMOS6502<accounting, variant>::dump(bool include_memory) const {
         auto result = std::vformat("Registers: AC = {:d}, X = {:d}, Y = {:d}\n", std::make_format_args(AC, X, Y));
         result += std::vformat("Program counter = {:#04x}, Stack pointer = {:#02x}\n", std::make_format_args(PC, SP));
         result += std::vformat("Flags: {}\n", std::make_format_args(SR.to_string()));
@@ -70,7 +75,8 @@ namespace Emulator {
     }
 
 
-    Byte MOS6502::get_register(Emulator::Register reg) const {
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::get_register(Emulator::Register reg) const {
         switch (reg) {
             case Register::AC:
                 return AC;
@@ -89,26 +95,45 @@ namespace Emulator {
 
 
 
-    void MOS6502::push_byte_to_stack(Byte value) {
-        cycle++;
-        memory.stack(SP--) = value;
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::push_byte_to_stack(Byte value) {
+        tick();
+        metrics.stackPushes.add();
+        const Word address = ROM::STACK_BOTTOM + SP;
+        if (breakpoints.is_write_watched(address)) watch(address, Access::WRITE);
+        writes++;
+        memory.set_stack_byte(SP--, value);
     }
 
 
-    Byte MOS6502::pull_byte_from_stack() {
-        cycle += 2;
-        return memory.stack(++SP);
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::pull_byte_from_stack() {
+        tick();
+        metrics.stackPulls.add();
+        const Word address = ROM::STACK_BOTTOM + (Byte)(SP + 1);
+        if (breakpoints.is_read_watched(address)) watch(address, Access::READ);
+        return std::as_const(memory).stack(++SP);
     }
 
 
-    void MOS6502::push_word_to_stack(Word value) {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::watch(Word address, Access access) noexcept {
+        // the first watched access of the command is reported
+        if (!watchpointHit.has_value())
+            watchpointHit = StopOnWatchpoint{.address = PC, .accessedAddress = address, .access = access};
+    }
+
+
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::push_word_to_stack(Word value) {
         WordToBytes buf(value);
         push_byte_to_stack(buf.high);
         push_byte_to_stack(buf.low);
     }
 
 
-    Word MOS6502::pull_word_from_stack() {
+    template<CycleAccounting accounting, Variant variant>
+    Word BasicMOS6502<accounting, variant>::pull_word_from_stack() {
         WordToBytes buf{};
         buf.low = pull_byte_from_stack();
         buf.high = pull_byte_from_stack();
@@ -116,15 +141,33 @@ namespace Emulator {
     }
 
 
-    void MOS6502::reset() {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::set_state(const State &state) noexcept {
+        PC = state.PC;
+        AC = state.AC;
+        X = state.X;
+        Y = state.Y;
+        SR = state.SR;
+        SP = state.SP;
+        cycle = state.cycle;
+    }
+
+
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::reset() {
         PC = fetch_word(ROM::RESET_LOCATION);
         cycle = 7;
         SR[Flag::INTERRUPT_DISABLE] = true;
     }
 
 
-    std::expected<MOS6502::SuccessfulTermination, MOS6502::ErrorTermination> MOS6502::execute() {
+    template<CycleAccounting accounting, Variant variant>
+    auto BasicMOS6502<accounting, variant>::execute() -> std::expected<SuccessfulTermination, ErrorTermination> {
         size_t commandsExecuted = 0;
+        const auto resumedFrom = std::exchange(stoppedAtBreakpoint, std::nullopt);
+        jammed = false;
+        // the memory might have been changed since the previous call
+        loopHead.reset();
         while (true) {
             Word commandAddress = PC;
 
@@ -132,50 +175,205 @@ namespace Emulator {
             if (commandsExecuted == maxNumberOfCommandsToExecute.value_or(commandsExecuted + 1))
                 return StopOnMaxReached{.address = commandAddress};
 
+            if (stopRequested.load(std::memory_order_relaxed)) [[unlikely]] {
+                stopRequested.store(false, std::memory_order_relaxed);
+                return StopOnRequest{.address = commandAddress};
+            }
+
+            if (breakpoints.is_breakpoint(commandAddress)
+                && (commandsExecuted > 0 || resumedFrom != commandAddress)
+                && breakpoints.condition_holds(commandAddress)) {
+                stoppedAtBreakpoint = commandAddress;
+                return StopOnBreakpoint{.address = commandAddress};
+            }
+
+            // read before execution, since the command may overwrite itself
+            [[maybe_unused]] const Byte opCode = accounting == CycleAccounting::INSTRUCTION ? std::as_const(memory)[commandAddress] : 0;
+
             if (auto operation = fetch_operation(); operation.has_value()) {
                 if (stopOnBRK && std::holds_alternative<BRK>(operation.value())) return StopOnBreak{.address = commandAddress};
 
+                if constexpr (accounting == CycleAccounting::INSTRUCTION) pageCrossed = false;
                 execute(operation.value());
             }
             else return std::unexpected(UnknownOperation{.address = commandAddress});
 
+            if constexpr (accounting == CycleAccounting::INSTRUCTION)
+                cycle += OPCODE_CYCLES[opCode] + (PAGE_CROSS_PENALTIES[opCode] && pageCrossed);
+
+            if (jammed) [[unlikely]] {
+                jammed = false;
+                return std::unexpected(Jammed{.address = commandAddress});
+            }
+
             commandsExecuted++;
+            metrics.instructionsRetired.add();
+            if constexpr (accounting != CycleAccounting::NONE) metrics.cycles.set(cycle);
+
+            if (watchpointHit.has_value()) {
+                auto hit = std::exchange(watchpointHit, std::nullopt).value();
+                hit.address = PC;
+                return hit;
+            }
+
+            if (PC <= commandAddress && accelerateLoops) accelerate_loop(commandAddress, commandsExecuted);
+            if (PC <= commandAddress && skipIdleLoops && maxNumberOfCommandsToExecute.has_value())
+                skip_idle_loop(commandsExecuted);
+        }
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::skip_idle_loop(size_t &commandsExecuted) noexcept {
+        const bool repeated = loopHead.has_value() && loopHead->writes == writes
+                              && loopHead->state.PC == PC && loopHead->state.AC == AC && loopHead->state.X == X
+                              && loopHead->state.Y == Y && loopHead->state.SR == SR && loopHead->state.SP == SP;
+        if (!repeated || breakpoints.any()) {
+            loopHead = LoopHead{.state = get_state(), .commandsExecuted = commandsExecuted, .writes = writes,
+                                .pageCrossings = metrics.pageCrossings.load(), .stackPulls = metrics.stackPulls.load()};
+            return;
         }
+
+        // the whole state is the same as one iteration ago, so every following iteration is the same as well
+        const size_t period = commandsExecuted - loopHead->commandsExecuted;
+        const size_t iterations = (maxNumberOfCommandsToExecute.value() - commandsExecuted) / period;
+        const size_t skippedCycles = (cycle - loopHead->state.cycle) * iterations;
+
+        cycle += skippedCycles;
+        commandsExecuted += period * iterations;
+        metrics.instructionsRetired.add(period * iterations);
+        metrics.pageCrossings.add((metrics.pageCrossings.load() - loopHead->pageCrossings) * iterations);
+        metrics.stackPulls.add((metrics.stackPulls.load() - loopHead->stackPulls) * iterations);
+        metrics.idleCyclesSkipped.add(skippedCycles);
+        if constexpr (accounting != CycleAccounting::NONE) metrics.cycles.set(cycle);
+
+        loopHead.reset();
     }
 
-    void MOS6502::set_writing_flags(Byte value) {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::accelerate_loop(Word branchAddress, size_t &commandsExecuted) noexcept {
+        const ROM &rom = memory;
+
+        // the loop ends with incrementing the index and branching back while it is not zero
+        if (rom[branchAddress] != BNE_RELATIVE) return;
+        const Byte increment = rom[branchAddress - 1];
+        if (increment != INY_IMPLICIT && increment != INX_IMPLICIT) return;
+        const bool byY = increment == INY_IMPLICIT;
+
+        // an access indexed by the index of the loop; the address is the one accessed with the index 0
+        struct Access { Byte opCode; Word address; std::optional<Byte> pointer; };
+        Word next = PC;
+        const auto access = [&](Byte indirectY, Byte absoluteY, Byte absoluteX) -> std::optional<Access> {
+            const Byte opCode = rom[next];
+            if (byY && opCode == indirectY) {
+                const Byte pointer = rom[next + 1];
+                next += 2;
+                return Access{.opCode = opCode, .address = rom.get_word(pointer), .pointer = pointer};
+            }
+            if (opCode == (byY ? absoluteY : absoluteX)) {
+                next += 3;
+                return Access{.opCode = opCode, .address = rom.get_word(next - 2), .pointer = std::nullopt};
+            }
+            return std::nullopt;
+        };
+        const auto load = access(LDA_INDIRECT_Y, LDA_ABSOLUTE_Y, LDA_ABSOLUTE_X);
+        const auto store = access(STA_INDIRECT_Y, STA_ABSOLUTE_Y, STA_ABSOLUTE_X);
+        if (!store.has_value() || next != branchAddress - 1) return;
+
+        // the branch was taken, so the index is not zero; the loop stops when it wraps or when the limit is reached
+        const Byte first = byY ? Y : X;
+        const size_t commandsPerIteration = load.has_value() ? 4 : 3;
+        size_t iterations = 0x100 - first;
+        if (maxNumberOfCommandsToExecute.has_value())
+            iterations = std::min(iterations, (maxNumberOfCommandsToExecute.value() - commandsExecuted) / commandsPerIteration);
+        if (iterations == 0 || breakpoints.any()) return;
+
+        const auto overlap = [](size_t start, size_t size, size_t otherStart, size_t otherSize) {
+            return start < otherStart + otherSize && otherStart < start + size;
+        };
+        const size_t target = store->address + first;
+        const size_t source = load.has_value() ? load->address + first : 0;
+        if (target + iterations > UINT16_MAX + 1 || source + iterations > UINT16_MAX + 1) return;
+        if (overlap(target, iterations, ROM::STACK_BOTTOM, 0x100)) return;
+        if (overlap(target, iterations, PC, branchAddress + 2 - PC)) return;
+        if (store->pointer.has_value() && overlap(target, iterations, store->pointer.value(), 2)) return;
+        if (load.has_value() && load->pointer.has_value() && overlap(target, iterations, load->pointer.value(), 2)) return;
+        // copying byte by byte forwards repeats the source instead when the target starts inside it
+        if (load.has_value() && target > source && target < source + iterations) return;
+
+        if (load.has_value()) {
+            const Byte last = rom[source + iterations - 1];
+            memory.copy(target, source, iterations);
+            AC = last;
+        }
+        else memory.fill(target, AC, iterations);
+        writes += iterations;
+
+        const Byte index = first + iterations;
+        (byY ? Y : X) = index;
+        SR[Flag::ZERO] = index == 0;
+        SR[Flag::NEGATIVE] = get_bit(index, (int)Flag::NEGATIVE);
+
+        // the number of the accesses crossing a page, whose base is at the given address
+        const auto crossings = [first, iterations](Word address) -> size_t {
+            const size_t fromIndex = 0x100 - (address & 0xFF);
+            return iterations - std::min(iterations, fromIndex > first ? fromIndex - first : 0);
+        };
+        const size_t pageCrossings = crossings(store->address) + (load.has_value() ? crossings(load->address) : 0);
+        metrics.pageCrossings.add(pageCrossings);
+
+        // the branch is taken in every iteration but the one wrapping the index
+        const Word exit = branchAddress + 2;
+        const size_t takenBranchCycles = WordToBytes(exit).high != WordToBytes(PC).high ? 2 : 1;
+        if (index == 0) PC = exit;
+        if constexpr (accounting != CycleAccounting::NONE) {
+            size_t cycles = OPCODE_CYCLES[store->opCode] + OPCODE_CYCLES[increment] + OPCODE_CYCLES[BNE_RELATIVE] + takenBranchCycles;
+            if (load.has_value()) cycles += OPCODE_CYCLES[load->opCode];
+            cycle += cycles * iterations - (index == 0 ? takenBranchCycles : 0);
+            // stores take the additional cycle regardless of crossing the page
+            if (load.has_value()) cycle += crossings(load->address);
+            metrics.cycles.set(cycle);
+        }
+
+        commandsExecuted += commandsPerIteration * iterations;
+        metrics.instructionsRetired.add(commandsPerIteration * iterations);
+        metrics.loopsAccelerated.add();
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::set_writing_flags(Byte value) {
         SR[Flag::ZERO] = value == 0;
         SR[Flag::NEGATIVE] = (char)value < 0;
     }
 
-    void MOS6502::execute(const Operation &operation) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::execute(const Operation &operation) noexcept {
         std::visit(Overload {
                 [this](ADC_Immediate op)   { add_to_accumulator(op.value); },
-                [this](ADC_ZeroPage op)    { add_to_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](ADC_ZeroPageX op)   { add_to_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE_X)); },
-                [this](ADC_Absolute op)    { add_to_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE)); },
-                [this](ADC_AbsoluteX op)   { add_to_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_X)); },
-                [this](ADC_AbsoluteY op)   { add_to_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_Y)); },
-                [this](ADC_IndirectX op)   { add_to_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_X)); },
-                [this](ADC_IndirectY op)   { add_to_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_Y)); },
+                [this](ADC_ZeroPage op)    { add_to_accumulator(fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](ADC_ZeroPageX op)   { add_to_accumulator(fetch_from<AddressingMode::ZERO_PAGE_X>(op.address)); },
+                [this](ADC_Absolute op)    { add_to_accumulator(fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](ADC_AbsoluteX op)   { add_to_accumulator(fetch_from<AddressingMode::ABSOLUTE_X>(op.address)); },
+                [this](ADC_AbsoluteY op)   { add_to_accumulator(fetch_from<AddressingMode::ABSOLUTE_Y>(op.address)); },
+                [this](ADC_IndirectX op)   { add_to_accumulator(fetch_from<AddressingMode::INDIRECT_X>(op.address)); },
+                [this](ADC_IndirectY op)   { add_to_accumulator(fetch_from<AddressingMode::INDIRECT_Y>(op.address)); },
 
                 [this](AND_Immediate op)   { and_with_accumulator(op.value); },
-                [this](AND_ZeroPage op)    { and_with_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](AND_ZeroPageX op)   { and_with_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE_X)); },
-                [this](AND_Absolute op)    { and_with_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE)); },
-                [this](AND_AbsoluteX op)   { and_with_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_X)); },
-                [this](AND_AbsoluteY op)   { and_with_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_Y)); },
-                [this](AND_IndirectX op)   { and_with_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_X)); },
-                [this](AND_IndirectY op)   { and_with_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_Y)); },
+                [this](AND_ZeroPage op)    { and_with_accumulator(fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](AND_ZeroPageX op)   { and_with_accumulator(fetch_from<AddressingMode::ZERO_PAGE_X>(op.address)); },
+                [this](AND_Absolute op)    { and_with_accumulator(fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](AND_AbsoluteX op)   { and_with_accumulator(fetch_from<AddressingMode::ABSOLUTE_X>(op.address)); },
+                [this](AND_AbsoluteY op)   { and_with_accumulator(fetch_from<AddressingMode::ABSOLUTE_Y>(op.address)); },
+                [this](AND_IndirectX op)   { and_with_accumulator(fetch_from<AddressingMode::INDIRECT_X>(op.address)); },
+                [this](AND_IndirectY op)   { and_with_accumulator(fetch_from<AddressingMode::INDIRECT_Y>(op.address)); },
 
                 [this](ASL_Accumulator op) { set_register(Register::AC, shift_left(AC)); },
-                [this](ASL_ZeroPage op)    { perform_at(op.address, AddressingMode::ZERO_PAGE, &MOS6502::shift_left); },
-                [this](ASL_ZeroPageX op)   { perform_at(op.address, AddressingMode::ZERO_PAGE_X, &MOS6502::shift_left); },
-                [this](ASL_Absolute op)    { perform_at(op.address, AddressingMode::ABSOLUTE, &MOS6502::shift_left); },
+                [this](ASL_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::shift_left>(op.address); },
+                [this](ASL_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::shift_left>(op.address); },
+                [this](ASL_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::shift_left>(op.address); },
                 [this](ASL_AbsoluteX op)   {
-                    perform_at(op.address, AddressingMode::ABSOLUTE_X, &MOS6502::shift_left);
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::shift_left>(op.address);
                     // this instruction takes an additional cycle even when the page is not crossed
-                    if (!pageCrossed) cycle++;
+                    if (!pageCrossed) tick();
                     },
 
                 [this](BCS op)             { if (SR[Flag::CARRY]) branch(op.offset); },
@@ -187,222 +385,431 @@ namespace Emulator {
                 [this](BVS op)             { if (SR[Flag::OVERFLOW_F]) branch(op.offset); },
                 [this](BVC op)             { if (!SR[Flag::OVERFLOW_F]) branch(op.offset); },
 
-                [this](BIT_ZeroPage op)    { bit_test(fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](BIT_Absolute op)    { bit_test(fetch_from(op.address, AddressingMode::ABSOLUTE)); },
+                [this](BIT_ZeroPage op)    { bit_test(fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](BIT_Absolute op)    { bit_test(fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
 
                 [this](BRK op) {
-                    // for some reason, the byte right next to the BRK command must be skipped
+                    // for some reason, the byte right next to the BRK command must be skipped; it is still read
+                    tick();
                     push_word_to_stack(PC + 1);
+                    push_byte_to_stack(SR.pushed());
                     PC = fetch_word(ROM::BRK_HANDLER);
                     SR[Flag::BREAK] = SET;
-                    cycle++;
+                    SR[Flag::INTERRUPT_DISABLE] = SET;
+                    // the CMOS processor also leaves the decimal mode when entering the handler
+                    if constexpr (variant == Variant::CMOS) SR[Flag::DECIMAL] = CLEAR;
                 },
 
-                [this](CLC op)             { SR[Flag::CARRY] = CLEAR; cycle++; },
-                [this](CLD op)             { SR[Flag::DECIMAL] = CLEAR; cycle++; },
-                [this](CLI op)             { SR[Flag::INTERRUPT_DISABLE] = CLEAR; cycle++; },
-                [this](CLV op)             { SR[Flag::OVERFLOW_F] = CLEAR; cycle++; },
+                [this](CLC op)             { SR[Flag::CARRY] = CLEAR; tick(); },
+                [this](CLD op)             { SR[Flag::DECIMAL] = CLEAR; tick(); },
+                [this](CLI op)             { SR[Flag::INTERRUPT_DISABLE] = CLEAR; tick(); },
+                [this](CLV op)             { SR[Flag::OVERFLOW_F] = CLEAR; tick(); },
 
                 [this](CMP_Immediate op)   { compare(AC, op.value); },
-                [this](CMP_ZeroPage op)    { compare(AC, fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](CMP_ZeroPageX op)   { compare(AC, fetch_from(op.address, AddressingMode::ZERO_PAGE_X)); },
-                [this](CMP_Absolute op)    { compare(AC, fetch_from(op.address, AddressingMode::ABSOLUTE)); },
-                [this](CMP_AbsoluteX op)   { compare(AC, fetch_from(op.address, AddressingMode::ABSOLUTE_X)); },
-                [this](CMP_AbsoluteY op)   { compare(AC, fetch_from(op.address, AddressingMode::ABSOLUTE_Y)); },
-                [this](CMP_IndirectX op)   { compare(AC, fetch_from(op.address, AddressingMode::INDIRECT_X)); },
-                [this](CMP_IndirectY op)   { compare(AC, fetch_from(op.address, AddressingMode::INDIRECT_Y)); },
+                [this](CMP_ZeroPage op)    { compare(AC, fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](CMP_ZeroPageX op)   { compare(AC, fetch_from<AddressingMode::ZERO_PAGE_X>(op.address)); },
+                [this](CMP_Absolute op)    { compare(AC, fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](CMP_AbsoluteX op)   { compare(AC, fetch_from<AddressingMode::ABSOLUTE_X>(op.address)); },
+                [this](CMP_AbsoluteY op)   { compare(AC, fetch_from<AddressingMode::ABSOLUTE_Y>(op.address)); },
+                [this](CMP_IndirectX op)   { compare(AC, fetch_from<AddressingMode::INDIRECT_X>(op.address)); },
+                [this](CMP_IndirectY op)   { compare(AC, fetch_from<AddressingMode::INDIRECT_Y>(op.address)); },
 
                 [this](CPX_Immediate op)   { compare(X, op.value); },
-                [this](CPX_ZeroPage op)    { compare(X, fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](CPX_Absolute op)    { compare(X, fetch_from(op.address, AddressingMode::ABSOLUTE)); },
+                [this](CPX_ZeroPage op)    { compare(X, fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](CPX_Absolute op)    { compare(X, fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
 
                 [this](CPY_Immediate op)   { compare(Y, op.value); },
-                [this](CPY_ZeroPage op)    { compare(Y, fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](CPY_Absolute op)    { compare(Y, fetch_from(op.address, AddressingMode::ABSOLUTE)); },
+                [this](CPY_ZeroPage op)    { compare(Y, fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](CPY_Absolute op)    { compare(Y, fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
 
-                [this](DEC_ZeroPage op)    { perform_at(op.address, AddressingMode::ZERO_PAGE, &MOS6502::decrement); },
-                [this](DEC_ZeroPageX op)   { perform_at(op.address, AddressingMode::ZERO_PAGE_X, &MOS6502::decrement); },
-                [this](DEC_Absolute op)    { perform_at(op.address, AddressingMode::ABSOLUTE, &MOS6502::decrement); },
+                [this](DEC_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::decrement>(op.address); },
+                [this](DEC_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::decrement>(op.address); },
+                [this](DEC_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::decrement>(op.address); },
                 [this](DEC_AbsoluteX op)   {
-                    perform_at(op.address, AddressingMode::ABSOLUTE_X, &MOS6502::decrement);
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::decrement>(op.address);
                     // this instruction takes an additional cycle even when the page is not crossed
-                    if (!pageCrossed) cycle++;
+                    if (!pageCrossed) tick();
                     },
 
-                [this](DEX op)             { set_register(Register::X, X - 1); cycle++; },
-                [this](DEY op)             { set_register(Register::Y, Y - 1); cycle++; },
+                [this](DEX op)             { set_register(Register::X, X - 1); tick(); },
+                [this](DEY op)             { set_register(Register::Y, Y - 1); tick(); },
 
                 [this](EOR_Immediate op)   { xor_with_accumulator(op.value); },
-                [this](EOR_ZeroPage op)    { xor_with_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](EOR_ZeroPageX op)   { xor_with_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE_X)); },
-                [this](EOR_Absolute op)    { xor_with_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE)); },
-                [this](EOR_AbsoluteX op)   { xor_with_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_X)); },
-                [this](EOR_AbsoluteY op)   { xor_with_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_Y)); },
-                [this](EOR_IndirectX op)   { xor_with_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_X)); },
-                [this](EOR_IndirectY op)   { xor_with_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_Y)); },
-
-                [this](INC_ZeroPage op)    { perform_at(op.address, AddressingMode::ZERO_PAGE, &MOS6502::increment); },
-                [this](INC_ZeroPageX op)   { perform_at(op.address, AddressingMode::ZERO_PAGE_X, &MOS6502::increment); },
-                [this](INC_Absolute op)    { perform_at(op.address, AddressingMode::ABSOLUTE, &MOS6502::increment); },
+                [this](EOR_ZeroPage op)    { xor_with_accumulator(fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](EOR_ZeroPageX op)   { xor_with_accumulator(fetch_from<AddressingMode::ZERO_PAGE_X>(op.address)); },
+                [this](EOR_Absolute op)    { xor_with_accumulator(fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](EOR_AbsoluteX op)   { xor_with_accumulator(fetch_from<AddressingMode::ABSOLUTE_X>(op.address)); },
+                [this](EOR_AbsoluteY op)   { xor_with_accumulator(fetch_from<AddressingMode::ABSOLUTE_Y>(op.address)); },
+                [this](EOR_IndirectX op)   { xor_with_accumulator(fetch_from<AddressingMode::INDIRECT_X>(op.address)); },
+                [this](EOR_IndirectY op)   { xor_with_accumulator(fetch_from<AddressingMode::INDIRECT_Y>(op.address)); },
+
+                [this](INC_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::increment>(op.address); },
+                [this](INC_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::increment>(op.address); },
+                [this](INC_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::increment>(op.address); },
                 [this](INC_AbsoluteX op)   {
-                    perform_at(op.address, AddressingMode::ABSOLUTE_X, &MOS6502::increment);
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::increment>(op.address);
                     // this instruction takes an additional cycle even when the page is not crossed
-                    if (!pageCrossed) cycle++;
+                    if (!pageCrossed) tick();
                 },
 
-                [this](INX op)             { set_register(Register::X, X + 1); cycle++; },
-                [this](INY op)             { set_register(Register::Y, Y + 1); cycle++; },
+                [this](INX op)             { set_register(Register::X, X + 1); tick(); },
+                [this](INY op)             { set_register(Register::Y, Y + 1); tick(); },
 
                 [this](JMP_Absolute op)    { PC = op.address; },
-                [this](JMP_Indirect op)    { PC = fetch_word(op.address); },
+                [this](JMP_Indirect op)    {
+                    if constexpr (variant == Variant::NMOS) {
+                        // the high byte of the target is read from the same page as the low one, even when the pointer is at its end
+                        const WordToBytes pointer(op.address);
+                        WordToBytes target;
+                        target.low = read_byte(op.address);
+                        target.high = read_byte((Word)(pointer.high << 8 | (Byte)(pointer.low + 1)));
+                        PC = target.word;
+                    }
+                    else {
+                        PC = fetch_word(op.address);
+                        tick();
+                        penalty();
+                    }
+                },
 
                 [this](JSR op) {
                     push_word_to_stack(PC - 1);
                     PC = op.address;
-                    cycle++;
+                    tick();
                 },
 
                 [this](LDA_Immediate op)   { set_register(Register::AC, op.value); },
-                [this](LDA_ZeroPage op)    { set_register(Register::AC, fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](LDA_ZeroPageX op)   { set_register(Register::AC, fetch_from(op.address, AddressingMode::ZERO_PAGE_X)); },
-                [this](LDA_Absolute op)    { set_register(Register::AC, fetch_from(op.address, AddressingMode::ABSOLUTE)); },
-                [this](LDA_AbsoluteX op)   { set_register(Register::AC, fetch_from(op.address, AddressingMode::ABSOLUTE_X)); },
-                [this](LDA_AbsoluteY op)   { set_register(Register::AC, fetch_from(op.address, AddressingMode::ABSOLUTE_Y)); },
-                [this](LDA_IndirectX op)   { set_register(Register::AC, fetch_from(op.address, AddressingMode::INDIRECT_X)); },
-                [this](LDA_IndirectY op)   { set_register(Register::AC, fetch_from(op.address, AddressingMode::INDIRECT_Y)); },
+                [this](LDA_ZeroPage op)    { set_register(Register::AC, fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](LDA_ZeroPageX op)   { set_register(Register::AC, fetch_from<AddressingMode::ZERO_PAGE_X>(op.address)); },
+                [this](LDA_Absolute op)    { set_register(Register::AC, fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](LDA_AbsoluteX op)   { set_register(Register::AC, fetch_from<AddressingMode::ABSOLUTE_X>(op.address)); },
+                [this](LDA_AbsoluteY op)   { set_register(Register::AC, fetch_from<AddressingMode::ABSOLUTE_Y>(op.address)); },
+                [this](LDA_IndirectX op)   { set_register(Register::AC, fetch_from<AddressingMode::INDIRECT_X>(op.address)); },
+                [this](LDA_IndirectY op)   { set_register(Register::AC, fetch_from<AddressingMode::INDIRECT_Y>(op.address)); },
 
                 [this](LDX_Immediate op)   { set_register(Register::X, op.value); },
-                [this](LDX_ZeroPage op)    { set_register(Register::X, fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](LDX_ZeroPageY op)   { set_register(Register::X, fetch_from(op.address, AddressingMode::ZERO_PAGE_Y)); },
-                [this](LDX_Absolute op)    { set_register(Register::X, fetch_from(op.address, AddressingMode::ABSOLUTE)); },
-                [this](LDX_AbsoluteY op)   { set_register(Register::X, fetch_from(op.address, AddressingMode::ABSOLUTE_Y)); },
+                [this](LDX_ZeroPage op)    { set_register(Register::X, fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](LDX_ZeroPageY op)   { set_register(Register::X, fetch_from<AddressingMode::ZERO_PAGE_Y>(op.address)); },
+                [this](LDX_Absolute op)    { set_register(Register::X, fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](LDX_AbsoluteY op)   { set_register(Register::X, fetch_from<AddressingMode::ABSOLUTE_Y>(op.address)); },
 
                 [this](LDY_Immediate op)   { set_register(Register::Y, op.value); },
-                [this](LDY_ZeroPage op)    { set_register(Register::Y, fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](LDY_ZeroPageX op)   { set_register(Register::Y, fetch_from(op.address, AddressingMode::ZERO_PAGE_X)); },
-                [this](LDY_Absolute op)    { set_register(Register::Y, fetch_from(op.address, AddressingMode::ABSOLUTE)); },
-                [this](LDY_AbsoluteX op)   { set_register(Register::Y, fetch_from(op.address, AddressingMode::ABSOLUTE_X)); },
+                [this](LDY_ZeroPage op)    { set_register(Register::Y, fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](LDY_ZeroPageX op)   { set_register(Register::Y, fetch_from<AddressingMode::ZERO_PAGE_X>(op.address)); },
+                [this](LDY_Absolute op)    { set_register(Register::Y, fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](LDY_AbsoluteX op)   { set_register(Register::Y, fetch_from<AddressingMode::ABSOLUTE_X>(op.address)); },
 
                 [this](LSR_Accumulator op) { set_register(Register::AC, shift_right(AC)); },
-                [this](LSR_ZeroPage op)    { perform_at(op.address, AddressingMode::ZERO_PAGE, &MOS6502::shift_right); },
-                [this](LSR_ZeroPageX op)   { perform_at(op.address, AddressingMode::ZERO_PAGE_X, &MOS6502::shift_right); },
-                [this](LSR_Absolute op)    { perform_at(op.address, AddressingMode::ABSOLUTE, &MOS6502::shift_right); },
+                [this](LSR_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::shift_right>(op.address); },
+                [this](LSR_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::shift_right>(op.address); },
+                [this](LSR_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::shift_right>(op.address); },
                 [this](LSR_AbsoluteX op)   {
-                    perform_at(op.address, AddressingMode::ABSOLUTE_X, &MOS6502::shift_right);
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::shift_right>(op.address);
                     // this instruction takes an additional cycle even when the page is not crossed
-                    if (!pageCrossed) cycle++;
+                    if (!pageCrossed) tick();
                     },
 
-                [this](NOP op)             { cycle++; },
+                [this](NOP op)             { tick(); },
 
                 [this](ORA_Immediate op)   { or_with_accumulator(op.value); },
-                [this](ORA_ZeroPage op)    { or_with_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](ORA_ZeroPageX op)   { or_with_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE_X)); },
-                [this](ORA_Absolute op)    { or_with_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE)); },
-                [this](ORA_AbsoluteX op)   { or_with_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_X)); },
-                [this](ORA_AbsoluteY op)   { or_with_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_Y)); },
-                [this](ORA_IndirectX op)   { or_with_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_X)); },
-                [this](ORA_IndirectY op)   { or_with_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_Y)); },
+                [this](ORA_ZeroPage op)    { or_with_accumulator(fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](ORA_ZeroPageX op)   { or_with_accumulator(fetch_from<AddressingMode::ZERO_PAGE_X>(op.address)); },
+                [this](ORA_Absolute op)    { or_with_accumulator(fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](ORA_AbsoluteX op)   { or_with_accumulator(fetch_from<AddressingMode::ABSOLUTE_X>(op.address)); },
+                [this](ORA_AbsoluteY op)   { or_with_accumulator(fetch_from<AddressingMode::ABSOLUTE_Y>(op.address)); },
+                [this](ORA_IndirectX op)   { or_with_accumulator(fetch_from<AddressingMode::INDIRECT_X>(op.address)); },
+                [this](ORA_IndirectY op)   { or_with_accumulator(fetch_from<AddressingMode::INDIRECT_Y>(op.address)); },
 
-                [this](PHA op)             { push_byte_to_stack(AC); cycle++; },
-                [this](PHP op)             { push_byte_to_stack(SR.to_byte()); cycle++; },
+                [this](PHA op)             { push_byte_to_stack(AC); tick(); },
+                [this](PHP op)             { push_byte_to_stack(SR.pushed()); tick(); },
 
-                [this](PLA op)             { set_register(Register::AC, pull_byte_from_stack()); cycle++; },
-                [this](PLP op)             { set_register(Register::SR, pull_byte_from_stack()); cycle++; },
+                [this](PLA op)             { tick(2); set_register(Register::AC, pull_byte_from_stack()); },
+                [this](PLP op)             { tick(2); set_register(Register::SR, pull_byte_from_stack()); },
 
                 [this](ROL_Accumulator op) { set_register(Register::AC, rotate_left(AC)); },
-                [this](ROL_ZeroPage op)    { perform_at(op.address, AddressingMode::ZERO_PAGE, &MOS6502::rotate_left); },
-                [this](ROL_ZeroPageX op)   { perform_at(op.address, AddressingMode::ZERO_PAGE_X, &MOS6502::rotate_left); },
-                [this](ROL_Absolute op)    { perform_at(op.address, AddressingMode::ABSOLUTE, &MOS6502::rotate_left); },
+                [this](ROL_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::rotate_left>(op.address); },
+                [this](ROL_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::rotate_left>(op.address); },
+                [this](ROL_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::rotate_left>(op.address); },
                 [this](ROL_AbsoluteX op)   {
-                    perform_at(op.address, AddressingMode::ABSOLUTE_X, &MOS6502::rotate_left);
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::rotate_left>(op.address);
                     // this instruction takes an additional cycle even when the page is not crossed
-                    if (!pageCrossed) cycle++;
+                    if (!pageCrossed) tick();
                     },
 
                 [this](ROR_Accumulator op) { set_register(Register::AC, rotate_right(AC)); },
-                [this](ROR_ZeroPage op)    { perform_at(op.address, AddressingMode::ZERO_PAGE, &MOS6502::rotate_right); },
-                [this](ROR_ZeroPageX op)   { perform_at(op.address, AddressingMode::ZERO_PAGE_X, &MOS6502::rotate_right); },
-                [this](ROR_Absolute op)    { perform_at(op.address, AddressingMode::ABSOLUTE, &MOS6502::rotate_right); },
+                [this](ROR_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::rotate_right>(op.address); },
+                [this](ROR_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::rotate_right>(op.address); },
+                [this](ROR_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::rotate_right>(op.address); },
                 [this](ROR_AbsoluteX op)   {
-                    perform_at(op.address, AddressingMode::ABSOLUTE_X, &MOS6502::rotate_right);
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::rotate_right>(op.address);
                     // this instruction takes an additional cycle even when the page is not crossed
-                    if (!pageCrossed) cycle++;
+                    if (!pageCrossed) tick();
                     },
 
                 [this](RTI op) {
+                    tick(2);
                     SR = pull_byte_from_stack();
                     PC = pull_word_from_stack();
-                    cycle--;
                 },
 
-                [this](RTS op)             { PC = pull_word_from_stack() + 1; cycle++; },
+                [this](RTS op)             { tick(2); PC = pull_word_from_stack() + 1; tick(); },
 
                 [this](SBC_Immediate op)   { subtract_from_accumulator(op.value); },
-                [this](SBC_ZeroPage op)    { subtract_from_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE)); },
-                [this](SBC_ZeroPageX op)   { subtract_from_accumulator(fetch_from(op.address, AddressingMode::ZERO_PAGE_X)); },
-                [this](SBC_Absolute op)    { subtract_from_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE)); },
-                [this](SBC_AbsoluteX op)   { subtract_from_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_X)); },
-                [this](SBC_AbsoluteY op)   { subtract_from_accumulator(fetch_from(op.address, AddressingMode::ABSOLUTE_Y)); },
-                [this](SBC_IndirectX op)   { subtract_from_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_X)); },
-                [this](SBC_IndirectY op)   { subtract_from_accumulator(fetch_from(op.address, AddressingMode::INDIRECT_Y)); },
-
-                [this](SEC op)             { SR[Flag::CARRY] = SET; },
-                [this](SED op)             { SR[Flag::DECIMAL] = SET; },
-                [this](SEI op)             { SR[Flag::INTERRUPT_DISABLE] = SET; },
-
-                [this](STA_ZeroPage op)    { write_to(op.address, AddressingMode::ZERO_PAGE, AC); },
-                [this](STA_ZeroPageX op)   { write_to(op.address, AddressingMode::ZERO_PAGE_X, AC); },
-                [this](STA_Absolute op)    { write_to(op.address, AddressingMode::ABSOLUTE, AC); },
+                [this](SBC_ZeroPage op)    { subtract_from_accumulator(fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](SBC_ZeroPageX op)   { subtract_from_accumulator(fetch_from<AddressingMode::ZERO_PAGE_X>(op.address)); },
+                [this](SBC_Absolute op)    { subtract_from_accumulator(fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](SBC_AbsoluteX op)   { subtract_from_accumulator(fetch_from<AddressingMode::ABSOLUTE_X>(op.address)); },
+                [this](SBC_AbsoluteY op)   { subtract_from_accumulator(fetch_from<AddressingMode::ABSOLUTE_Y>(op.address)); },
+                [this](SBC_IndirectX op)   { subtract_from_accumulator(fetch_from<AddressingMode::INDIRECT_X>(op.address)); },
+                [this](SBC_IndirectY op)   { subtract_from_accumulator(fetch_from<AddressingMode::INDIRECT_Y>(op.address)); },
+
+                [this](SEC op)             { SR[Flag::CARRY] = SET; tick(); },
+                [this](SED op)             { SR[Flag::DECIMAL] = SET; tick(); },
+                [this](SEI op)             { SR[Flag::INTERRUPT_DISABLE] = SET; tick(); },
+
+                [this](STA_ZeroPage op)    { write_to<AddressingMode::ZERO_PAGE>(op.address, AC); },
+                [this](STA_ZeroPageX op)   { write_to<AddressingMode::ZERO_PAGE_X>(op.address, AC); },
+                [this](STA_Absolute op)    { write_to<AddressingMode::ABSOLUTE>(op.address, AC); },
                 [this](STA_AbsoluteX op)   {
-                    write_to(op.address, AddressingMode::ABSOLUTE_X, AC);
+                    write_to<AddressingMode::ABSOLUTE_X>(op.address, AC);
                     // this instruction takes an additional cycle even when the page is not crossed
-                    if (!pageCrossed) cycle++;
+                    if (!pageCrossed) tick();
                     },
                 [this](STA_AbsoluteY op)   {
-                    write_to(op.address, AddressingMode::ABSOLUTE_Y, AC);
+                    write_to<AddressingMode::ABSOLUTE_Y>(op.address, AC);
                     // this instruction takes an additional cycle even when the page is not crossed
-                    if (!pageCrossed) cycle++;
+                    if (!pageCrossed) tick();
                     },
-                [this](STA_IndirectX op)   { write_to(op.address, AddressingMode::INDIRECT_X, AC); },
+                [this](STA_IndirectX op)   { write_to<AddressingMode::INDIRECT_X>(op.address, AC); },
                 [this](STA_IndirectY op)   {
-                    write_to(op.address, AddressingMode::INDIRECT_Y, AC);
+                    write_to<AddressingMode::INDIRECT_Y>(op.address, AC);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+
+                [this](STX_ZeroPage op)    { write_to<AddressingMode::ZERO_PAGE>(op.address, X); },
+                [this](STX_ZeroPageY op)   { write_to<AddressingMode::ZERO_PAGE_Y>(op.address, X); },
+                [this](STX_Absolute op)    { write_to<AddressingMode::ABSOLUTE>(op.address, X); },
+
+                [this](STY_ZeroPage op)    { write_to<AddressingMode::ZERO_PAGE>(op.address, Y); },
+                [this](STY_ZeroPageX op)   { write_to<AddressingMode::ZERO_PAGE_X>(op.address, Y); },
+                [this](STY_Absolute op)    { write_to<AddressingMode::ABSOLUTE>(op.address, Y); },
+
+                [this](TAX op) { set_register(Register::X, AC); tick(); },
+                [this](TAY op) { set_register(Register::Y, AC); tick(); },
+                [this](TSX op) { set_register(Register::X, SP); tick(); },
+                [this](TXA op) { set_register(Register::AC, X); tick(); },
+                [this](TXS op) { set_register(Register::SP, X); tick(); },
+                [this](TYA op) { set_register(Register::AC, Y); tick(); },
+
+                [this](SLO_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::shift_left_then_or>(op.address); },
+                [this](SLO_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::shift_left_then_or>(op.address); },
+                [this](SLO_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::shift_left_then_or>(op.address); },
+                [this](SLO_AbsoluteX op)   {
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::shift_left_then_or>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](SLO_AbsoluteY op)   {
+                    perform_at<AddressingMode::ABSOLUTE_Y, &BasicMOS6502::shift_left_then_or>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](SLO_IndirectX op)   { perform_at<AddressingMode::INDIRECT_X, &BasicMOS6502::shift_left_then_or>(op.address); },
+                [this](SLO_IndirectY op)   {
+                    perform_at<AddressingMode::INDIRECT_Y, &BasicMOS6502::shift_left_then_or>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+
+                [this](RLA_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::rotate_left_then_and>(op.address); },
+                [this](RLA_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::rotate_left_then_and>(op.address); },
+                [this](RLA_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::rotate_left_then_and>(op.address); },
+                [this](RLA_AbsoluteX op)   {
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::rotate_left_then_and>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](RLA_AbsoluteY op)   {
+                    perform_at<AddressingMode::ABSOLUTE_Y, &BasicMOS6502::rotate_left_then_and>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](RLA_IndirectX op)   { perform_at<AddressingMode::INDIRECT_X, &BasicMOS6502::rotate_left_then_and>(op.address); },
+                [this](RLA_IndirectY op)   {
+                    perform_at<AddressingMode::INDIRECT_Y, &BasicMOS6502::rotate_left_then_and>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+
+                [this](SRE_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::shift_right_then_xor>(op.address); },
+                [this](SRE_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::shift_right_then_xor>(op.address); },
+                [this](SRE_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::shift_right_then_xor>(op.address); },
+                [this](SRE_AbsoluteX op)   {
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::shift_right_then_xor>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](SRE_AbsoluteY op)   {
+                    perform_at<AddressingMode::ABSOLUTE_Y, &BasicMOS6502::shift_right_then_xor>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](SRE_IndirectX op)   { perform_at<AddressingMode::INDIRECT_X, &BasicMOS6502::shift_right_then_xor>(op.address); },
+                [this](SRE_IndirectY op)   {
+                    perform_at<AddressingMode::INDIRECT_Y, &BasicMOS6502::shift_right_then_xor>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+
+                [this](RRA_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::rotate_right_then_add>(op.address); },
+                [this](RRA_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::rotate_right_then_add>(op.address); },
+                [this](RRA_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::rotate_right_then_add>(op.address); },
+                [this](RRA_AbsoluteX op)   {
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::rotate_right_then_add>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](RRA_AbsoluteY op)   {
+                    perform_at<AddressingMode::ABSOLUTE_Y, &BasicMOS6502::rotate_right_then_add>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](RRA_IndirectX op)   { perform_at<AddressingMode::INDIRECT_X, &BasicMOS6502::rotate_right_then_add>(op.address); },
+                [this](RRA_IndirectY op)   {
+                    perform_at<AddressingMode::INDIRECT_Y, &BasicMOS6502::rotate_right_then_add>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+
+                [this](DCP_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::decrement_then_compare>(op.address); },
+                [this](DCP_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::decrement_then_compare>(op.address); },
+                [this](DCP_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::decrement_then_compare>(op.address); },
+                [this](DCP_AbsoluteX op)   {
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::decrement_then_compare>(op.address);
                     // this instruction takes an additional cycle even when the page is not crossed
-                    if (!pageCrossed) cycle++;
+                    if (!pageCrossed) tick();
+                    },
+                [this](DCP_AbsoluteY op)   {
+                    perform_at<AddressingMode::ABSOLUTE_Y, &BasicMOS6502::decrement_then_compare>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](DCP_IndirectX op)   { perform_at<AddressingMode::INDIRECT_X, &BasicMOS6502::decrement_then_compare>(op.address); },
+                [this](DCP_IndirectY op)   {
+                    perform_at<AddressingMode::INDIRECT_Y, &BasicMOS6502::decrement_then_compare>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
                     },
 
-                [this](STX_ZeroPage op)    { write_to(op.address, AddressingMode::ZERO_PAGE, X); },
-                [this](STX_ZeroPageY op)   { write_to(op.address, AddressingMode::ZERO_PAGE_Y, X); },
-                [this](STX_Absolute op)    { write_to(op.address, AddressingMode::ABSOLUTE, X); },
+                [this](ISC_ZeroPage op)    { perform_at<AddressingMode::ZERO_PAGE, &BasicMOS6502::increment_then_subtract>(op.address); },
+                [this](ISC_ZeroPageX op)   { perform_at<AddressingMode::ZERO_PAGE_X, &BasicMOS6502::increment_then_subtract>(op.address); },
+                [this](ISC_Absolute op)    { perform_at<AddressingMode::ABSOLUTE, &BasicMOS6502::increment_then_subtract>(op.address); },
+                [this](ISC_AbsoluteX op)   {
+                    perform_at<AddressingMode::ABSOLUTE_X, &BasicMOS6502::increment_then_subtract>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](ISC_AbsoluteY op)   {
+                    perform_at<AddressingMode::ABSOLUTE_Y, &BasicMOS6502::increment_then_subtract>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
+                [this](ISC_IndirectX op)   { perform_at<AddressingMode::INDIRECT_X, &BasicMOS6502::increment_then_subtract>(op.address); },
+                [this](ISC_IndirectY op)   {
+                    perform_at<AddressingMode::INDIRECT_Y, &BasicMOS6502::increment_then_subtract>(op.address);
+                    // this instruction takes an additional cycle even when the page is not crossed
+                    if (!pageCrossed) tick();
+                    },
 
-                [this](STY_ZeroPage op)    { write_to(op.address, AddressingMode::ZERO_PAGE, Y); },
-                [this](STY_ZeroPageX op)   { write_to(op.address, AddressingMode::ZERO_PAGE_X, Y); },
-                [this](STY_Absolute op)    { write_to(op.address, AddressingMode::ABSOLUTE, Y); },
+                [this](SAX_ZeroPage op)  { write_to<AddressingMode::ZERO_PAGE>(op.address, AC & X); },
+                [this](SAX_ZeroPageY op) { write_to<AddressingMode::ZERO_PAGE_Y>(op.address, AC & X); },
+                [this](SAX_Absolute op)  { write_to<AddressingMode::ABSOLUTE>(op.address, AC & X); },
+                [this](SAX_IndirectX op) { write_to<AddressingMode::INDIRECT_X>(op.address, AC & X); },
+
+                [this](LAX_ZeroPage op)  { load_accumulator_and_x(fetch_from<AddressingMode::ZERO_PAGE>(op.address)); },
+                [this](LAX_ZeroPageY op) { load_accumulator_and_x(fetch_from<AddressingMode::ZERO_PAGE_Y>(op.address)); },
+                [this](LAX_Absolute op)  { load_accumulator_and_x(fetch_from<AddressingMode::ABSOLUTE>(op.address)); },
+                [this](LAX_AbsoluteY op) { load_accumulator_and_x(fetch_from<AddressingMode::ABSOLUTE_Y>(op.address)); },
+                [this](LAX_IndirectX op) { load_accumulator_and_x(fetch_from<AddressingMode::INDIRECT_X>(op.address)); },
+                [this](LAX_IndirectY op) { load_accumulator_and_x(fetch_from<AddressingMode::INDIRECT_Y>(op.address)); },
+
+                [this]<OpCode code>(ANC_Immediate<code> op) {
+                    and_with_accumulator(op.value);
+                    SR[Flag::CARRY] = SR[Flag::NEGATIVE];
+                },
+                [this](ALR_Immediate op) {
+                    const Byte value = AC & op.value;
+                    SR[Flag::CARRY] = get_bit(value, 0);
+                    set_register(Register::AC, value >> 1);
+                },
+                [this](ARR_Immediate op) {
+                    Byte result = (AC & op.value) >> 1;
+                    set_bit(result, 7, SR[Flag::CARRY]);
+                    set_register(Register::AC, result);
+                    // the flags come from the adder, which this command uses for the rotation
+                    SR[Flag::CARRY] = get_bit(result, 6);
+                    SR[Flag::OVERFLOW_F] = get_bit(result, 6) != get_bit(result, 5);
+                },
+                [this](ANE_Immediate op)   { set_register(Register::AC, (AC | UNSTABLE_MAGIC) & X & op.value); },
+                [this](LXA_Immediate op)   { load_accumulator_and_x((AC | UNSTABLE_MAGIC) & op.value); },
+                [this](SBX_Immediate op)   {
+                    const Byte value = AC & X;
+                    SR[Flag::CARRY] = value >= op.value;
+                    set_register(Register::X, value - op.value);
+                },
+                [this](USBC_Immediate op)  { subtract_from_accumulator(op.value); },
 
-                [this](TAX op) { set_register(Register::X, AC); cycle++; },
-                [this](TAY op) { set_register(Register::Y, AC); cycle++; },
-                [this](TSX op) { set_register(Register::X, SP); cycle++; },
-                [this](TXA op) { set_register(Register::AC, X); cycle++; },
-                [this](TXS op) { set_register(Register::SP, X); cycle++; },
-                [this](TYA op) { set_register(Register::AC, Y); cycle++; }
+                [this](LAS_AbsoluteY op)   {
+                    SP = fetch_from<AddressingMode::ABSOLUTE_Y>(op.address) & SP;
+                    load_accumulator_and_x(SP);
+                },
+                [this](SHA_AbsoluteY op)   { store_and_high_byte(op.address, Y, AC & X); },
+                [this](SHA_IndirectY op)   { store_and_high_byte(fetch_word(op.address), Y, AC & X); },
+                [this](SHX_AbsoluteY op)   { store_and_high_byte(op.address, Y, X); },
+                [this](SHY_AbsoluteX op)   { store_and_high_byte(op.address, X, Y); },
+                [this](TAS_AbsoluteY op)   {
+                    SP = AC & X;
+                    store_and_high_byte(op.address, Y, SP);
+                },
+
+                // these NOPs still read their operand, which matters for watchpoints and memory-mapped devices
+                [this]<OpCode code>(NOP_Implicit<code> op)  { tick(); },
+                [this]<OpCode code>(NOP_Immediate<code> op) {},
+                [this]<OpCode code>(NOP_ZeroPage<code> op)  { (void)fetch_from<AddressingMode::ZERO_PAGE>(op.address); },
+                [this]<OpCode code>(NOP_ZeroPageX<code> op) { (void)fetch_from<AddressingMode::ZERO_PAGE_X>(op.address); },
+                [this]<OpCode code>(NOP_Absolute<code> op)  { (void)fetch_from<AddressingMode::ABSOLUTE>(op.address); },
+                [this]<OpCode code>(NOP_AbsoluteX<code> op) { (void)fetch_from<AddressingMode::ABSOLUTE_X>(op.address); },
+
+                [this]<OpCode code>(JAM<code> op) {
+                    // the processor stays on this command until it is reset
+                    PC--;
+                    tick();
+                    jammed = true;
+                }
             },
                    operation
         );
     }
 
-    void MOS6502::add_to_accumulator(Byte value) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::add_to_accumulator(Byte value) noexcept {
+        if (SR[Flag::DECIMAL]) return add_decimal(value);
+
         SR[Flag::OVERFLOW_F] = SR[Flag::CARRY];
         add_with_overflow((char)AC, (char)value, SR[Flag::OVERFLOW_F], INT8_MIN, INT8_MAX);
 
         set_register(Register::AC, add_with_overflow(AC, value, SR[Flag::CARRY], 0, UINT8_MAX));
     }
 
-    void MOS6502::and_with_accumulator(Byte value) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::and_with_accumulator(Byte value) noexcept {
         set_register(Register::AC, AC & value);
     }
 
-    Byte MOS6502::shift_left(Byte value) noexcept {
-        cycle++;
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::shift_left(Byte value) noexcept {
+        tick();
         SR[Flag::CARRY] = get_bit(value, 7);
         set_writing_flags(value << 1);
         return value << 1;
@@ -428,15 +835,19 @@ namespace Emulator {
 //        memory.set_byte({.address = targetAddress, .value = (this->*byteOperator)(memory.fetch_byte(targetAddress, cycle)), .cycle = cycle});
 //    }
 
-    void MOS6502::branch(char offset) noexcept {
-        cycle++;
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::branch(char offset) noexcept {
         Word newPC = PC + offset;
-//        if (WordToBytes(PC).high != WordToBytes(newPC).high) cycle++;
+        // the base duration covers a branch not taken; taking it costs a cycle, crossing the page one more
+        const Byte extraCycles = WordToBytes(PC).high != WordToBytes(newPC).high ? 2 : 1;
+        tick(extraCycles);
+        penalty(extraCycles);
 
         PC = newPC;
     }
 
-    void MOS6502::bit_test(Byte value) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::bit_test(Byte value) noexcept {
         Byte result = AC & value;
 
         SR[Flag::ZERO] = result == 0;
@@ -446,43 +857,50 @@ namespace Emulator {
         SR[Flag::NEGATIVE] = get_bit(value, (int)Flag::NEGATIVE);
     }
 
-    void MOS6502::compare(Byte reg, Byte value) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::compare(Byte reg, Byte value) noexcept {
         SR[Flag::CARRY] = reg >= value;
         SR[Flag::ZERO] = reg == value;
         SR[Flag::NEGATIVE] = reg < value;
     }
 
-    Byte MOS6502::decrement(Byte value) noexcept {
-        cycle++;
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::decrement(Byte value) noexcept {
+        tick();
         Byte result = value - 1;
         set_writing_flags(result);
         return result;
     }
 
-    void MOS6502::xor_with_accumulator(Byte value) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::xor_with_accumulator(Byte value) noexcept {
         set_register(Register::AC, AC ^ value);
     }
 
-    Byte MOS6502::increment(Byte value) noexcept {
-        cycle++;
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::increment(Byte value) noexcept {
+        tick();
         Byte result = value + 1;
         set_writing_flags(result);
         return result;
     }
 
-    Byte MOS6502::shift_right(Byte value) noexcept {
-        cycle++;
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::shift_right(Byte value) noexcept {
+        tick();
         SR[Flag::CARRY] = get_bit(value, 0);
         set_writing_flags(value >> 1);
         return value >> 1;
     }
 
-    void MOS6502::or_with_accumulator(Byte value) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::or_with_accumulator(Byte value) noexcept {
         set_register(Register::AC, AC | value);
     }
 
-    Byte MOS6502::rotate_left(Byte value) noexcept {
-        cycle++;
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::rotate_left(Byte value) noexcept {
+        tick();
         Byte newValue = value << 1;
         set_bit(newValue, 0, SR[Flag::CARRY]);
         set_writing_flags(newValue);
@@ -491,8 +909,9 @@ namespace Emulator {
         return newValue;
     }
 
-    Byte MOS6502::rotate_right(Byte value) noexcept {
-        cycle++;
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::rotate_right(Byte value) noexcept {
+        tick();
         Byte newValue = value >> 1;
         set_bit(newValue, 7, SR[Flag::CARRY]);
         set_writing_flags(newValue);
@@ -501,7 +920,10 @@ namespace Emulator {
         return newValue;
     }
 
-    void MOS6502::subtract_from_accumulator(Byte value) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::subtract_from_accumulator(Byte value) noexcept {
+        if (SR[Flag::DECIMAL]) return subtract_decimal(value);
+
         SR[Flag::OVERFLOW_F] = SR[Flag::CARRY];
         subtract_with_overflow((char)AC, (char)value, SR[Flag::OVERFLOW_F], INT8_MIN, INT8_MAX);
         SR[Flag::OVERFLOW_F] = !SR[Flag::OVERFLOW_F];
@@ -509,259 +931,236 @@ namespace Emulator {
         set_register(Register::AC, subtract_with_overflow(AC, value, SR[Flag::CARRY], 0, UINT8_MAX));
     }
 
-    Byte MOS6502::index_zero_page(Byte address, Byte index) noexcept {
-        cycle++;
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::add_decimal(Byte value) noexcept {
+        const bool carry = SR[Flag::CARRY];
+        int low = (AC & 0x0F) + (value & 0x0F) + carry;
+        if (low >= 0x0A) low = ((low + 0x06) & 0x0F) + 0x10;
+        int result = (AC & 0xF0) + (value & 0xF0) + low;
+
+        // the flags but the carry are taken before the high digit is adjusted, the zero flag even from the binary sum
+        const int signedResult = (char)(AC & 0xF0) + (char)(value & 0xF0) + low;
+        SR[Flag::OVERFLOW_F] = signedResult < INT8_MIN || signedResult > INT8_MAX;
+        SR[Flag::NEGATIVE] = get_bit(result, 7);
+        SR[Flag::ZERO] = (Byte)(AC + value + carry) == 0;
+
+        if (result >= 0xA0) result += 0x60;
+        SR[Flag::CARRY] = result > UINT8_MAX;
+        AC = result;
+
+        // the CMOS processor takes a cycle more to set the negative and the zero flags from the decimal result
+        if constexpr (variant == Variant::CMOS) {
+            set_writing_flags(AC);
+            tick();
+            penalty();
+        }
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::subtract_decimal(Byte value) noexcept {
+        const bool borrow = !SR[Flag::CARRY];
+        const int binary = AC - value - borrow;
+        const int low = (AC & 0x0F) - (value & 0x0F) - borrow;
+
+        // the carry and the overflow flags come from the binary difference
+        SR[Flag::OVERFLOW_F] = ((AC ^ value) & (AC ^ binary) & 0x80) != 0;
+        SR[Flag::CARRY] = binary >= 0;
+
+        if constexpr (variant == Variant::NMOS) {
+            int result = (AC & 0xF0) - (value & 0xF0) + (low < 0 ? ((low - 0x06) & 0x0F) - 0x10 : low);
+            if (result < 0) result -= 0x60;
+            set_writing_flags(binary);
+            AC = result;
+        }
+        else {
+            int result = binary;
+            if (result < 0) result -= 0x60;
+            if (low < 0) result -= 0x06;
+            set_register(Register::AC, result);
+            tick();
+            penalty();
+        }
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::shift_left_then_or(Byte value) noexcept {
+        const Byte result = shift_left(value);
+        or_with_accumulator(result);
+        return result;
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::rotate_left_then_and(Byte value) noexcept {
+        const Byte result = rotate_left(value);
+        and_with_accumulator(result);
+        return result;
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::shift_right_then_xor(Byte value) noexcept {
+        const Byte result = shift_right(value);
+        xor_with_accumulator(result);
+        return result;
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::rotate_right_then_add(Byte value) noexcept {
+        const Byte result = rotate_right(value);
+        add_to_accumulator(result);
+        return result;
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::decrement_then_compare(Byte value) noexcept {
+        const Byte result = decrement(value);
+        compare(AC, result);
+        return result;
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::increment_then_subtract(Byte value) noexcept {
+        const Byte result = increment(value);
+        subtract_from_accumulator(result);
+        return result;
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::load_accumulator_and_x(Byte value) noexcept {
+        set_register(Register::AC, value);
+        set_register(Register::X, value);
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    void BasicMOS6502<accounting, variant>::store_and_high_byte(Word base, Byte index, Byte value) noexcept {
+        const Byte result = value & (WordToBytes(base).high + 1);
+        Word targetAddress = index_absolute(base, index);
+        if (pageCrossed) targetAddress = (Word)(result << 8 | (targetAddress & 0xFF));
+        // this instruction takes an additional cycle even when the page is not crossed
+        else tick();
+
+        if (breakpoints.is_write_watched(targetAddress)) watch(targetAddress, Access::WRITE);
+        write_byte(targetAddress, result);
+    }
+
+    template<CycleAccounting accounting, Variant variant>
+    Byte BasicMOS6502<accounting, variant>::index_zero_page(Byte address, Byte index) noexcept {
+        tick();
         pageCrossed = index > UINT8_MAX - address;
         return address + index;
     }
 
-    Word MOS6502::index_absolute(Word address, Byte index) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    Word BasicMOS6502<accounting, variant>::index_absolute(Word address, Byte index) noexcept {
         Word result = address + index;
         pageCrossed = WordToBytes(result).high != WordToBytes(address).high;
-        if (pageCrossed) cycle++;
+        if (pageCrossed) {
+            tick();
+            metrics.pageCrossings.add();
+        }
         return result;
     }
 
 
-    Word MOS6502::fetch_word() noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    Word BasicMOS6502<accounting, variant>::fetch_word() noexcept {
         WordToBytes result;
-        result.low = memory.fetch_byte(PC++, cycle);
-        result.high = memory.fetch_byte(PC++, cycle);
+        result.low = read_byte(PC++);
+        result.high = read_byte(PC++);
         return result.word;
     }
 
-    Word MOS6502::fetch_word(Word address) noexcept {
+    template<CycleAccounting accounting, Variant variant>
+    Word BasicMOS6502<accounting, variant>::fetch_word(Word address) noexcept {
         WordToBytes result;
-        result.low = memory.fetch_byte(address, cycle);
-        result.high = memory.fetch_byte(address + 1, cycle);
+        result.low = read_byte(address);
+        result.high = read_byte(address + 1);
         return result.word;
     }
 
-    std::expected<Operation, InvalidOperation> MOS6502::fetch_operation() noexcept {
-        Byte opCode = memory.fetch_byte(PC++, cycle);
-
-        switch (opCode) {
-            default: return std::unexpected(InvalidOperation{.opCode = opCode});
-
-            case ADC_IMMEDIATE:   return ADC_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case ADC_ZERO_PAGE:   return ADC_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case ADC_ZERO_PAGE_X: return ADC_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case ADC_ABSOLUTE:    return ADC_Absolute{.address = fetch_word()};
-            case ADC_ABSOLUTE_X:  return ADC_AbsoluteX{.address = fetch_word()};
-            case ADC_ABSOLUTE_Y:  return ADC_AbsoluteY{.address = fetch_word()};
-            case ADC_INDIRECT_X:  return ADC_IndirectX{.address = memory.fetch_byte(PC++, cycle)};
-            case ADC_INDIRECT_Y:  return ADC_IndirectY{.address = memory.fetch_byte(PC++, cycle)};
-
-            case AND_IMMEDIATE:   return AND_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case AND_ZERO_PAGE:   return AND_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case AND_ZERO_PAGE_X: return AND_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case AND_ABSOLUTE:    return AND_Absolute{.address = fetch_word()};
-            case AND_ABSOLUTE_X:  return AND_AbsoluteX{.address = fetch_word()};
-            case AND_ABSOLUTE_Y:  return AND_AbsoluteY{.address = fetch_word()};
-            case AND_INDIRECT_X:  return AND_IndirectX{.address = memory.fetch_byte(PC++, cycle)};
-            case AND_INDIRECT_Y:  return AND_IndirectY{.address = memory.fetch_byte(PC++, cycle)};
-
-            case ASL_ACCUMULATOR: return ASL_Accumulator{};
-            case ASL_ZERO_PAGE:   return ASL_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case ASL_ZERO_PAGE_X: return ASL_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case ASL_ABSOLUTE:    return ASL_Absolute{.address = fetch_word()};
-            case ASL_ABSOLUTE_X:  return ASL_AbsoluteX{.address = fetch_word()};
-
-            case BCC_RELATIVE:    return BCC{.offset = (char)memory.fetch_byte(PC++, cycle)};
-            case BCS_RELATIVE:    return BCS{.offset = (char)memory.fetch_byte(PC++, cycle)};
-            case BEQ_RELATIVE:    return BEQ{.offset = (char)memory.fetch_byte(PC++, cycle)};
-            case BNE_RELATIVE:    return BNE{.offset = (char)memory.fetch_byte(PC++, cycle)};
-            case BMI_RELATIVE:    return BMI{.offset = (char)memory.fetch_byte(PC++, cycle)};
-            case BPL_RELATIVE:    return BPL{.offset = (char)memory.fetch_byte(PC++, cycle)};
-            case BVC_RELATIVE:    return BVC{.offset = (char)memory.fetch_byte(PC++, cycle)};
-            case BVS_RELATIVE:    return BVS{.offset = (char)memory.fetch_byte(PC++, cycle)};
-
-            case BIT_ZERO_PAGE:   return BIT_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case BIT_ABSOLUTE:    return BIT_Absolute{.address = fetch_word()};
-
-            case BRK_IMPLICIT:    return BRK{};
-
-            case CLC_IMPLICIT:    return CLC{};
-            case CLD_IMPLICIT:    return CLD{};
-            case CLI_IMPLICIT:    return CLI{};
-            case CLV_IMPLICIT:    return CLV{};
-
-            case CMP_IMMEDIATE:   return CMP_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case CMP_ZERO_PAGE:   return CMP_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case CMP_ZERO_PAGE_X: return CMP_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case CMP_ABSOLUTE:    return CMP_Absolute{.address = fetch_word()};
-            case CMP_ABSOLUTE_X:  return CMP_AbsoluteX{.address = fetch_word()};
-            case CMP_ABSOLUTE_Y:  return CMP_AbsoluteY{.address = fetch_word()};
-            case CMP_INDIRECT_X:  return CMP_IndirectX{.address = memory.fetch_byte(PC++, cycle)};
-            case CMP_INDIRECT_Y:  return CMP_IndirectY{.address = memory.fetch_byte(PC++, cycle)};
-
-            case CPX_IMMEDIATE:   return CPX_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case CPX_ZERO_PAGE:   return CPX_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case CPX_ABSOLUTE:    return CPX_Absolute{.address = fetch_word()};
-
-            case CPY_IMMEDIATE:   return CPY_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case CPY_ZERO_PAGE:   return CPY_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case CPY_ABSOLUTE:    return CPY_Absolute{.address = fetch_word()};
-
-            case DEC_ZERO_PAGE:   return DEC_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case DEC_ZERO_PAGE_X: return DEC_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case DEC_ABSOLUTE:    return DEC_Absolute{.address = fetch_word()};
-            case DEC_ABSOLUTE_X:  return DEC_AbsoluteX{.address = fetch_word()};
-
-            case DEX_IMPLICIT:    return DEX{};
-            case DEY_IMPLICIT:    return DEY{};
-
-            case EOR_IMMEDIATE:   return EOR_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case EOR_ZERO_PAGE:   return EOR_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case EOR_ZERO_PAGE_X: return EOR_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case EOR_ABSOLUTE:    return EOR_Absolute{.address = fetch_word()};
-            case EOR_ABSOLUTE_X:  return EOR_AbsoluteX{.address = fetch_word()};
-            case EOR_ABSOLUTE_Y:  return EOR_AbsoluteY{.address = fetch_word()};
-            case EOR_INDIRECT_X:  return EOR_IndirectX{.address = memory.fetch_byte(PC++, cycle)};
-            case EOR_INDIRECT_Y:  return EOR_IndirectY{.address = memory.fetch_byte(PC++, cycle)};
-
-            case INC_ZERO_PAGE:   return INC_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case INC_ZERO_PAGE_X: return INC_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case INC_ABSOLUTE:    return INC_Absolute{.address = fetch_word()};
-            case INC_ABSOLUTE_X:  return INC_AbsoluteX{.address = fetch_word()};
-
-            case INX_IMPLICIT:    return INX{};
-            case INY_IMPLICIT:    return INY{};
-
-            case JMP_ABSOLUTE:    return JMP_Absolute{.address = fetch_word()};
-            case JMP_INDIRECT:    return JMP_Indirect{.address = fetch_word()};
-
-            case JSR_ABSOLUTE:    return JSR{.address = fetch_word()};
-
-            case LDA_IMMEDIATE:   return LDA_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case LDA_ZERO_PAGE:   return LDA_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case LDA_ZERO_PAGE_X: return LDA_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case LDA_ABSOLUTE:    return LDA_Absolute{.address = fetch_word()};
-            case LDA_ABSOLUTE_X:  return LDA_AbsoluteX{.address = fetch_word()};
-            case LDA_ABSOLUTE_Y:  return LDA_AbsoluteY{.address = fetch_word()};
-            case LDA_INDIRECT_X:  return LDA_IndirectX{.address = memory.fetch_byte(PC++, cycle)};
-            case LDA_INDIRECT_Y:  return LDA_IndirectY{.address = memory.fetch_byte(PC++, cycle)};
-
-            case LDX_IMMEDIATE:   return LDX_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case LDX_ZERO_PAGE:   return LDX_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case LDX_ZERO_PAGE_Y: return LDX_ZeroPageY{.address = memory.fetch_byte(PC++, cycle)};
-            case LDX_ABSOLUTE:    return LDX_Absolute{.address = fetch_word()};
-            case LDX_ABSOLUTE_Y:  return LDX_AbsoluteY{.address = fetch_word()};
-
-            case LDY_IMMEDIATE:   return LDY_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case LDY_ZERO_PAGE:   return LDY_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case LDY_ZERO_PAGE_X: return LDY_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case LDY_ABSOLUTE:    return LDY_Absolute{.address = fetch_word()};
-            case LDY_ABSOLUTE_X:  return LDY_AbsoluteX{.address = fetch_word()};
-
-            case LSR_ACCUMULATOR: return LSR_Accumulator{};
-            case LSR_ZERO_PAGE:   return LSR_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case LSR_ZERO_PAGE_X: return LSR_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case LSR_ABSOLUTE:    return LSR_Absolute{.address = fetch_word()};
-            case LSR_ABSOLUTE_X:  return LSR_AbsoluteX{.address = fetch_word()};
-
-            case NOP_IMPLICIT:    return NOP{};
-
-            case ORA_IMMEDIATE:   return ORA_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case ORA_ZERO_PAGE:   return ORA_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case ORA_ZERO_PAGE_X: return ORA_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case ORA_ABSOLUTE:    return ORA_Absolute{.address = fetch_word()};
-            case ORA_ABSOLUTE_X:  return ORA_AbsoluteX{.address = fetch_word()};
-            case ORA_ABSOLUTE_Y:  return ORA_AbsoluteY{.address = fetch_word()};
-            case ORA_INDIRECT_X:  return ORA_IndirectX{.address = memory.fetch_byte(PC++, cycle)};
-            case ORA_INDIRECT_Y:  return ORA_IndirectY{.address = memory.fetch_byte(PC++, cycle)};
-
-            case PHA_IMPLICIT:    return PHA{};
-            case PHP_IMPLICIT:    return PHP{};
-
-            case PLA_IMPLICIT:    return PLA{};
-            case PLP_IMPLICIT:    return PLP{};
-
-            case ROL_ACCUMULATOR: return ROL_Accumulator{};
-            case ROL_ZERO_PAGE:   return ROL_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case ROL_ZERO_PAGE_X: return ROL_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case ROL_ABSOLUTE:    return ROL_Absolute{.address = fetch_word()};
-            case ROL_ABSOLUTE_X:  return ROL_AbsoluteX{.address = fetch_word()};
-
-            case ROR_ACCUMULATOR: return ROR_Accumulator{};
-            case ROR_ZERO_PAGE:   return ROR_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case ROR_ZERO_PAGE_X: return ROR_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case ROR_ABSOLUTE:    return ROR_Absolute{.address = fetch_word()};
-            case ROR_ABSOLUTE_X:  return ROR_AbsoluteX{.address = fetch_word()};
-
-            case RTI_IMPLICIT:    return RTI{};
-            case RTS_IMPLICIT:    return RTS{};
-
-            case SBC_IMMEDIATE:   return SBC_Immediate{.value = memory.fetch_byte(PC++, cycle)};
-            case SBC_ZERO_PAGE:   return SBC_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case SBC_ZERO_PAGE_X: return SBC_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case SBC_ABSOLUTE:    return SBC_Absolute{.address = fetch_word()};
-            case SBC_ABSOLUTE_X:  return SBC_AbsoluteX{.address = fetch_word()};
-            case SBC_ABSOLUTE_Y:  return SBC_AbsoluteY{.address = fetch_word()};
-            case SBC_INDIRECT_X:  return SBC_IndirectX{.address = memory.fetch_byte(PC++, cycle)};
-            case SBC_INDIRECT_Y:  return SBC_IndirectY{.address = memory.fetch_byte(PC++, cycle)};
-
-            case SEC_IMPLICIT:    return SEC{};
-            case SED_IMPLICIT:    return SED{};
-            case SEI_IMPLICIT:    return SEI{};
-
-            case STA_ZERO_PAGE:   return STA_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case STA_ZERO_PAGE_X: return STA_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case STA_ABSOLUTE:    return STA_Absolute{.address = fetch_word()};
-            case STA_ABSOLUTE_X:  return STA_AbsoluteX{.address = fetch_word()};
-            case STA_ABSOLUTE_Y:  return STA_AbsoluteY{.address = fetch_word()};
-            case STA_INDIRECT_X:  return STA_IndirectX{.address = memory.fetch_byte(PC++, cycle)};
-            case STA_INDIRECT_Y:  return STA_IndirectY{.address = memory.fetch_byte(PC++, cycle)};
-
-            case STX_ZERO_PAGE:   return STX_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case STX_ZERO_PAGE_Y: return STX_ZeroPageY{.address = memory.fetch_byte(PC++, cycle)};
-            case STX_ABSOLUTE:    return STX_Absolute{.address = fetch_word()};
-
-            case STY_ZERO_PAGE:   return STY_ZeroPage{.address = memory.fetch_byte(PC++, cycle)};
-            case STY_ZERO_PAGE_X: return STY_ZeroPageX{.address = memory.fetch_byte(PC++, cycle)};
-            case STY_ABSOLUTE:    return STY_Absolute{.address = fetch_word()};
-
-            case TAX_IMPLICIT:    return TAX{};
-            case TAY_IMPLICIT:    return TAY{};
-            case TSX_IMPLICIT:    return TSX{};
-            case TXA_IMPLICIT:    return TXA{};
-            case TXS_IMPLICIT:    return TXS{};
-            case TYA_IMPLICIT:    return TYA{};
+    template<CycleAccounting accounting, Variant variant>
+    template<class Command>
+    Operation BasicMOS6502<accounting, variant>::decode() noexcept {
+        if constexpr (requires (Command command) { command.offset; })
+            return Command{.offset = (char)read_byte(PC++)};
+        else if constexpr (requires (Command command) { command.value; })
+            return Command{.value = read_byte(PC++)};
+        else if constexpr (requires (Command command) { command.address; }) {
+            if constexpr (std::same_as<decltype(Command::address), Word>) return Command{.address = fetch_word()};
+            else return Command{.address = read_byte(PC++)};
+        }
+        else {
+            if constexpr (std::same_as<Command, BRK>) metrics.breaks.add();
+            return Command{};
         }
     }
 
-    Word MOS6502::resolve(Word address, AddressingMode mode) noexcept {
-        switch (mode) {
-            case AddressingMode::ZERO_PAGE:   return address;
-            case AddressingMode::ZERO_PAGE_X: return index_zero_page(address, X);
-            case AddressingMode::ZERO_PAGE_Y: return index_zero_page(address, Y);
-            case AddressingMode::ABSOLUTE:    return address;
-            case AddressingMode::ABSOLUTE_X:  return index_absolute(address, X);
-            case AddressingMode::ABSOLUTE_Y:  return index_absolute(address, Y);
-            case AddressingMode::INDIRECT_X:  return fetch_word(index_zero_page(address, X));
-            case AddressingMode::INDIRECT_Y:  return index_absolute(fetch_word(address), Y);
+    template<CycleAccounting accounting, Variant variant>
+    std::expected<Operation, InvalidOperation> BasicMOS6502<accounting, variant>::fetch_operation() noexcept {
+        using Decoder = Operation (BasicMOS6502::*)() noexcept;
+
+        // every alternative of Operation knows its opcode, so the decoders are generated rather than written by hand
+        static constexpr auto decoders = []<size_t ... index>(std::index_sequence<index...>) {
+            std::array<Decoder, 256> result{};
+            ((result[std::variant_alternative_t<index, Operation>::opcode] = &BasicMOS6502::decode<std::variant_alternative_t<index, Operation>>), ...);
+            return result;
+        }(std::make_index_sequence<std::variant_size_v<Operation>>{});
+        static_assert(std::ranges::find(decoders, nullptr) == decoders.end(), "every opcode must correspond to an operation");
+
+        const Byte opCode = read_byte(PC++);
+
+        // the opcodes undocumented on NMOS are new instructions or NOPs on CMOS, which are not emulated
+        if (!DOCUMENTED_OPCODES[opCode] && (variant == Variant::CMOS || trapIllegalOpcodes)) [[unlikely]] {
+            metrics.unknownOperations.add();
+            return std::unexpected(InvalidOperation{.opCode = opCode});
         }
 
-        std::unreachable();
+        return (this->*decoders[opCode])();
     }
 
-    Byte MOS6502::fetch_from(Word address, AddressingMode mode) noexcept {
-        return memory.fetch_byte(resolve(address, mode), cycle);
+    template<CycleAccounting accounting, Variant variant>
+    template<AddressingMode mode>
+    Word BasicMOS6502<accounting, variant>::resolve(Word address) noexcept {
+        if constexpr (mode == AddressingMode::ZERO_PAGE)        return address;
+        else if constexpr (mode == AddressingMode::ZERO_PAGE_X) return index_zero_page(address, X);
+        else if constexpr (mode == AddressingMode::ZERO_PAGE_Y) return index_zero_page(address, Y);
+        else if constexpr (mode == AddressingMode::ABSOLUTE)    return address;
+        else if constexpr (mode == AddressingMode::ABSOLUTE_X)  return index_absolute(address, X);
+        else if constexpr (mode == AddressingMode::ABSOLUTE_Y)  return index_absolute(address, Y);
+        else if constexpr (mode == AddressingMode::INDIRECT_X)  return fetch_word(index_zero_page(address, X));
+        else {
+            static_assert(mode == AddressingMode::INDIRECT_Y, "unsupported addressing mode");
+            return index_absolute(fetch_word(address), Y);
+        }
     }
 
-    void MOS6502::write_to(Word address, AddressingMode mode, Byte value) noexcept {
-        memory.set_byte({.address = resolve(address, mode), .value = value, .cycle = cycle});
+    template<CycleAccounting accounting, Variant variant>
+    template<AddressingMode mode>
+    Byte BasicMOS6502<accounting, variant>::fetch_from(Word address) noexcept {
+        const auto targetAddress = resolve<mode>(address);
+        if (breakpoints.is_read_watched(targetAddress)) watch(targetAddress, Access::READ);
+        return read_byte(targetAddress);
     }
 
-    void MOS6502::perform_at(Word address, AddressingMode mode, MOS6502::ByteOperator byteOperator) noexcept {
-        auto targetAddress = resolve(address, mode);
-        memory.set_byte({.address = targetAddress, .value = (this->*byteOperator)(memory.fetch_byte(targetAddress, cycle)), .cycle = cycle});
+    template<CycleAccounting accounting, Variant variant>
+    template<AddressingMode mode>
+    void BasicMOS6502<accounting, variant>::write_to(Word address, Byte value) noexcept {
+        const auto targetAddress = resolve<mode>(address);
+        if (breakpoints.is_write_watched(targetAddress)) watch(targetAddress, Access::WRITE);
+        write_byte(targetAddress, value);
     }
 
-}
-
-
-
-
+    template<CycleAccounting accounting, Variant variant>
+    template<AddressingMode mode, typename BasicMOS6502<accounting, variant>::ByteOperator byteOperator>
+    void BasicMOS6502<accounting, variant>::perform_at(Word address) noexcept {
+        auto targetAddress = resolve<mode>(address);
+        if (breakpoints.is_read_watched(targetAddress)) watch(targetAddress, Access::READ);
+        if (breakpoints.is_write_watched(targetAddress)) watch(targetAddress, Access::WRITE);
+        write_byte(targetAddress, (this->*byteOperator)(read_byte(targetAddress)));
+    }
 
+    template class BasicMOS6502<CycleAccounting::EXACT, Variant::NMOS>;
+    template class BasicMOS6502<CycleAccounting::INSTRUCTION, Variant::NMOS>;
+    template class BasicMOS6502<CycleAccounting::NONE, Variant::NMOS>;
+    template class BasicMOS6502<CycleAccounting::EXACT, Variant::CMOS>;
 
+}
@@ -9,17 +9,26 @@
 #include "ROM.hpp"
 #include "Operation.hpp"
 #include "ProcessorStatus.hpp"
+#include "Metrics.hpp"
+#include "Breakpoints.hpp"
 
 #include <optional>
 #include <bitset>
 #include <functional>
+#include <atomic>
+#include <utility>
 
 
 namespace Emulator {
     /**
      * Emulator of MOS 6502 microprocessor. It has three 8-bit registers and 64Kb of memory.
+     *
+     * The way cycles are counted and the processor variant are chosen at compile time, so that every instantiation
+     *  shares the same instruction semantics, while the bookkeeping it does not need is compiled out.
+     * MOS6502 is the NMOS processor with exact cycle accounting.
      */
-    class MOS6502 {
+    template<CycleAccounting accounting = CycleAccounting::EXACT, Variant variant = Variant::NMOS>
+    class BasicMOS6502 {
 
     public:
 
@@ -30,19 +39,82 @@ namespace Emulator {
         struct StopOnBreak { Word address; };
         /// address of the next command
         struct StopOnMaxReached { Word address; };
+        /// address of the command with the breakpoint, which has not been executed yet
+        struct StopOnBreakpoint { Word address; };
+        /// address of the next command and the watched address accessed by the previous one
+        struct StopOnWatchpoint { Word address; Word accessedAddress; Access access; };
+        /// address of the next command
+        struct StopOnRequest { Word address; };
 
-        using SuccessfulTermination = std::variant<StopOnBreak, StopOnMaxReached>;
+        using SuccessfulTermination = std::variant<StopOnBreak, StopOnMaxReached, StopOnBreakpoint, StopOnWatchpoint, StopOnRequest>;
 
         /*
          * Error termination statuses
          */
 
         struct UnknownOperation { Word address; };
+        /// address of the JAM command that halted the processor
+        struct Jammed { Word address; };
 
-        using ErrorTermination = std::variant<UnknownOperation>;
+        using ErrorTermination = std::variant<UnknownOperation, Jammed>;
 
         void stop_on_break(bool value) { stopOnBRK = value; }
 
+        /**
+         * Undocumented opcodes of the NMOS 6502 are executed by default.
+         * When trapped, they terminate execution with UnknownOperation, just like before they were supported.
+         */
+        void trap_illegal_opcodes(bool value) { trapIllegalOpcodes = value; }
+
+        /// execution stops after the given number of commands; nullopt removes the limit
+        void max_number_of_commands(std::optional<size_t> value) { maxNumberOfCommandsToExecute = value; }
+
+        /**
+         * A loop returning to its first command with the same registers and without writing to memory will repeat
+         *  itself forever, like `loop: JMP loop` or `loop: LDA $10; BEQ loop`. There are no memory-mapped devices, so every
+         *  location it reads is stable. When such a loop is detected and the number of commands is limited,
+         *  execution skips ahead to the limit, advancing the cycle counter and the metrics exactly as if the loop ran.
+         * Enabled by default; never done while there are breakpoints or watchpoints.
+         */
+        void skip_idle_loops(bool value) { skipIdleLoops = value; }
+
+        /**
+         * Loops copying or filling memory a byte at a time until the index wraps to zero are run with a single copy
+         *  or fill of the memory, leaving the registers, the flags, the cycle counter and the metrics as if they were
+         *  executed command by command. Recognized loops, with the same index register throughout:
+         *   - `loop: LDA (src),Y; STA (dst),Y; INY; BNE loop` and `loop: STA (dst),Y; INY; BNE loop`;
+         *   - the same with absolute indexed addressing, by Y or X, and INX for the latter.
+         * The loop runs normally while it touches the stack page, its own code or its pointers, copies to a target
+         *  starting inside the source, or while there are breakpoints or watchpoints. Enabled by default.
+         */
+        void accelerate_loops(bool value) { accelerateLoops = value; }
+
+        /// live counters of this CPU; safe to sample from another thread while execute() is running
+        [[nodiscard]] const Metrics& get_metrics() const noexcept { return metrics; }
+
+        /// asks execute(), possibly running in another thread, to stop before the next command
+        void request_stop() noexcept { stopRequested.store(true, std::memory_order_relaxed); }
+
+        /// withdraws a stop requested after execute() returned, which would otherwise stop the next call at once
+        void cancel_stop_request() noexcept { stopRequested.store(false, std::memory_order_relaxed); }
+
+        /// breakpoints and watchpoints checked by execute(); resuming after a breakpoint does not stop on it again
+        [[nodiscard]] Breakpoints& get_breakpoints() noexcept { return breakpoints; }
+
+        /// values of the registers and the cycle counter
+        struct State {
+            Word PC;
+            Byte AC;
+            Byte X, Y;
+            ProcessorStatus SR;
+            Byte SP;
+            size_t cycle;
+        };
+
+        [[nodiscard]] State get_state() const noexcept { return {.PC = PC, .AC = AC, .X = X, .Y = Y, .SR = SR, .SP = SP, .cycle = cycle}; }
+
+        void set_state(const State &state) noexcept;
+
 
 
 
@@ -63,6 +135,9 @@ namespace Emulator {
         /// sets the memory of the processor to the exact same values as the given new memory
         void burn(const ROM &newMemory) noexcept { memory = newMemory; }
 
+        /// the memory as the processor left it, e.g. to read the results of a program
+        [[nodiscard]] const ROM& get_memory() const noexcept { return memory; }
+
         std::expected<SuccessfulTermination, ErrorTermination> execute();
 
         void execute(const Operation& operation) noexcept;
@@ -70,8 +145,18 @@ namespace Emulator {
 
     private:
         friend class MOS6502_TestFixture;
+        friend class Recorder;
+        friend class GdbServer;
+        friend class CycleStepper;
+        friend class RecompiledRuntime;
+        friend class Emulation;
+        friend class SaveStates;
+        friend class SingleStepRunner;
+
+        using ByteOperator = Byte(BasicMOS6502::*)(Byte);
 
-        using ByteOperator = Byte(MOS6502::*)(Byte);
+        /// value ORed with the accumulator by the unstable ANE and LXA; it differs between chips, 0xEE is the most common
+        static constexpr Byte UNSTABLE_MAGIC = 0xEE;
 
 
 
@@ -79,6 +164,16 @@ namespace Emulator {
         // HELPER FUNCTIONS //
         // **************** //
 
+        /// counts a cycle spent on a memory access or an internal operation; only the exact accounting tracks them
+        void tick(size_t cycles = 1) noexcept { if constexpr (accounting == CycleAccounting::EXACT) cycle += cycles; }
+
+        /// counts a cycle not included into the published duration of a command; the exact accounting counts it with tick()
+        void penalty(size_t cycles = 1) noexcept { if constexpr (accounting == CycleAccounting::INSTRUCTION) cycle += cycles; }
+
+        [[nodiscard]] Byte read_byte(Word address) noexcept { tick(); return std::as_const(memory)[address]; }
+
+        void write_byte(Word address, Byte value) noexcept { tick(); writes++; memory.set_byte(address, value); }
+
         /// reads the word with low byte at PC and advances the PC
         [[nodiscard]] Word fetch_word() noexcept;
 
@@ -88,24 +183,46 @@ namespace Emulator {
         /// reads the next operation
         [[nodiscard]] std::expected<Operation, InvalidOperation> fetch_operation() noexcept;
 
+        /// reads the operand of the given command, whose opcode has already been read
+        template<class Command>
+        [[nodiscard]] Operation decode() noexcept;
+
 
         [[nodiscard]] Byte index_zero_page(Byte address, Byte index) noexcept;
         [[nodiscard]] Word index_absolute(Word address, Byte index) noexcept;
 
+        /*
+         * The addressing mode and the operator are template parameters, since every operation knows them statically.
+         * This lets the compiler inline the whole address computation and the operator into each operation.
+         */
+
         /// resolve the actual address of the stored byte
-        Word resolve(Word address, AddressingMode mode) noexcept;
+        template<AddressingMode mode>
+        Word resolve(Word address) noexcept;
 
         /// fetch a byte from memory using different addressing modes
-        [[nodiscard]] Byte fetch_from(Word address, AddressingMode mode) noexcept;
+        template<AddressingMode mode>
+        [[nodiscard]] Byte fetch_from(Word address) noexcept;
 
         /// write the given value to the address resolved according to the mode
-        void write_to(Word address, AddressingMode mode, Byte value) noexcept;
+        template<AddressingMode mode>
+        void write_to(Word address, Byte value) noexcept;
 
         /// replacing a byte of memory with a new value
-        void perform_at(Word address, AddressingMode mode, ByteOperator byteOperator) noexcept;
+        template<AddressingMode mode, ByteOperator byteOperator>
+        void perform_at(Word address) noexcept;
 
         void set_register(Register reg, Byte value);
 
+        /// remembers the access to a watched address, so that execution stops after the current command
+        void watch(Word address, Access access) noexcept;
+
+        /// called after a command jumping backwards; skips the rest of the loop it closes, if the loop is idle
+        void skip_idle_loop(size_t &commandsExecuted) noexcept;
+
+        /// called after a command jumping backwards; runs the rest of the copy or fill loop it closes, if it is one
+        void accelerate_loop(Word branchAddress, size_t &commandsExecuted) noexcept;
+
         void set_writing_flags(Byte value);
 
         void push_byte_to_stack(Byte value);
@@ -113,6 +230,7 @@ namespace Emulator {
         /// first pushes the least significant byte, then the most significant
         void push_word_to_stack(Word value);
 
+        /// takes the cycle of the read only, the preceding increment of SP is accounted by the caller
         Byte pull_byte_from_stack();
 
         /// first pulls the most significant byte, then the least significant
@@ -146,6 +264,33 @@ namespace Emulator {
 
         void subtract_from_accumulator(Byte value) noexcept;
 
+        /// ADC and SBC in the decimal mode; only the results of valid BCD operands are defined, the rest match the NMOS or CMOS processor
+        void add_decimal(Byte value) noexcept;
+
+        void subtract_decimal(Byte value) noexcept;
+
+        // combined read-modify-write operations of the undocumented opcodes
+
+        Byte shift_left_then_or(Byte value) noexcept;
+
+        Byte rotate_left_then_and(Byte value) noexcept;
+
+        Byte shift_right_then_xor(Byte value) noexcept;
+
+        Byte rotate_right_then_add(Byte value) noexcept;
+
+        Byte decrement_then_compare(Byte value) noexcept;
+
+        Byte increment_then_subtract(Byte value) noexcept;
+
+        void load_accumulator_and_x(Byte value) noexcept;
+
+        /**
+         * Stores the value ANDed with the high byte of the base address plus one, as SHA, SHX, SHY and TAS do.
+         * When indexing crosses the page, the high byte of the target address is replaced with the stored value.
+         */
+        void store_and_high_byte(Word base, Byte index, Byte value) noexcept;
+
 
     protected:
 
@@ -178,11 +323,43 @@ namespace Emulator {
 
         // auxiliary variables, not defined by the MOS6502 specifications
         bool pageCrossed;
+        Metrics metrics;
+        Breakpoints breakpoints;
+        /// watched access made by the command being executed, if any
+        std::optional<StopOnWatchpoint> watchpointHit;
+        /// address of the last breakpoint execution stopped at, so that the next execute() can step over it
+        std::optional<Word> stoppedAtBreakpoint;
+        std::atomic<bool> stopRequested = false;
+        /// set by JAM, the command that halts the processor
+        bool jammed = false;
+        /// number of bytes written by the executed commands, telling whether a loop has side effects
+        size_t writes = 0;
+
+        /// state after the last backward jump, which an idle loop returns to
+        struct LoopHead {
+            State state;
+            size_t commandsExecuted;
+            size_t writes;
+            uint64_t pageCrossings;
+            uint64_t stackPulls;
+        };
+        std::optional<LoopHead> loopHead;
 
         // execution conditions
-        bool stopOnBRK;
+        bool stopOnBRK = false;
+        bool trapIllegalOpcodes = false;
+        bool skipIdleLoops = true;
+        bool accelerateLoops = true;
         std::optional<size_t> maxNumberOfCommandsToExecute;
     };
+
+    using MOS6502 = BasicMOS6502<>;
+
+    // instantiated in MOS6502.cpp
+    extern template class BasicMOS6502<CycleAccounting::EXACT, Variant::NMOS>;
+    extern template class BasicMOS6502<CycleAccounting::INSTRUCTION, Variant::NMOS>;
+    extern template class BasicMOS6502<CycleAccounting::NONE, Variant::NMOS>;
+    extern template class BasicMOS6502<CycleAccounting::EXACT, Variant::CMOS>;
 }
 
 #endif //EMULATOR_MOS6502_MOS6502_HPP
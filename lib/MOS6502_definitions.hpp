@@ -102,7 +102,26 @@ namespace Emulator {
          * In instruction contains the zero page location of the least significant byte of 16 bit address.
          * The Y register is dynamically added to this value to generated the actual target address for operation.
          */
-        INDIRECT_Y
+        INDIRECT_Y,
+
+        /*
+         * The modes below do not address memory through an index, so they are only used to describe commands.
+         */
+
+        /// the command has no operand, its source and destination are implied by the command itself
+        IMPLICIT,
+
+        /// the command operates directly on the accumulator
+        ACCUMULATOR,
+
+        /// the operand is the 8 bit value itself
+        IMMEDIATE,
+
+        /// the operand is a signed 8 bit offset added to the program counter if the branch is taken
+        RELATIVE,
+
+        /// the operand is the address of the 16 bit target address, only used by JMP
+        INDIRECT
     };
 
 
@@ -290,11 +309,141 @@ namespace Emulator {
         TSX_IMPLICIT    = 0xBA,
         TXA_IMPLICIT    = 0x8A,
         TXS_IMPLICIT    = 0x9A,
-        TYA_IMPLICIT    = 0x98
+        TYA_IMPLICIT    = 0x98,
+
+        // undocumented opcodes of the NMOS 6502
+
+        SLO_ZERO_PAGE   = 0x07,
+        SLO_ZERO_PAGE_X = 0x17,
+        SLO_ABSOLUTE    = 0x0F,
+        SLO_ABSOLUTE_X  = 0x1F,
+        SLO_ABSOLUTE_Y  = 0x1B,
+        SLO_INDIRECT_X  = 0x03,
+        SLO_INDIRECT_Y  = 0x13,
+
+        RLA_ZERO_PAGE   = 0x27,
+        RLA_ZERO_PAGE_X = 0x37,
+        RLA_ABSOLUTE    = 0x2F,
+        RLA_ABSOLUTE_X  = 0x3F,
+        RLA_ABSOLUTE_Y  = 0x3B,
+        RLA_INDIRECT_X  = 0x23,
+        RLA_INDIRECT_Y  = 0x33,
+
+        SRE_ZERO_PAGE   = 0x47,
+        SRE_ZERO_PAGE_X = 0x57,
+        SRE_ABSOLUTE    = 0x4F,
+        SRE_ABSOLUTE_X  = 0x5F,
+        SRE_ABSOLUTE_Y  = 0x5B,
+        SRE_INDIRECT_X  = 0x43,
+        SRE_INDIRECT_Y  = 0x53,
+
+        RRA_ZERO_PAGE   = 0x67,
+        RRA_ZERO_PAGE_X = 0x77,
+        RRA_ABSOLUTE    = 0x6F,
+        RRA_ABSOLUTE_X  = 0x7F,
+        RRA_ABSOLUTE_Y  = 0x7B,
+        RRA_INDIRECT_X  = 0x63,
+        RRA_INDIRECT_Y  = 0x73,
+
+        DCP_ZERO_PAGE   = 0xC7,
+        DCP_ZERO_PAGE_X = 0xD7,
+        DCP_ABSOLUTE    = 0xCF,
+        DCP_ABSOLUTE_X  = 0xDF,
+        DCP_ABSOLUTE_Y  = 0xDB,
+        DCP_INDIRECT_X  = 0xC3,
+        DCP_INDIRECT_Y  = 0xD3,
+
+        ISC_ZERO_PAGE   = 0xE7,
+        ISC_ZERO_PAGE_X = 0xF7,
+        ISC_ABSOLUTE    = 0xEF,
+        ISC_ABSOLUTE_X  = 0xFF,
+        ISC_ABSOLUTE_Y  = 0xFB,
+        ISC_INDIRECT_X  = 0xE3,
+        ISC_INDIRECT_Y  = 0xF3,
+
+        SAX_ZERO_PAGE   = 0x87,
+        SAX_ZERO_PAGE_Y = 0x97,
+        SAX_ABSOLUTE    = 0x8F,
+        SAX_INDIRECT_X  = 0x83,
+
+        LAX_ZERO_PAGE   = 0xA7,
+        LAX_ZERO_PAGE_Y = 0xB7,
+        LAX_ABSOLUTE    = 0xAF,
+        LAX_ABSOLUTE_Y  = 0xBF,
+        LAX_INDIRECT_X  = 0xA3,
+        LAX_INDIRECT_Y  = 0xB3,
+
+        ANC_IMMEDIATE_0B= 0x0B,
+        ANC_IMMEDIATE_2B= 0x2B,
+        ALR_IMMEDIATE   = 0x4B,
+        ARR_IMMEDIATE   = 0x6B,
+        ANE_IMMEDIATE   = 0x8B,
+        LXA_IMMEDIATE   = 0xAB,
+        SBX_IMMEDIATE   = 0xCB,
+        USBC_IMMEDIATE  = 0xEB,
+
+        LAS_ABSOLUTE_Y  = 0xBB,
+        SHA_ABSOLUTE_Y  = 0x9F,
+        SHA_INDIRECT_Y  = 0x93,
+        SHX_ABSOLUTE_Y  = 0x9E,
+        SHY_ABSOLUTE_X  = 0x9C,
+        TAS_ABSOLUTE_Y  = 0x9B,
+
+        NOP_IMPLICIT_1A = 0x1A,
+        NOP_IMPLICIT_3A = 0x3A,
+        NOP_IMPLICIT_5A = 0x5A,
+        NOP_IMPLICIT_7A = 0x7A,
+        NOP_IMPLICIT_DA = 0xDA,
+        NOP_IMPLICIT_FA = 0xFA,
+        NOP_IMMEDIATE_80= 0x80,
+        NOP_IMMEDIATE_82= 0x82,
+        NOP_IMMEDIATE_89= 0x89,
+        NOP_IMMEDIATE_C2= 0xC2,
+        NOP_IMMEDIATE_E2= 0xE2,
+        NOP_ZERO_PAGE_04= 0x04,
+        NOP_ZERO_PAGE_44= 0x44,
+        NOP_ZERO_PAGE_64= 0x64,
+        NOP_ZERO_PAGE_X_14= 0x14,
+        NOP_ZERO_PAGE_X_34= 0x34,
+        NOP_ZERO_PAGE_X_54= 0x54,
+        NOP_ZERO_PAGE_X_74= 0x74,
+        NOP_ZERO_PAGE_X_D4= 0xD4,
+        NOP_ZERO_PAGE_X_F4= 0xF4,
+        NOP_ABSOLUTE_0C = 0x0C,
+        NOP_ABSOLUTE_X_1C= 0x1C,
+        NOP_ABSOLUTE_X_3C= 0x3C,
+        NOP_ABSOLUTE_X_5C= 0x5C,
+        NOP_ABSOLUTE_X_7C= 0x7C,
+        NOP_ABSOLUTE_X_DC= 0xDC,
+        NOP_ABSOLUTE_X_FC= 0xFC,
+
+        JAM_02          = 0x02,
+        JAM_12          = 0x12,
+        JAM_22          = 0x22,
+        JAM_32          = 0x32,
+        JAM_42          = 0x42,
+        JAM_52          = 0x52,
+        JAM_62          = 0x62,
+        JAM_72          = 0x72,
+        JAM_92          = 0x92,
+        JAM_B2          = 0xB2,
+        JAM_D2          = 0xD2,
+        JAM_F2          = 0xF2
     };
 
     enum class Register { AC, X, Y, SP, SR };
 
+    /**
+     * How the processor counts its cycles.
+     * EXACT counts every memory access and internal operation as the command executes,
+     *  INSTRUCTION adds the published duration of each command together with its page crossing and branch penalties,
+     *  NONE leaves the cycle counter untouched for runs which only need the functional result.
+     */
+    enum class CycleAccounting { NONE, INSTRUCTION, EXACT };
+
+    /// NMOS is the original 6502; CMOS is the 65C02, which fixes a few bugs of the original but adds no instructions here
+    enum class Variant { NMOS, CMOS };
+
 
 
 }
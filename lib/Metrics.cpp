@@ -0,0 +1,47 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <format>
+
+#include "Metrics.hpp"
+
+
+Emulator::Metrics::Snapshot Emulator::Metrics::snapshot() const noexcept {
+    return {
+        .instructionsRetired = instructionsRetired.load(),
+        .cycles = cycles.load(),
+        .pageCrossings = pageCrossings.load(),
+        .stackPushes = stackPushes.load(),
+        .stackPulls = stackPulls.load(),
+        .breaks = breaks.load(),
+        .unknownOperations = unknownOperations.load(),
+        .idleCyclesSkipped = idleCyclesSkipped.load(),
+        .loopsAccelerated = loopsAccelerated.load()
+    };
+}
+
+void Emulator::Metrics::reset() noexcept {
+    for (auto counter: {&instructionsRetired, &cycles, &pageCrossings, &stackPushes, &stackPulls, &breaks, &unknownOperations,
+                         &idleCyclesSkipped, &loopsAccelerated})
+        counter->set(0);
+}
+
+static std::string counter_description(const std::string &name, const std::string &help, const std::string &cpu, uint64_t value) {
+    return std::vformat("# HELP {0} {1}\n# TYPE {0} counter\n{0}{{cpu=\"{2}\"}} {3}\n",
+                        std::make_format_args(name, help, cpu, value));
+}
+
+std::string Emulator::to_prometheus(const Metrics::Snapshot &snapshot, const std::string &cpu) {
+    std::string result;
+    result += counter_description("mos6502_instructions_retired_total", "Instructions executed to completion.", cpu, snapshot.instructionsRetired);
+    result += counter_description("mos6502_cycles_total", "Processor cycles elapsed.", cpu, snapshot.cycles);
+    result += counter_description("mos6502_page_crossings_total", "Indexed accesses that took an extra cycle for crossing a page boundary.", cpu, snapshot.pageCrossings);
+    result += counter_description("mos6502_stack_pushes_total", "Bytes pushed to the stack.", cpu, snapshot.stackPushes);
+    result += counter_description("mos6502_stack_pulls_total", "Bytes pulled from the stack.", cpu, snapshot.stackPulls);
+    result += counter_description("mos6502_breaks_total", "BRK instructions fetched.", cpu, snapshot.breaks);
+    result += counter_description("mos6502_unknown_operations_total", "Executions terminated by an unknown opcode.", cpu, snapshot.unknownOperations);
+    result += counter_description("mos6502_idle_cycles_skipped_total", "Cycles of idle loops skipped instead of being executed.", cpu, snapshot.idleCyclesSkipped);
+    result += counter_description("mos6502_loops_accelerated_total", "Copy and fill loops run as a single operation on the memory.", cpu, snapshot.loopsAccelerated);
+    return result;
+}
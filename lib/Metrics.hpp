@@ -0,0 +1,79 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_METRICS_HPP
+#define EMULATOR_MOS6502_METRICS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Emulator {
+
+    /**
+     * Counter written by the emulating thread only and readable from any other thread without locking.
+     * Since there is a single writer, increment is a relaxed load followed by a relaxed store,
+     *  which compiles to a plain add instead of a locked read-modify-write.
+     */
+    class Counter {
+    public:
+        Counter() noexcept = default;
+        Counter(const Counter &other) noexcept: m_value{other.load()} {};
+        Counter& operator =(const Counter &other) noexcept { set(other.load()); return *this; }
+
+        void add(uint64_t value = 1) noexcept { m_value.store(m_value.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); }
+        void set(uint64_t value) noexcept     { m_value.store(value, std::memory_order_relaxed); }
+
+        [[nodiscard]] uint64_t load() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint64_t> m_value{0};
+    };
+
+
+    /**
+     * Live counters of a single CPU, updated on the hot path and sampled by monitoring code.
+     */
+    struct Metrics {
+        Counter instructionsRetired;
+        Counter cycles;
+        /// additional cycles spent because indexed addressing crossed a page boundary
+        Counter pageCrossings;
+        Counter stackPushes;
+        Counter stackPulls;
+        Counter breaks;
+        /// executions terminated because of an opcode not corresponding to any known operation
+        Counter unknownOperations;
+        /// cycles of idle loops skipped instead of being executed, included in the cycles
+        Counter idleCyclesSkipped;
+        /// copy and fill loops run as a single operation on the memory
+        Counter loopsAccelerated;
+
+        /// values of all the counters read at (approximately) the same moment
+        struct Snapshot {
+            uint64_t instructionsRetired;
+            uint64_t cycles;
+            uint64_t pageCrossings;
+            uint64_t stackPushes;
+            uint64_t stackPulls;
+            uint64_t breaks;
+            uint64_t unknownOperations;
+            uint64_t idleCyclesSkipped;
+            uint64_t loopsAccelerated;
+        };
+
+        [[nodiscard]] Snapshot snapshot() const noexcept;
+
+        void reset() noexcept;
+    };
+
+    /**
+     * Formats the snapshot in the Prometheus text exposition format.
+     *
+     * @param cpu value of the "cpu" label attached to every sample, allowing to tell several emulated CPUs apart
+     */
+    std::string to_prometheus(const Metrics::Snapshot &snapshot, const std::string &cpu = "0");
+}
+
+#endif //EMULATOR_MOS6502_METRICS_HPP
@@ -0,0 +1,179 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_MICROCODE_HPP
+#define EMULATOR_MOS6502_MICROCODE_HPP
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string_view>
+#include <stdexcept>
+
+#include "OpcodeTable.hpp"
+
+namespace Emulator {
+
+    /// what a command does with its data, regardless of the addressing mode
+    enum class Mnemonic: Byte {
+        ADC, ALR, ANC, AND, ANE, ARR, ASL, BCC, BCS, BEQ, BIT, BMI, BNE, BPL, BRK, BVC, BVS, CLC, CLD, CLI, CLV,
+        CMP, CPX, CPY, DCP, DEC, DEX, DEY, EOR, INC, INX, INY, ISC, JAM, JMP, JSR, LAS, LAX, LDA, LDX, LDY, LSR,
+        LXA, NOP, ORA, PHA, PHP, PLA, PLP, RLA, ROL, ROR, RRA, RTI, RTS, SAX, SBC, SBX, SEC, SED, SEI, SHA, SHX,
+        SHY, SLO, SRE, STA, STX, STY, TAS, TAX, TAY, TSX, TXA, TXS, TYA, USBC
+    };
+
+    /// names of the mnemonics in the order of their declaration
+    inline constexpr std::array<std::string_view, (size_t)Mnemonic::USBC + 1> MNEMONICS {
+        "ADC", "ALR", "ANC", "AND", "ANE", "ARR", "ASL", "BCC", "BCS", "BEQ", "BIT", "BMI", "BNE", "BPL", "BRK", "BVC", "BVS", "CLC", "CLD", "CLI", "CLV",
+        "CMP", "CPX", "CPY", "DCP", "DEC", "DEX", "DEY", "EOR", "INC", "INX", "INY", "ISC", "JAM", "JMP", "JSR", "LAS", "LAX", "LDA", "LDX", "LDY", "LSR",
+        "LXA", "NOP", "ORA", "PHA", "PHP", "PLA", "PLP", "RLA", "ROL", "ROR", "RRA", "RTI", "RTS", "SAX", "SBC", "SBX", "SEC", "SED", "SEI", "SHA", "SHX",
+        "SHY", "SLO", "SRE", "STA", "STX", "STY", "TAS", "TAX", "TAY", "TSX", "TXA", "TXS", "TYA", "USBC"
+    };
+
+    constexpr Mnemonic to_mnemonic(std::string_view name) {
+        for (size_t i = 0; i < MNEMONICS.size(); i++)
+            if (MNEMONICS[i] == name) return (Mnemonic)i;
+        throw std::invalid_argument("unknown mnemonic");
+    }
+
+
+    /**
+     * Work done by the processor during a single bus cycle of a command, following the cycle-by-cycle
+     *  descriptions of the NMOS 6502. Every micro-operation makes exactly one memory access, which is a dummy one
+     *  when the processor is busy internally.
+     *
+     * "Operate" means applying the mnemonic of the command to the data read, or producing the data to be written.
+     */
+    enum class MicroOp: Byte {
+        // implied, accumulator and immediate commands
+        READ_PC_OPERATE, READ_PC_MODIFY_ACCUMULATOR, FETCH_IMMEDIATE_OPERATE,
+
+        // computing the effective address
+        FETCH_ADDRESS_LOW, FETCH_ADDRESS_HIGH, FETCH_ADDRESS_HIGH_ADD_X, FETCH_ADDRESS_HIGH_ADD_Y,
+        READ_ADD_X, READ_ADD_Y, FETCH_POINTER_LOW, FETCH_POINTER_HIGH, FETCH_POINTER_HIGH_ADD_Y,
+
+        // accessing the data; the indexed addressing modes first access the address whose high byte is not fixed yet
+        READ_OPERATE, READ_OPERATE_SAME_PAGE, READ_FIX_ADDRESS, READ, OPERATE_WRITE, WRITE_OPERATE, WRITE,
+
+        // branches
+        FETCH_OFFSET, BRANCH, BRANCH_FIX,
+
+        // jumps, the stack and interrupts
+        JUMP, JUMP_POINTER_HIGH, READ_PC, READ_PC_INCREMENT, READ_STACK, PUSH_PCH, PUSH_PCL, PUSH_STATUS, OPERATE_PUSH,
+        PULL_OPERATE, PULL_STATUS, PULL_PCL, PULL_PCH, VECTOR_LOW, VECTOR_HIGH, JAM
+    };
+
+    inline constexpr size_t MICRO_OPS_COUNT = (size_t)MicroOp::JAM + 1;
+
+
+    /// the cycles of a command following the one fetching its opcode
+    struct Microcode {
+        std::array<MicroOp, 7> cycles;
+        Byte length;
+        Mnemonic mnemonic;
+    };
+
+    /// the microcode of the command with the given metadata
+    constexpr Microcode microcode(const OpcodeInfo &info) {
+        using enum MicroOp;
+
+        Microcode result{.cycles = {}, .length = 0, .mnemonic = to_mnemonic(info.mnemonic)};
+        const auto append = [&result](std::initializer_list<MicroOp> cycles) {
+            for (const auto cycle: cycles) result.cycles[result.length++] = cycle;
+        };
+
+        switch (result.mnemonic) {
+            case Mnemonic::BRK: append({READ_PC_INCREMENT, PUSH_PCH, PUSH_PCL, PUSH_STATUS, VECTOR_LOW, VECTOR_HIGH}); return result;
+            case Mnemonic::JSR: append({FETCH_ADDRESS_LOW, READ_STACK, PUSH_PCH, PUSH_PCL, JUMP}); return result;
+            case Mnemonic::RTS: append({READ_PC, READ_STACK, PULL_PCL, PULL_PCH, READ_PC_INCREMENT}); return result;
+            case Mnemonic::RTI: append({READ_PC, READ_STACK, PULL_STATUS, PULL_PCL, PULL_PCH}); return result;
+            case Mnemonic::PHA:
+            case Mnemonic::PHP: append({READ_PC, OPERATE_PUSH}); return result;
+            case Mnemonic::PLA:
+            case Mnemonic::PLP: append({READ_PC, READ_STACK, PULL_OPERATE}); return result;
+            case Mnemonic::JAM: append({JAM}); return result;
+            case Mnemonic::JMP:
+                if (info.mode == AddressingMode::ABSOLUTE) append({FETCH_ADDRESS_LOW, JUMP});
+                else append({FETCH_ADDRESS_LOW, FETCH_ADDRESS_HIGH, FETCH_POINTER_LOW, JUMP_POINTER_HIGH});
+                return result;
+            default:
+                break;
+        }
+
+        enum class Access { READ, WRITE, MODIFY };
+        const auto access = [mnemonic = result.mnemonic] {
+            switch (mnemonic) {
+                case Mnemonic::STA: case Mnemonic::STX: case Mnemonic::STY: case Mnemonic::SAX:
+                case Mnemonic::SHA: case Mnemonic::SHX: case Mnemonic::SHY: case Mnemonic::TAS:
+                    return Access::WRITE;
+                case Mnemonic::ASL: case Mnemonic::LSR: case Mnemonic::ROL: case Mnemonic::ROR: case Mnemonic::INC: case Mnemonic::DEC:
+                case Mnemonic::SLO: case Mnemonic::RLA: case Mnemonic::SRE: case Mnemonic::RRA: case Mnemonic::DCP: case Mnemonic::ISC:
+                    return Access::MODIFY;
+                default:
+                    return Access::READ;
+            }
+        }();
+
+        switch (info.mode) {
+            case AddressingMode::IMPLICIT:    append({READ_PC_OPERATE}); return result;
+            case AddressingMode::ACCUMULATOR: append({READ_PC_MODIFY_ACCUMULATOR}); return result;
+            case AddressingMode::IMMEDIATE:   append({FETCH_IMMEDIATE_OPERATE}); return result;
+            case AddressingMode::RELATIVE:    append({FETCH_OFFSET, BRANCH, BRANCH_FIX}); return result;
+            case AddressingMode::ZERO_PAGE:   append({FETCH_ADDRESS_LOW}); break;
+            case AddressingMode::ZERO_PAGE_X: append({FETCH_ADDRESS_LOW, READ_ADD_X}); break;
+            case AddressingMode::ZERO_PAGE_Y: append({FETCH_ADDRESS_LOW, READ_ADD_Y}); break;
+            case AddressingMode::ABSOLUTE:    append({FETCH_ADDRESS_LOW, FETCH_ADDRESS_HIGH}); break;
+            case AddressingMode::ABSOLUTE_X:  append({FETCH_ADDRESS_LOW, FETCH_ADDRESS_HIGH_ADD_X}); break;
+            case AddressingMode::ABSOLUTE_Y:  append({FETCH_ADDRESS_LOW, FETCH_ADDRESS_HIGH_ADD_Y}); break;
+            case AddressingMode::INDIRECT_X:  append({FETCH_ADDRESS_LOW, READ_ADD_X, FETCH_POINTER_LOW, FETCH_POINTER_HIGH}); break;
+            case AddressingMode::INDIRECT_Y:  append({FETCH_ADDRESS_LOW, FETCH_POINTER_LOW, FETCH_POINTER_HIGH_ADD_Y}); break;
+            case AddressingMode::INDIRECT:    throw std::invalid_argument("only JMP uses the indirect addressing");
+        }
+
+        // a read finishes on the access to the address whose high byte is not fixed yet, if indexing stays within the page
+        const bool indexed = info.mode == AddressingMode::ABSOLUTE_X || info.mode == AddressingMode::ABSOLUTE_Y
+                             || info.mode == AddressingMode::INDIRECT_Y;
+        switch (access) {
+            case Access::READ:   indexed ? append({READ_OPERATE_SAME_PAGE, READ_OPERATE}) : append({READ_OPERATE}); break;
+            case Access::WRITE:  indexed ? append({READ_FIX_ADDRESS, OPERATE_WRITE}) : append({OPERATE_WRITE}); break;
+            // the unmodified value is written back while the new one is computed
+            case Access::MODIFY:
+                if (indexed) append({READ_FIX_ADDRESS});
+                append({READ, WRITE_OPERATE, WRITE});
+                break;
+        }
+        return result;
+    }
+
+    /// microcode of every opcode of the NMOS processor, generated from the opcode table
+    inline constexpr std::array<Microcode, 256> MICROCODE = [] {
+        std::array<Microcode, 256> result{};
+        for (size_t opCode = 0; opCode < result.size(); opCode++) result[opCode] = microcode(OPCODES[opCode]);
+        return result;
+    }();
+
+    /// IRQ and NMI: BRK with the opcode fetch and the increment of PC suppressed
+    inline constexpr Microcode INTERRUPT_MICROCODE {
+        .cycles = {MicroOp::READ_PC, MicroOp::PUSH_PCH, MicroOp::PUSH_PCL, MicroOp::PUSH_STATUS, MicroOp::VECTOR_LOW, MicroOp::VECTOR_HIGH},
+        .length = 6,
+        .mnemonic = Mnemonic::BRK
+    };
+
+    // the microcode takes the published number of cycles, with the opcode fetch and without the optional ones
+    static_assert([] {
+        for (size_t opCode = 0; opCode < MICROCODE.size(); opCode++) {
+            const auto &code = MICROCODE[opCode];
+            const auto cycles = std::span(code.cycles.begin(), code.length);
+            const auto pageCrossing = std::ranges::count(cycles, MicroOp::READ_OPERATE_SAME_PAGE);
+            const auto optional = pageCrossing + 2 * std::ranges::count(cycles, MicroOp::BRANCH);
+
+            if (OPCODES[opCode].pageCrossPenalty != (pageCrossing > 0)) return false;
+            if (code.mnemonic != Mnemonic::JAM && 1 + code.length - optional != OPCODES[opCode].cycles) return false;
+        }
+        return true;
+    }(), "the microcode must agree with the opcode table");
+
+}
+
+#endif //EMULATOR_MOS6502_MICROCODE_HPP
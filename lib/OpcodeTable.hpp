@@ -0,0 +1,352 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_OPCODETABLE_HPP
+#define EMULATOR_MOS6502_OPCODETABLE_HPP
+
+#include <array>
+#include <string_view>
+#include <type_traits>
+
+#include "MOS6502_definitions.hpp"
+#include "ProcessorStatus.hpp"
+
+namespace Emulator {
+
+    /// everything known about an opcode apart from what the command does
+    struct OpcodeInfo {
+        std::string_view mnemonic;
+        AddressingMode mode;
+        /// number of bytes of the command, including the opcode
+        Byte length;
+        /// published duration on NMOS, not including the cycles taken by crossing the page or by a taken branch
+        Byte cycles;
+        /// reading across the page takes an additional cycle
+        bool pageCrossPenalty;
+        /// flags the command may change, with the bits positioned as in the status register
+        Byte flags;
+        bool documented;
+
+        [[nodiscard]] constexpr bool affects(Flag flag) const noexcept { return (flags >> (int)flag) & 1; }
+    };
+
+    /// number of bytes following the opcode in the given addressing mode
+    constexpr Byte operand_length(AddressingMode mode) noexcept {
+        switch (mode) {
+            case AddressingMode::IMPLICIT:
+            case AddressingMode::ACCUMULATOR:
+                return 0;
+            case AddressingMode::ABSOLUTE:
+            case AddressingMode::ABSOLUTE_X:
+            case AddressingMode::ABSOLUTE_Y:
+            case AddressingMode::INDIRECT:
+                return 2;
+            default:
+                return 1;
+        }
+    }
+
+    /**
+     * The single source of the opcode metadata, indexed by opcode. Decoding, disassembly, encoding and the
+     *  instruction-level timing are all derived from it.
+     */
+    inline constexpr std::array<OpcodeInfo, 256> OPCODES = [] {
+        constexpr auto IMP = AddressingMode::IMPLICIT,   ACC = AddressingMode::ACCUMULATOR, IMM = AddressingMode::IMMEDIATE,
+                       ZP  = AddressingMode::ZERO_PAGE,  ZPX = AddressingMode::ZERO_PAGE_X, ZPY = AddressingMode::ZERO_PAGE_Y,
+                       ABS = AddressingMode::ABSOLUTE,   ABX = AddressingMode::ABSOLUTE_X,  ABY = AddressingMode::ABSOLUTE_Y,
+                       IND = AddressingMode::INDIRECT,   IZX = AddressingMode::INDIRECT_X,  IZY = AddressingMode::INDIRECT_Y,
+                       REL = AddressingMode::RELATIVE;
+
+        constexpr Byte N = 1 << (int)Flag::NEGATIVE, V = 1 << (int)Flag::OVERFLOW_F, B = 1 << (int)Flag::BREAK,
+                       D = 1 << (int)Flag::DECIMAL, I = 1 << (int)Flag::INTERRUPT_DISABLE, Z = 1 << (int)Flag::ZERO,
+                       C = 1 << (int)Flag::CARRY;
+
+        constexpr bool PAGE_PENALTY = true;
+
+        constexpr auto documented = [](std::string_view mnemonic, AddressingMode mode, Byte cycles, Byte flags, bool penalty = false) {
+            return OpcodeInfo{.mnemonic = mnemonic, .mode = mode, .length = (Byte)(1 + operand_length(mode)), .cycles = cycles,
+                              .pageCrossPenalty = penalty, .flags = flags, .documented = true};
+        };
+        constexpr auto undocumented = [documented](std::string_view mnemonic, AddressingMode mode, Byte cycles, Byte flags, bool penalty = false) {
+            auto info = documented(mnemonic, mode, cycles, flags, penalty);
+            info.documented = false;
+            return info;
+        };
+
+        // JAM never completes, so it has no duration
+        return std::array<OpcodeInfo, 256> {
+            documented("BRK", IMP, 7, B | I),                           // 0x00
+            documented("ORA", IZX, 6, N | Z),                           // 0x01
+            undocumented("JAM", IMP, 0, 0),                             // 0x02
+            undocumented("SLO", IZX, 8, N | Z | C),                     // 0x03
+            undocumented("NOP", ZP, 3, 0),                              // 0x04
+            documented("ORA", ZP, 3, N | Z),                            // 0x05
+            documented("ASL", ZP, 5, N | Z | C),                        // 0x06
+            undocumented("SLO", ZP, 5, N | Z | C),                      // 0x07
+            documented("PHP", IMP, 3, 0),                               // 0x08
+            documented("ORA", IMM, 2, N | Z),                           // 0x09
+            documented("ASL", ACC, 2, N | Z | C),                       // 0x0A
+            undocumented("ANC", IMM, 2, N | Z | C),                     // 0x0B
+            undocumented("NOP", ABS, 4, 0),                             // 0x0C
+            documented("ORA", ABS, 4, N | Z),                           // 0x0D
+            documented("ASL", ABS, 6, N | Z | C),                       // 0x0E
+            undocumented("SLO", ABS, 6, N | Z | C),                     // 0x0F
+            documented("BPL", REL, 2, 0),                               // 0x10
+            documented("ORA", IZY, 5, N | Z, PAGE_PENALTY),             // 0x11
+            undocumented("JAM", IMP, 0, 0),                             // 0x12
+            undocumented("SLO", IZY, 8, N | Z | C),                     // 0x13
+            undocumented("NOP", ZPX, 4, 0),                             // 0x14
+            documented("ORA", ZPX, 4, N | Z),                           // 0x15
+            documented("ASL", ZPX, 6, N | Z | C),                       // 0x16
+            undocumented("SLO", ZPX, 6, N | Z | C),                     // 0x17
+            documented("CLC", IMP, 2, C),                               // 0x18
+            documented("ORA", ABY, 4, N | Z, PAGE_PENALTY),             // 0x19
+            undocumented("NOP", IMP, 2, 0),                             // 0x1A
+            undocumented("SLO", ABY, 7, N | Z | C),                     // 0x1B
+            undocumented("NOP", ABX, 4, 0, PAGE_PENALTY),               // 0x1C
+            documented("ORA", ABX, 4, N | Z, PAGE_PENALTY),             // 0x1D
+            documented("ASL", ABX, 7, N | Z | C),                       // 0x1E
+            undocumented("SLO", ABX, 7, N | Z | C),                     // 0x1F
+            documented("JSR", ABS, 6, 0),                               // 0x20
+            documented("AND", IZX, 6, N | Z),                           // 0x21
+            undocumented("JAM", IMP, 0, 0),                             // 0x22
+            undocumented("RLA", IZX, 8, N | Z | C),                     // 0x23
+            documented("BIT", ZP, 3, N | V | Z),                        // 0x24
+            documented("AND", ZP, 3, N | Z),                            // 0x25
+            documented("ROL", ZP, 5, N | Z | C),                        // 0x26
+            undocumented("RLA", ZP, 5, N | Z | C),                      // 0x27
+            documented("PLP", IMP, 4, N | V | B | D | I | Z | C),       // 0x28
+            documented("AND", IMM, 2, N | Z),                           // 0x29
+            documented("ROL", ACC, 2, N | Z | C),                       // 0x2A
+            undocumented("ANC", IMM, 2, N | Z | C),                     // 0x2B
+            documented("BIT", ABS, 4, N | V | Z),                       // 0x2C
+            documented("AND", ABS, 4, N | Z),                           // 0x2D
+            documented("ROL", ABS, 6, N | Z | C),                       // 0x2E
+            undocumented("RLA", ABS, 6, N | Z | C),                     // 0x2F
+            documented("BMI", REL, 2, 0),                               // 0x30
+            documented("AND", IZY, 5, N | Z, PAGE_PENALTY),             // 0x31
+            undocumented("JAM", IMP, 0, 0),                             // 0x32
+            undocumented("RLA", IZY, 8, N | Z | C),                     // 0x33
+            undocumented("NOP", ZPX, 4, 0),                             // 0x34
+            documented("AND", ZPX, 4, N | Z),                           // 0x35
+            documented("ROL", ZPX, 6, N | Z | C),                       // 0x36
+            undocumented("RLA", ZPX, 6, N | Z | C),                     // 0x37
+            documented("SEC", IMP, 2, C),                               // 0x38
+            documented("AND", ABY, 4, N | Z, PAGE_PENALTY),             // 0x39
+            undocumented("NOP", IMP, 2, 0),                             // 0x3A
+            undocumented("RLA", ABY, 7, N | Z | C),                     // 0x3B
+            undocumented("NOP", ABX, 4, 0, PAGE_PENALTY),               // 0x3C
+            documented("AND", ABX, 4, N | Z, PAGE_PENALTY),             // 0x3D
+            documented("ROL", ABX, 7, N | Z | C),                       // 0x3E
+            undocumented("RLA", ABX, 7, N | Z | C),                     // 0x3F
+            documented("RTI", IMP, 6, N | V | B | D | I | Z | C),       // 0x40
+            documented("EOR", IZX, 6, N | Z),                           // 0x41
+            undocumented("JAM", IMP, 0, 0),                             // 0x42
+            undocumented("SRE", IZX, 8, N | Z | C),                     // 0x43
+            undocumented("NOP", ZP, 3, 0),                              // 0x44
+            documented("EOR", ZP, 3, N | Z),                            // 0x45
+            documented("LSR", ZP, 5, N | Z | C),                        // 0x46
+            undocumented("SRE", ZP, 5, N | Z | C),                      // 0x47
+            documented("PHA", IMP, 3, 0),                               // 0x48
+            documented("EOR", IMM, 2, N | Z),                           // 0x49
+            documented("LSR", ACC, 2, N | Z | C),                       // 0x4A
+            undocumented("ALR", IMM, 2, N | Z | C),                     // 0x4B
+            documented("JMP", ABS, 3, 0),                               // 0x4C
+            documented("EOR", ABS, 4, N | Z),                           // 0x4D
+            documented("LSR", ABS, 6, N | Z | C),                       // 0x4E
+            undocumented("SRE", ABS, 6, N | Z | C),                     // 0x4F
+            documented("BVC", REL, 2, 0),                               // 0x50
+            documented("EOR", IZY, 5, N | Z, PAGE_PENALTY),             // 0x51
+            undocumented("JAM", IMP, 0, 0),                             // 0x52
+            undocumented("SRE", IZY, 8, N | Z | C),                     // 0x53
+            undocumented("NOP", ZPX, 4, 0),                             // 0x54
+            documented("EOR", ZPX, 4, N | Z),                           // 0x55
+            documented("LSR", ZPX, 6, N | Z | C),                       // 0x56
+            undocumented("SRE", ZPX, 6, N | Z | C),                     // 0x57
+            documented("CLI", IMP, 2, I),                               // 0x58
+            documented("EOR", ABY, 4, N | Z, PAGE_PENALTY),             // 0x59
+            undocumented("NOP", IMP, 2, 0),                             // 0x5A
+            undocumented("SRE", ABY, 7, N | Z | C),                     // 0x5B
+            undocumented("NOP", ABX, 4, 0, PAGE_PENALTY),               // 0x5C
+            documented("EOR", ABX, 4, N | Z, PAGE_PENALTY),             // 0x5D
+            documented("LSR", ABX, 7, N | Z | C),                       // 0x5E
+            undocumented("SRE", ABX, 7, N | Z | C),                     // 0x5F
+            documented("RTS", IMP, 6, 0),                               // 0x60
+            documented("ADC", IZX, 6, N | V | Z | C),                   // 0x61
+            undocumented("JAM", IMP, 0, 0),                             // 0x62
+            undocumented("RRA", IZX, 8, N | V | Z | C),                 // 0x63
+            undocumented("NOP", ZP, 3, 0),                              // 0x64
+            documented("ADC", ZP, 3, N | V | Z | C),                    // 0x65
+            documented("ROR", ZP, 5, N | Z | C),                        // 0x66
+            undocumented("RRA", ZP, 5, N | V | Z | C),                  // 0x67
+            documented("PLA", IMP, 4, N | Z),                           // 0x68
+            documented("ADC", IMM, 2, N | V | Z | C),                   // 0x69
+            documented("ROR", ACC, 2, N | Z | C),                       // 0x6A
+            undocumented("ARR", IMM, 2, N | V | Z | C),                 // 0x6B
+            documented("JMP", IND, 5, 0),                               // 0x6C
+            documented("ADC", ABS, 4, N | V | Z | C),                   // 0x6D
+            documented("ROR", ABS, 6, N | Z | C),                       // 0x6E
+            undocumented("RRA", ABS, 6, N | V | Z | C),                 // 0x6F
+            documented("BVS", REL, 2, 0),                               // 0x70
+            documented("ADC", IZY, 5, N | V | Z | C, PAGE_PENALTY),     // 0x71
+            undocumented("JAM", IMP, 0, 0),                             // 0x72
+            undocumented("RRA", IZY, 8, N | V | Z | C),                 // 0x73
+            undocumented("NOP", ZPX, 4, 0),                             // 0x74
+            documented("ADC", ZPX, 4, N | V | Z | C),                   // 0x75
+            documented("ROR", ZPX, 6, N | Z | C),                       // 0x76
+            undocumented("RRA", ZPX, 6, N | V | Z | C),                 // 0x77
+            documented("SEI", IMP, 2, I),                               // 0x78
+            documented("ADC", ABY, 4, N | V | Z | C, PAGE_PENALTY),     // 0x79
+            undocumented("NOP", IMP, 2, 0),                             // 0x7A
+            undocumented("RRA", ABY, 7, N | V | Z | C),                 // 0x7B
+            undocumented("NOP", ABX, 4, 0, PAGE_PENALTY),               // 0x7C
+            documented("ADC", ABX, 4, N | V | Z | C, PAGE_PENALTY),     // 0x7D
+            documented("ROR", ABX, 7, N | Z | C),                       // 0x7E
+            undocumented("RRA", ABX, 7, N | V | Z | C),                 // 0x7F
+            undocumented("NOP", IMM, 2, 0),                             // 0x80
+            documented("STA", IZX, 6, 0),                               // 0x81
+            undocumented("NOP", IMM, 2, 0),                             // 0x82
+            undocumented("SAX", IZX, 6, 0),                             // 0x83
+            documented("STY", ZP, 3, 0),                                // 0x84
+            documented("STA", ZP, 3, 0),                                // 0x85
+            documented("STX", ZP, 3, 0),                                // 0x86
+            undocumented("SAX", ZP, 3, 0),                              // 0x87
+            documented("DEY", IMP, 2, N | Z),                           // 0x88
+            undocumented("NOP", IMM, 2, 0),                             // 0x89
+            documented("TXA", IMP, 2, N | Z),                           // 0x8A
+            undocumented("ANE", IMM, 2, N | Z),                         // 0x8B
+            documented("STY", ABS, 4, 0),                               // 0x8C
+            documented("STA", ABS, 4, 0),                               // 0x8D
+            documented("STX", ABS, 4, 0),                               // 0x8E
+            undocumented("SAX", ABS, 4, 0),                             // 0x8F
+            documented("BCC", REL, 2, 0),                               // 0x90
+            documented("STA", IZY, 6, 0),                               // 0x91
+            undocumented("JAM", IMP, 0, 0),                             // 0x92
+            undocumented("SHA", IZY, 6, 0),                             // 0x93
+            documented("STY", ZPX, 4, 0),                               // 0x94
+            documented("STA", ZPX, 4, 0),                               // 0x95
+            documented("STX", ZPY, 4, 0),                               // 0x96
+            undocumented("SAX", ZPY, 4, 0),                             // 0x97
+            documented("TYA", IMP, 2, N | Z),                           // 0x98
+            documented("STA", ABY, 5, 0),                               // 0x99
+            documented("TXS", IMP, 2, 0),                               // 0x9A
+            undocumented("TAS", ABY, 5, 0),                             // 0x9B
+            undocumented("SHY", ABX, 5, 0),                             // 0x9C
+            documented("STA", ABX, 5, 0),                               // 0x9D
+            undocumented("SHX", ABY, 5, 0),                             // 0x9E
+            undocumented("SHA", ABY, 5, 0),                             // 0x9F
+            documented("LDY", IMM, 2, N | Z),                           // 0xA0
+            documented("LDA", IZX, 6, N | Z),                           // 0xA1
+            documented("LDX", IMM, 2, N | Z),                           // 0xA2
+            undocumented("LAX", IZX, 6, N | Z),                         // 0xA3
+            documented("LDY", ZP, 3, N | Z),                            // 0xA4
+            documented("LDA", ZP, 3, N | Z),                            // 0xA5
+            documented("LDX", ZP, 3, N | Z),                            // 0xA6
+            undocumented("LAX", ZP, 3, N | Z),                          // 0xA7
+            documented("TAY", IMP, 2, N | Z),                           // 0xA8
+            documented("LDA", IMM, 2, N | Z),                           // 0xA9
+            documented("TAX", IMP, 2, N | Z),                           // 0xAA
+            undocumented("LXA", IMM, 2, N | Z),                         // 0xAB
+            documented("LDY", ABS, 4, N | Z),                           // 0xAC
+            documented("LDA", ABS, 4, N | Z),                           // 0xAD
+            documented("LDX", ABS, 4, N | Z),                           // 0xAE
+            undocumented("LAX", ABS, 4, N | Z),                         // 0xAF
+            documented("BCS", REL, 2, 0),                               // 0xB0
+            documented("LDA", IZY, 5, N | Z, PAGE_PENALTY),             // 0xB1
+            undocumented("JAM", IMP, 0, 0),                             // 0xB2
+            undocumented("LAX", IZY, 5, N | Z, PAGE_PENALTY),           // 0xB3
+            documented("LDY", ZPX, 4, N | Z),                           // 0xB4
+            documented("LDA", ZPX, 4, N | Z),                           // 0xB5
+            documented("LDX", ZPY, 4, N | Z),                           // 0xB6
+            undocumented("LAX", ZPY, 4, N | Z),                         // 0xB7
+            documented("CLV", IMP, 2, V),                               // 0xB8
+            documented("LDA", ABY, 4, N | Z, PAGE_PENALTY),             // 0xB9
+            documented("TSX", IMP, 2, N | Z),                           // 0xBA
+            undocumented("LAS", ABY, 4, N | Z, PAGE_PENALTY),           // 0xBB
+            documented("LDY", ABX, 4, N | Z, PAGE_PENALTY),             // 0xBC
+            documented("LDA", ABX, 4, N | Z, PAGE_PENALTY),             // 0xBD
+            documented("LDX", ABY, 4, N | Z, PAGE_PENALTY),             // 0xBE
+            undocumented("LAX", ABY, 4, N | Z, PAGE_PENALTY),           // 0xBF
+            documented("CPY", IMM, 2, N | Z | C),                       // 0xC0
+            documented("CMP", IZX, 6, N | Z | C),                       // 0xC1
+            undocumented("NOP", IMM, 2, 0),                             // 0xC2
+            undocumented("DCP", IZX, 8, N | Z | C),                     // 0xC3
+            documented("CPY", ZP, 3, N | Z | C),                        // 0xC4
+            documented("CMP", ZP, 3, N | Z | C),                        // 0xC5
+            documented("DEC", ZP, 5, N | Z),                            // 0xC6
+            undocumented("DCP", ZP, 5, N | Z | C),                      // 0xC7
+            documented("INY", IMP, 2, N | Z),                           // 0xC8
+            documented("CMP", IMM, 2, N | Z | C),                       // 0xC9
+            documented("DEX", IMP, 2, N | Z),                           // 0xCA
+            undocumented("SBX", IMM, 2, N | Z | C),                     // 0xCB
+            documented("CPY", ABS, 4, N | Z | C),                       // 0xCC
+            documented("CMP", ABS, 4, N | Z | C),                       // 0xCD
+            documented("DEC", ABS, 6, N | Z),                           // 0xCE
+            undocumented("DCP", ABS, 6, N | Z | C),                     // 0xCF
+            documented("BNE", REL, 2, 0),                               // 0xD0
+            documented("CMP", IZY, 5, N | Z | C, PAGE_PENALTY),         // 0xD1
+            undocumented("JAM", IMP, 0, 0),                             // 0xD2
+            undocumented("DCP", IZY, 8, N | Z | C),                     // 0xD3
+            undocumented("NOP", ZPX, 4, 0),                             // 0xD4
+            documented("CMP", ZPX, 4, N | Z | C),                       // 0xD5
+            documented("DEC", ZPX, 6, N | Z),                           // 0xD6
+            undocumented("DCP", ZPX, 6, N | Z | C),                     // 0xD7
+            documented("CLD", IMP, 2, D),                               // 0xD8
+            documented("CMP", ABY, 4, N | Z | C, PAGE_PENALTY),         // 0xD9
+            undocumented("NOP", IMP, 2, 0),                             // 0xDA
+            undocumented("DCP", ABY, 7, N | Z | C),                     // 0xDB
+            undocumented("NOP", ABX, 4, 0, PAGE_PENALTY),               // 0xDC
+            documented("CMP", ABX, 4, N | Z | C, PAGE_PENALTY),         // 0xDD
+            documented("DEC", ABX, 7, N | Z),                           // 0xDE
+            undocumented("DCP", ABX, 7, N | Z | C),                     // 0xDF
+            documented("CPX", IMM, 2, N | Z | C),                       // 0xE0
+            documented("SBC", IZX, 6, N | V | Z | C),                   // 0xE1
+            undocumented("NOP", IMM, 2, 0),                             // 0xE2
+            undocumented("ISC", IZX, 8, N | V | Z | C),                 // 0xE3
+            documented("CPX", ZP, 3, N | Z | C),                        // 0xE4
+            documented("SBC", ZP, 3, N | V | Z | C),                    // 0xE5
+            documented("INC", ZP, 5, N | Z),                            // 0xE6
+            undocumented("ISC", ZP, 5, N | V | Z | C),                  // 0xE7
+            documented("INX", IMP, 2, N | Z),                           // 0xE8
+            documented("SBC", IMM, 2, N | V | Z | C),                   // 0xE9
+            documented("NOP", IMP, 2, 0),                               // 0xEA
+            undocumented("USBC", IMM, 2, N | V | Z | C),                // 0xEB
+            documented("CPX", ABS, 4, N | Z | C),                       // 0xEC
+            documented("SBC", ABS, 4, N | V | Z | C),                   // 0xED
+            documented("INC", ABS, 6, N | Z),                           // 0xEE
+            undocumented("ISC", ABS, 6, N | V | Z | C),                 // 0xEF
+            documented("BEQ", REL, 2, 0),                               // 0xF0
+            documented("SBC", IZY, 5, N | V | Z | C, PAGE_PENALTY),     // 0xF1
+            undocumented("JAM", IMP, 0, 0),                             // 0xF2
+            undocumented("ISC", IZY, 8, N | V | Z | C),                 // 0xF3
+            undocumented("NOP", ZPX, 4, 0),                             // 0xF4
+            documented("SBC", ZPX, 4, N | V | Z | C),                   // 0xF5
+            documented("INC", ZPX, 6, N | Z),                           // 0xF6
+            undocumented("ISC", ZPX, 6, N | V | Z | C),                 // 0xF7
+            documented("SED", IMP, 2, D),                               // 0xF8
+            documented("SBC", ABY, 4, N | V | Z | C, PAGE_PENALTY),     // 0xF9
+            undocumented("NOP", IMP, 2, 0),                             // 0xFA
+            undocumented("ISC", ABY, 7, N | V | Z | C),                 // 0xFB
+            undocumented("NOP", ABX, 4, 0, PAGE_PENALTY),               // 0xFC
+            documented("SBC", ABX, 4, N | V | Z | C, PAGE_PENALTY),     // 0xFD
+            documented("INC", ABX, 7, N | Z),                           // 0xFE
+            undocumented("ISC", ABX, 7, N | V | Z | C),                 // 0xFF
+        };
+    }();
+
+    /// projects the table onto one of its fields, so that the hot path indexes a compact array instead of the whole table
+    template<auto field>
+    inline constexpr auto OPCODE_FIELD = [] {
+        std::array<std::remove_cvref_t<decltype(OPCODES[0].*field)>, 256> result{};
+        for (size_t opCode = 0; opCode < OPCODES.size(); opCode++) result[opCode] = OPCODES[opCode].*field;
+        return result;
+    }();
+
+    inline constexpr auto OPCODE_LENGTHS = OPCODE_FIELD<&OpcodeInfo::length>;
+    inline constexpr auto OPCODE_CYCLES = OPCODE_FIELD<&OpcodeInfo::cycles>;
+    inline constexpr auto PAGE_CROSS_PENALTIES = OPCODE_FIELD<&OpcodeInfo::pageCrossPenalty>;
+    inline constexpr auto DOCUMENTED_OPCODES = OPCODE_FIELD<&OpcodeInfo::documented>;
+}
+
+#endif //EMULATOR_MOS6502_OPCODETABLE_HPP
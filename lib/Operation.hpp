@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <expected>
+#include <span>
 
 #include "MOS6502_definitions.hpp"
 #include "Error.hpp"
@@ -208,6 +209,105 @@ namespace Emulator {
     struct TYA             { constexpr static OpCode opcode = TYA_IMPLICIT; };
 
 
+    /*
+     * Undocumented opcodes of the NMOS 6502.
+     * Opcodes that behave identically share a template parametrised by the opcode.
+     */
+
+    struct SLO_ZeroPage    { constexpr static OpCode opcode = SLO_ZERO_PAGE;   Byte address; };
+    struct SLO_ZeroPageX   { constexpr static OpCode opcode = SLO_ZERO_PAGE_X; Byte address; };
+    struct SLO_Absolute    { constexpr static OpCode opcode = SLO_ABSOLUTE;    Word address; };
+    struct SLO_AbsoluteX   { constexpr static OpCode opcode = SLO_ABSOLUTE_X;  Word address; };
+    struct SLO_AbsoluteY   { constexpr static OpCode opcode = SLO_ABSOLUTE_Y;  Word address; };
+    struct SLO_IndirectX   { constexpr static OpCode opcode = SLO_INDIRECT_X;  Byte address; };
+    struct SLO_IndirectY   { constexpr static OpCode opcode = SLO_INDIRECT_Y;  Byte address; };
+
+    struct RLA_ZeroPage    { constexpr static OpCode opcode = RLA_ZERO_PAGE;   Byte address; };
+    struct RLA_ZeroPageX   { constexpr static OpCode opcode = RLA_ZERO_PAGE_X; Byte address; };
+    struct RLA_Absolute    { constexpr static OpCode opcode = RLA_ABSOLUTE;    Word address; };
+    struct RLA_AbsoluteX   { constexpr static OpCode opcode = RLA_ABSOLUTE_X;  Word address; };
+    struct RLA_AbsoluteY   { constexpr static OpCode opcode = RLA_ABSOLUTE_Y;  Word address; };
+    struct RLA_IndirectX   { constexpr static OpCode opcode = RLA_INDIRECT_X;  Byte address; };
+    struct RLA_IndirectY   { constexpr static OpCode opcode = RLA_INDIRECT_Y;  Byte address; };
+
+    struct SRE_ZeroPage    { constexpr static OpCode opcode = SRE_ZERO_PAGE;   Byte address; };
+    struct SRE_ZeroPageX   { constexpr static OpCode opcode = SRE_ZERO_PAGE_X; Byte address; };
+    struct SRE_Absolute    { constexpr static OpCode opcode = SRE_ABSOLUTE;    Word address; };
+    struct SRE_AbsoluteX   { constexpr static OpCode opcode = SRE_ABSOLUTE_X;  Word address; };
+    struct SRE_AbsoluteY   { constexpr static OpCode opcode = SRE_ABSOLUTE_Y;  Word address; };
+    struct SRE_IndirectX   { constexpr static OpCode opcode = SRE_INDIRECT_X;  Byte address; };
+    struct SRE_IndirectY   { constexpr static OpCode opcode = SRE_INDIRECT_Y;  Byte address; };
+
+    struct RRA_ZeroPage    { constexpr static OpCode opcode = RRA_ZERO_PAGE;   Byte address; };
+    struct RRA_ZeroPageX   { constexpr static OpCode opcode = RRA_ZERO_PAGE_X; Byte address; };
+    struct RRA_Absolute    { constexpr static OpCode opcode = RRA_ABSOLUTE;    Word address; };
+    struct RRA_AbsoluteX   { constexpr static OpCode opcode = RRA_ABSOLUTE_X;  Word address; };
+    struct RRA_AbsoluteY   { constexpr static OpCode opcode = RRA_ABSOLUTE_Y;  Word address; };
+    struct RRA_IndirectX   { constexpr static OpCode opcode = RRA_INDIRECT_X;  Byte address; };
+    struct RRA_IndirectY   { constexpr static OpCode opcode = RRA_INDIRECT_Y;  Byte address; };
+
+    struct DCP_ZeroPage    { constexpr static OpCode opcode = DCP_ZERO_PAGE;   Byte address; };
+    struct DCP_ZeroPageX   { constexpr static OpCode opcode = DCP_ZERO_PAGE_X; Byte address; };
+    struct DCP_Absolute    { constexpr static OpCode opcode = DCP_ABSOLUTE;    Word address; };
+    struct DCP_AbsoluteX   { constexpr static OpCode opcode = DCP_ABSOLUTE_X;  Word address; };
+    struct DCP_AbsoluteY   { constexpr static OpCode opcode = DCP_ABSOLUTE_Y;  Word address; };
+    struct DCP_IndirectX   { constexpr static OpCode opcode = DCP_INDIRECT_X;  Byte address; };
+    struct DCP_IndirectY   { constexpr static OpCode opcode = DCP_INDIRECT_Y;  Byte address; };
+
+    struct ISC_ZeroPage    { constexpr static OpCode opcode = ISC_ZERO_PAGE;   Byte address; };
+    struct ISC_ZeroPageX   { constexpr static OpCode opcode = ISC_ZERO_PAGE_X; Byte address; };
+    struct ISC_Absolute    { constexpr static OpCode opcode = ISC_ABSOLUTE;    Word address; };
+    struct ISC_AbsoluteX   { constexpr static OpCode opcode = ISC_ABSOLUTE_X;  Word address; };
+    struct ISC_AbsoluteY   { constexpr static OpCode opcode = ISC_ABSOLUTE_Y;  Word address; };
+    struct ISC_IndirectX   { constexpr static OpCode opcode = ISC_INDIRECT_X;  Byte address; };
+    struct ISC_IndirectY   { constexpr static OpCode opcode = ISC_INDIRECT_Y;  Byte address; };
+
+    struct SAX_ZeroPage    { constexpr static OpCode opcode = SAX_ZERO_PAGE;   Byte address; };
+    struct SAX_ZeroPageY   { constexpr static OpCode opcode = SAX_ZERO_PAGE_Y; Byte address; };
+    struct SAX_Absolute    { constexpr static OpCode opcode = SAX_ABSOLUTE;    Word address; };
+    struct SAX_IndirectX   { constexpr static OpCode opcode = SAX_INDIRECT_X;  Byte address; };
+
+    struct LAX_ZeroPage    { constexpr static OpCode opcode = LAX_ZERO_PAGE;   Byte address; };
+    struct LAX_ZeroPageY   { constexpr static OpCode opcode = LAX_ZERO_PAGE_Y; Byte address; };
+    struct LAX_Absolute    { constexpr static OpCode opcode = LAX_ABSOLUTE;    Word address; };
+    struct LAX_AbsoluteY   { constexpr static OpCode opcode = LAX_ABSOLUTE_Y;  Word address; };
+    struct LAX_IndirectX   { constexpr static OpCode opcode = LAX_INDIRECT_X;  Byte address; };
+    struct LAX_IndirectY   { constexpr static OpCode opcode = LAX_INDIRECT_Y;  Byte address; };
+
+    template<OpCode code>
+    struct ANC_Immediate   { constexpr static OpCode opcode = code;            Byte value; };
+    struct ALR_Immediate   { constexpr static OpCode opcode = ALR_IMMEDIATE;   Byte value; };
+    struct ARR_Immediate   { constexpr static OpCode opcode = ARR_IMMEDIATE;   Byte value; };
+    struct ANE_Immediate   { constexpr static OpCode opcode = ANE_IMMEDIATE;   Byte value; };
+    struct LXA_Immediate   { constexpr static OpCode opcode = LXA_IMMEDIATE;   Byte value; };
+    struct SBX_Immediate   { constexpr static OpCode opcode = SBX_IMMEDIATE;   Byte value; };
+    struct USBC_Immediate  { constexpr static OpCode opcode = USBC_IMMEDIATE;  Byte value; };
+
+    struct LAS_AbsoluteY   { constexpr static OpCode opcode = LAS_ABSOLUTE_Y;  Word address; };
+    struct SHA_AbsoluteY   { constexpr static OpCode opcode = SHA_ABSOLUTE_Y;  Word address; };
+    struct SHA_IndirectY   { constexpr static OpCode opcode = SHA_INDIRECT_Y;  Byte address; };
+    struct SHX_AbsoluteY   { constexpr static OpCode opcode = SHX_ABSOLUTE_Y;  Word address; };
+    struct SHY_AbsoluteX   { constexpr static OpCode opcode = SHY_ABSOLUTE_X;  Word address; };
+    struct TAS_AbsoluteY   { constexpr static OpCode opcode = TAS_ABSOLUTE_Y;  Word address; };
+
+    template<OpCode code>
+    struct NOP_Implicit    { constexpr static OpCode opcode = code; };
+    template<OpCode code>
+    struct NOP_Immediate   { constexpr static OpCode opcode = code;            Byte value; };
+    template<OpCode code>
+    struct NOP_ZeroPage    { constexpr static OpCode opcode = code;            Byte address; };
+    template<OpCode code>
+    struct NOP_ZeroPageX   { constexpr static OpCode opcode = code;            Byte address; };
+    template<OpCode code>
+    struct NOP_Absolute    { constexpr static OpCode opcode = code;            Word address; };
+    template<OpCode code>
+    struct NOP_AbsoluteX   { constexpr static OpCode opcode = code;            Word address; };
+
+    /// halts the processor, only a reset brings it back
+    template<OpCode code>
+    struct JAM             { constexpr static OpCode opcode = code; };
+
+
 
 
     using Operation = std::variant<
@@ -394,15 +494,130 @@ namespace Emulator {
             TSX,
             TXA,
             TXS,
-            TYA
+            TYA,
+
+            SLO_ZeroPage,
+            SLO_ZeroPageX,
+            SLO_Absolute,
+            SLO_AbsoluteX,
+            SLO_AbsoluteY,
+            SLO_IndirectX,
+            SLO_IndirectY,
+            RLA_ZeroPage,
+            RLA_ZeroPageX,
+            RLA_Absolute,
+            RLA_AbsoluteX,
+            RLA_AbsoluteY,
+            RLA_IndirectX,
+            RLA_IndirectY,
+            SRE_ZeroPage,
+            SRE_ZeroPageX,
+            SRE_Absolute,
+            SRE_AbsoluteX,
+            SRE_AbsoluteY,
+            SRE_IndirectX,
+            SRE_IndirectY,
+            RRA_ZeroPage,
+            RRA_ZeroPageX,
+            RRA_Absolute,
+            RRA_AbsoluteX,
+            RRA_AbsoluteY,
+            RRA_IndirectX,
+            RRA_IndirectY,
+            DCP_ZeroPage,
+            DCP_ZeroPageX,
+            DCP_Absolute,
+            DCP_AbsoluteX,
+            DCP_AbsoluteY,
+            DCP_IndirectX,
+            DCP_IndirectY,
+            ISC_ZeroPage,
+            ISC_ZeroPageX,
+            ISC_Absolute,
+            ISC_AbsoluteX,
+            ISC_AbsoluteY,
+            ISC_IndirectX,
+            ISC_IndirectY,
+            SAX_ZeroPage,
+            SAX_ZeroPageY,
+            SAX_Absolute,
+            SAX_IndirectX,
+            LAX_ZeroPage,
+            LAX_ZeroPageY,
+            LAX_Absolute,
+            LAX_AbsoluteY,
+            LAX_IndirectX,
+            LAX_IndirectY,
+            ANC_Immediate<ANC_IMMEDIATE_0B>,
+            ANC_Immediate<ANC_IMMEDIATE_2B>,
+            ALR_Immediate,
+            ARR_Immediate,
+            ANE_Immediate,
+            LXA_Immediate,
+            SBX_Immediate,
+            USBC_Immediate,
+            LAS_AbsoluteY,
+            SHA_AbsoluteY,
+            SHA_IndirectY,
+            SHX_AbsoluteY,
+            SHY_AbsoluteX,
+            TAS_AbsoluteY,
+            NOP_Implicit<NOP_IMPLICIT_1A>,
+            NOP_Implicit<NOP_IMPLICIT_3A>,
+            NOP_Implicit<NOP_IMPLICIT_5A>,
+            NOP_Implicit<NOP_IMPLICIT_7A>,
+            NOP_Implicit<NOP_IMPLICIT_DA>,
+            NOP_Implicit<NOP_IMPLICIT_FA>,
+            NOP_Immediate<NOP_IMMEDIATE_80>,
+            NOP_Immediate<NOP_IMMEDIATE_82>,
+            NOP_Immediate<NOP_IMMEDIATE_89>,
+            NOP_Immediate<NOP_IMMEDIATE_C2>,
+            NOP_Immediate<NOP_IMMEDIATE_E2>,
+            NOP_ZeroPage<NOP_ZERO_PAGE_04>,
+            NOP_ZeroPage<NOP_ZERO_PAGE_44>,
+            NOP_ZeroPage<NOP_ZERO_PAGE_64>,
+            NOP_ZeroPageX<NOP_ZERO_PAGE_X_14>,
+            NOP_ZeroPageX<NOP_ZERO_PAGE_X_34>,
+            NOP_ZeroPageX<NOP_ZERO_PAGE_X_54>,
+            NOP_ZeroPageX<NOP_ZERO_PAGE_X_74>,
+            NOP_ZeroPageX<NOP_ZERO_PAGE_X_D4>,
+            NOP_ZeroPageX<NOP_ZERO_PAGE_X_F4>,
+            NOP_Absolute<NOP_ABSOLUTE_0C>,
+            NOP_AbsoluteX<NOP_ABSOLUTE_X_1C>,
+            NOP_AbsoluteX<NOP_ABSOLUTE_X_3C>,
+            NOP_AbsoluteX<NOP_ABSOLUTE_X_5C>,
+            NOP_AbsoluteX<NOP_ABSOLUTE_X_7C>,
+            NOP_AbsoluteX<NOP_ABSOLUTE_X_DC>,
+            NOP_AbsoluteX<NOP_ABSOLUTE_X_FC>,
+            JAM<JAM_02>,
+            JAM<JAM_12>,
+            JAM<JAM_22>,
+            JAM<JAM_32>,
+            JAM<JAM_42>,
+            JAM<JAM_52>,
+            JAM<JAM_62>,
+            JAM<JAM_72>,
+            JAM<JAM_92>,
+            JAM<JAM_B2>,
+            JAM<JAM_D2>,
+            JAM<JAM_F2>
             >;
 
 
 
     std::string description(const Operation &operation) noexcept;
 
+    /// describes the command with the given opcode and operand without decoding it; the operand is ignored if there is none
+    std::string description(Byte opCode, Word operand) noexcept;
+
     std::vector<Byte> encode(const Operation &operation) noexcept;
 
+    /**
+     * Writes the opcode and the operand to the output, without allocating.
+     * @return the number of bytes written, the length of the command
+     */
+    size_t encode(const Operation &operation, std::span<Byte, 3> out) noexcept;
+
 }
 
 #endif //EMULATOR_MOS6502_OPERATION_HPP
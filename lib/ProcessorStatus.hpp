@@ -33,7 +33,6 @@ namespace Emulator {
          * While the decimal mode flag is set the processor will obey the rules of Binary Coded Decimal (BCD) arithmetic during addition and subtraction.
          * The flag can be explicitly set using 'Set Decimal Flag' (SED) and cleared with 'Clear Decimal Flag' (CLD).
          */
-        // TODO: implement addition and subtraction in decimal mode
         DECIMAL = 3,
 
         /**
@@ -75,6 +74,14 @@ namespace Emulator {
 
         [[nodiscard]] Byte to_byte() const noexcept;
 
+        /**
+         * The register as PHP and BRK push it: the unused bit is always set, and so is the break bit, which does not
+         *  exist in the register. IRQ and NMI push it with the break bit clear, which tells them apart from BRK.
+         */
+        [[nodiscard]] Byte pushed(bool breakCommand = true) const noexcept {
+            return (to_byte() & ~0x10) | 0x20 | (breakCommand ? 0x10 : 0);
+        }
+
         ProcessorStatus operator |(const ProcessorStatus &other) const noexcept;
 
         bool operator ==(int value) const noexcept { return to_byte() == value; }
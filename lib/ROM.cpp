@@ -4,6 +4,9 @@
 
 #include <iostream>
 #include <format>
+#include <cstring>
+#include <bit>
+#include <utility>
 #include "ROM.hpp"
 
 
@@ -19,15 +22,62 @@ Emulator::Byte &Emulator::ROM::operator[](Emulator::Word address) {
         std::cerr << std::vformat("warning: writing to stack address 0x{:04x}\n", std::make_format_args(address));
 //        throw std::runtime_error("");
     }
+    mark_dirty(address);
     return m_bytes[address];
 }
 
-Emulator::Byte Emulator::ROM::fetch_byte(Emulator::Word address, size_t &cycle) const {
-    cycle++;
-    return m_bytes[address];
+Emulator::ROM &Emulator::ROM::operator=(const Emulator::ROM &other) noexcept {
+    for (size_t page = 0; page < PAGES_COUNT; page++) {
+        const size_t start = page * PAGE_SIZE;
+        if (std::memcmp(&m_bytes[start], &other.m_bytes[start], PAGE_SIZE) != 0) mark_dirty(start);
+    }
+    m_bytes = other.m_bytes;
+    return *this;
+}
+
+void Emulator::ROM::set_byte(Emulator::Word address, Emulator::Byte value) noexcept {
+    if (m_journal) m_journal->push_back({.address = address, .previous = m_bytes[address]});
+    (*this)[address] = value;
+}
+
+void Emulator::ROM::set_stack_byte(Emulator::Byte index, Emulator::Byte value) noexcept {
+    if (m_journal) m_journal->push_back({.address = (Word)(STACK_BOTTOM + index), .previous = m_bytes[STACK_BOTTOM + index]});
+    stack(index) = value;
+}
+
+void Emulator::ROM::copy(Emulator::Word target, Emulator::Word source, size_t size) noexcept {
+    if (m_journal)
+        for (size_t i = 0; i < size; i++) m_journal->push_back({.address = (Word)(target + i), .previous = m_bytes[target + i]});
+    mark_dirty(target, size);
+    std::memmove(&m_bytes[target], &m_bytes[source], size);
+}
+
+void Emulator::ROM::fill(Emulator::Word target, Emulator::Byte value, size_t size) noexcept {
+    if (m_journal)
+        for (size_t i = 0; i < size; i++) m_journal->push_back({.address = (Word)(target + i), .previous = m_bytes[target + i]});
+    mark_dirty(target, size);
+    std::memset(&m_bytes[target], value, size);
+}
+
+void Emulator::ROM::load(Emulator::Word start, std::span<const Byte> bytes) noexcept {
+    mark_dirty(start, bytes.size());
+    Word address = start;
+    for (const auto byte: bytes) m_bytes[address++] = byte;
+}
+
+Emulator::ROM::PageSet Emulator::ROM::collect_dirty_pages() noexcept {
+    PageSet pages;
+    for (size_t word = 0; word < m_dirty.size(); word++) {
+        for (uint64_t bits = std::exchange(m_dirty[word], 0); bits != 0; bits &= bits - 1)
+            pages.set(word * 64 + std::countr_zero(bits));
+    }
+    return pages;
 }
 
-void Emulator::ROM::set_byte(Emulator::ROM::SetByteInputAddressNotModified input) {
-    input.cycle++;
-    (*this)[input.address] = input.value;
+void Emulator::ROM::mark_dirty(Emulator::Word start, size_t size) noexcept {
+    if (size == 0) return;
+    // the last page of the range, counted past the end of the address space if it wraps
+    const size_t last = (start + size - 1) / PAGE_SIZE;
+    for (size_t page = start / PAGE_SIZE; page <= last && page < start / PAGE_SIZE + PAGES_COUNT; page++)
+        mark_dirty((Word)(page * PAGE_SIZE));
 }
@@ -5,12 +5,23 @@
 #ifndef EMULATOR_MOS6502_ROM_HPP
 #define EMULATOR_MOS6502_ROM_HPP
 
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <format>
+#include <span>
+#include <deque>
 
 #include "MOS6502_definitions.hpp"
 
 namespace Emulator {
 
+    /// value of a memory byte before it was overwritten during execution
+    struct WriteRecord { Word address; Byte previous; };
+
+    using WriteJournal = std::deque<WriteRecord>;
+
+
     class ROM {
 
     public:
@@ -18,36 +29,89 @@ namespace Emulator {
         static constexpr Word INTERRUPT_HANDLER = 0xFFFA;
         static constexpr Word RESET_LOCATION = 0xFFFC;
         static constexpr Word BRK_HANDLER = 0xFFFE;
+        static constexpr Word STACK_BOTTOM = 0x0100;
+
+        static constexpr size_t PAGE_SIZE = 256;
+        static constexpr size_t PAGES_COUNT = 256;
+        /// a bit per page, set if the page is in the set
+        using PageSet = std::bitset<PAGES_COUNT>;
 
 
         ROM(): m_bytes{} {};
 
-        void reset() noexcept { for (auto &byte: m_bytes) byte = 0; }
+        /// the journal is not copied, since it observes this particular memory
+        ROM(const ROM &other) noexcept: m_bytes{other.m_bytes}, m_dirty{other.m_dirty} {};
+        /// only the pages whose bytes differ become dirty
+        ROM& operator =(const ROM &other) noexcept;
+
+        [[nodiscard]] bool operator ==(const ROM &other) const noexcept { return m_bytes == other.m_bytes; }
+
+        void reset() noexcept { for (auto &byte: m_bytes) byte = 0; m_dirty.fill(UINT64_MAX); }
+
+        /// copies the given bytes into memory starting at the given address, wrapping around the end of the address space
+        void load(Word start, std::span<const Byte> bytes) noexcept;
 
         /// simply returns a value at the given address
         [[nodiscard]] Byte operator [](Word address) const { return m_bytes[address]; }
-        /// returns read-write value at a given address
+        /// returns read-write value at a given address, whose page is assumed to be written
         Byte& operator [](Word address);
 
-        /// returns value at the given address, incrementing only the cycle
-        [[nodiscard]] Byte fetch_byte(Word address, size_t &cycle) const;
-
         /// simply returns a big-endian word with the low byte stored at the given address
         [[nodiscard]] Word get_word(Word address) const;
 
-        struct SetByteInputAddressNotModified { Word address; Byte value; size_t &cycle; };
-        /// writes the byte to the given address incrementing only the cycle
-        void set_byte(SetByteInputAddressNotModified input);
+        /// writes the byte to the given address, recording the overwritten value to the journal, if any
+        void set_byte(Word address, Byte value) noexcept;
 
         [[nodiscard]] Byte stack(Byte index) const noexcept { return m_bytes[STACK_BOTTOM + index]; }
-        Byte& stack(Byte index) noexcept                    { return m_bytes[STACK_BOTTOM + index]; }
+        Byte& stack(Byte index) noexcept                    { mark_dirty(STACK_BOTTOM); return m_bytes[STACK_BOTTOM + index]; }
+
+        /// writes the byte to the stack, recording the overwritten value to the journal, if any
+        void set_stack_byte(Byte index, Byte value) noexcept;
+
+        /**
+         * Same as set_byte for every byte of the target range in ascending order, taking the values the source range had
+         *  before the copy, as memmove does, so the ranges may overlap. That differs from copying byte by byte when the
+         *  target starts inside the source, which the callers replaying such a copy must rule out.
+         * Neither range may wrap around the end of the address space.
+         */
+        void copy(Word target, Word source, size_t size) noexcept;
+
+        /// same as set_byte with the given value for every byte of the range, which may not wrap around the end of the address space
+        void fill(Word target, Byte value, size_t size) noexcept;
+
+        /**
+         * Every byte written by set_byte or set_stack_byte will be appended to the journal together with its previous value.
+         * Writes made via the subscript operator are not recorded as they do not come from the executed program.
+         *
+         * @param journal nullptr to stop recording
+         */
+        void attach_journal(WriteJournal *journal) noexcept { m_journal = journal; }
+
+        [[nodiscard]] WriteJournal* journal() const noexcept { return m_journal; }
+
+        /// restores the byte overwritten by the recorded write
+        void revert(const WriteRecord &record) noexcept { mark_dirty(record.address); m_bytes[record.address] = record.previous; }
 
         [[nodiscard]] static bool is_in_stack(Word address) noexcept { return (address >= STACK_BOTTOM) && (address <= STACK_BOTTOM + UINT8_MAX); }
 
-    private:
-        static constexpr Word STACK_BOTTOM = 0x0100;
+        /**
+         * The pages written in any way since the previous call, which are no longer dirty after it.
+         * Meant for a single consumer, e.g. the views of the memory or the save-states of a CPU.
+         */
+        [[nodiscard]] PageSet collect_dirty_pages() noexcept;
 
-        std::array<Byte, UINT16_MAX> m_bytes;
+        [[nodiscard]] bool is_dirty(Byte page) const noexcept { return m_dirty[page >> 6] >> (page & 63) & 1; }
+
+    private:
+        /// a single OR on every store
+        void mark_dirty(Word address) noexcept { m_dirty[address >> 14] |= uint64_t{1} << (address >> 8 & 63); }
+        /// marks the pages of the range, which may wrap around the end of the address space
+        void mark_dirty(Word start, size_t size) noexcept;
+
+        std::array<Byte, UINT16_MAX + 1> m_bytes;
+        /// a bit per page, 64 pages per word
+        std::array<uint64_t, PAGES_COUNT / 64> m_dirty{};
+        WriteJournal *m_journal = nullptr;
     };
 
 }
@@ -0,0 +1,95 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "Recompiled.hpp"
+
+
+Emulator::RecompiledRuntime::RecompiledRuntime(MOS6502 &cpu, const RecompiledProgram &program) noexcept:
+        m_cpu{cpu}, m_program{program} {
+    for (const auto [address, value]: program.code) {
+        m_code[address] = true;
+        // the memory does not hold the image the code was compiled from
+        if (std::as_const(cpu.memory)[address] != value) m_codeModified = true;
+    }
+}
+
+auto Emulator::RecompiledRuntime::execute() -> ExecutionResult {
+    if (m_codeModified || m_cpu.breakpoints.any()) return m_cpu.execute();
+
+    const auto limit = m_cpu.maxNumberOfCommandsToExecute;
+    m_limit = limit.value_or(SIZE_MAX);
+    m_commands = 0;
+
+    while (true) {
+        if (m_commands == m_limit) return MOS6502::StopOnMaxReached{.address = m_cpu.PC};
+
+        if (!m_codeModified && !m_cpu.stopRequested.load(std::memory_order_relaxed)) {
+            const size_t executed = m_commands;
+            load_registers();
+            const bool compiled = m_program.run(*this);
+            store_registers();
+
+            m_cpu.metrics.instructionsRetired.add(m_commands - executed);
+            m_cpu.metrics.cycles.set(m_cpu.cycle);
+            if (compiled) continue;
+        }
+
+        // the interpreter runs a single command, which also reports every other reason to stop
+        m_cpu.max_number_of_commands(1);
+        const auto result = interpret();
+        m_cpu.max_number_of_commands(limit);
+
+        if (!result.has_value() || !std::holds_alternative<MOS6502::StopOnMaxReached>(result.value())) return result;
+        m_commands++;
+    }
+}
+
+auto Emulator::RecompiledRuntime::interpret() -> ExecutionResult {
+    // the writes of the interpreter are journaled to find out whether they overwrite the compiled code
+    WriteJournal *journal = m_cpu.memory.journal();
+    if (journal == nullptr) {
+        m_journal.clear();
+        m_cpu.memory.attach_journal(journal = &m_journal);
+    }
+    const size_t recorded = journal->size();
+
+    const auto result = m_cpu.execute();
+
+    for (size_t i = recorded; i < journal->size(); i++)
+        if (m_code[(*journal)[i].address]) m_codeModified = true;
+    if (journal == &m_journal) m_cpu.memory.attach_journal(nullptr);
+    return result;
+}
+
+void Emulator::RecompiledRuntime::add(Byte value) noexcept {
+    store_registers();
+    m_cpu.add_to_accumulator(value);
+    load_registers();
+}
+
+void Emulator::RecompiledRuntime::subtract(Byte value) noexcept {
+    store_registers();
+    m_cpu.subtract_from_accumulator(value);
+    load_registers();
+}
+
+void Emulator::RecompiledRuntime::load_registers() noexcept {
+    PC = m_cpu.PC;
+    AC = m_cpu.AC;
+    X = m_cpu.X;
+    Y = m_cpu.Y;
+    SR = m_cpu.SR;
+    SP = m_cpu.SP;
+    cycle = m_cpu.cycle;
+}
+
+void Emulator::RecompiledRuntime::store_registers() noexcept {
+    m_cpu.PC = PC;
+    m_cpu.AC = AC;
+    m_cpu.X = X;
+    m_cpu.Y = Y;
+    m_cpu.SR = SR;
+    m_cpu.SP = SP;
+    m_cpu.cycle = cycle;
+}
@@ -0,0 +1,176 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_RECOMPILED_HPP
+#define EMULATOR_MOS6502_RECOMPILED_HPP
+
+#include <bitset>
+#include <span>
+#include <expected>
+#include <type_traits>
+
+#include "MOS6502.hpp"
+
+namespace Emulator {
+
+    class RecompiledRuntime;
+
+    /// C++ code generated by Recompiler from a ROM image, together with the bytes it was compiled from
+    struct RecompiledProgram {
+        struct CodeByte { Word address; Byte value; };
+
+        /// runs the compiled code from the PC of the runtime; @return false if no compiled command starts at the PC
+        bool (*run)(RecompiledRuntime &runtime);
+        std::span<const CodeByte> code;
+    };
+
+
+    /**
+     * Executes a MOS6502 with the code of a RecompiledProgram, falling back to the interpreter for every command
+     *  that was not compiled: the ones reached by indirect jumps and returns only, BRK, JAM and the undocumented ones.
+     *
+     * The compiled code is only valid for the bytes it was compiled from. If they differ from the memory of the CPU
+     *  when the runtime is created, or the program overwrites any of them, the interpreter runs from then on.
+     * Breakpoints and watchpoints are checked by the interpreter only, so it runs whenever there are any.
+     *
+     * The rest of the public interface is used by the generated code. The registers are copied from the CPU while
+     *  the compiled code runs; cycles are counted per command from the published timing, as MOS6502 counts them.
+     */
+    class RecompiledRuntime {
+    public:
+        using ExecutionResult = std::expected<MOS6502::SuccessfulTermination, MOS6502::ErrorTermination>;
+
+        RecompiledRuntime(MOS6502 &cpu, const RecompiledProgram &program) noexcept;
+
+        /// same as MOS6502::execute(), including the limit of the number of commands
+        ExecutionResult execute();
+
+        /// whether the program has overwritten its compiled code, which stops the compiled code after the current command
+        [[nodiscard]] bool code_modified() const noexcept { return m_codeModified; }
+
+        Word PC = 0;
+        Byte AC = 0;
+        Byte X = 0, Y = 0;
+        ProcessorStatus SR;
+        Byte SP = 0;
+        size_t cycle = 0;
+
+        /// checked before every compiled command
+        [[nodiscard]] bool must_stop() const noexcept {
+            return m_commands == m_limit || m_cpu.stopRequested.load(std::memory_order_relaxed);
+        }
+
+        /// completes a command of the given published duration
+        void retire(Byte cycles) noexcept { cycle += cycles; m_commands++; }
+
+        [[nodiscard]] Byte read(Word address) const noexcept { return std::as_const(m_cpu.memory)[address]; }
+
+        [[nodiscard]] Word word(Word address) const noexcept { return m_cpu.memory.get_word(address); }
+
+        void write(Word address, Byte value) noexcept {
+            m_cpu.writes++;
+            m_cpu.memory.set_byte(address, value);
+            if (m_code[address]) m_codeModified = true;
+        }
+
+        /// the base address indexed as by absolute indexed addressing; crossing the page costs a cycle if there is a penalty
+        [[nodiscard]] Word indexed(Word base, Byte index, bool penalty) noexcept {
+            const Word result = base + index;
+            if (WordToBytes(result).high != WordToBytes(base).high) {
+                m_cpu.metrics.pageCrossings.add();
+                if (penalty) cycle++;
+            }
+            return result;
+        }
+
+        /// the taken branch from the address following the command
+        void branch(Word from, Word to) noexcept { cycle += WordToBytes(from).high != WordToBytes(to).high ? 2 : 1; }
+
+        // the flags are left to the CPU, so that both share its semantics
+
+        void set_nz(Byte value) noexcept { with_status([&] { m_cpu.set_writing_flags(value); }); }
+
+        void compare(Byte reg, Byte value) noexcept { with_status([&] { m_cpu.compare(reg, value); }); }
+
+        void bit(Byte value) noexcept {
+            m_cpu.AC = AC;
+            with_status([&] { m_cpu.bit_test(value); });
+        }
+
+        void add(Byte value) noexcept;
+        void subtract(Byte value) noexcept;
+
+        [[nodiscard]] Byte increment(Byte value) noexcept { return with_status([&] { return m_cpu.increment(value); }); }
+        [[nodiscard]] Byte decrement(Byte value) noexcept { return with_status([&] { return m_cpu.decrement(value); }); }
+        [[nodiscard]] Byte shift_left(Byte value) noexcept { return with_status([&] { return m_cpu.shift_left(value); }); }
+        [[nodiscard]] Byte shift_right(Byte value) noexcept { return with_status([&] { return m_cpu.shift_right(value); }); }
+        [[nodiscard]] Byte rotate_left(Byte value) noexcept { return with_status([&] { return m_cpu.rotate_left(value); }); }
+        [[nodiscard]] Byte rotate_right(Byte value) noexcept { return with_status([&] { return m_cpu.rotate_right(value); }); }
+
+        void push(Byte value) noexcept {
+            m_cpu.metrics.stackPushes.add();
+            m_cpu.writes++;
+            if (m_code[ROM::STACK_BOTTOM + SP]) m_codeModified = true;
+            m_cpu.memory.set_stack_byte(SP--, value);
+        }
+
+        /// first pushes the most significant byte, then the least significant
+        void push_word(Word value) noexcept {
+            push(WordToBytes(value).high);
+            push(WordToBytes(value).low);
+        }
+
+        [[nodiscard]] Byte pull() noexcept {
+            m_cpu.metrics.stackPulls.add();
+            return std::as_const(m_cpu.memory).stack(++SP);
+        }
+
+        [[nodiscard]] Word pull_word() noexcept {
+            WordToBytes result;
+            result.low = pull();
+            result.high = pull();
+            return result.word;
+        }
+
+    private:
+        /// runs the CPU, noting whether it overwrites the compiled code
+        ExecutionResult interpret();
+
+        void load_registers() noexcept;
+        void store_registers() noexcept;
+
+        /**
+         * Calls a helper of the CPU on the status register of the runtime. The cycles the helper ticks are lost, as
+         *  the runtime counts them per command and overwrites the counter of the CPU with its own.
+         */
+        template<typename Helper>
+        std::invoke_result_t<Helper> with_status(Helper &&helper) noexcept {
+            m_cpu.SR = SR;
+            if constexpr (std::is_void_v<std::invoke_result_t<Helper>>) {
+                helper();
+                SR = m_cpu.SR;
+            }
+            else {
+                const auto result = helper();
+                SR = m_cpu.SR;
+                return result;
+            }
+        }
+
+        MOS6502 &m_cpu;
+        const RecompiledProgram &m_program;
+
+        std::bitset<UINT16_MAX + 1> m_code;
+        bool m_codeModified = false;
+        /// records the writes of the interpreter, cleared before every command it runs
+        WriteJournal m_journal;
+
+        /// commands executed by the current call of execute() and their limit
+        size_t m_commands = 0;
+        size_t m_limit = SIZE_MAX;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_RECOMPILED_HPP
@@ -0,0 +1,229 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <format>
+#include <vector>
+
+#include "Recompiler.hpp"
+#include "OpcodeTable.hpp"
+#include "Microcode.hpp"
+#include "Operation.hpp"
+
+
+Emulator::Recompiler::Recompiler(const ROM &image): m_image{image}, m_graph{image} {
+    collect_commands();
+}
+
+bool Emulator::Recompiler::is_compiled(Byte opCode) noexcept {
+    return OPCODES[opCode].documented && opCode != BRK_IMPLICIT;
+}
+
+void Emulator::Recompiler::add_entry(Word address) {
+    m_graph.add_entry(address);
+    collect_commands();
+}
+
+void Emulator::Recompiler::collect_commands() {
+    m_commands.clear();
+    for (const Word command: m_graph.commands())
+        if (is_compiled(std::as_const(m_image)[command])) m_commands.insert(command);
+}
+
+std::string Emulator::Recompiler::continue_at(Word address, std::set<Word> &labels) const {
+    if (!m_commands.contains(address)) return std::format("{{ r.PC = 0x{:04X}; return true; }}", address);
+    labels.insert(address);
+    return std::format("goto L_{:04X};", address);
+}
+
+std::string Emulator::Recompiler::translate_command(Word address, std::set<Word> &labels) const {
+    const Byte opCode = m_image[address];
+    const auto &info = OPCODES[opCode];
+    const Word next = address + info.length;
+    const Word operand = info.length == 3 ? m_image.get_word(address + 1) : m_image[address + 1];
+
+    // the address accessed by the command, as computed by the addressing modes of MOS6502
+    const auto target = [&]() -> std::string {
+        const bool penalty = info.pageCrossPenalty;
+        switch (info.mode) {
+            case AddressingMode::ZERO_PAGE:   return std::format("0x{:02X}", operand);
+            case AddressingMode::ZERO_PAGE_X: return std::format("(Byte)(0x{:02X} + r.X)", operand);
+            case AddressingMode::ZERO_PAGE_Y: return std::format("(Byte)(0x{:02X} + r.Y)", operand);
+            case AddressingMode::ABSOLUTE:    return std::format("0x{:04X}", operand);
+            case AddressingMode::ABSOLUTE_X:  return std::format("r.indexed(0x{:04X}, r.X, {})", operand, penalty);
+            case AddressingMode::ABSOLUTE_Y:  return std::format("r.indexed(0x{:04X}, r.Y, {})", operand, penalty);
+            case AddressingMode::INDIRECT_X:  return std::format("r.word((Byte)(0x{:02X} + r.X))", operand);
+            case AddressingMode::INDIRECT_Y:  return std::format("r.indexed(r.word(0x{:02X}), r.Y, {})", operand, penalty);
+            default:                          return "";
+        }
+    };
+    const auto value = [&]() -> std::string {
+        if (info.mode == AddressingMode::IMMEDIATE) return std::format("0x{:02X}", operand);
+        return std::format("r.read({})", target());
+    };
+
+    const auto mnemonic = to_mnemonic(info.mnemonic);
+    const auto reg = [mnemonic] {
+        switch (mnemonic) {
+            case Mnemonic::LDX: case Mnemonic::STX: case Mnemonic::CPX: case Mnemonic::INX: case Mnemonic::DEX: return "r.X";
+            case Mnemonic::LDY: case Mnemonic::STY: case Mnemonic::CPY: case Mnemonic::INY: case Mnemonic::DEY: return "r.Y";
+            default: return "r.AC";
+        }
+    }();
+    // read-modify-write commands on the accumulator or on memory
+    const auto modify = [&](std::string_view function) {
+        if (info.mode == AddressingMode::ACCUMULATOR) return std::format("r.AC = r.{}(r.AC);", function);
+        return std::format("{{ const Word address = {}; r.write(address, r.{}(r.read(address))); }}", target(), function);
+    };
+    const auto branch = [&](std::string_view condition) {
+        const Word destination = next + (char)operand;
+        return std::format("if ({}) {{ r.branch(0x{:04X}, 0x{:04X}); {} }}", condition, next, destination, continue_at(destination, labels));
+    };
+
+    // statements before and after the command is retired
+    std::string body, tail;
+    bool writes = false;
+    bool fallsThrough = true;
+    switch (mnemonic) {
+        case Mnemonic::LDA: case Mnemonic::LDX: case Mnemonic::LDY:
+            body = std::format("{0} = {1}; r.set_nz({0});", reg, value());
+            break;
+        case Mnemonic::STA: case Mnemonic::STX: case Mnemonic::STY:
+            body = std::format("r.write({}, {});", target(), reg);
+            writes = true;
+            break;
+        case Mnemonic::AND: body = std::format("r.AC &= {}; r.set_nz(r.AC);", value()); break;
+        case Mnemonic::ORA: body = std::format("r.AC |= {}; r.set_nz(r.AC);", value()); break;
+        case Mnemonic::EOR: body = std::format("r.AC ^= {}; r.set_nz(r.AC);", value()); break;
+        case Mnemonic::ADC: body = std::format("r.add({});", value()); break;
+        case Mnemonic::SBC: body = std::format("r.subtract({});", value()); break;
+        case Mnemonic::CMP: case Mnemonic::CPX: case Mnemonic::CPY:
+            body = std::format("r.compare({}, {});", reg, value());
+            break;
+        case Mnemonic::BIT: body = std::format("r.bit({});", value()); break;
+
+        case Mnemonic::ASL: body = modify("shift_left"); writes = info.mode != AddressingMode::ACCUMULATOR; break;
+        case Mnemonic::LSR: body = modify("shift_right"); writes = info.mode != AddressingMode::ACCUMULATOR; break;
+        case Mnemonic::ROL: body = modify("rotate_left"); writes = info.mode != AddressingMode::ACCUMULATOR; break;
+        case Mnemonic::ROR: body = modify("rotate_right"); writes = info.mode != AddressingMode::ACCUMULATOR; break;
+        case Mnemonic::INC: body = modify("increment"); writes = true; break;
+        case Mnemonic::DEC: body = modify("decrement"); writes = true; break;
+        case Mnemonic::INX: case Mnemonic::INY: body = std::format("r.set_nz(++{});", reg); break;
+        case Mnemonic::DEX: case Mnemonic::DEY: body = std::format("r.set_nz(--{});", reg); break;
+
+        case Mnemonic::TAX: body = "r.X = r.AC; r.set_nz(r.X);"; break;
+        case Mnemonic::TAY: body = "r.Y = r.AC; r.set_nz(r.Y);"; break;
+        case Mnemonic::TXA: body = "r.AC = r.X; r.set_nz(r.AC);"; break;
+        case Mnemonic::TYA: body = "r.AC = r.Y; r.set_nz(r.AC);"; break;
+        case Mnemonic::TSX: body = "r.X = r.SP; r.set_nz(r.X);"; break;
+        case Mnemonic::TXS: body = "r.SP = r.X;"; break;
+
+        case Mnemonic::CLC: body = "r.SR[Flag::CARRY] = CLEAR;"; break;
+        case Mnemonic::SEC: body = "r.SR[Flag::CARRY] = SET;"; break;
+        case Mnemonic::CLD: body = "r.SR[Flag::DECIMAL] = CLEAR;"; break;
+        case Mnemonic::SED: body = "r.SR[Flag::DECIMAL] = SET;"; break;
+        case Mnemonic::CLI: body = "r.SR[Flag::INTERRUPT_DISABLE] = CLEAR;"; break;
+        case Mnemonic::SEI: body = "r.SR[Flag::INTERRUPT_DISABLE] = SET;"; break;
+        case Mnemonic::CLV: body = "r.SR[Flag::OVERFLOW_F] = CLEAR;"; break;
+        case Mnemonic::NOP: break;
+
+        case Mnemonic::PHA: body = "r.push(r.AC);"; writes = true; break;
+        case Mnemonic::PHP: body = "r.push(r.SR.pushed());"; writes = true; break;
+        case Mnemonic::PLA: body = "r.AC = r.pull(); r.set_nz(r.AC);"; break;
+        case Mnemonic::PLP: body = "r.SR = r.pull();"; break;
+
+        case Mnemonic::BCC: tail = branch("!r.SR[Flag::CARRY]"); break;
+        case Mnemonic::BCS: tail = branch("r.SR[Flag::CARRY]"); break;
+        case Mnemonic::BNE: tail = branch("!r.SR[Flag::ZERO]"); break;
+        case Mnemonic::BEQ: tail = branch("r.SR[Flag::ZERO]"); break;
+        case Mnemonic::BPL: tail = branch("!r.SR[Flag::NEGATIVE]"); break;
+        case Mnemonic::BMI: tail = branch("r.SR[Flag::NEGATIVE]"); break;
+        case Mnemonic::BVC: tail = branch("!r.SR[Flag::OVERFLOW_F]"); break;
+        case Mnemonic::BVS: tail = branch("r.SR[Flag::OVERFLOW_F]"); break;
+
+        case Mnemonic::JMP:
+            fallsThrough = false;
+            if (info.mode == AddressingMode::ABSOLUTE) {
+                tail = continue_at(operand, labels);
+                break;
+            }
+            // the high byte of the target is read from the same page as the low one, even when the pointer is at its end
+            body = std::format("r.PC = (Word)(r.read(0x{:04X}) | r.read(0x{:04X}) << 8);",
+                               operand, (Word)((operand & 0xFF00) | (Byte)(operand + 1)));
+            tail = "return true;";
+            break;
+        case Mnemonic::JSR:
+            fallsThrough = false;
+            body = std::format("r.push_word(0x{:04X});", (Word)(next - 1));
+            tail = std::format("if (r.code_modified()) {{ r.PC = 0x{0:04X}; return true; }}\n                {1}",
+                               operand, continue_at(operand, labels));
+            break;
+        case Mnemonic::RTS:
+            fallsThrough = false;
+            body = "r.PC = r.pull_word() + 1;";
+            tail = "return true;";
+            break;
+        case Mnemonic::RTI:
+            fallsThrough = false;
+            body = "r.SR = r.pull(); r.PC = r.pull_word();";
+            tail = "return true;";
+            break;
+
+        default:
+            // BRK, JAM and the undocumented commands are left to the interpreter
+            std::unreachable();
+    }
+    if (writes) tail = std::format("if (r.code_modified()) {{ r.PC = 0x{:04X}; return true; }}", next);
+
+    // falling through to the next case is only possible when it is the following command
+    if (fallsThrough) {
+        const auto following = std::next(m_commands.find(address));
+        const auto statement = following == m_commands.end() || *following != next ? continue_at(next, labels) : "[[fallthrough]];";
+        tail += (tail.empty() ? "" : "\n                ") + statement;
+    }
+
+    std::string result = std::format("                // {}\n", description(opCode, operand));
+    result += std::format("                if (r.must_stop()) {{ r.PC = 0x{:04X}; return true; }}\n", address);
+    if (!body.empty()) result += std::format("                {}\n", body);
+    result += std::format("                r.retire({});\n", info.cycles);
+    if (!tail.empty()) result += std::format("                {}\n", tail);
+    return result;
+}
+
+std::string Emulator::Recompiler::translate(std::string_view name) const {
+    std::set<Word> labels;
+    std::vector<std::string> commands;
+    for (const Word address: m_commands) commands.push_back(translate_command(address, labels));
+
+    std::string result = "// Generated by Emulator_MOS6502_Recompiler, do not edit.\n\n"
+                         "#include \"Recompiled.hpp\"\n\n"
+                         "using namespace Emulator;\n\n"
+                         "namespace {\n\n"
+                         "    bool run(RecompiledRuntime &r) {\n"
+                         "        switch (r.PC) {\n";
+    auto command = commands.begin();
+    for (const Word address: m_commands) {
+        result += std::format("            case 0x{:04X}:", address);
+        if (labels.contains(address)) result += std::format(" L_{:04X}:", address);
+        result += "\n" + *command++;
+    }
+    result += "            default:\n"
+              "                return false;\n"
+              "        }\n"
+              "    }\n\n";
+
+    std::vector<std::string> code;
+    for (const Word address: m_commands)
+        for (Byte i = 0; i < OPCODES[m_image[address]].length; i++)
+            code.push_back(std::format("{{0x{:04X}, 0x{:02X}}}", (Word)(address + i), m_image[address + i]));
+
+    result += std::format("    constexpr std::array<RecompiledProgram::CodeByte, {}> CODE {{{{\n", code.size());
+    for (size_t i = 0; i < code.size(); i++)
+        result += (i % 8 == 0 ? "        " : " ") + code[i] + (i + 1 == code.size() || i % 8 == 7 ? ",\n" : ",");
+    result += "    }};\n\n"
+              "}\n\n";
+
+    result += std::format("extern const RecompiledProgram {0};\n"
+                          "const RecompiledProgram {0} {{.run = &run, .code = CODE}};\n", name);
+    return result;
+}
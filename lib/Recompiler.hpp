@@ -0,0 +1,61 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_RECOMPILER_HPP
+#define EMULATOR_MOS6502_RECOMPILER_HPP
+
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "ROM.hpp"
+#include "ControlFlow.hpp"
+
+namespace Emulator {
+
+    /**
+     * Ahead-of-time recompiler of a ROM image into a C++ translation unit run by RecompiledRuntime.
+     *
+     * The commands reachable from the reset, NMI and IRQ/BRK vectors are found by ControlFlowGraph.
+     * All of them are compiled into a single function, which switches on the PC once and then jumps between
+     *  the commands directly. Returns and indirect jumps leave the function, which is entered again at their target.
+     *
+     * BRK, JAM and the undocumented commands are not compiled; the interpreter runs them, as well as any command
+     *  reached only through a computed address.
+     */
+    class Recompiler {
+    public:
+        /// finds the code reachable from the vectors of the image
+        explicit Recompiler(const ROM &image);
+
+        /// also compiles the code reachable from the given address, for entries not referenced by the vectors
+        void add_entry(Word address);
+
+        /// addresses of the commands to be compiled
+        [[nodiscard]] const std::set<Word>& commands() const noexcept { return m_commands; }
+
+        /// @return source of a translation unit defining `const Emulator::RecompiledProgram <name>`
+        [[nodiscard]] std::string translate(std::string_view name) const;
+
+        /// whether the command with the given opcode is compiled rather than left to the interpreter
+        [[nodiscard]] static bool is_compiled(Byte opCode) noexcept;
+
+    private:
+        /// the compiled ones of the reachable commands
+        void collect_commands();
+
+        /// the C++ statements implementing the command at the given address
+        [[nodiscard]] std::string translate_command(Word address, std::set<Word> &labels) const;
+
+        /// the statement continuing at the given address, a jump within the compiled code if possible
+        [[nodiscard]] std::string continue_at(Word address, std::set<Word> &labels) const;
+
+        ROM m_image;
+        ControlFlowGraph m_graph;
+        std::set<Word> m_commands;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_RECOMPILER_HPP
@@ -0,0 +1,112 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <algorithm>
+
+#include "Recorder.hpp"
+
+
+Emulator::Recorder::Recorder(Emulator::MOS6502 &cpu, Emulator::Recorder::Configuration configuration):
+        m_cpu{cpu}, m_configuration{configuration} {
+    m_configuration.snapshotInterval = std::max<size_t>(m_configuration.snapshotInterval, 1);
+    m_configuration.maxSnapshots = std::max<size_t>(m_configuration.maxSnapshots, 1);
+
+    m_cpu.memory.attach_journal(&m_journal);
+    take_snapshot();
+}
+
+Emulator::Recorder::~Recorder() {
+    m_cpu.memory.attach_journal(nullptr);
+}
+
+Emulator::Recorder::ExecutionResult Emulator::Recorder::run(size_t commands) {
+    ExecutionResult result = MOS6502::StopOnMaxReached{.address = m_cpu.PC};
+
+    const auto previousLimit = m_cpu.maxNumberOfCommandsToExecute;
+    while (commands > 0) {
+        const auto untilSnapshot = m_configuration.snapshotInterval - m_position % m_configuration.snapshotInterval;
+        const auto retiredBefore = m_cpu.metrics.instructionsRetired.load();
+
+        m_cpu.maxNumberOfCommandsToExecute = std::min(commands, untilSnapshot);
+        result = m_cpu.execute();
+
+        const auto executed = m_cpu.metrics.instructionsRetired.load() - retiredBefore;
+        m_position += executed;
+        commands -= executed;
+        if (m_position % m_configuration.snapshotInterval == 0) take_snapshot();
+
+        if (!result.has_value() || !std::holds_alternative<MOS6502::StopOnMaxReached>(result.value())) break;
+    }
+    m_cpu.maxNumberOfCommandsToExecute = previousLimit;
+
+    return result;
+}
+
+bool Emulator::Recorder::seek(size_t position) {
+    if (position > m_position || position < earliest_position()) return false;
+
+    const auto snapshot = *std::prev(std::ranges::upper_bound(m_snapshots, position, {}, &Snapshot::position));
+    restore(snapshot);
+    replay(position - snapshot.position);
+    return true;
+}
+
+bool Emulator::Recorder::seek_cycle(size_t cycle) {
+    if (cycle > m_cpu.cycle || cycle < m_snapshots.front().state.cycle) return false;
+
+    const auto isAfter = [cycle](const Snapshot &snapshot) { return snapshot.state.cycle > cycle; };
+    const auto snapshot = *std::prev(std::ranges::find_if(m_snapshots, isAfter));
+
+    // finding the last command that started at or before the given cycle, then reconstructing the state before it
+    const auto end = m_position;
+    restore(snapshot);
+    size_t position = m_position;
+    while (m_position < end) {
+        replay(1);
+        if (m_position == position || m_cpu.cycle > cycle) break;
+        position = m_position;
+    }
+    return seek(position);
+}
+
+void Emulator::Recorder::take_snapshot() {
+    if (!m_snapshots.empty() && m_snapshots.back().position == m_position) return;
+
+    m_snapshots.push_back({.position = m_position, .state = m_cpu.get_state(), .journalIndex = m_journalOffset + m_journal.size()});
+    if (m_snapshots.size() <= m_configuration.maxSnapshots) return;
+
+    // nothing can be reconstructed before the oldest remaining snapshot, so the journal before it is not needed anymore
+    m_snapshots.pop_front();
+    const auto obsolete = m_snapshots.front().journalIndex - m_journalOffset;
+    m_journal.erase(m_journal.begin(), m_journal.begin() + (ptrdiff_t)obsolete);
+    m_journalOffset += obsolete;
+}
+
+void Emulator::Recorder::restore(const Emulator::Recorder::Snapshot &snapshot) {
+    while (m_journalOffset + m_journal.size() > snapshot.journalIndex) {
+        m_cpu.memory.revert(m_journal.back());
+        m_journal.pop_back();
+    }
+
+    m_cpu.set_state(snapshot.state);
+    m_cpu.watchpointHit.reset();
+    m_cpu.stoppedAtBreakpoint.reset();
+
+    m_position = snapshot.position;
+    while (m_snapshots.back().position > snapshot.position) m_snapshots.pop_back();
+}
+
+void Emulator::Recorder::replay(size_t commands) {
+    while (commands > 0) {
+        const auto before = m_position;
+        const auto result = run(commands);
+        commands -= m_position - before;
+
+        // breakpoints and watchpoints are stepped over, other stops mean that the program cannot advance further
+        if (!result.has_value()) break;
+        if (!std::holds_alternative<MOS6502::StopOnBreakpoint>(result.value())
+            && !std::holds_alternative<MOS6502::StopOnWatchpoint>(result.value())
+            && m_position == before) break;
+    }
+}
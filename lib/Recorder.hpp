@@ -0,0 +1,106 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_RECORDER_HPP
+#define EMULATOR_MOS6502_RECORDER_HPP
+
+#include <deque>
+#include <expected>
+
+#include "MOS6502.hpp"
+
+namespace Emulator {
+
+    /**
+     * Records the execution of a CPU so that it can be stepped backwards.
+     *
+     * Every snapshotInterval commands the registers are saved, and every byte written by the program is journaled
+     *  together with its previous value. To go back to an earlier command, memory is restored by reverting the journal
+     *  down to the nearest preceding snapshot, registers are restored from it, and the remaining commands are re-executed.
+     * Execution is deterministic, so the reconstructed state is exactly the one the CPU had.
+     *
+     * Only the last maxSnapshots snapshots are kept; together with the journal written after the oldest of them
+     *  this bounds the memory overhead and determines how far back execution can be reconstructed.
+     */
+    class Recorder {
+    public:
+        struct Configuration {
+            /// number of commands between two consecutive snapshots
+            size_t snapshotInterval = 10'000;
+            /// maximal number of snapshots kept, the oldest ones are discarded first
+            size_t maxSnapshots = 256;
+        };
+
+        using ExecutionResult = std::expected<MOS6502::SuccessfulTermination, MOS6502::ErrorTermination>;
+
+        /// starts recording the given CPU from its current state
+        explicit Recorder(MOS6502 &cpu, Configuration configuration);
+        explicit Recorder(MOS6502 &cpu): Recorder(cpu, Configuration{}) {};
+        ~Recorder();
+
+        Recorder(const Recorder&) = delete;
+        Recorder& operator =(const Recorder&) = delete;
+
+        /**
+         * Executes at most the given number of commands, taking snapshots on the way.
+         * Stops earlier under the same conditions as MOS6502::execute().
+         */
+        ExecutionResult run(size_t commands);
+
+        /// number of commands executed since the recording started
+        [[nodiscard]] size_t position() const noexcept { return m_position; }
+
+        /// the earliest position that can still be reconstructed
+        [[nodiscard]] size_t earliest_position() const noexcept { return m_snapshots.front().position; }
+
+        /**
+         * Brings the CPU to the state it had after the given number of commands since the recording started.
+         *
+         * @return false if the position is in the future or was already discarded, the CPU is not modified then
+         */
+        bool seek(size_t position);
+
+        /// goes back by the given number of commands
+        bool step_back(size_t commands = 1) { return commands <= m_position && seek(m_position - commands); }
+
+        /**
+         * Brings the CPU to the state at the start of the command that was being executed at the given cycle.
+         *
+         * @return false if the cycle is in the future or before the earliest position
+         */
+        bool seek_cycle(size_t cycle);
+
+        [[nodiscard]] size_t snapshot_count() const noexcept { return m_snapshots.size(); }
+        [[nodiscard]] size_t journal_size() const noexcept { return m_journal.size(); }
+
+    private:
+        struct Snapshot {
+            size_t position;
+            MOS6502::State state;
+            /// absolute index of the first journal record written after the snapshot
+            size_t journalIndex;
+        };
+
+        void take_snapshot();
+
+        /// reverts memory and registers to the given snapshot, dropping everything recorded after it
+        void restore(const Snapshot &snapshot);
+
+        /// executes the given number of commands, stepping over breakpoints and watchpoints
+        void replay(size_t commands);
+
+        MOS6502 &m_cpu;
+        Configuration m_configuration;
+
+        std::deque<Snapshot> m_snapshots;
+        WriteJournal m_journal;
+        /// number of records discarded from the front of the journal
+        size_t m_journalOffset = 0;
+
+        size_t m_position = 0;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_RECORDER_HPP
@@ -0,0 +1,43 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <utility>
+
+#include "SaveStates.hpp"
+
+
+size_t Emulator::SaveStates::save() {
+    auto dirty = m_cpu.memory.collect_dirty_pages();
+    // the first save-state has nothing to be relative to
+    if (m_saves.empty()) dirty.set();
+
+    Save save{.state = m_cpu.get_state(), .pages = {}};
+    for (size_t page = 0; page < ROM::PAGES_COUNT; page++) {
+        if (!dirty[page]) continue;
+        auto &stored = save.pages[(Byte)page];
+        for (size_t offset = 0; offset < ROM::PAGE_SIZE; offset++)
+            stored[offset] = std::as_const(m_cpu.memory)[(Word)(page * ROM::PAGE_SIZE + offset)];
+    }
+    m_saves.push_back(std::move(save));
+    return m_saves.size() - 1;
+}
+
+bool Emulator::SaveStates::restore(size_t index) {
+    if (index >= m_saves.size()) return false;
+
+    ROM memory{};
+    for (size_t page = 0; page < ROM::PAGES_COUNT; page++) {
+        // the first save-state stores every page
+        auto save = m_saves.rend() - 1 - index;
+        while (!save->pages.contains((Byte)page)) save++;
+        memory.load((Word)(page * ROM::PAGE_SIZE), save->pages.at((Byte)page));
+    }
+
+    m_cpu.memory = memory;
+    m_cpu.set_state(m_saves[index].state);
+    // the memory is now exactly the one of the save-state, which the next one will be relative to
+    (void)m_cpu.memory.collect_dirty_pages();
+    m_saves.resize(index + 1);
+    return true;
+}
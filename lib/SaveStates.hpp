@@ -0,0 +1,57 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_SAVESTATES_HPP
+#define EMULATOR_MOS6502_SAVESTATES_HPP
+
+#include <array>
+#include <map>
+#include <vector>
+
+#include "MOS6502.hpp"
+
+namespace Emulator {
+
+    /**
+     * Save-states of a CPU, every one of them but the first storing only the pages of memory written since
+     *  the previous one, as reported by ROM::collect_dirty_pages(). The save-states are the consumer of the
+     *  dirty pages of the memory of the CPU, which nothing else may collect meanwhile.
+     *
+     * A save-state is restored by taking every page from the latest save-state up to it storing the page.
+     */
+    class SaveStates {
+    public:
+        /// the first save-state is taken by save()
+        explicit SaveStates(MOS6502 &cpu): m_cpu{cpu} {};
+
+        /// @return index of the new save-state
+        size_t save();
+
+        /**
+         * Brings the CPU to the given save-state, dropping the ones saved after it.
+         *
+         * @return false if there is no such save-state, the CPU is not modified then
+         */
+        bool restore(size_t index);
+
+        [[nodiscard]] size_t size() const noexcept { return m_saves.size(); }
+
+        /// number of pages stored by the given save-state
+        [[nodiscard]] size_t stored_pages(size_t index) const { return m_saves.at(index).pages.size(); }
+
+    private:
+        using Page = std::array<Byte, ROM::PAGE_SIZE>;
+
+        struct Save {
+            MOS6502::State state;
+            std::map<Byte, Page> pages;
+        };
+
+        MOS6502 &m_cpu;
+        std::vector<Save> m_saves;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_SAVESTATES_HPP
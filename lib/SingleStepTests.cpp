@@ -0,0 +1,461 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "SingleStepTests.hpp"
+
+using namespace Emulator;
+
+
+int SingleStepReader::peek() {
+    if (m_position == m_size) {
+        m_offset += m_size;
+        m_input.read(m_buffer.data(), (std::streamsize)m_buffer.size());
+        m_size = m_input.gcount();
+        m_position = 0;
+        if (m_size == 0) return -1;
+    }
+    return (unsigned char)m_buffer[m_position];
+}
+
+bool SingleStepReader::consume(char expected) {
+    if (peek() != (unsigned char)expected) return false;
+    m_position++;
+    return true;
+}
+
+void SingleStepReader::skip_whitespace() {
+    for (int c = peek(); c == ' ' || c == '\n' || c == '\r' || c == '\t'; c = peek()) m_position++;
+}
+
+bool SingleStepReader::fail(std::string message) {
+    m_error = ParseError{.offset = m_offset + m_position, .message = std::move(message)};
+    return false;
+}
+
+template<typename Member>
+bool SingleStepReader::parse_object(Member &&member) {
+    skip_whitespace();
+    if (!consume('{')) return fail("expected an object");
+    skip_whitespace();
+    if (consume('}')) return true;
+
+    while (true) {
+        if (!parse_string(m_key)) return false;
+        skip_whitespace();
+        if (!consume(':')) return fail("expected ':'");
+        if (!member(std::string_view(m_key))) return false;
+        skip_whitespace();
+        if (consume(',')) continue;
+        if (consume('}')) return true;
+        return fail("expected ',' or '}'");
+    }
+}
+
+template<typename Element>
+bool SingleStepReader::parse_array(Element &&element) {
+    skip_whitespace();
+    if (!consume('[')) return fail("expected an array");
+    skip_whitespace();
+    if (consume(']')) return true;
+
+    while (true) {
+        if (!element()) return false;
+        skip_whitespace();
+        if (consume(',')) continue;
+        if (consume(']')) return true;
+        return fail("expected ',' or ']'");
+    }
+}
+
+bool SingleStepReader::parse_string(std::string &value) {
+    skip_whitespace();
+    if (!consume('"')) return fail("expected a string");
+
+    value.clear();
+    while (true) {
+        const int c = peek();
+        if (c < 0) return fail("unterminated string");
+        m_position++;
+        if (c == '"') return true;
+        if (c != '\\') {
+            value.push_back((char)c);
+            continue;
+        }
+
+        const int escaped = peek();
+        m_position++;
+        switch (escaped) {
+            case '"': case '\\': case '/': value.push_back((char)escaped); break;
+            case 'b': value.push_back('\b'); break;
+            case 'f': value.push_back('\f'); break;
+            case 'n': value.push_back('\n'); break;
+            case 'r': value.push_back('\r'); break;
+            case 't': value.push_back('\t'); break;
+            case 'u': {
+                unsigned code = 0;
+                for (int i = 0; i < 4; i++, m_position++) {
+                    const int digit = peek();
+                    if (!std::isxdigit(digit)) return fail("invalid escape");
+                    code = code << 4 | (std::isdigit(digit) ? digit - '0' : (digit | 0x20) - 'a' + 10);
+                }
+                // encoded as UTF-8; the names of the cases are plain ASCII anyway
+                if (code < 0x80) value.push_back((char)code);
+                else if (code < 0x800) value += {(char)(0xC0 | code >> 6), (char)(0x80 | (code & 0x3F))};
+                else value += {(char)(0xE0 | code >> 12), (char)(0x80 | (code >> 6 & 0x3F)), (char)(0x80 | (code & 0x3F))};
+                break;
+            }
+            default: return fail("invalid escape");
+        }
+    }
+}
+
+bool SingleStepReader::parse_number(uint64_t &value, uint64_t max) {
+    skip_whitespace();
+    if (!std::isdigit(peek())) return fail("expected a number");
+
+    value = 0;
+    for (int digit = peek(); std::isdigit(digit); digit = peek()) {
+        value = value * 10 + (digit - '0');
+        if (value > max) return fail("number out of range");
+        m_position++;
+    }
+    return true;
+}
+
+bool SingleStepReader::skip_value() {
+    skip_whitespace();
+    const int c = peek();
+    if (c == '"') {
+        std::string ignored;
+        return parse_string(ignored);
+    }
+    if (c == '{') return parse_object([this](std::string_view) { return skip_value(); });
+    if (c == '[') return parse_array([this] { return skip_value(); });
+
+    // a number or a literal
+    const auto scalar = [](int c) { return std::isalnum(c) || c == '-' || c == '+' || c == '.'; };
+    if (!scalar(c)) return fail("expected a value");
+    while (scalar(peek())) m_position++;
+    return true;
+}
+
+bool SingleStepReader::parse_state(SingleStepState &state) {
+    state.ram.clear();
+    return parse_object([this, &state](std::string_view key) {
+        uint64_t value = 0;
+        if (key == "ram") {
+            return parse_array([this, &state] {
+                uint64_t address = 0, byte = 0;
+                skip_whitespace();
+                if (!consume('[')) return fail("expected an [address, value] pair");
+                if (!parse_number(address, UINT16_MAX)) return false;
+                skip_whitespace();
+                if (!consume(',')) return fail("expected ','");
+                if (!parse_number(byte, UINT8_MAX)) return false;
+                skip_whitespace();
+                if (!consume(']')) return fail("expected ']'");
+                state.ram.emplace_back((Word)address, (Byte)byte);
+                return true;
+            });
+        }
+
+        if (key == "pc") {
+            if (!parse_number(value, UINT16_MAX)) return false;
+            state.pc = value;
+            return true;
+        }
+        Byte *reg = key == "s" ? &state.s : key == "a" ? &state.a : key == "x" ? &state.x
+                  : key == "y" ? &state.y : key == "p" ? &state.p : nullptr;
+        if (reg == nullptr) return skip_value();
+        if (!parse_number(value, UINT8_MAX)) return false;
+        *reg = value;
+        return true;
+    });
+}
+
+bool SingleStepReader::parse_cycles(std::vector<CycleStepper::BusAccess> &cycles) {
+    cycles.clear();
+    return parse_array([this, &cycles] {
+        uint64_t address = 0, value = 0;
+        skip_whitespace();
+        if (!consume('[')) return fail("expected an [address, value, access] cycle");
+        if (!parse_number(address, UINT16_MAX)) return false;
+        skip_whitespace();
+        if (!consume(',')) return fail("expected ','");
+        if (!parse_number(value, UINT8_MAX)) return false;
+        skip_whitespace();
+        if (!consume(',')) return fail("expected ','");
+        if (!parse_string(m_key)) return false;
+        skip_whitespace();
+        if (!consume(']')) return fail("expected ']'");
+
+        Access access;
+        if (m_key == "read") access = Access::READ;
+        else if (m_key == "write") access = Access::WRITE;
+        else return fail("unknown access " + m_key);
+        cycles.push_back({.cycle = cycles.size(), .address = (Word)address, .value = (Byte)value, .access = access});
+        return true;
+    });
+}
+
+bool SingleStepReader::parse_case(SingleStepCase &testCase) {
+    enum Key { NAME = 1, INITIAL = 2, FINAL = 4, CYCLES = 8 };
+    int keys = 0;
+    const bool parsed = parse_object([this, &testCase, &keys](std::string_view key) {
+        if (key == "name") { keys |= NAME; return parse_string(testCase.name); }
+        if (key == "initial") { keys |= INITIAL; return parse_state(testCase.initial); }
+        if (key == "final") { keys |= FINAL; return parse_state(testCase.final); }
+        if (key == "cycles") { keys |= CYCLES; return parse_cycles(testCase.cycles); }
+        return skip_value();
+    });
+    if (!parsed) return false;
+    if (keys != (NAME | INITIAL | FINAL | CYCLES)) return fail("a case needs a name, an initial and a final state and its cycles");
+    return true;
+}
+
+std::expected<bool, ParseError> SingleStepReader::next(SingleStepCase &testCase) {
+    if (m_finished) return false;
+
+    skip_whitespace();
+    if (!m_started) {
+        if (!consume('[')) {
+            fail("expected an array of cases");
+            return std::unexpected(*m_error);
+        }
+        m_started = true;
+        skip_whitespace();
+        if (consume(']')) {
+            m_finished = true;
+            return false;
+        }
+    }
+    else {
+        if (consume(']')) {
+            m_finished = true;
+            return false;
+        }
+        if (!consume(',')) {
+            fail("expected ',' or ']'");
+            return std::unexpected(*m_error);
+        }
+    }
+
+    if (!parse_case(testCase)) return std::unexpected(*m_error);
+    return true;
+}
+
+
+
+SingleStepRunner::SingleStepRunner() noexcept: m_stepper{m_cpu} {
+    // a single command at a time, exactly as it is
+    m_cpu.stop_on_break(false);
+    m_cpu.skip_idle_loops(false);
+    m_cpu.accelerate_loops(false);
+    m_cpu.max_number_of_commands(1);
+    m_cpu.memory.attach_journal(&m_journal);
+    m_stepper.set_bus_callback([this](const CycleStepper::BusAccess &access) { m_cycles.push_back(access); });
+}
+
+void SingleStepRunner::load(const SingleStepState &state) noexcept {
+    for (const auto &[address, value]: state.ram) m_cpu.memory.load(address, std::span{&value, 1});
+    m_cpu.set_state({.PC = state.pc, .AC = state.a, .X = state.x, .Y = state.y, .SR = state.p, .SP = state.s, .cycle = 0});
+    m_journal.clear();
+}
+
+void SingleStepRunner::clear(const SingleStepState &state) noexcept {
+    static constexpr Byte zero = 0;
+    for (const auto &[address, value]: state.ram) m_cpu.memory.load(address, std::span{&zero, 1});
+    for (const auto &record: m_journal) m_cpu.memory.load(record.address, std::span{&zero, 1});
+    m_journal.clear();
+}
+
+std::optional<std::string> SingleStepRunner::compare(const SingleStepState &expected) const {
+    // neither the break bit nor the unused one exist in the register, they only show in its pushed copies
+    static constexpr Byte PHANTOM_FLAGS = 0x30;
+
+    const auto differs = [](std::string_view what, unsigned actual, unsigned expected) {
+        return std::vformat("{} is {:#04x}, expected {:#04x}", std::make_format_args(what, actual, expected));
+    };
+    const auto state = m_cpu.get_state();
+    if (state.PC != expected.pc) return differs("PC", state.PC, expected.pc);
+    if (state.SP != expected.s) return differs("S", state.SP, expected.s);
+    if (state.AC != expected.a) return differs("A", state.AC, expected.a);
+    if (state.X != expected.x) return differs("X", state.X, expected.x);
+    if (state.Y != expected.y) return differs("Y", state.Y, expected.y);
+    if ((state.SR.to_byte() ^ expected.p) & ~PHANTOM_FLAGS) return differs("P", state.SR.to_byte(), expected.p);
+
+    for (const auto &[address, value]: expected.ram) {
+        const Byte actual = std::as_const(m_cpu.memory)[address];
+        if (actual != value) return differs(std::format("${:04x}", address), actual, value);
+    }
+    for (const auto &record: m_journal) {
+        const auto listed = std::ranges::any_of(expected.ram, [&record](const auto &byte) { return byte.first == record.address; });
+        if (!listed) return std::format("${:04x} was written, but it is not in the final memory", record.address);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> SingleStepRunner::run_interpreted(const SingleStepCase &testCase) {
+    load(testCase.initial);
+    const auto result = m_cpu.execute();
+
+    auto difference = [&]() -> std::optional<std::string> {
+        if (!result.has_value()) {
+            const Word address = std::visit([](const auto &termination) { return termination.address; }, result.error());
+            return std::format("halted at ${:04x}", address);
+        }
+        if (auto state = compare(testCase.final)) return state;
+        if (m_cpu.get_state().cycle != testCase.cycles.size())
+            return std::format("took {:d} cycles, expected {:d}", m_cpu.get_state().cycle, testCase.cycles.size());
+        return std::nullopt;
+    }();
+    clear(testCase.initial);
+    return difference;
+}
+
+std::optional<std::string> SingleStepRunner::run_stepped(const SingleStepCase &testCase) {
+    load(testCase.initial);
+    m_stepper.reset();
+    m_cycles.clear();
+    m_stepper.step_command();
+
+    auto difference = [&]() -> std::optional<std::string> {
+        if (auto state = compare(testCase.final)) return state;
+        for (size_t i = 0; i < std::min(m_cycles.size(), testCase.cycles.size()); i++) {
+            const auto &actual = m_cycles[i];
+            const auto &expected = testCase.cycles[i];
+            if (actual.address != expected.address || actual.value != expected.value || actual.access != expected.access)
+                return std::format("cycle {:d} is {} ${:04x} = {:#04x}, expected {} ${:04x} = {:#04x}", i,
+                                   to_string(actual.access), actual.address, actual.value,
+                                   to_string(expected.access), expected.address, expected.value);
+        }
+        if (m_cycles.size() != testCase.cycles.size())
+            return std::format("took {:d} cycles, expected {:d}", m_cycles.size(), testCase.cycles.size());
+        return std::nullopt;
+    }();
+    clear(testCase.initial);
+    return difference;
+}
+
+
+
+namespace {
+
+    /// cases handed to a thread at once
+    constexpr size_t BATCH_SIZE = 256;
+
+    /// the storage of the cases is reused by the following batches
+    struct Batch {
+        size_t first = 0;
+        size_t size = 0;
+        std::vector<SingleStepCase> cases{BATCH_SIZE};
+    };
+
+}
+
+std::expected<SingleStepReport, ParseError> Emulator::run_single_step_tests(std::istream &input, unsigned threads, size_t maxFailures) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::mutex mutex;
+    std::condition_variable filled, drained;
+    std::deque<std::unique_ptr<Batch>> pending, spare;
+    bool finished = false;
+    SingleStepReport report;
+
+    const auto work = [&] {
+        const auto runner = std::make_unique<SingleStepRunner>();
+        SingleStepReport local;
+        std::unique_ptr<Batch> batch;
+        while (true) {
+            {
+                std::unique_lock lock(mutex);
+                if (batch) spare.push_back(std::move(batch));
+                filled.wait(lock, [&] { return !pending.empty() || finished; });
+                if (pending.empty()) break;
+                batch = std::move(pending.front());
+                pending.pop_front();
+            }
+            drained.notify_one();
+
+            for (size_t i = 0; i < batch->size; i++) {
+                const auto &testCase = batch->cases[i];
+                const auto failed = [&](size_t &count, std::string_view engine, const std::string &difference) {
+                    count++;
+                    if (local.failures.size() < maxFailures)
+                        local.failures.push_back({.index = batch->first + i, .name = testCase.name,
+                                                  .difference = std::format("{}: {}", engine, difference)});
+                };
+                if (const auto difference = runner->run_interpreted(testCase)) failed(local.interpreterFailures, "interpreter", *difference);
+                if (const auto difference = runner->run_stepped(testCase)) failed(local.stepperFailures, "cycle stepper", *difference);
+            }
+        }
+
+        // every thread takes the batches in order, so the first failures overall are among its first ones
+        std::lock_guard lock(mutex);
+        report.interpreterFailures += local.interpreterFailures;
+        report.stepperFailures += local.stepperFailures;
+        std::ranges::move(local.failures, std::back_inserter(report.failures));
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; i++) workers.emplace_back(work);
+
+    SingleStepReader reader(input);
+    std::optional<ParseError> error;
+    size_t cases = 0;
+    for (bool more = true; more && !error.has_value();) {
+        std::unique_ptr<Batch> batch;
+        {
+            std::unique_lock lock(mutex);
+            drained.wait(lock, [&] { return pending.size() < 2 * threads; });
+            if (!spare.empty()) {
+                batch = std::move(spare.back());
+                spare.pop_back();
+            }
+        }
+        if (!batch) batch = std::make_unique<Batch>();
+
+        batch->first = cases;
+        batch->size = 0;
+        while (batch->size < BATCH_SIZE) {
+            const auto read = reader.next(batch->cases[batch->size]);
+            if (!read.has_value()) error = read.error();
+            if (!read.value_or(false)) {
+                more = false;
+                break;
+            }
+            batch->size++;
+        }
+        cases += batch->size;
+
+        if (batch->size == 0) continue;
+        {
+            std::lock_guard lock(mutex);
+            pending.push_back(std::move(batch));
+        }
+        filled.notify_one();
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        finished = true;
+    }
+    filled.notify_all();
+    for (auto &worker: workers) worker.join();
+
+    if (error.has_value()) return std::unexpected(*error);
+    report.cases = cases;
+    std::ranges::stable_sort(report.failures, {}, &SingleStepFailure::index);
+    if (report.failures.size() > maxFailures) report.failures.resize(maxFailures);
+    return report;
+}
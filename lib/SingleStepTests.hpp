@@ -0,0 +1,161 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_SINGLESTEPTESTS_HPP
+#define EMULATOR_MOS6502_SINGLESTEPTESTS_HPP
+
+#include <expected>
+#include <format>
+#include <istream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MOS6502.hpp"
+#include "CycleStepper.hpp"
+
+namespace Emulator {
+
+    /*
+     * Per-instruction conformance vectors in the format of the SingleStepTests suite: a JSON array per opcode, every
+     *  case of which gives the registers and the touched memory before and after a single command, and every cycle
+     *  of the bus in between.
+     */
+
+    struct SingleStepState {
+        Word pc;
+        Byte s, a, x, y, p;
+        /// every byte the command may touch, as address and value
+        std::vector<std::pair<Word, Byte>> ram;
+    };
+
+    struct SingleStepCase {
+        std::string name;
+        SingleStepState initial;
+        SingleStepState final;
+        /// the cycle of every access is its index
+        std::vector<CycleStepper::BusAccess> cycles;
+    };
+
+    struct ParseError {
+        /// offset in the input where parsing stopped
+        size_t offset;
+        std::string message;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("Invalid test vectors at offset {:d}: {}", std::make_format_args(offset, message));
+        }
+    };
+
+
+    /**
+     * Reads the cases one at a time from a stream, holding no more than a buffer of the input and the current case.
+     * The parser knows the layout of the cases and skips any other keys.
+     */
+    class SingleStepReader {
+    public:
+        explicit SingleStepReader(std::istream &input): m_input{input}, m_buffer(BUFFER_SIZE) {}
+
+        /**
+         * Reads the next case into the given one, reusing its storage.
+         *
+         * @return false after the last case
+         */
+        std::expected<bool, ParseError> next(SingleStepCase &testCase);
+
+    private:
+        static constexpr size_t BUFFER_SIZE = 1 << 16;
+
+        /// -1 at the end of the input
+        [[nodiscard]] int peek();
+        [[nodiscard]] bool consume(char expected);
+        void skip_whitespace();
+
+        /// calls the member with every key, positioned at its value
+        template<typename Member>
+        bool parse_object(Member &&member);
+        template<typename Element>
+        bool parse_array(Element &&element);
+
+        bool parse_case(SingleStepCase &testCase);
+        bool parse_state(SingleStepState &state);
+        bool parse_cycles(std::vector<CycleStepper::BusAccess> &cycles);
+        bool parse_string(std::string &value);
+        bool parse_number(uint64_t &value, uint64_t max);
+        bool skip_value();
+
+        /// records the error at the current offset
+        bool fail(std::string message);
+
+        std::istream &m_input;
+        std::vector<char> m_buffer;
+        size_t m_position = 0;
+        size_t m_size = 0;
+        /// offset of the start of the buffer in the input
+        size_t m_offset = 0;
+
+        bool m_started = false;
+        bool m_finished = false;
+        std::string m_key;
+        std::optional<ParseError> m_error;
+    };
+
+
+    /**
+     * Runs cases on a CPU of its own with both engines: MOS6502::execute() and the CycleStepper.
+     * Each case starts from a fresh state: between cases only the bytes given by the previous case and the ones
+     *  written by it are cleared, as recorded by the write journal of the memory, rather than all of the memory.
+     */
+    class SingleStepRunner {
+    public:
+        SingleStepRunner() noexcept;
+
+        /// @return description of the first difference from the expected outcome, if any
+        std::optional<std::string> run_interpreted(const SingleStepCase &testCase);
+
+        /// compares every cycle of the bus too
+        std::optional<std::string> run_stepped(const SingleStepCase &testCase);
+
+    private:
+        void load(const SingleStepState &state) noexcept;
+        void clear(const SingleStepState &state) noexcept;
+        [[nodiscard]] std::optional<std::string> compare(const SingleStepState &expected) const;
+
+        MOS6502 m_cpu;
+        CycleStepper m_stepper;
+        WriteJournal m_journal;
+        std::vector<CycleStepper::BusAccess> m_cycles;
+    };
+
+
+    struct SingleStepFailure {
+        /// index of the case in the input
+        size_t index;
+        std::string name;
+        /// the engine and the first difference
+        std::string difference;
+    };
+
+    struct SingleStepReport {
+        size_t cases = 0;
+        size_t interpreterFailures = 0;
+        size_t stepperFailures = 0;
+        /// the first failures in the order of the input
+        std::vector<SingleStepFailure> failures;
+    };
+
+    /**
+     * Streams the cases from the input to the given number of threads, every one of them running batches of cases
+     *  with a SingleStepRunner of its own, while the calling thread reads the next batches.
+     *
+     * @param threads 0 for a thread per core
+     * @param maxFailures number of failures to describe in the report; all of them are counted
+     */
+    std::expected<SingleStepReport, ParseError> run_single_step_tests(std::istream &input, unsigned threads = 0,
+                                                                      size_t maxFailures = 10);
+
+}
+
+#endif //EMULATOR_MOS6502_SINGLESTEPTESTS_HPP
@@ -0,0 +1,295 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "TimingAnalyzer.hpp"
+#include "OpcodeTable.hpp"
+#include "Microcode.hpp"
+
+
+namespace {
+
+    using Emulator::CycleRange;
+
+    /// widens the range to include the other one, if there is any range yet
+    void merge(std::optional<CycleRange> &range, CycleRange other) noexcept {
+        if (!range.has_value()) range = other;
+        else range = CycleRange{.best = std::min(range->best, other.best), .worst = std::max(range->worst, other.worst)};
+    }
+
+    CycleRange operator+(CycleRange range, CycleRange other) noexcept {
+        return {.best = range.best + other.best, .worst = range.worst + other.worst};
+    }
+
+    CycleRange operator+(CycleRange range, size_t cycles) noexcept {
+        return {.best = range.best + cycles, .worst = range.worst + cycles};
+    }
+
+}
+
+
+Emulator::TimingAnalyzer::TimingAnalyzer(const ROM &image): m_graph{image}, m_image{image} {}
+
+void Emulator::TimingAnalyzer::bound_loop(Word header, LoopBound bound) {
+    m_bounds[header] = bound;
+    m_routines.clear();
+}
+
+auto Emulator::TimingAnalyzer::analyze(Word routine) -> std::expected<CycleRange, TimingError> {
+    if (const auto known = m_routines.find(routine); known != m_routines.end()) return known->second;
+    if (m_analyzing.contains(routine)) return std::unexpected(RecursiveCall{.subroutine = routine});
+    if (!m_graph.blocks().contains(routine)) m_graph.add_entry(routine);
+
+    m_analyzing.insert(routine);
+    const auto result = analyze_routine(routine);
+    m_analyzing.erase(routine);
+
+    if (result.has_value()) m_routines.emplace(routine, result.value());
+    return result;
+}
+
+auto Emulator::TimingAnalyzer::analyze_block(const BasicBlock &block) -> std::expected<Node, TimingError> {
+    Node node{.cycles = {.best = 0, .worst = 0}, .successors = {}, .returns = false};
+    for (Word address = block.start;; address += OPCODES[std::as_const(m_image)[address]].length) {
+        const auto &info = OPCODES[std::as_const(m_image)[address]];
+        node.cycles = node.cycles + CycleRange{.best = info.cycles, .worst = info.cycles + (size_t)info.pageCrossPenalty};
+        if (address == block.last) break;
+    }
+
+    const Byte opCode = std::as_const(m_image)[block.last];
+    const Word operand = m_image.get_word(block.last + 1);
+    switch (MICROCODE[opCode].mnemonic) {
+        case Mnemonic::BRK:
+        case Mnemonic::JAM:
+            return std::unexpected(UnknownControlFlow{.address = block.last});
+        case Mnemonic::RTS:
+        case Mnemonic::RTI:
+            node.returns = true;
+            return node;
+        case Mnemonic::JSR: {
+            const auto subroutine = analyze(operand);
+            if (!subroutine.has_value()) return std::unexpected(subroutine.error());
+            node.cycles = node.cycles + subroutine.value();
+            node.successors.emplace_back(block.last + 3, 0);
+            return node;
+        }
+        case Mnemonic::JMP:
+            if (OPCODES[opCode].mode == AddressingMode::INDIRECT && block.successors.empty())
+                return std::unexpected(UnknownControlFlow{.address = block.last});
+            break;
+        default:
+            break;
+    }
+
+    for (const auto &edge: block.successors) {
+        switch (edge.kind) {
+            case EdgeKind::FALL_THROUGH:
+            case EdgeKind::JUMP:
+            case EdgeKind::INDIRECT_JUMP:
+                node.successors.emplace_back(edge.to, 0);
+                break;
+            case EdgeKind::BRANCH: {
+                // a taken branch costs a cycle, and another one if it crosses the page
+                const Word next = block.last + 2;
+                node.successors.emplace_back(edge.to, WordToBytes(next).high != WordToBytes(edge.to).high ? 2 : 1);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return node;
+}
+
+auto Emulator::TimingAnalyzer::analyze_routine(Word routine) -> std::expected<CycleRange, TimingError> {
+    // the blocks of the routine, the calls counted within the blocks calling
+    std::map<Word, Node> nodes;
+    std::map<Word, std::vector<Word>> predecessors;
+    std::vector<Word> pending{routine};
+    while (!pending.empty()) {
+        const Word start = pending.back();
+        pending.pop_back();
+        if (nodes.contains(start)) continue;
+
+        // copied, since analyzing the subroutines might add entries to the graph
+        const BasicBlock block = m_graph.blocks().at(start);
+        const auto node = analyze_block(block);
+        if (!node.has_value()) return std::unexpected(node.error());
+        for (const auto &[successor, cycles]: node->successors) {
+            predecessors[successor].push_back(start);
+            pending.push_back(successor);
+        }
+        nodes.emplace(start, node.value());
+    }
+
+    // the edges back to a block on the path from the routine are the ones closing loops
+    std::map<Word, std::vector<Word>> backEdges;
+    {
+        std::set<Word> visited{routine}, onPath{routine};
+        std::vector<std::pair<Word, size_t>> path{{routine, 0}};
+        while (!path.empty()) {
+            auto &[start, index] = path.back();
+            const auto &successors = nodes.at(start).successors;
+            if (index == successors.size()) {
+                onPath.erase(start);
+                path.pop_back();
+                continue;
+            }
+            const Word successor = successors[index++].first;
+            if (onPath.contains(successor)) backEdges[successor].push_back(start);
+            else if (visited.insert(successor).second) {
+                onPath.insert(successor);
+                path.emplace_back(successor, 0);
+            }
+        }
+    }
+
+    struct Loop {
+        Word header;
+        std::set<Word> body;
+        /// index of the innermost loop containing this one, SIZE_MAX for the routine itself
+        size_t parent = SIZE_MAX;
+    };
+    std::vector<Loop> loops;
+    for (const auto &[header, sources]: backEdges) {
+        const auto bound = m_bounds.find(header);
+        if (bound == m_bounds.end()) return std::unexpected(UnboundedLoop{.header = header});
+        if (bound->second.minimum == 0 || bound->second.minimum > bound->second.maximum)
+            return std::unexpected(InvalidLoop{.header = header});
+
+        Loop loop{.header = header, .body = {header}};
+        std::vector<Word> reaching = sources;
+        while (!reaching.empty()) {
+            const Word start = reaching.back();
+            reaching.pop_back();
+            if (loop.body.insert(start).second) reaching.insert(reaching.end(), predecessors[start].begin(), predecessors[start].end());
+        }
+        // only the header may be reached from outside of the loop
+        for (const Word start: loop.body) {
+            if (start == header) continue;
+            if (start == routine || std::ranges::any_of(predecessors[start], [&](Word from) { return !loop.body.contains(from); }))
+                return std::unexpected(InvalidLoop{.header = header});
+        }
+        loops.push_back(std::move(loop));
+    }
+
+    // loops are either nested or disjoint, so the inner ones are smaller
+    std::ranges::sort(loops, {}, [](const Loop &loop) { return loop.body.size(); });
+    std::map<Word, size_t> innermost, headers;
+    for (size_t i = 0; i < loops.size(); i++) {
+        headers[loops[i].header] = i;
+        for (const Word start: loops[i].body) innermost.try_emplace(start, i);
+        for (size_t j = i + 1; j < loops.size() && loops[i].parent == SIZE_MAX; j++)
+            if (loops[j].body.contains(loops[i].header)) loops[i].parent = j;
+    }
+
+    std::vector<Summary> summaries(loops.size());
+
+    // summarizes the loop with the given index, or the routine itself, with all the loops nested in it summarized before
+    const auto summarize = [&](size_t region) -> std::expected<Summary, TimingError> {
+        const Word entry = region == SIZE_MAX ? routine : loops[region].header;
+        // the region is summarized in terms of its own blocks, the routine might start with a loop though
+        const auto header = region == SIZE_MAX ? std::nullopt : std::optional{entry};
+        const auto contains = [&](Word start) { return region == SIZE_MAX || loops[region].body.contains(start); };
+
+        // the block itself, or the outermost loop containing it nested in the region
+        const auto representative = [&](Word start) {
+            const auto loop = innermost.find(start);
+            if (loop == innermost.end() || loop->second == region) return start;
+            size_t outer = loop->second;
+            while (loops[outer].parent != region) outer = loops[outer].parent;
+            return loops[outer].header;
+        };
+        // the cycles and successors of a block, or of a nested loop
+        const auto expand = [&](Word start) -> Summary {
+            if (start != header && headers.contains(start)) return summaries[headers.at(start)];
+            const auto &node = nodes.at(start);
+            Summary result{.cycles = node.cycles, .exits = {}, .returns = node.returns};
+            for (const auto &[successor, cycles]: node.successors) result.exits.insert(successor);
+            return result;
+        };
+        const auto successors = [&](Word start) {
+            std::vector<std::pair<Word, size_t>> result;
+            if (start != header && headers.contains(start))
+                for (const Word exit: summaries[headers.at(start)].exits) result.emplace_back(exit, 0);
+            else result = nodes.at(start).successors;
+            return result;
+        };
+
+        // the blocks of the region in topological order, the edges back to its entry being left out
+        std::vector<Word> order;
+        {
+            std::set<Word> visited{entry}, onPath{entry};
+            std::vector<std::pair<Word, std::vector<std::pair<Word, size_t>>>> path{{entry, successors(entry)}};
+            while (!path.empty()) {
+                auto &[start, remaining] = path.back();
+                if (remaining.empty()) {
+                    order.push_back(start);
+                    onPath.erase(start);
+                    path.pop_back();
+                    continue;
+                }
+                const Word successor = remaining.back().first;
+                remaining.pop_back();
+                if (successor == header || !contains(successor)) continue;
+
+                const Word next = representative(successor);
+                if (onPath.contains(next)) return std::unexpected(InvalidLoop{.header = next});
+                if (visited.insert(next).second) {
+                    onPath.insert(next);
+                    path.emplace_back(next, successors(next));
+                }
+            }
+            std::ranges::reverse(order);
+        }
+
+        std::map<Word, std::optional<CycleRange>> arrivals{{entry, CycleRange{.best = 0, .worst = 0}}};
+        std::optional<CycleRange> repeated, left;
+        Summary result{.cycles = {}, .exits = {}, .returns = false};
+        for (const Word start: order) {
+            const auto arrival = arrivals[start];
+            if (!arrival.has_value()) continue;
+
+            const auto block = expand(start);
+            const CycleRange done = arrival.value() + block.cycles;
+            if (block.returns) {
+                merge(left, done);
+                result.returns = true;
+            }
+            for (const auto &[successor, cycles]: successors(start)) {
+                if (successor == header) merge(repeated, done + cycles);
+                else if (!contains(successor)) {
+                    merge(left, done + cycles);
+                    result.exits.insert(successor);
+                }
+                else merge(arrivals[representative(successor)], done + cycles);
+            }
+        }
+
+        if (!left.has_value()) return std::unexpected(NoExit{.address = entry});
+        if (region == SIZE_MAX) {
+            result.cycles = left.value();
+            return result;
+        }
+
+        // every iteration but the last one goes back to the header, the last one leaves the loop
+        const auto &bound = m_bounds.at(entry);
+        const CycleRange iteration = repeated.value_or(CycleRange{.best = 0, .worst = 0});
+        result.cycles = {.best = (bound.minimum - 1) * iteration.best + left->best,
+                         .worst = (bound.maximum - 1) * iteration.worst + left->worst};
+        return result;
+    };
+
+    for (size_t i = 0; i < loops.size(); i++) {
+        auto summary = summarize(i);
+        if (!summary.has_value()) return std::unexpected(summary.error());
+        summaries[i] = std::move(summary.value());
+    }
+    const auto summary = summarize(SIZE_MAX);
+    if (!summary.has_value()) return std::unexpected(summary.error());
+    return summary->cycles;
+}
@@ -0,0 +1,129 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_TIMINGANALYZER_HPP
+#define EMULATOR_MOS6502_TIMINGANALYZER_HPP
+
+#include <expected>
+#include <format>
+#include <map>
+#include <set>
+#include <string>
+#include <variant>
+
+#include "ControlFlow.hpp"
+
+namespace Emulator {
+
+    /// the fewest and the most cycles something may take
+    struct CycleRange {
+        size_t best;
+        size_t worst;
+
+        bool operator==(const CycleRange &other) const noexcept = default;
+    };
+
+    /// how many times the first command of a loop is executed every time the loop is entered
+    struct LoopBound {
+        size_t minimum;
+        size_t maximum;
+    };
+
+
+    struct UnboundedLoop {
+        Word header;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("The loop at {:#06x} has no bound", std::make_format_args(header));
+        }
+    };
+
+    /// a loop entered other than through its first command, or a bound with its minimum above its maximum
+    struct InvalidLoop {
+        Word header;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("The loop at {:#06x} is entered in the middle or has an invalid bound", std::make_format_args(header));
+        }
+    };
+
+    /// a loop, or the routine itself, that never returns
+    struct NoExit {
+        Word address;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("The code at {:#06x} never returns", std::make_format_args(address));
+        }
+    };
+
+    /// JMP (indirect) whose target is not known, BRK or JAM
+    struct UnknownControlFlow {
+        Word address;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("The command at {:#06x} continues at an unknown address", std::make_format_args(address));
+        }
+    };
+
+    struct RecursiveCall {
+        Word subroutine;
+
+        [[nodiscard]] std::string to_string() const noexcept {
+            return std::vformat("The subroutine at {:#06x} calls itself", std::make_format_args(subroutine));
+        }
+    };
+
+    using TimingError = std::variant<UnboundedLoop, InvalidLoop, NoExit, UnknownControlFlow, RecursiveCall>;
+
+
+    /**
+     * Static analysis of the number of cycles routines of a ROM image take, from their first command up to and
+     *  including the RTS or RTI returning from them, as the published timing of MOS6502 counts them.
+     *
+     * Every path through the routine is followed in its ControlFlowGraph; the subroutines it calls are analyzed
+     *  the same way. Crossing the page costs a cycle in the worst case only, while the cost of a taken branch is known.
+     * Loops have to be reducible and bounded by bound_loop(); an iteration may take any path through the loop, and the
+     *  loop may be left at any of its exits, so that the range is safe, although possibly wider than the actual one.
+     */
+    class TimingAnalyzer {
+    public:
+        explicit TimingAnalyzer(const ROM &image);
+
+        /// the loop whose first command is at the given address is executed within the given bound every time it is entered
+        void bound_loop(Word header, LoopBound bound);
+
+        [[nodiscard]] std::expected<CycleRange, TimingError> analyze(Word routine);
+
+    private:
+        /// a block with the subroutine it calls, if any
+        struct Node {
+            CycleRange cycles;
+            /// the blocks following it and the cycles taken by getting there
+            std::vector<std::pair<Word, size_t>> successors;
+            bool returns;
+        };
+
+        /// the range of a loop from entering it to leaving it, and where it may be left for
+        struct Summary {
+            CycleRange cycles;
+            std::set<Word> exits;
+            bool returns;
+        };
+
+        [[nodiscard]] std::expected<CycleRange, TimingError> analyze_routine(Word routine);
+
+        [[nodiscard]] std::expected<Node, TimingError> analyze_block(const BasicBlock &block);
+
+        ControlFlowGraph m_graph;
+        ROM m_image;
+        std::map<Word, LoopBound> m_bounds;
+
+        std::map<Word, CycleRange> m_routines;
+        /// the routines being analyzed, to detect recursion
+        std::set<Word> m_analyzing;
+    };
+
+}
+
+#endif //EMULATOR_MOS6502_TIMINGANALYZER_HPP
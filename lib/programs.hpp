@@ -6,17 +6,74 @@
 #define EMULATOR_MOS6502_PROGRAMS_HPP
 
 #include "MOS6502_definitions.hpp"
+#include "Assembler.hpp"
 
 using namespace Emulator;
 
+/*
+ * Built-in programs, assembled at compile time from their listings.
+ */
+
+inline constexpr AssemblySource MULTIPLICATION_SOURCE{R"(
+TMP_ADDRESS = 0
+        TAY             ; transfer first argument to Y
+        LDA TMP_ADDRESS ; load byte of temporary address to accumulator
+        PHA             ; push byte of temporary address from accumulator to stack
+        STY TMP_ADDRESS ; store the first argument to the temporary address
+        LDA #0          ; initialize the result (low byte)
+        LDY #0          ; initialize the result (high byte)
+loop:   CPX #0          ; start the loop - compare the second number to 0
+        BEQ done        ; if it is zero, then jump out of the loop
+        CLC             ; clear carry
+        ADC TMP_ADDRESS ; add the first number to the result
+        BCC next        ; if carry is not set, skip the next instruction
+        INY             ; if carry is set, increment the high byte of the result
+next:   DEX             ; decrement the second number
+        JMP loop        ; continue the loop
+done:   TAX             ; transfer low byte of result to X
+        PLA             ; pull byte of temporary address from stack to accumulator
+        STA TMP_ADDRESS ; store byte of temporary address back to memory
+        TXA             ; transfer low byte of result back to accumulator
+)"};
+
 /**
  * Implements multiplication of two numbers a and b such that 0 <= a, b < 256.
  * The first number must be stored in accumulator, the second one in X register.
  * The result of multiplication consists of 2 bytes: high is written into Y, low into accumulator.
  *
- * @param startAddress address where the program will be written (address of its first operation); needed for jumping
+ * @tparam startAddress address where the program will be written (address of its first operation); needed for jumping
  * @return the sequence of bytes executable by a MOS6502 CPU
  */
-std::array<Byte, 29> program_multiplication(Word startAddress);
+template<Word startAddress>
+constexpr std::array<Byte, 29> program_multiplication() noexcept {
+    return assembled<MULTIPLICATION_SOURCE, startAddress>();
+}
+
+
+inline constexpr AssemblySource WORKLOAD_SOURCE{R"(
+POINTER = $20
+start:  LDX #$00
+loop:   LDA $0300,X
+        ADC $10
+        STA $0400,X
+        ASL $11
+        INC $0500,X
+        EOR (POINTER),Y
+        LSR $12,X
+        DEX
+        BNE loop
+        JMP start
+)"};
+
+/**
+ * An endless loop exercising the common addressing modes, both for reading and for read-modify-write.
+ * (POINTER),Y is expected to point to readable memory.
+ *
+ * @tparam startAddress address where the program will be written
+ */
+template<Word startAddress>
+constexpr std::array<Byte, 25> program_workload() noexcept {
+    return assembled<WORKLOAD_SOURCE, startAddress>();
+}
 
 #endif //EMULATOR_MOS6502_PROGRAMS_HPP
@@ -6,7 +6,6 @@
 
 using namespace Emulator;
 
-// TODO: Implement instruction-wise parsing of the memory (make the page view instruction-wise as well?)
 // TODO: Implement instruction-wise code writing:
 //  clicking on the assembly label reveals list of commands, choose from it and fill the arguments if necessary
 
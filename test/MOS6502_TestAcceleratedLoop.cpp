@@ -0,0 +1,50 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+static constexpr std::array<Byte, 4> testedIndices{0x00, 0x01, 0x40, 0xFF};
+
+
+TEST_F(MOS6502_TestFixture, TestAcceleratedCopy) {
+    for (const auto index: testedIndices) {
+        // loop: LDA ($10),Y; STA ($12),Y; INY; BNE loop
+        test_accelerated_loop({LDA_INDIRECT_Y, 0x10, STA_INDIRECT_Y, 0x12, INY_IMPLICIT, BNE_RELATIVE, 0xF9}, index, std::nullopt, index != 0xFF);
+        // loop: LDA $0390,X; STA $0540,X; INX; BNE loop
+        test_accelerated_loop({LDA_ABSOLUTE_X, 0x90, 0x03, STA_ABSOLUTE_X, 0x40, 0x05, INX_IMPLICIT, BNE_RELATIVE, 0xF7}, index, std::nullopt, index != 0xFF);
+        // loop: LDA $0381,Y; STA $0380,Y; INY; BNE loop, copying to an overlapping target below the source
+        test_accelerated_loop({LDA_ABSOLUTE_Y, 0x81, 0x03, STA_ABSOLUTE_Y, 0x80, 0x03, INY_IMPLICIT, BNE_RELATIVE, 0xF7}, index, std::nullopt, index != 0xFF);
+        // loop: LDA $0380,Y; STA $0390,Y; INY; BNE loop repeats the source instead of copying it,
+        //  so it is accelerated only once the rest of the source does not reach the target
+        test_accelerated_loop({LDA_ABSOLUTE_Y, 0x80, 0x03, STA_ABSOLUTE_Y, 0x90, 0x03, INY_IMPLICIT, BNE_RELATIVE, 0xF7}, index, std::nullopt, index != 0xFF);
+        // the limit stops the loop before the index wraps
+        test_accelerated_loop({LDA_INDIRECT_Y, 0x10, STA_INDIRECT_Y, 0x12, INY_IMPLICIT, BNE_RELATIVE, 0xF9}, index, 101, index != 0xFF);
+    }
+}
+
+TEST_F(MOS6502_TestFixture, TestAcceleratedFill) {
+    for (const auto index: testedIndices) {
+        // loop: STA ($12),Y; INY; BNE loop
+        test_accelerated_loop({STA_INDIRECT_Y, 0x12, INY_IMPLICIT, BNE_RELATIVE, 0xFB}, index, std::nullopt, index != 0xFF);
+        // loop: STA $04F0,Y; INY; BNE loop
+        test_accelerated_loop({STA_ABSOLUTE_Y, 0xF0, 0x04, INY_IMPLICIT, BNE_RELATIVE, 0xFA}, index, 50, index != 0xFF);
+    }
+}
+
+TEST_F(MOS6502_TestFixture, TestNotAcceleratedLoop) {
+    for (const auto index: testedIndices) {
+        // loop: STA ($12),Y; INX; BNE loop increments another register
+        test_accelerated_loop({STA_INDIRECT_Y, 0x12, INX_IMPLICIT, BNE_RELATIVE, 0xFB}, index, 300, false);
+        // the limit stops the loop within its first iteration
+        test_accelerated_loop({LDA_INDIRECT_Y, 0x10, STA_INDIRECT_Y, 0x12, INY_IMPLICIT, BNE_RELATIVE, 0xF9}, index, 6, false);
+    }
+
+    // LDA #0; STA $13; STA $12; loop: STA ($12),Y; INY; BNE loop is accelerated only once it has overwritten its pointer
+    test_accelerated_loop({LDA_IMMEDIATE, 0x00, STA_ZERO_PAGE, 0x13, STA_ZERO_PAGE, 0x12, STA_INDIRECT_Y, 0x12, INY_IMPLICIT, BNE_RELATIVE, 0xFB},
+                          0x00, std::nullopt, true);
+    // loop: STA $0100,X; INX; BNE loop writes to the stack
+    test_accelerated_loop({STA_ABSOLUTE_X, 0x00, 0x01, INX_IMPLICIT, BNE_RELATIVE, 0xFA}, 0xF0, std::nullopt, false);
+}
@@ -96,4 +96,8 @@ TEST_F(MOS6502_TestFixture, Test_SBC) {
             test_arithmetics(ArithmeticOperation::SUB, value1, value2, carry, addressing);
             test_arithmetics(ArithmeticOperation::SUB, value2, value1, carry, addressing);
         }
-}
\ No newline at end of file
+}
+
+TEST_F(MOS6502_TestFixture, TestDecimalMode) {
+    test_decimal_mode();
+}
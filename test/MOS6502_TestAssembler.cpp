@@ -0,0 +1,214 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <array>
+#include <string>
+
+#include "MOS6502_TestFixture.hpp"
+#include "Assembler.hpp"
+#include "OpcodeTable.hpp"
+#include "programs.hpp"
+
+using namespace Emulator;
+
+
+/// the bytes of the source assembled from $0000, which must succeed
+static std::vector<Byte> assembled(std::string_view source) {
+    std::vector<Byte> bytes;
+    const auto result = Assembler::assemble(source, [&bytes](Word address, Byte value) {
+        if (address >= bytes.size()) bytes.resize(address + 1);
+        bytes[address] = value;
+    });
+    EXPECT_TRUE(result.has_value()) << std::visit([](const auto &error) { return error.to_string(); }, result.error());
+    return bytes;
+}
+
+template<typename Error>
+static void expect_error(std::string_view source, size_t line) {
+    ROM memory{};
+    const auto result = Assembler::assemble(source, memory);
+    ASSERT_FALSE(result.has_value()) << source;
+    ASSERT_TRUE(std::holds_alternative<Error>(result.error())) << std::visit([](const auto &error) { return error.to_string(); }, result.error());
+    EXPECT_EQ(std::get<Error>(result.error()).line, line) << source;
+}
+
+
+TEST_F(MOS6502_TestFixture, TestAssemblerMultiplication) {
+    constexpr std::string_view source = R"(
+TMP_ADDRESS = 0
+        .org $0200
+        TAY             ; transfer first argument to Y
+        LDA TMP_ADDRESS ; push the byte of the temporary address to the stack
+        PHA
+        STY TMP_ADDRESS ; store the first argument to the temporary address
+        LDA #0          ; initialize the result (low byte)
+        LDY #0          ; initialize the result (high byte)
+loop:   CPX #0
+        BEQ done
+        CLC
+        ADC TMP_ADDRESS
+        BCC skip
+        INY
+skip:   DEX
+        JMP loop
+done:   TAX
+        PLA
+        STA TMP_ADDRESS
+        TXA
+)";
+
+    std::array<Byte, 29> program{};
+    const auto range = Assembler::assemble(source, 0x0200, program);
+    ASSERT_TRUE(range.has_value());
+    EXPECT_EQ(range->start, 0x0200);
+    EXPECT_EQ(range->end, 0x0200 + program.size());
+    EXPECT_EQ(program, (std::array<Byte, 29>{
+        TAY_IMPLICIT, LDA_ZERO_PAGE, 0x00, PHA_IMPLICIT, STY_ZERO_PAGE, 0x00, LDA_IMMEDIATE, 0x00, LDY_IMMEDIATE, 0x00,
+        CPX_IMMEDIATE, 0x00, BEQ_RELATIVE, 10, CLC_IMPLICIT, ADC_ZERO_PAGE, 0x00, BCC_RELATIVE, 1, INY_IMPLICIT,
+        DEX_IMPLICIT, JMP_ABSOLUTE, 0x0A, 0x02, TAX_IMPLICIT, PLA_IMPLICIT, STA_ZERO_PAGE, 0x00, TXA_IMPLICIT}));
+
+    // the same program runs as well
+    ROM image{};
+    ASSERT_TRUE(Assembler::assemble(source, image).has_value());
+    EXPECT_EQ(image.get_word(0x0200 + 22), 0x020A);
+}
+
+TEST_F(MOS6502_TestFixture, TestAssemblerCompileTime) {
+    static_assert(program_multiplication<0x0200>() == std::array<Byte, 29>{
+        TAY_IMPLICIT, LDA_ZERO_PAGE, 0x00, PHA_IMPLICIT, STY_ZERO_PAGE, 0x00, LDA_IMMEDIATE, 0x00, LDY_IMMEDIATE, 0x00,
+        CPX_IMMEDIATE, 0x00, BEQ_RELATIVE, 10, CLC_IMPLICIT, ADC_ZERO_PAGE, 0x00, BCC_RELATIVE, 1, INY_IMPLICIT,
+        DEX_IMPLICIT, JMP_ABSOLUTE, 0x0A, 0x02, TAX_IMPLICIT, PLA_IMPLICIT, STA_ZERO_PAGE, 0x00, TXA_IMPLICIT});
+    static_assert(program_multiplication<0x8000>()[22] == 0x0A && program_multiplication<0x8000>()[23] == 0x80);
+    static_assert(program_workload<0x0200>()[20] == BNE_RELATIVE && program_workload<0x0200>()[21] == (Byte)-20);
+
+    // sections at different addresses, with a gap between them
+    static constexpr AssemblySource SECTIONS{".org $10\n.byte 1\n.org $13\n.word $0302"};
+    static_assert(assembled<SECTIONS>() == std::array<Byte, 5>{1, 0, 0, 2, 3});
+
+    for (const auto [a, b]: {std::pair<Byte, Byte>{0, 0}, {13, 17}, {200, 3}, {255, 255}}) test_multiplication(a, b);
+}
+
+TEST_F(MOS6502_TestFixture, TestAssemblerAddressingModes) {
+    // every addressing mode of every mnemonic, written as description() shows it, assembles to that mnemonic and mode
+    for (size_t opCode = 0; opCode <= UINT8_MAX; opCode++) {
+        const auto &info = OPCODES[opCode];
+        const Word operand = info.mode == AddressingMode::RELATIVE ? 0x00F0
+                           : info.length == 3 ? 0x1234 : 0x0042;
+        std::string text = info.mode == AddressingMode::RELATIVE
+                ? std::format("{} *{:+}", info.mnemonic, (char)operand + 2)
+                : description(opCode, operand);
+        // description() shows immediate values in decimal, as the assembler reads them
+        const auto bytes = assembled(text);
+
+        ASSERT_EQ(bytes.size(), info.length) << text;
+        EXPECT_EQ(OPCODES[bytes[0]].mnemonic, info.mnemonic) << text;
+        EXPECT_EQ(OPCODES[bytes[0]].mode, info.mode) << text;
+        if (info.documented) EXPECT_EQ(bytes[0], opCode) << text;
+        if (info.length > 1) EXPECT_EQ(bytes[1], (Byte)operand) << text;
+        if (info.length > 2) EXPECT_EQ(bytes[2], operand >> 8) << text;
+    }
+}
+
+TEST_F(MOS6502_TestFixture, TestAssemblerExpressions) {
+    EXPECT_EQ(assembled(R"(
+        BASE = $1200
+        .org $10
+start:  .byte 1, $ff, %101, 'a', -1, "Hi;", <BASE + 2, >(BASE + $100)
+        .word start, BASE * 2 / 4 + 3 - 1, 1 << 4 | 3 & ~1, end - start   ; the length
+end:
+)"), (std::vector<Byte>{
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 0xFF, 5, 'a', 0xFF, 'H', 'i', ';', 0x02, 0x13,
+        0x10, 0x00, 0x02, 0x09, 0x12, 0x00, 0x12, 0x00}));
+
+    // a forward reference decides the length of the command before its value is known
+    EXPECT_EQ(assembled(R"(
+        LDA later
+        LDA early
+        JMP (vector)
+        LDA (early,X)
+        STA (early),Y
+        LDX early,Y
+        LDA early,Y
+        ASL
+        ROL A
+early = $10
+later = $10
+vector: .word *
+)"), (std::vector<Byte>{
+        LDA_ABSOLUTE, 0x10, 0x00, LDA_ABSOLUTE, 0x10, 0x00, JMP_INDIRECT, 0x15, 0x00, LDA_INDIRECT_X, 0x10,
+        STA_INDIRECT_Y, 0x10, LDX_ABSOLUTE_Y, 0x10, 0x00, LDA_ABSOLUTE_Y, 0x10, 0x00, ASL_ACCUMULATOR, ROL_ACCUMULATOR,
+        0x15, 0x00}));
+
+    EXPECT_EQ(assembled(R"(
+zero = $10
+        lda zero
+        ldx zero,y
+        lda zero,x
+        lda (zero + 1) * 2,x
+)"), (std::vector<Byte>{LDA_ZERO_PAGE, 0x10, LDX_ZERO_PAGE_Y, 0x10, LDA_ZERO_PAGE_X, 0x10, LDA_ZERO_PAGE_X, 0x22}));
+
+    // constants depending on labels below them can be used above their definitions, as absolute addresses
+    EXPECT_EQ(assembled("LDX #len\nlen = end - start\nstart: NOP\nend:\n"), (std::vector<Byte>{LDX_IMMEDIATE, 0x01, NOP_IMPLICIT}));
+    EXPECT_EQ(assembled(R"(
+        LDX #len
+        LDA size,X
+size = len * 2
+len = end - start
+start:  NOP
+        NOP
+end:
+)"), (std::vector<Byte>{LDX_IMMEDIATE, 0x02, LDA_ABSOLUTE_X, 0x04, 0x00, NOP_IMPLICIT, NOP_IMPLICIT}));
+}
+
+TEST_F(MOS6502_TestFixture, TestAssemblerErrors) {
+    expect_error<SyntaxError>("NOP\nLDA #1 +", 2);
+    expect_error<SyntaxError>(".fill 3", 1);
+    expect_error<UnknownMnemonic>("NOP\n\nFOO #1", 3);
+    expect_error<InvalidAddressing>("STA #1", 1);
+    expect_error<InvalidAddressing>("JSR ($12),Y", 1);
+    expect_error<UndefinedSymbol>("JMP nowhere", 1);
+    expect_error<UndefinedSymbol>(".org later\nlater = 5", 1);
+    expect_error<UndefinedSymbol>("LDA #a\na = b\nb = a + 1", 1);
+    expect_error<DuplicateSymbol>("a: NOP\na: NOP", 2);
+    expect_error<DuplicateSymbol>("a = 1\na = 1", 2);
+    expect_error<ValueOutOfRange>("LDA #256", 1);
+    expect_error<ValueOutOfRange>("LDA ($100),Y", 1);
+    expect_error<ValueOutOfRange>("BNE far\n.org $0200\nfar: NOP", 1);
+    expect_error<ValueOutOfRange>(".org $FFFF\nNOP\nNOP", 3);
+
+    // the output is too small
+    std::array<Byte, 2> output{};
+    const auto result = Assembler::assemble("JMP $1234", 0x0000, output);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_TRUE(std::holds_alternative<ValueOutOfRange>(result.error()));
+}
+
+TEST_F(MOS6502_TestFixture, TestAssemblerLargeProgram) {
+    // blocks each branching and jumping to their neighbours, referring to the following block before it is defined
+    constexpr size_t BLOCKS = 4000;
+    std::string source = ".org $0200\n";
+    for (size_t block = 0; block < BLOCKS; block++) {
+        source += std::format("block{0}: LDA #{1}\n    BEQ block{0}\n    BNE end{0}\n    JMP block{2}\n"
+                              "end{0}: STA value + {1}\n", block, block % 256, (block + 1) % BLOCKS);
+    }
+    source += "value: .byte 0\n";
+
+    std::vector<Byte> output(BLOCKS * 12 + 1);
+    const auto result = Assembler::assemble(source, 0x0200, output);
+    ASSERT_TRUE(result.has_value()) << std::visit([](const auto &error) { return error.to_string(); }, result.error());
+    EXPECT_EQ(result->end - result->start, output.size());
+
+    const Word value = 0x0200 + BLOCKS * 12;
+    for (size_t block = 0; block < BLOCKS; block += 997) {
+        const auto *bytes = output.data() + block * 12;
+        EXPECT_EQ(bytes[0], LDA_IMMEDIATE);
+        EXPECT_EQ(bytes[3], (Byte)-4);
+        EXPECT_EQ(bytes[5], 3);
+        EXPECT_EQ(bytes[6], JMP_ABSOLUTE);
+        EXPECT_EQ(bytes[7] | bytes[8] << 8, 0x0200 + (block + 1) % BLOCKS * 12);
+        EXPECT_EQ(bytes[9], STA_ABSOLUTE);
+        EXPECT_EQ(bytes[10] | bytes[11] << 8, value + block % 256);
+    }
+}
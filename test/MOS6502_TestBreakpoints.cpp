@@ -0,0 +1,29 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+static constexpr std::array<Word, 4> testedPCs{0x0200, 0x02fc, 0x8000, 0xfff0};
+static constexpr std::array<Word, 4> testedOffsets{0, 2, 4, 6};
+static constexpr std::array<Byte, 3> testedAddresses{0x10, 0x80, 0xff};
+
+
+TEST_F(MOS6502_TestFixture, TestBreakpoint) {
+    for (const auto initialPC: testedPCs)
+        for (const auto offset: testedOffsets) {
+            test_breakpoint(initialPC, offset, true);
+            test_breakpoint(initialPC, offset, false);
+        }
+}
+
+TEST_F(MOS6502_TestFixture, TestWatchpoint) {
+    for (const auto initialPC: testedPCs)
+        for (const auto address: testedAddresses) {
+            test_watchpoint(initialPC, address, Access::READ);
+            test_watchpoint(initialPC, address, Access::WRITE);
+            test_watchpoint(initialPC, address, Access::READ_WRITE);
+        }
+}
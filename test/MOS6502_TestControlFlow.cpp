@@ -0,0 +1,141 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <algorithm>
+#include <fstream>
+
+#include "MOS6502_TestFixture.hpp"
+#include "ControlFlow.hpp"
+
+using namespace Emulator;
+
+
+/**
+ * reset:  LDX #$03
+ * loop:   JSR first
+ *         JSR second
+ *         DEX
+ *         BNE loop
+ *         JMP ($8030)
+ *         JAM
+ *
+ * first:  LDA #$01
+ *         JMP tail
+ * second: LDA #$02
+ *         NOP
+ *         NOP
+ * tail:   STA $10
+ *         RTS
+ *
+ * target: <the given commands>
+ *         JMP reset
+ * irq:    RTI
+ */
+static ROM control_flow_image(std::initializer_list<Byte> target) {
+    ROM image{};
+    image.load(0x8000, std::vector<Byte>{
+            LDX_IMMEDIATE, 0x03,
+            JSR_ABSOLUTE, 0x20, 0x80,
+            JSR_ABSOLUTE, 0x28, 0x80,
+            DEX_IMPLICIT,
+            BNE_RELATIVE, (Byte)-9,
+            JMP_INDIRECT, 0x30, 0x80,
+            JAM_02
+    });
+    image.load(0x8020, std::vector<Byte>{LDA_IMMEDIATE, 0x01, JMP_ABSOLUTE, 0x2C, 0x80});
+    image.load(0x8028, std::vector<Byte>{LDA_IMMEDIATE, 0x02, NOP_IMPLICIT, NOP_IMPLICIT, STA_ZERO_PAGE, 0x10, RTS_IMPLICIT});
+    image.load(0x8030, std::vector<Byte>{0x40, 0x80});
+
+    std::vector<Byte> code{target};
+    code.insert(code.end(), {JMP_ABSOLUTE, 0x00, 0x80, RTI_IMPLICIT});
+    image.load(0x8040, code);
+
+    const Word irq = 0x8040 + code.size() - 1;
+    image.load(ROM::INTERRUPT_HANDLER, std::vector<Byte>{(Byte)irq, (Byte)(irq >> 8)});
+    image.load(ROM::RESET_LOCATION, std::vector<Byte>{0x00, 0x80});
+    image.load(ROM::BRK_HANDLER, std::vector<Byte>{(Byte)irq, (Byte)(irq >> 8)});
+    return image;
+}
+
+static bool has_edge(const ControlFlowGraph &graph, Word block, Word to, EdgeKind kind) {
+    if (!graph.blocks().contains(block)) return false;
+    const auto &successors = graph.blocks().at(block).successors;
+    return std::ranges::any_of(successors, [=](const Edge &edge) { return edge.to == to && edge.kind == kind; });
+}
+
+
+TEST_F(MOS6502_TestFixture, TestControlFlowBlocks) {
+    const ControlFlowGraph graph(control_flow_image({LDA_IMMEDIATE, 0x00}));
+
+    EXPECT_TRUE(graph.is_command(0x8000));
+    EXPECT_TRUE(graph.is_command(0x802B));
+    EXPECT_TRUE(graph.is_command(0x8042));
+    EXPECT_FALSE(graph.is_command(0x800E));
+    EXPECT_FALSE(graph.is_command(0x8001));
+    EXPECT_FALSE(graph.is_command(0x8025));
+
+    EXPECT_EQ(graph.blocks().size(), 10);
+    EXPECT_TRUE(has_edge(graph, 0x8000, 0x8002, EdgeKind::FALL_THROUGH));
+    EXPECT_TRUE(has_edge(graph, 0x8002, 0x8020, EdgeKind::CALL));
+    EXPECT_TRUE(has_edge(graph, 0x8008, 0x8002, EdgeKind::BRANCH));
+    EXPECT_TRUE(has_edge(graph, 0x8008, 0x800B, EdgeKind::FALL_THROUGH));
+    EXPECT_TRUE(has_edge(graph, 0x8020, 0x802C, EdgeKind::JUMP));
+    EXPECT_TRUE(has_edge(graph, 0x8028, 0x802C, EdgeKind::FALL_THROUGH));
+    EXPECT_EQ(graph.blocks().at(0x8028).last, 0x802B);
+    EXPECT_EQ(graph.blocks().at(0x8008).last, 0x8009);
+
+    ASSERT_NE(graph.block_of(0x802A), nullptr);
+    EXPECT_EQ(graph.block_of(0x802A)->start, 0x8028);
+    EXPECT_EQ(graph.block_of(0x8025), nullptr);
+}
+
+TEST_F(MOS6502_TestFixture, TestControlFlowReturns) {
+    const ControlFlowGraph graph(control_flow_image({LDA_IMMEDIATE, 0x00}));
+
+    EXPECT_EQ(graph.subroutines(), (std::set<Word>{0x8020, 0x8028}));
+    // the tail shared by both subroutines returns to the callers of both
+    EXPECT_TRUE(has_edge(graph, 0x802C, 0x8005, EdgeKind::RETURN));
+    EXPECT_TRUE(has_edge(graph, 0x802C, 0x8008, EdgeKind::RETURN));
+    EXPECT_EQ(graph.blocks().at(0x802C).successors.size(), 2);
+    // RTI is not followed
+    EXPECT_TRUE(graph.blocks().at(0x8045).successors.empty());
+}
+
+TEST_F(MOS6502_TestFixture, TestControlFlowIndirectJump) {
+    const ControlFlowGraph constant(control_flow_image({LDA_IMMEDIATE, 0x00}));
+    EXPECT_EQ(constant.indirect_target(0x800B), 0x8040);
+    EXPECT_TRUE(has_edge(constant, 0x800B, 0x8040, EdgeKind::INDIRECT_JUMP));
+
+    // the target writes the pointer, so the jump is not known anymore, but its code has been reached
+    const ControlFlowGraph overwritten(control_flow_image({STA_ABSOLUTE, 0x31, 0x80}));
+    EXPECT_EQ(overwritten.indirect_target(0x800B), std::nullopt);
+    EXPECT_TRUE(overwritten.blocks().at(0x800B).successors.empty());
+    EXPECT_TRUE(overwritten.is_command(0x8040));
+
+    // an indirect store may write anywhere, an indexed one within the reach of the index
+    EXPECT_EQ(ControlFlowGraph(control_flow_image({STA_INDIRECT_Y, 0x10})).indirect_target(0x800B), std::nullopt);
+    EXPECT_EQ(ControlFlowGraph(control_flow_image({STA_ABSOLUTE_X, 0x40, 0x7F})).indirect_target(0x800B), std::nullopt);
+    EXPECT_EQ(ControlFlowGraph(control_flow_image({STA_ABSOLUTE_X, 0x32, 0x80})).indirect_target(0x800B), 0x8040);
+    EXPECT_EQ(ControlFlowGraph(control_flow_image({LDA_ABSOLUTE, 0x30, 0x80})).indirect_target(0x800B), 0x8040);
+}
+
+TEST_F(MOS6502_TestFixture, TestControlFlowFirmware) {
+    std::ifstream file(FIRMWARE_IMAGE, std::ios::binary);
+    ASSERT_TRUE(file);
+    ROM image{};
+    image.load(0xFF00, std::vector<Byte>{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+
+    ControlFlowGraph graph(image);
+    EXPECT_EQ(graph.subroutines(), (std::set<Word>{0xFF91, 0xFF98}));
+    EXPECT_TRUE(has_edge(graph, 0xFF91, 0xFF14, EdgeKind::RETURN));
+    EXPECT_TRUE(has_edge(graph, 0xFF98, 0xFF71, EdgeKind::RETURN));
+    // the pointer of the indirect jump is written just before it
+    EXPECT_EQ(graph.indirect_target(0xFF7B), std::nullopt);
+    EXPECT_FALSE(graph.is_command(0xFF7E));
+
+    graph.add_entry(0xFF7E);
+    EXPECT_TRUE(graph.is_command(0xFF85));
+    EXPECT_TRUE(has_edge(graph, 0xFF98, 0xFF8D, EdgeKind::RETURN));
+    EXPECT_TRUE(has_edge(graph, 0xFF8D, 0xFF9B, EdgeKind::INTERRUPT));
+}
@@ -0,0 +1,33 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+#include "Corpus.hpp"
+
+using namespace Emulator;
+
+
+TEST_F(MOS6502_TestFixture, TestCorpus) {
+    for (const auto &program: CORPUS) {
+        // accelerated loops must leave the same output after the same number of cycles
+        std::optional<size_t> cycles;
+        for (const bool accelerated: {false, true}) {
+            const std::string testID = std::format("{}, accelerated: {}", program.name, accelerated);
+            MOS6502 cpu{};
+            cpu.burn(program.memory());
+            cpu.reset();
+            cpu.stop_on_break(true);
+            cpu.accelerate_loops(accelerated);
+            cpu.max_number_of_commands(100'000'000);
+
+            const auto result = cpu.execute();
+            ASSERT_TRUE(result.has_value()) << testID;
+            ASSERT_TRUE(std::holds_alternative<MOS6502::StopOnBreak>(result.value())) << testID;
+            EXPECT_TRUE(program.succeeded(cpu.get_memory())) << testID;
+
+            if (cycles.has_value()) EXPECT_EQ(cpu.get_state().cycle, cycles.value()) << testID;
+            cycles = cpu.get_state().cycle;
+        }
+    }
+}
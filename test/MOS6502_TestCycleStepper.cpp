@@ -0,0 +1,24 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+
+TEST_F(MOS6502_TestFixture, TestCycleStepper) {
+    for (int opCode = 0; opCode <= UINT8_MAX; opCode++)
+        for (const Word initialPC: {0x0200, 0x02F0})
+            for (const Byte index: {0x00, 0xFF})
+                for (const Byte status: {0x00, 0xFF})
+                    test_cycle_stepper(opCode, initialPC, index, status);
+}
+
+TEST_F(MOS6502_TestFixture, TestCycleStepperBus) {
+    test_cycle_stepper_bus();
+}
+
+TEST_F(MOS6502_TestFixture, TestCycleStepperInterrupts) {
+    test_cycle_stepper_interrupts();
+}
@@ -0,0 +1,61 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <array>
+#include <fstream>
+#include <string>
+
+#include "MOS6502_TestFixture.hpp"
+#include "Disassembler.hpp"
+#include "OpcodeTable.hpp"
+
+using namespace Emulator;
+
+
+TEST_F(MOS6502_TestFixture, TestDisassemblerDescriptions) {
+    std::array<char, MAX_DESCRIPTION_LENGTH> buffer{};
+    for (size_t opCode = 0; opCode <= UINT8_MAX; opCode++) {
+        for (const Word operand: {0x0000, 0x0005, 0x0042, 0x007F, 0x0080, 0x00FF, 0x1234, 0xABCD, 0xFFFF}) {
+            char *end = write_description(buffer.data(), opCode, operand);
+            EXPECT_EQ(std::string(buffer.data(), end), description(opCode, operand))
+                << std::format("opcode {:#04x}, operand {:#06x}", opCode, operand);
+        }
+    }
+}
+
+TEST_F(MOS6502_TestFixture, TestDisassemblerBatch) {
+    std::ifstream file(FIRMWARE_IMAGE, std::ios::binary);
+    ASSERT_TRUE(file);
+    ROM image{};
+    image.load(0xFF00, std::vector<Byte>{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+
+    std::string expected;
+    for (size_t address = 0xFF00; address <= UINT16_MAX;) {
+        const Byte opCode = image[address];
+        const auto length = OPCODES[opCode].length;
+        const Word operand = length == 1 ? 0 : length == 2 ? image[address + 1] : image.get_word(address + 1);
+        expected += std::format("{:04x}  {}\n", address, description(opCode, operand));
+        address += length;
+    }
+
+    std::vector<char> buffer(64 * 1024);
+    const auto batch = disassemble(image, 0xFF00, SIZE_MAX, buffer);
+    EXPECT_EQ(std::string(buffer.data(), batch.written), expected);
+    EXPECT_GT(batch.next, UINT16_MAX);
+
+    // a small buffer takes as many lines as surely fit, the rest follows from where it stopped
+    std::array<char, 3 * MAX_LINE_LENGTH> small{};
+    std::string pieces;
+    for (size_t address = 0xFF00; address <= UINT16_MAX;) {
+        const auto piece = disassemble(image, address, SIZE_MAX, small);
+        ASSERT_GT(piece.commands, 0);
+        EXPECT_LE(piece.written, small.size());
+        pieces.append(small.data(), piece.written);
+        address = piece.next;
+    }
+    EXPECT_EQ(pieces, expected);
+
+    const auto limited = disassemble(image, 0xFF00, 2, buffer);
+    EXPECT_EQ(limited.commands, 2);
+}
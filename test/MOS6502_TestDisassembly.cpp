@@ -0,0 +1,87 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <fstream>
+
+#include "MOS6502_TestFixture.hpp"
+#include "Disassembly.hpp"
+
+using namespace Emulator;
+
+
+/// compares the commands of the disassembly with the ones of a disassembly made from scratch
+static void expect_same_commands(const Disassembly &disassembly, const Disassembly &expected, const std::string &testID) {
+    ASSERT_EQ(disassembly.size(), expected.size()) << testID;
+    for (size_t address = 0; address <= UINT16_MAX; address++)
+        ASSERT_EQ(disassembly.is_command(address), expected.is_command(address)) << testID << std::format(" at {:#06x}", address);
+}
+
+
+TEST_F(MOS6502_TestFixture, TestDisassemblyRows) {
+    ROM image{};
+    // LDA #$01; JMP $1234; NOP
+    image.load(0x0000, std::vector<Byte>{LDA_IMMEDIATE, 0x01, JMP_ABSOLUTE, 0x34, 0x12, NOP_IMPLICIT});
+    const Disassembly disassembly(image);
+
+    EXPECT_TRUE(disassembly.is_command(0x0000));
+    EXPECT_FALSE(disassembly.is_command(0x0001));
+    EXPECT_TRUE(disassembly.is_command(0x0002));
+    EXPECT_TRUE(disassembly.is_command(0x0005));
+    EXPECT_EQ(disassembly.address(0), 0x0000);
+    EXPECT_EQ(disassembly.address(2), 0x0005);
+    EXPECT_EQ(disassembly.row(0x0004), 1);
+
+    for (const size_t row: {(size_t)0, (size_t)3, (size_t)1000, disassembly.size() - 1}) {
+        EXPECT_EQ(disassembly.row(disassembly.address(row)), row);
+    }
+}
+
+TEST_F(MOS6502_TestFixture, TestDisassemblyAnchors) {
+    ROM image{};
+    // LDA $EAEA, with a NOP hidden in its operand
+    image.load(0x0010, std::vector<Byte>{LDA_ABSOLUTE, NOP_IMPLICIT, NOP_IMPLICIT, NOP_IMPLICIT});
+    Disassembly disassembly(image);
+    EXPECT_FALSE(disassembly.is_command(0x0011));
+    EXPECT_FALSE(disassembly.overlaps(0x0010));
+
+    const size_t size = disassembly.size();
+    const auto window = disassembly.anchored(0x0011);
+    EXPECT_EQ(window.start, 0x0010);
+    disassembly.apply(window);
+    EXPECT_TRUE(disassembly.overlaps(0x0010));
+    EXPECT_TRUE(disassembly.is_command(0x0011));
+    EXPECT_TRUE(disassembly.is_command(0x0012));
+    EXPECT_EQ(disassembly.size(), size - window.removed + window.inserted);
+    EXPECT_EQ(disassembly.size(), size + 2);
+}
+
+TEST_F(MOS6502_TestFixture, TestDisassemblyIncremental) {
+    std::ifstream file(FIRMWARE_IMAGE, std::ios::binary);
+    ASSERT_TRUE(file);
+    ROM image{};
+    image.load(0xFF00, std::vector<Byte>{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+    // data the sweep goes through before the firmware
+    uint32_t seed = 12345;
+    const auto random = [&seed]() { return seed = seed * 1103515245 + 12345, (seed >> 16) & 0x7FFF; };
+    for (Word address = 0x8000; address < 0x9000; address++) image[address] = random();
+
+    Disassembly disassembly(image);
+    expect_same_commands(disassembly, Disassembly(image), "initial");
+
+    for (size_t edit = 0; edit < 200; edit++) {
+        const Word address = edit % 4 == 0 ? 0xFF00 + random() % 0x100 : 0x8000 + random() % 0x1000;
+        image[address] = random();
+
+        const size_t size = disassembly.size();
+        const auto window = disassembly.affected(address);
+        EXPECT_LE(window.start, address);
+        EXPECT_GT(window.end, address);
+        EXPECT_EQ(window.row, disassembly.row(window.start));
+        disassembly.apply(window);
+
+        const std::string testID = std::format("edit {:d} at {:#06x}", edit, address);
+        EXPECT_EQ(disassembly.size(), size - window.removed + window.inserted) << testID;
+        expect_same_commands(disassembly, Disassembly(image), testID);
+    }
+}
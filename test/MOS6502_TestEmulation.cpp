@@ -0,0 +1,104 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <chrono>
+#include <thread>
+
+#include "MOS6502_TestFixture.hpp"
+#include "Emulation.hpp"
+
+using namespace Emulator;
+
+
+static ROM emulated_program(const std::vector<Byte> &code) {
+    ROM program{};
+    program.load(0x0200, code);
+    program.load(ROM::RESET_LOCATION, std::vector<Byte>{0x00, 0x02});
+    return program;
+}
+
+/// polls the condition for a few seconds at most
+static bool eventually(const std::function<bool()> &condition) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+
+TEST_F(MOS6502_TestFixture, TestDoubleBuffer) {
+    DoubleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.read([](int) { FAIL(); }));
+
+    EXPECT_TRUE(buffer.write([](int &value) { value = 1; }));
+    EXPECT_TRUE(buffer.read([&](int value) {
+        EXPECT_EQ(value, 1);
+        // the back slot is free, but once it is swapped the reader is still busy with the new back one
+        EXPECT_TRUE(buffer.write([](int &value) { value = 2; }));
+        EXPECT_FALSE(buffer.write([](int &value) { value = 3; }));
+    }));
+    EXPECT_TRUE(buffer.read([](int value) { EXPECT_EQ(value, 2); }));
+    EXPECT_TRUE(buffer.write([](int &value) { value = 3; }));
+    EXPECT_TRUE(buffer.read([](int value) { EXPECT_EQ(value, 3); }));
+}
+
+TEST_F(MOS6502_TestFixture, TestEmulationFinishes) {
+    //       LDX #$05
+    // loop: STX $10
+    //       DEX
+    //       BNE loop
+    //       BRK
+    Emulation emulation(emulated_program({LDX_IMMEDIATE, 0x05, STX_ZERO_PAGE, 0x10, DEX_IMPLICIT, BNE_RELATIVE, (Byte)-5, BRK_IMPLICIT}));
+    ASSERT_TRUE(eventually([&]() { return emulation.finished(); }));
+
+    ASSERT_TRUE(emulation.read([](const Emulation::Snapshot &snapshot) {
+        ASSERT_TRUE(snapshot.result.has_value());
+        ASSERT_TRUE(snapshot.result->has_value());
+        ASSERT_TRUE(std::holds_alternative<MOS6502::StopOnBreak>(snapshot.result->value()));
+        EXPECT_EQ(std::get<MOS6502::StopOnBreak>(snapshot.result->value()).address, 0x0207);
+        EXPECT_EQ(snapshot.state.X, 0);
+        EXPECT_EQ(snapshot.memory[0x10], 1);
+        EXPECT_EQ(snapshot.instructionsRetired, 16);
+    }));
+}
+
+TEST_F(MOS6502_TestFixture, TestEmulationPauses) {
+    // loop: INX
+    //       STX $10
+    //       JMP loop
+    Emulation emulation(emulated_program({INX_IMPLICIT, STX_ZERO_PAGE, 0x10, JMP_ABSOLUTE, 0x00, 0x02}), std::chrono::milliseconds(1));
+
+    // snapshots keep being published while the program is running
+    uint64_t first = 0, later = 0;
+    ASSERT_TRUE(eventually([&]() { return emulation.read([&](const Emulation::Snapshot &snapshot) { first = snapshot.instructionsRetired; }) && first > 0; }));
+    ASSERT_TRUE(eventually([&]() { emulation.read([&](const Emulation::Snapshot &snapshot) { later = snapshot.instructionsRetired; }); return later > first; }));
+
+    emulation.pause();
+    Emulation::Snapshot paused;
+    ASSERT_TRUE(eventually([&]() { emulation.read([&](const Emulation::Snapshot &snapshot) { paused = snapshot; }); return paused.paused; }));
+    EXPECT_FALSE(paused.result.has_value());
+    EXPECT_EQ(paused.memory[0x10], paused.state.PC == 0x0201 ? (Byte)(paused.state.X - 1) : paused.state.X);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    emulation.read([&](const Emulation::Snapshot &snapshot) {
+        EXPECT_EQ(snapshot.instructionsRetired, paused.instructionsRetired);
+        EXPECT_EQ(snapshot.state.PC, paused.state.PC);
+    });
+
+    emulation.resume();
+    ASSERT_TRUE(eventually([&]() {
+        emulation.read([&](const Emulation::Snapshot &snapshot) { later = snapshot.instructionsRetired; });
+        return later > paused.instructionsRetired;
+    }));
+
+    emulation.stop();
+    ASSERT_TRUE(eventually([&]() { return emulation.finished(); }));
+    emulation.read([](const Emulation::Snapshot &snapshot) {
+        ASSERT_TRUE(snapshot.result.has_value());
+        ASSERT_TRUE(snapshot.result->has_value());
+        EXPECT_TRUE(std::holds_alternative<MOS6502::StopOnRequest>(snapshot.result->value()));
+    });
+}
@@ -2,9 +2,27 @@
 // Created by Mikhail on 14/09/2023.
 //
 
+#include <algorithm>
 #include <format>
+#include <fstream>
+#include <map>
 #include "MOS6502_TestFixture.hpp"
 #include "helpers.hpp"
+#include "Recorder.hpp"
+#include "SaveStates.hpp"
+#include "GdbServer.hpp"
+#include "OpcodeTable.hpp"
+#include "CycleStepper.hpp"
+#include "Recompiled.hpp"
+#include "programs.hpp"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <filesystem>
+#include <thread>
+#endif
 
 void MOS6502_TestFixture::write_word(Word word, Word address) noexcept {
     const WordToBytes buf(word);
@@ -22,6 +40,8 @@ void MOS6502_TestFixture::reset() noexcept {
     SP = 255;
 
     memory.reset();
+    metrics.reset();
+    trapIllegalOpcodes = false;
 }
 
 std::optional<Location> MOS6502_TestFixture::prepare_memory(const Addressing &addressing) noexcept {
@@ -294,7 +314,8 @@ void MOS6502_TestFixture::test_push_to_stack(Register reg, Byte value) {
         maxNumberOfCommandsToExecute = 1;
         execute();
 
-        EXPECT_EQ(memory.stack(SP + 1), value) << testID;
+        // PHP pushes the status with the break and the unused bits set
+        EXPECT_EQ(memory.stack(SP + 1), reg == Register::SR ? value | 0x30 : value) << testID;
         EXPECT_EQ(SP, 254) << testID;
         EXPECT_EQ(cycle, 3) << testID;
         EXPECT_EQ(PC, 1) << testID;
@@ -796,8 +817,9 @@ void MOS6502_TestFixture::test_branch(Flag flag, bool value, bool targetValue, W
         ASSERT_FALSE(executionResult.failed()) << testID << ' ' << executionResult.fail_message();
 
         const auto branchHappened = value == targetValue;
-        EXPECT_EQ(PC, (branchHappened) ? (Word)(initialPC + offset + 2) : (Word)(initialPC + 2)) << testID;
-        EXPECT_EQ(cycle, (branchHappened) ? 3 : 2) << testID;
+        const Word nextPC = initialPC + 2;
+        EXPECT_EQ(PC, (branchHappened) ? (Word)(nextPC + offset) : nextPC) << testID;
+        EXPECT_EQ(cycle, (branchHappened) ? 3 + page_crossed(nextPC, offset) : 2) << testID;
         EXPECT_EQ(SR, initialSR);
     }
 }
@@ -816,12 +838,15 @@ void MOS6502_TestFixture::test_brk(Word initialPC, Word interruptVector) {
     const auto executionResult = prepare_and_execute(instruction);
     ASSERT_FALSE(executionResult.failed()) << testID << ' ' << executionResult.fail_message();
 
-    EXPECT_EQ(SP, 253) << testID;
+    // the status is pushed with the break and the unused bits set
+    EXPECT_EQ(SP, 252) << testID;
     EXPECT_EQ(memory.stack(255), storedPC.high) << testID;
     EXPECT_EQ(memory.stack(254), storedPC.low) << testID;
+    EXPECT_EQ(memory.stack(253), 0x30) << testID;
     EXPECT_EQ(PC, interruptVector) << testID;
-    EXPECT_EQ(cycle, 6) << testID;
+    EXPECT_EQ(cycle, 7) << testID;
     EXPECT_EQ(SR[Flag::BREAK], SET) << testID;
+    EXPECT_EQ(SR[Flag::INTERRUPT_DISABLE], SET) << testID;
 }
 
 void MOS6502_TestFixture::test_nop() {
@@ -858,6 +883,982 @@ void MOS6502_TestFixture::test_return_from_interrupt(Word previousPC, Byte previ
     EXPECT_EQ(cycle, 6) << testID;
 }
 
+void MOS6502_TestFixture::test_metrics(Word initialPC, Word address, Byte index) {
+    reset();
+    PC = initialPC;
+
+    std::string testID = std::vformat("Test metrics(initial PC: {:#04x}, address: {:#04x}, index: {:d})",
+                                      std::make_format_args(initialPC, address, index));
+
+    const WordToBytes buf(address);
+    const std::array<Byte, 8> program{LDA_ABSOLUTE_X, buf.low, buf.high, PHA_IMPLICIT, PLA_IMPLICIT, PHP_IMPLICIT, BRK_IMPLICIT, NOP_IMPLICIT};
+    memory.load(initialPC, program);
+    X = index;
+    stop_on_break(true);
+    max_number_of_commands(std::nullopt);
+
+    const auto result = execute();
+    ASSERT_TRUE(result.has_value()) << testID;
+    ASSERT_TRUE(std::holds_alternative<StopOnBreak>(result.value())) << testID;
+
+    const auto snapshot = get_metrics().snapshot();
+    EXPECT_EQ(snapshot.instructionsRetired, 4) << testID;
+    EXPECT_EQ(snapshot.pageCrossings, page_crossed(address, index)) << testID;
+    EXPECT_EQ(snapshot.stackPushes, 2) << testID;
+    EXPECT_EQ(snapshot.stackPulls, 1) << testID;
+    EXPECT_EQ(snapshot.breaks, 1) << testID;
+    EXPECT_EQ(snapshot.unknownOperations, 0) << testID;
+    // the fetch of BRK is not accounted as it is not executed
+    EXPECT_EQ(snapshot.cycles, cycle - 1) << testID;
+}
+
+void MOS6502_TestFixture::test_unknown_operation_metrics(Byte opCode) {
+    reset();
+
+    std::string testID = std::vformat("Test unknown operation metrics(opcode: {:#02x})", std::make_format_args(opCode));
+
+    memory[0] = NOP_IMPLICIT;
+    memory[1] = opCode;
+    max_number_of_commands(std::nullopt);
+    // every opcode is decodable since undocumented ones are supported, so they have to be trapped
+    trap_illegal_opcodes(true);
+
+    const auto result = execute();
+    ASSERT_FALSE(result.has_value()) << testID;
+    EXPECT_TRUE(std::holds_alternative<UnknownOperation>(result.error())) << testID;
+
+    const auto snapshot = get_metrics().snapshot();
+    EXPECT_EQ(snapshot.instructionsRetired, 1) << testID;
+    EXPECT_EQ(snapshot.unknownOperations, 1) << testID;
+    EXPECT_EQ(snapshot.breaks, 0) << testID;
+}
+
+/**
+ * Writes the following program to initialPC:
+ *  LDA #1; STA address; LDA address; PHA; BRK
+ */
+static std::array<Byte, 8> watched_program(Byte address) {
+    return {LDA_IMMEDIATE, 1, STA_ZERO_PAGE, address, LDA_ZERO_PAGE, address, PHA_IMPLICIT, BRK_IMPLICIT};
+}
+
+void MOS6502_TestFixture::test_breakpoint(Word initialPC, Word offset, bool conditionHolds) {
+    reset();
+    PC = initialPC;
+
+    std::string testID = std::vformat("Test breakpoint(initial PC: {:#04x}, offset: {:d}, condition holds: {:d})",
+                                      std::make_format_args(initialPC, offset, conditionHolds));
+
+    memory.load(initialPC, watched_program(0x10));
+    stop_on_break(true);
+    max_number_of_commands(std::nullopt);
+    breakpoints.clear();
+
+    const Word breakpointAddress = initialPC + offset;
+    breakpoints.set_breakpoint(breakpointAddress, [this, conditionHolds, breakpointAddress]() {
+        return conditionHolds && get_state().PC == breakpointAddress;
+    });
+
+    auto result = execute();
+    ASSERT_TRUE(result.has_value()) << testID;
+
+    if (conditionHolds) {
+        ASSERT_TRUE(std::holds_alternative<StopOnBreakpoint>(result.value())) << testID;
+        EXPECT_EQ(std::get<StopOnBreakpoint>(result.value()).address, breakpointAddress) << testID;
+        EXPECT_EQ(PC, breakpointAddress) << testID;
+
+        // resuming executes the command at the breakpoint instead of stopping on it again
+        result = execute();
+        ASSERT_TRUE(result.has_value()) << testID;
+    }
+
+    EXPECT_TRUE(std::holds_alternative<StopOnBreak>(result.value())) << testID;
+    EXPECT_EQ(AC, 1) << testID;
+    breakpoints.clear();
+}
+
+void MOS6502_TestFixture::test_watchpoint(Word initialPC, Byte address, Access access) {
+    reset();
+    PC = initialPC;
+
+    std::string testID = std::vformat("Test watchpoint(initial PC: {:#04x}, address: {:#02x}, access: {})",
+                                      std::make_format_args(initialPC, address, to_string(access)));
+
+    memory.load(initialPC, watched_program(address));
+    stop_on_break(true);
+    max_number_of_commands(std::nullopt);
+    breakpoints.clear();
+    breakpoints.set_watchpoint(address, access);
+
+    if ((Byte)access & (Byte)Access::WRITE) {
+        const auto result = execute();
+        ASSERT_TRUE(result.has_value()) << testID;
+        ASSERT_TRUE(std::holds_alternative<StopOnWatchpoint>(result.value())) << testID;
+
+        const auto hit = std::get<StopOnWatchpoint>(result.value());
+        EXPECT_EQ(hit.address, (Word)(initialPC + 4)) << testID;
+        EXPECT_EQ(hit.accessedAddress, address) << testID;
+        EXPECT_EQ(hit.access, Access::WRITE) << testID;
+        EXPECT_EQ(PC, (Word)(initialPC + 4)) << testID;
+    }
+
+    if ((Byte)access & (Byte)Access::READ) {
+        const auto result = execute();
+        ASSERT_TRUE(result.has_value()) << testID;
+        ASSERT_TRUE(std::holds_alternative<StopOnWatchpoint>(result.value())) << testID;
+
+        const auto hit = std::get<StopOnWatchpoint>(result.value());
+        EXPECT_EQ(hit.address, (Word)(initialPC + 6)) << testID;
+        EXPECT_EQ(hit.accessedAddress, address) << testID;
+        EXPECT_EQ(hit.access, Access::READ) << testID;
+    }
+
+    const auto result = execute();
+    ASSERT_TRUE(result.has_value()) << testID;
+    EXPECT_TRUE(std::holds_alternative<StopOnBreak>(result.value())) << testID;
+    breakpoints.clear();
+}
+
+void MOS6502_TestFixture::test_recorder(size_t snapshotInterval, size_t maxSnapshots) {
+    reset();
+    PC = 0x0200;
+
+    std::string testID = std::vformat("Test recorder(snapshot interval: {:d}, max snapshots: {:d})",
+                                      std::make_format_args(snapshotInterval, maxSnapshots));
+
+    // loop: INX; TXA; PHA; PLA; STA $10,X; ADC $10; INC $20; JSR subroutine; JMP loop; subroutine: DEY; STY $30; RTS
+    const std::array<Byte, 20> program{
+        INX_IMPLICIT, TXA_IMPLICIT, PHA_IMPLICIT, PLA_IMPLICIT, STA_ZERO_PAGE_X, 0x10, ADC_ZERO_PAGE, 0x10,
+        INC_ZERO_PAGE, 0x20, JSR_ABSOLUTE, 0x10, 0x02, JMP_ABSOLUTE, 0x00, 0x02,
+        DEY_IMPLICIT, STY_ZERO_PAGE, 0x30, RTS_IMPLICIT
+    };
+    memory.load(0x0200, program);
+    stop_on_break(true);
+    breakpoints.clear();
+
+    constexpr size_t totalCommands = 300;
+    const auto initialState = get_state();
+    const ROM initialMemory = memory;
+
+    // reference run, one command at a time
+    std::vector<State> states{initialState};
+    std::map<size_t, ROM> memories{{0, memory}};
+    for (size_t position = 1; position <= totalCommands; position++) {
+        max_number_of_commands(1);
+        execute();
+        states.push_back(get_state());
+        if (position % 7 == 0) memories[position] = memory;
+    }
+    const auto finalMemory = memory;
+
+    set_state(initialState);
+    memory = initialMemory;
+
+    Recorder recorder(*this, {.snapshotInterval = snapshotInterval, .maxSnapshots = maxSnapshots});
+    const auto result = recorder.run(totalCommands);
+    ASSERT_TRUE(result.has_value()) << testID;
+    ASSERT_EQ(recorder.position(), totalCommands) << testID;
+    EXPECT_LE(recorder.snapshot_count(), maxSnapshots) << testID;
+    EXPECT_EQ(memory, finalMemory) << testID;
+
+    const auto checkState = [this, &testID](const State &expected, size_t position) {
+        EXPECT_EQ(PC, expected.PC) << testID << " position " << position;
+        EXPECT_EQ(AC, expected.AC) << testID << " position " << position;
+        EXPECT_EQ(X, expected.X) << testID << " position " << position;
+        EXPECT_EQ(Y, expected.Y) << testID << " position " << position;
+        EXPECT_EQ(SP, expected.SP) << testID << " position " << position;
+        EXPECT_EQ(SR, expected.SR) << testID << " position " << position;
+        EXPECT_EQ(cycle, expected.cycle) << testID << " position " << position;
+    };
+
+    // going backwards from the end, then forward again
+    for (auto it = memories.rbegin(); it != memories.rend(); it++) {
+        const auto &[position, expectedMemory] = *it;
+        if (position < recorder.earliest_position()) {
+            EXPECT_FALSE(recorder.seek(position)) << testID;
+            continue;
+        }
+        ASSERT_TRUE(recorder.seek(position)) << testID;
+        EXPECT_EQ(recorder.position(), position) << testID;
+        checkState(states[position], position);
+        EXPECT_EQ(memory, expectedMemory) << testID << " position " << position;
+
+        // in the middle of the command, the state must be the one at its start
+        if (position > recorder.earliest_position() && states[position].cycle > states[position - 1].cycle + 1) {
+            ASSERT_TRUE(recorder.seek_cycle(states[position - 1].cycle + 1)) << testID;
+            EXPECT_EQ(recorder.position(), position - 1) << testID;
+            checkState(states[position - 1], position - 1);
+        }
+    }
+
+    // execution after stepping back continues exactly as the original one
+    const auto earliest = recorder.earliest_position();
+    ASSERT_TRUE(recorder.seek(earliest)) << testID;
+    recorder.run(totalCommands - earliest);
+    checkState(states[totalCommands], totalCommands);
+    EXPECT_EQ(memory, finalMemory) << testID;
+    EXPECT_FALSE(recorder.step_back(totalCommands + 1)) << testID;
+}
+
+void MOS6502_TestFixture::test_multiplication(Byte a, Byte b) {
+    const std::string testID = std::format("{:d} * {:d}", a, b);
+    reset();
+    // followed by BRK
+    memory.load(0x0200, program_multiplication<0x0200>());
+    memory[0x0000] = 0x5A;
+    PC = 0x0200;
+    AC = a;
+    X = b;
+    maxNumberOfCommandsToExecute = 10'000;
+    stopOnBRK = true;
+
+    const auto result = execute();
+    stopOnBRK = false;
+    ASSERT_TRUE(result.has_value()) << testID;
+    EXPECT_TRUE(std::holds_alternative<StopOnBreak>(result.value())) << testID;
+    EXPECT_EQ(AC | Y << 8, a * b) << testID;
+    EXPECT_EQ(std::as_const(memory)[0x0000], 0x5A) << testID;
+}
+
+void MOS6502_TestFixture::test_save_states() {
+    reset();
+    PC = 0x0200;
+
+    // loop: INX; PHA; STA $10,X; STA $3000,X; JMP loop
+    const std::array<Byte, 11> program{
+        INX_IMPLICIT, PHA_IMPLICIT, STA_ZERO_PAGE_X, 0x10, STA_ABSOLUTE_X, 0x00, 0x30, JMP_ABSOLUTE, 0x00, 0x02, NOP_IMPLICIT
+    };
+    memory.load(0x0200, program);
+    stop_on_break(true);
+    breakpoints.clear();
+
+    SaveStates saves(*this);
+    std::vector<State> states;
+    std::vector<ROM> memories;
+    const auto run = [&]() {
+        AC += 3;
+        max_number_of_commands(20);
+        ASSERT_TRUE(execute().has_value());
+    };
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(saves.save(), i);
+        states.push_back(get_state());
+        memories.push_back(memory);
+        run();
+    }
+
+    // the zero page, the stack and the page at 0x3000
+    EXPECT_EQ(saves.stored_pages(0), ROM::PAGES_COUNT);
+    for (size_t i = 1; i < saves.size(); i++) EXPECT_EQ(saves.stored_pages(i), 3) << "save-state " << i;
+
+    const auto checkState = [this](size_t index, const State &expected, const ROM &expectedMemory) {
+        EXPECT_EQ(PC, expected.PC) << "save-state " << index;
+        EXPECT_EQ(AC, expected.AC) << "save-state " << index;
+        EXPECT_EQ(X, expected.X) << "save-state " << index;
+        EXPECT_EQ(SP, expected.SP) << "save-state " << index;
+        EXPECT_EQ(cycle, expected.cycle) << "save-state " << index;
+        EXPECT_EQ(memory, expectedMemory) << "save-state " << index;
+    };
+
+    EXPECT_FALSE(saves.restore(4));
+    ASSERT_TRUE(saves.restore(2));
+    EXPECT_EQ(saves.size(), 3);
+    checkState(2, states[2], memories[2]);
+
+    // the next save-state is relative to the restored one
+    run();
+    memory[0x4000] = 1;
+    EXPECT_EQ(saves.save(), 3);
+    EXPECT_EQ(saves.stored_pages(3), 4);
+
+    ASSERT_TRUE(saves.restore(1));
+    checkState(1, states[1], memories[1]);
+    ASSERT_TRUE(saves.restore(0));
+    checkState(0, states[0], memories[0]);
+    EXPECT_EQ(saves.size(), 1);
+
+    // nothing has been written since the restored save-state
+    EXPECT_EQ(saves.save(), 1);
+    EXPECT_EQ(saves.stored_pages(1), 0);
+}
+
+
+void MOS6502_TestFixture::test_illegal_operation(const std::vector<Byte> &program,
+                                                 const State &initial, const std::map<Word, Byte> &initialMemory,
+                                                 const State &expected, const std::map<Word, Byte> &expectedMemory) {
+    reset();
+    set_state(initial);
+
+    std::string testID = std::vformat("Test illegal operation(opcode: {:#02x}, initial PC: {:#04x})",
+                                      std::make_format_args(program.front(), initial.PC));
+
+    memory.load(initial.PC, program);
+    for (const auto &[address, value]: initialMemory) memory.load(address, std::array{value});
+    max_number_of_commands(1);
+
+    const auto result = execute();
+    ASSERT_TRUE(result.has_value()) << testID;
+    EXPECT_TRUE(std::holds_alternative<StopOnMaxReached>(result.value())) << testID;
+
+    EXPECT_EQ(PC, expected.PC) << testID;
+    EXPECT_EQ(AC, expected.AC) << testID;
+    EXPECT_EQ(X, expected.X) << testID;
+    EXPECT_EQ(Y, expected.Y) << testID;
+    EXPECT_EQ(SR, expected.SR) << testID << ", flags: " << SR.to_string();
+    EXPECT_EQ(SP, expected.SP) << testID;
+    EXPECT_EQ(cycle, expected.cycle) << testID;
+    for (const auto &[address, value]: expectedMemory)
+        EXPECT_EQ(memory[address], value) << testID << std::vformat(", address: {:#04x}", std::make_format_args(address));
+}
+
+void MOS6502_TestFixture::test_jam(Word initialPC, Byte opCode) {
+    reset();
+    PC = initialPC;
+
+    std::string testID = std::vformat("Test JAM(opcode: {:#02x}, initial PC: {:#04x})", std::make_format_args(opCode, initialPC));
+
+    memory.load(initialPC, std::array{opCode});
+    max_number_of_commands(std::nullopt);
+
+    // the processor stays halted at the same command until it is reset
+    for (int attempt = 0; attempt < 2; attempt++) {
+        const auto result = execute();
+        ASSERT_FALSE(result.has_value()) << testID;
+        ASSERT_TRUE(std::holds_alternative<Jammed>(result.error())) << testID;
+        EXPECT_EQ(std::get<Jammed>(result.error()).address, initialPC) << testID;
+        EXPECT_EQ(PC, initialPC) << testID;
+    }
+    EXPECT_EQ(get_metrics().snapshot().instructionsRetired, 0) << testID;
+
+    trap_illegal_opcodes(true);
+    const auto result = execute();
+    ASSERT_FALSE(result.has_value()) << testID;
+    EXPECT_TRUE(std::holds_alternative<UnknownOperation>(result.error())) << testID;
+}
+
+
+/// executes the given number of commands of the program loaded at 0x0200 by a fresh CPU of the given instantiation
+template<class CPU>
+static std::pair<typename CPU::State, std::expected<typename CPU::SuccessfulTermination, typename CPU::ErrorTermination>>
+run_program(const ROM &memory, typename CPU::State initial, size_t commands) {
+    CPU cpu{};
+    cpu.burn(memory);
+    cpu.set_state(initial);
+    cpu.stop_on_break(false);
+    cpu.max_number_of_commands(commands);
+    const auto result = cpu.execute();
+    return {cpu.get_state(), result};
+}
+
+void MOS6502_TestFixture::test_cycle_accounting() {
+    // LDX #$01; LDA $02FF,X; STA $10; INC $10; ASL $10; DEX; BNE +5; BEQ +1; NOP; LDY $10
+    constexpr std::array<Byte, 19> program {0xA2, 0x01, 0xBD, 0xFF, 0x02, 0x85, 0x10, 0xE6, 0x10, 0x06, 0x10,
+                                            0xCA, 0xD0, 0x05, 0xF0, 0x01, 0xEA, 0xA4, 0x10};
+    // including the cycle taken by crossing the page in LDA and the one taken by the branch of BEQ
+    constexpr size_t publishedDuration = 2 + 5 + 3 + 5 + 5 + 2 + 2 + 3 + 3;
+    constexpr size_t commands = 9;
+
+    ROM rom;
+    rom.load(0x0200, program);
+    rom[0x0300] = 0x40;
+    const auto [exact, exactResult] = run_program<MOS6502>(rom, {.PC = 0x0200, .SP = 0xFF}, commands);
+    const auto [instruction, instructionResult] = run_program<BasicMOS6502<CycleAccounting::INSTRUCTION>>(rom, {.PC = 0x0200, .SP = 0xFF}, commands);
+    const auto [none, noneResult] = run_program<BasicMOS6502<CycleAccounting::NONE>>(rom, {.PC = 0x0200, .SP = 0xFF, .cycle = 123}, commands);
+    ASSERT_TRUE(exactResult.has_value() && instructionResult.has_value() && noneResult.has_value());
+
+    // every accounting shares the same instruction semantics
+    const auto check_registers = [&exact](const auto &state, const std::string &testID) {
+        EXPECT_EQ(state.PC, 0x0213) << testID;
+        EXPECT_EQ(state.AC, 0x40) << testID;
+        EXPECT_EQ(state.X, 0x00) << testID;
+        EXPECT_EQ(state.Y, 0x82) << testID;
+        EXPECT_EQ(state.SR, exact.SR) << testID;
+        EXPECT_TRUE(state.SR[Flag::NEGATIVE]) << testID;
+    };
+    check_registers(exact, "exact accounting");
+    check_registers(instruction, "instruction accounting");
+    check_registers(none, "no accounting");
+
+    EXPECT_GT(exact.cycle, 0);
+    EXPECT_EQ(instruction.cycle, publishedDuration);
+    EXPECT_EQ(none.cycle, 123);
+}
+
+void MOS6502_TestFixture::test_variants() {
+    using CMOS = BasicMOS6502<CycleAccounting::EXACT, Variant::CMOS>;
+
+    // JMP ($02FF) reads the high byte of the target from 0x0200 on NMOS and from 0x0300 on CMOS, which takes a cycle more
+    ROM rom;
+    rom.load(0x0200, std::array<Byte, 3>{JMP_INDIRECT, 0xFF, 0x02});
+    rom[0x02FF] = 0x34;
+    rom[0x0300] = 0x12;
+
+    const auto [nmosJump, nmosJumpResult] = run_program<MOS6502>(rom, {.PC = 0x0200, .SP = 0xFF}, 1);
+    const auto [cmosJump, cmosJumpResult] = run_program<CMOS>(rom, {.PC = 0x0200, .SP = 0xFF}, 1);
+    ASSERT_TRUE(nmosJumpResult.has_value() && cmosJumpResult.has_value());
+    EXPECT_EQ(nmosJump.PC, 0x6C34);
+    EXPECT_EQ(cmosJump.PC, 0x1234);
+    EXPECT_EQ(cmosJump.cycle, nmosJump.cycle + 1);
+
+    // BRK leaves the decimal mode only on CMOS
+    rom.reset();
+    rom.load(0x0200, std::array<Byte, 1>{BRK_IMPLICIT});
+    rom.load(ROM::BRK_HANDLER, std::array<Byte, 2>{0x00, 0x04});
+    ProcessorStatus decimal;
+    decimal[Flag::DECIMAL] = SET;
+
+    const auto [nmosBreak, nmosBreakResult] = run_program<MOS6502>(rom, {.PC = 0x0200, .SR = decimal, .SP = 0xFF}, 1);
+    const auto [cmosBreak, cmosBreakResult] = run_program<CMOS>(rom, {.PC = 0x0200, .SR = decimal, .SP = 0xFF}, 1);
+    ASSERT_TRUE(nmosBreakResult.has_value() && cmosBreakResult.has_value());
+    EXPECT_EQ(nmosBreak.PC, 0x0400);
+    EXPECT_EQ(cmosBreak.PC, 0x0400);
+    EXPECT_TRUE(nmosBreak.SR[Flag::DECIMAL]);
+    EXPECT_FALSE(cmosBreak.SR[Flag::DECIMAL]);
+
+    // the undocumented NMOS opcodes are not executed on CMOS
+    rom.reset();
+    rom.load(0x0200, std::array<Byte, 2>{LAX_ZERO_PAGE, 0x10});
+
+    const auto [nmosIllegal, nmosIllegalResult] = run_program<MOS6502>(rom, {.PC = 0x0200, .SP = 0xFF}, 1);
+    const auto [cmosIllegal, cmosIllegalResult] = run_program<CMOS>(rom, {.PC = 0x0200, .SP = 0xFF}, 1);
+    EXPECT_TRUE(nmosIllegalResult.has_value());
+    ASSERT_FALSE(cmosIllegalResult.has_value());
+    EXPECT_TRUE(std::holds_alternative<CMOS::UnknownOperation>(cmosIllegalResult.error()));
+}
+
+void MOS6502_TestFixture::test_decimal_mode() {
+    using CMOS = BasicMOS6502<CycleAccounting::EXACT, Variant::CMOS>;
+
+    struct Case {
+        OpCode opCode;
+        Byte a, b;
+        bool carry;
+        Byte result;
+        bool resultCarry;
+        /// the negative and the zero flags of NMOS, taken before the decimal adjustment; CMOS takes them from the result
+        bool negative, zero;
+    };
+    constexpr std::array<Case, 9> cases{
+        Case{ADC_IMMEDIATE, 0x12, 0x34, false, 0x46, false, false, false},
+        {ADC_IMMEDIATE, 0x58, 0x46, true, 0x05, true, true, false},
+        {ADC_IMMEDIATE, 0x99, 0x01, false, 0x00, true, true, false},
+        {ADC_IMMEDIATE, 0x79, 0x00, true, 0x80, false, true, false},
+        {ADC_IMMEDIATE, 0x50, 0x50, false, 0x00, true, true, false},
+        {SBC_IMMEDIATE, 0x46, 0x12, true, 0x34, true, false, false},
+        {SBC_IMMEDIATE, 0x40, 0x13, true, 0x27, true, false, false},
+        {SBC_IMMEDIATE, 0x00, 0x01, true, 0x99, false, true, false},
+        {SBC_IMMEDIATE, 0x32, 0x32, true, 0x00, true, false, true},
+    };
+
+    for (const auto &[opCode, a, b, carry, result, resultCarry, negative, zero]: cases) {
+        const std::string testID = std::vformat("Test decimal {:#04x}(a: {:#04x}, b: {:#04x}, carry: {:d})",
+                                                std::make_format_args(opCode, a, b, carry));
+        ROM rom;
+        rom.load(0x0200, std::array<Byte, 2>{opCode, b});
+        ProcessorStatus status;
+        status[Flag::DECIMAL] = SET;
+        status[Flag::CARRY] = carry;
+
+        const auto [nmos, nmosResult] = run_program<MOS6502>(rom, {.PC = 0x0200, .AC = a, .SR = status, .SP = 0xFF}, 1);
+        const auto [cmos, cmosResult] = run_program<CMOS>(rom, {.PC = 0x0200, .AC = a, .SR = status, .SP = 0xFF}, 1);
+        ASSERT_TRUE(nmosResult.has_value() && cmosResult.has_value()) << testID;
+
+        EXPECT_EQ(nmos.AC, result) << testID;
+        EXPECT_EQ(cmos.AC, result) << testID;
+        EXPECT_EQ(nmos.SR[Flag::CARRY], resultCarry) << testID;
+        EXPECT_EQ(cmos.SR[Flag::CARRY], resultCarry) << testID;
+        EXPECT_EQ(nmos.SR[Flag::NEGATIVE], negative) << testID;
+        EXPECT_EQ(nmos.SR[Flag::ZERO], zero) << testID;
+        EXPECT_EQ(cmos.SR[Flag::NEGATIVE], get_bit(result, 7)) << testID;
+        EXPECT_EQ(cmos.SR[Flag::ZERO], result == 0) << testID;
+        EXPECT_EQ(nmos.cycle, 2) << testID;
+        EXPECT_EQ(cmos.cycle, 3) << testID;
+    }
+
+    // the overflow flag comes from the sum of the digits before the high one is adjusted
+    ROM rom;
+    rom.load(0x0200, std::array<Byte, 2>{ADC_IMMEDIATE, 0x00});
+    ProcessorStatus status;
+    status[Flag::DECIMAL] = SET;
+    status[Flag::CARRY] = SET;
+    const auto [overflow, overflowResult] = run_program<MOS6502>(rom, {.PC = 0x0200, .AC = 0x79, .SR = status, .SP = 0xFF}, 1);
+    ASSERT_TRUE(overflowResult.has_value());
+    EXPECT_TRUE(overflow.SR[Flag::OVERFLOW_F]);
+}
+
+
+void MOS6502_TestFixture::test_opcode_table() {
+    EXPECT_EQ(std::ranges::count(DOCUMENTED_OPCODES, true), 151);
+
+    // every operation is encoded with the length given by the table and described with its mnemonic
+    [&]<size_t ... index>(std::index_sequence<index...>) {
+        const auto check = [](const Operation &operation) {
+            const auto bytes = encode(operation);
+            ASSERT_FALSE(bytes.empty());
+            const auto &info = OPCODES[bytes.front()];
+            const std::string testID = std::string(info.mnemonic) + ' ' + std::to_string(bytes.front());
+
+            EXPECT_EQ(bytes.size(), info.length) << testID;
+            EXPECT_TRUE(description(operation).starts_with(info.mnemonic)) << testID;
+        };
+        (check(std::variant_alternative_t<index, Operation>{}), ...);
+    }(std::make_index_sequence<std::variant_size_v<Operation>>{});
+
+    EXPECT_EQ(description(BCS{.offset = 5}), "BCS *+5");
+    EXPECT_EQ(description(JSR{.address = 0x1234}), "JSR $1234");
+    EXPECT_EQ(description(JMP_Indirect{.address = 0x1234}), "JMP ($1234)");
+    EXPECT_EQ(description(LDA_AbsoluteX{.address = 0x1234}), "LDA $1234,X");
+    EXPECT_EQ(description(ASL_Accumulator{}), "ASL A");
+    EXPECT_EQ(description(LDA_IMMEDIATE, 0x10), "LDA #16");
+    EXPECT_EQ(encode(STA_Absolute{.address = 0x1234}), (std::vector<Byte>{STA_ABSOLUTE, 0x34, 0x12}));
+    EXPECT_EQ(byte_description(LAX_ZERO_PAGE), "LAX");
+
+    EXPECT_TRUE(OPCODES[ADC_IMMEDIATE].affects(Flag::OVERFLOW_F));
+    EXPECT_FALSE(OPCODES[LDA_IMMEDIATE].affects(Flag::CARRY));
+    EXPECT_EQ(OPCODES[STA_ABSOLUTE_X].flags, 0);
+    EXPECT_TRUE(OPCODES[LDA_ABSOLUTE_X].pageCrossPenalty);
+    EXPECT_FALSE(OPCODES[STA_ABSOLUTE_X].pageCrossPenalty);
+    EXPECT_EQ(OPCODES[JMP_INDIRECT].mode, AddressingMode::INDIRECT);
+    EXPECT_EQ(OPCODE_CYCLES[JSR_ABSOLUTE], 6);
+}
+
+/// the operand addresses 0x0310 directly and 0x0480 through the zero page pointer, so that only indexing by 0xFF crosses the page
+static void load_timed_command(ROM &memory, Byte opCode, Word initialPC) {
+    memory.load(initialPC, std::array<Byte, 3>{opCode, 0x10, 0x03});
+    memory.load(0x0010, std::array<Byte, 2>{0x80, 0x04});
+}
+
+void MOS6502_TestFixture::test_exact_timing(Byte opCode, Word initialPC, Byte index, Byte status) {
+    reset();
+    PC = initialPC;
+    X = index;
+    Y = index;
+    SR = status;
+
+    std::string testID = std::vformat("Test timing({} {:#02x}, initial PC: {:#04x}, index: {:#02x}, status: {:#02x})",
+                                      std::make_format_args(byte_description(opCode), opCode, initialPC, index, status));
+
+    load_timed_command(memory, opCode, initialPC);
+    stop_on_break(false);
+    max_number_of_commands(1);
+
+    const auto result = execute();
+    ASSERT_TRUE(result.has_value()) << testID;
+
+    const auto &info = OPCODES[opCode];
+    size_t expected = info.cycles;
+    if (info.pageCrossPenalty && index == 0xFF) expected++;
+    if (info.mode == AddressingMode::RELATIVE && PC != initialPC + 2) {
+        // the branch is taken
+        expected++;
+        if (WordToBytes(PC).high != WordToBytes(initialPC + 2).high) expected++;
+    }
+    EXPECT_EQ(cycle, expected) << testID;
+}
+
+void MOS6502_TestFixture::test_cycle_stepper(Byte opCode, Word initialPC, Byte index, Byte status) {
+    reset();
+    PC = initialPC;
+    X = index;
+    Y = index;
+    SR = status;
+    load_timed_command(memory, opCode, initialPC);
+
+    std::string testID = std::vformat("Test cycle stepper({} {:#02x}, initial PC: {:#04x}, index: {:#02x}, status: {:#02x})",
+                                      std::make_format_args(byte_description(opCode), opCode, initialPC, index, status));
+
+    // the reference is the instruction-level engine, run from the same state
+    const auto initial = get_state();
+    const ROM initialMemory = memory;
+    stop_on_break(false);
+    max_number_of_commands(1);
+    (void)execute();
+    const auto expected = get_state();
+    const ROM expectedMemory = memory;
+
+    memory = initialMemory;
+    set_state(initial);
+    CycleStepper stepper(*this);
+    stepper.step_command();
+    EXPECT_TRUE(stepper.at_command_boundary()) << testID;
+    EXPECT_EQ(stepper.jammed(), OPCODES[opCode].mnemonic == "JAM") << testID;
+
+    EXPECT_EQ(PC, expected.PC) << testID;
+    EXPECT_EQ(cycle, expected.cycle) << testID;
+    // BRK of the instruction-level engine neither pushes the status nor disables interrupts
+    if (OPCODES[opCode].mnemonic == "BRK") return;
+
+    EXPECT_EQ(AC, expected.AC) << testID;
+    EXPECT_EQ(X, expected.X) << testID;
+    EXPECT_EQ(Y, expected.Y) << testID;
+    EXPECT_EQ(SR, expected.SR) << testID;
+    EXPECT_EQ(SP, expected.SP) << testID;
+    EXPECT_TRUE(memory == expectedMemory) << testID;
+}
+
+void MOS6502_TestFixture::test_cycle_stepper_bus() {
+    using Bus = std::vector<CycleStepper::BusAccess>;
+    constexpr auto READ = Access::READ, WRITE = Access::WRITE;
+
+    Bus accesses;
+    CycleStepper stepper(*this);
+    stepper.set_bus_callback([&accesses](const CycleStepper::BusAccess &access) { accesses.push_back(access); });
+
+    // LDA $02FF,X reads from the wrong page before fixing the high byte of the address
+    reset();
+    PC = 0x0200;
+    X = 1;
+    memory.load(0x0200, std::array<Byte, 3>{LDA_ABSOLUTE_X, 0xFF, 0x02});
+    memory[0x0300] = 0x42;
+    stepper.step_command();
+    EXPECT_EQ(AC, 0x42);
+    EXPECT_EQ(accesses, (Bus{{0, 0x0200, LDA_ABSOLUTE_X, READ}, {1, 0x0201, 0xFF, READ}, {2, 0x0202, 0x02, READ},
+                             {3, 0x0200, LDA_ABSOLUTE_X, READ}, {4, 0x0300, 0x42, READ}}));
+
+    // STA $0300,X reads the target before writing to it, even within the page
+    reset();
+    accesses.clear();
+    PC = 0x0200;
+    AC = 0x42;
+    memory.load(0x0200, std::array<Byte, 3>{STA_ABSOLUTE_X, 0x00, 0x03});
+    stepper.step_command();
+    EXPECT_EQ(accesses, (Bus{{0, 0x0200, STA_ABSOLUTE_X, READ}, {1, 0x0201, 0x00, READ}, {2, 0x0202, 0x03, READ},
+                             {3, 0x0300, 0x00, READ}, {4, 0x0300, 0x42, WRITE}}));
+
+    // INC $10 writes the unmodified value back before the incremented one
+    reset();
+    accesses.clear();
+    PC = 0x0200;
+    memory.load(0x0200, std::array<Byte, 2>{INC_ZERO_PAGE, 0x10});
+    memory[0x0010] = 0x41;
+    stepper.step_command();
+    EXPECT_EQ(accesses, (Bus{{0, 0x0200, INC_ZERO_PAGE, READ}, {1, 0x0201, 0x10, READ}, {2, 0x0010, 0x41, READ},
+                             {3, 0x0010, 0x41, WRITE}, {4, 0x0010, 0x42, WRITE}}));
+
+    // a taken BNE crossing the page reads the next opcode and then the same offset in the wrong page
+    reset();
+    accesses.clear();
+    PC = 0x02FC;
+    memory.load(0x02FC, std::array<Byte, 2>{BNE_RELATIVE, 0x04});
+    stepper.step_command();
+    EXPECT_EQ(PC, 0x0302);
+    EXPECT_EQ(accesses, (Bus{{0, 0x02FC, BNE_RELATIVE, READ}, {1, 0x02FD, 0x04, READ},
+                             {2, 0x02FE, 0x00, READ}, {3, 0x0202, 0x00, READ}}));
+}
+
+void MOS6502_TestFixture::test_cycle_stepper_interrupts() {
+    constexpr Byte interruptDisable = 1 << (int)Flag::INTERRUPT_DISABLE, breakCommand = 1 << (int)Flag::BREAK;
+
+    const auto prepare = [this](Byte status) {
+        reset();
+        PC = 0x0200;
+        SR = status;
+        memory.load(0x0200, std::array<Byte, 3>{CLI_IMPLICIT, NOP_IMPLICIT, NOP_IMPLICIT});
+        memory.load(ROM::BRK_HANDLER, std::array<Byte, 2>{0x00, 0x04});
+        memory.load(ROM::INTERRUPT_HANDLER, std::array<Byte, 2>{0x00, 0x05});
+        memory[0x0400] = NOP_IMPLICIT;
+        memory[0x0500] = NOP_IMPLICIT;
+    };
+
+    // CLI takes effect only after the next command, since the line is polled before the last cycle of each command
+    prepare(interruptDisable);
+    CycleStepper stepper(*this);
+    stepper.set_irq(true);
+    stepper.step_command();
+    EXPECT_EQ(PC, 0x0201);
+    stepper.step_command();
+    EXPECT_EQ(PC, 0x0202);
+
+    // the interrupt takes 7 cycles and pushes the status with the break flag clear
+    stepper.step_command();
+    EXPECT_EQ(PC, 0x0400);
+    EXPECT_EQ(cycle, 2 + 2 + 7);
+    EXPECT_EQ(SP, 0xFC);
+    EXPECT_EQ(memory.stack(0xFF), 0x02);
+    EXPECT_EQ(memory.stack(0xFE), 0x02);
+    EXPECT_EQ(memory.stack(0xFD) & breakCommand, 0);
+    EXPECT_TRUE(SR[Flag::INTERRUPT_DISABLE]);
+    EXPECT_EQ(get_metrics().snapshot().instructionsRetired, 2);
+
+    // the handler is not interrupted again while interrupts are disabled
+    stepper.step_command();
+    EXPECT_EQ(PC, 0x0401);
+
+    // NMI is served regardless of the interrupt disable flag, but only once per edge
+    prepare(interruptDisable);
+    stepper.reset();
+    stepper.trigger_nmi();
+    stepper.step_command();
+    stepper.step_command();
+    EXPECT_EQ(PC, 0x0500);
+    stepper.step_command();
+    EXPECT_EQ(PC, 0x0501);
+
+    // BRK pushes the status with the break flag set
+    prepare(0);
+    memory[0x0200] = BRK_IMPLICIT;
+    stepper.reset();
+    stepper.step_command();
+    EXPECT_EQ(PC, 0x0400);
+    EXPECT_EQ(cycle, 7);
+    EXPECT_EQ(memory.stack(0xFD) & breakCommand, breakCommand);
+}
+
+void MOS6502_TestFixture::test_idle_loop(const std::vector<Byte> &program, size_t commands, bool idle) {
+    std::string testID = std::vformat("Test idle loop(opcode: {:#02x}, commands: {:d})", std::make_format_args(program[0], commands));
+
+    const auto run = [&](bool skip) {
+        reset();
+        PC = 0x0200;
+        memory.load(PC, program);
+        // the page crossing of indexed reads is skipped as well
+        X = 0xFF;
+        max_number_of_commands(commands);
+        skip_idle_loops(skip);
+        const auto result = execute();
+        EXPECT_TRUE(result.has_value() && std::holds_alternative<StopOnMaxReached>(result.value())) << testID;
+        return std::pair{get_state(), get_metrics().snapshot()};
+    };
+
+    const auto [executedState, executed] = run(false);
+    const auto [skippedState, skipped] = run(true);
+    skip_idle_loops(true);
+
+    EXPECT_EQ(executed.idleCyclesSkipped, 0) << testID;
+    EXPECT_EQ(skipped.idleCyclesSkipped > 0, idle) << testID;
+    EXPECT_LT(skipped.idleCyclesSkipped, skippedState.cycle) << testID;
+
+    EXPECT_EQ(skippedState.PC, executedState.PC) << testID;
+    EXPECT_EQ(skippedState.AC, executedState.AC) << testID;
+    EXPECT_EQ(skippedState.X, executedState.X) << testID;
+    EXPECT_EQ(skippedState.Y, executedState.Y) << testID;
+    EXPECT_EQ(skippedState.SR, executedState.SR) << testID;
+    EXPECT_EQ(skippedState.SP, executedState.SP) << testID;
+    EXPECT_EQ(skippedState.cycle, executedState.cycle) << testID;
+
+    EXPECT_EQ(skipped.instructionsRetired, commands) << testID;
+    EXPECT_EQ(skipped.instructionsRetired, executed.instructionsRetired) << testID;
+    EXPECT_EQ(skipped.cycles, executed.cycles) << testID;
+    EXPECT_EQ(skipped.pageCrossings, executed.pageCrossings) << testID;
+    EXPECT_EQ(skipped.stackPulls, executed.stackPulls) << testID;
+}
+
+void MOS6502_TestFixture::test_accelerated_loop(const std::vector<Byte> &program, Byte index, std::optional<size_t> commands, bool accelerated) {
+    const size_t limit = commands.value_or(0);
+    std::string testID = std::vformat("Test accelerated loop(opcode: {:#02x}, index: {:#02x}, commands: {:d})",
+                                      std::make_format_args(program[0], index, limit));
+
+    const auto run = [&](bool accelerate) {
+        reset();
+        PC = 0x0200;
+        memory.load(PC, program);
+        memory.load(0x10, std::array<Byte, 4>{0x80, 0x03, 0xC0, 0x04});
+        for (Word address = 0x0380; address < 0x0480; address++) memory[address] = (Byte)(address * 7);
+        X = Y = index;
+        AC = 0x5A;
+        stop_on_break(true);
+        max_number_of_commands(commands);
+        accelerate_loops(accelerate);
+        const auto result = execute();
+        EXPECT_TRUE(result.has_value()) << testID;
+        return std::tuple{result.has_value() ? result.value().index() : 0, get_state(), memory, get_metrics().snapshot()};
+    };
+
+    const auto [executedResult, executedState, executedMemory, executed] = run(false);
+    const auto [acceleratedResult, acceleratedState, acceleratedMemory, metrics] = run(true);
+    accelerate_loops(true);
+
+    EXPECT_EQ(executed.loopsAccelerated, 0) << testID;
+    EXPECT_EQ(metrics.loopsAccelerated, accelerated ? 1 : 0) << testID;
+
+    EXPECT_EQ(acceleratedResult, executedResult) << testID;
+    EXPECT_EQ(acceleratedState.PC, executedState.PC) << testID;
+    EXPECT_EQ(acceleratedState.AC, executedState.AC) << testID;
+    EXPECT_EQ(acceleratedState.X, executedState.X) << testID;
+    EXPECT_EQ(acceleratedState.Y, executedState.Y) << testID;
+    EXPECT_EQ(acceleratedState.SR, executedState.SR) << testID;
+    EXPECT_EQ(acceleratedState.SP, executedState.SP) << testID;
+    EXPECT_EQ(acceleratedState.cycle, executedState.cycle) << testID;
+    EXPECT_TRUE(acceleratedMemory == executedMemory) << testID;
+
+    EXPECT_EQ(metrics.instructionsRetired, executed.instructionsRetired) << testID;
+    EXPECT_EQ(metrics.cycles, executed.cycles) << testID;
+    EXPECT_EQ(metrics.pageCrossings, executed.pageCrossings) << testID;
+}
+
+extern const RecompiledProgram recompiled_firmware;
+
+void MOS6502_TestFixture::test_recompiled(std::optional<size_t> commands, std::optional<Word> patched) {
+    const size_t limit = commands.value_or(0);
+    const Word address = patched.value_or(0);
+    std::string testID = std::vformat("Test recompiled(commands: {:d}, patched: {:#04x})", std::make_format_args(limit, address));
+
+    std::ifstream file(FIRMWARE_IMAGE, std::ios::binary);
+    ASSERT_TRUE(file) << testID;
+    const std::vector<Byte> firmware{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    const auto run = [&](bool recompiled) {
+        reset();
+        memory.load(0xFF00, firmware);
+        if (patched.has_value()) memory[address] = NOP_IMPLICIT;
+        PC = memory.get_word(ROM::RESET_LOCATION);
+        stop_on_break(true);
+        max_number_of_commands(commands);
+        const auto result = recompiled ? RecompiledRuntime(*this, recompiled_firmware).execute() : execute();
+        EXPECT_TRUE(result.has_value()) << testID;
+        return std::tuple{result.has_value() ? result.value().index() : 0, get_state(), memory, get_metrics().snapshot()};
+    };
+
+    const auto [interpretedResult, interpretedState, interpretedMemory, interpreted] = run(false);
+    const auto [recompiledResult, recompiledState, recompiledMemory, metrics] = run(true);
+
+    EXPECT_EQ(recompiledResult, interpretedResult) << testID;
+    EXPECT_EQ(recompiledState.PC, interpretedState.PC) << testID;
+    EXPECT_EQ(recompiledState.AC, interpretedState.AC) << testID;
+    EXPECT_EQ(recompiledState.X, interpretedState.X) << testID;
+    EXPECT_EQ(recompiledState.Y, interpretedState.Y) << testID;
+    EXPECT_EQ(recompiledState.SR, interpretedState.SR) << testID;
+    EXPECT_EQ(recompiledState.SP, interpretedState.SP) << testID;
+    EXPECT_EQ(recompiledState.cycle, interpretedState.cycle) << testID;
+    EXPECT_TRUE(recompiledMemory == interpretedMemory) << testID;
+
+    EXPECT_EQ(metrics.instructionsRetired, interpreted.instructionsRetired) << testID;
+    EXPECT_EQ(metrics.cycles, interpreted.cycles) << testID;
+    EXPECT_EQ(metrics.pageCrossings, interpreted.pageCrossings) << testID;
+    EXPECT_EQ(metrics.stackPushes, interpreted.stackPushes) << testID;
+    EXPECT_EQ(metrics.stackPulls, interpreted.stackPulls) << testID;
+}
+
+void MOS6502_TestFixture::test_routine_timing(const std::vector<Byte> &routine, const std::map<Word, LoopBound> &bounds,
+                                              CycleRange expected, const std::vector<std::array<Byte, 3>> &inputs) {
+    std::string testID = std::vformat("Test routine timing(opcode: {:#02x}, best: {:d}, worst: {:d})",
+                                      std::make_format_args(routine[0], expected.best, expected.worst));
+
+    reset();
+    memory.load(0x0200, routine);
+    TimingAnalyzer analyzer(memory);
+    for (const auto &[header, bound]: bounds) analyzer.bound_loop(header, bound);
+    const auto range = analyzer.analyze(0x0200);
+    ASSERT_TRUE(range.has_value()) << testID;
+    EXPECT_EQ(range->best, expected.best) << testID;
+    EXPECT_EQ(range->worst, expected.worst) << testID;
+
+    // the routine is called from 0x0300, and returns to the breakpoint after the call
+    constexpr Byte JSR_CYCLES = 6;
+    for (const auto [ac, x, y]: inputs) {
+        reset();
+        memory.load(0x0200, routine);
+        memory.load(0x0300, std::array<Byte, 4>{JSR_ABSOLUTE, 0x00, 0x02, NOP_IMPLICIT});
+        PC = 0x0300;
+        AC = ac;
+        X = x;
+        Y = y;
+        breakpoints.set_breakpoint(0x0303);
+        const auto result = execute();
+        breakpoints.clear();
+
+        EXPECT_TRUE(result.has_value() && std::holds_alternative<StopOnBreakpoint>(result.value())) << testID;
+        EXPECT_GE(cycle - JSR_CYCLES, range->best) << testID << std::format(", AC: {:#02x}, X: {:#02x}, Y: {:#02x}", ac, x, y);
+        EXPECT_LE(cycle - JSR_CYCLES, range->worst) << testID << std::format(", AC: {:#02x}, X: {:#02x}, Y: {:#02x}", ac, x, y);
+    }
+}
+
+#ifndef _WIN32
+/// minimal debugger side of the protocol, with acknowledgements turned on
+class GdbClient {
+public:
+    explicit GdbClient(const std::string &path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+
+        m_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+        // the server may not be listening yet
+        for (int attempt = 0; attempt < 100; attempt++) {
+            if (connect(m_socket, (const sockaddr*)&address, sizeof(address)) == 0) return;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    ~GdbClient() { close(m_socket); }
+
+    std::string request(const std::string &data) {
+        Byte checksum = 0;
+        for (const auto byte: data) checksum += byte;
+        const auto packet = std::vformat("${}#{:02x}", std::make_format_args(data, checksum));
+        send(m_socket, packet.data(), packet.size(), 0);
+
+        if (receive() != '+') return "<no acknowledgement>";
+        if (receive() != '$') return "<no reply>";
+
+        std::string reply;
+        for (char byte = receive(); byte != '#'; byte = receive()) reply += byte;
+        receive();
+        receive();
+        send(m_socket, "+", 1, 0);
+        return reply;
+    }
+
+private:
+    char receive() {
+        char byte = 0;
+        recv(m_socket, &byte, 1, 0);
+        return byte;
+    }
+
+    int m_socket;
+};
+
+
+void MOS6502_TestFixture::test_gdb_server() {
+    const auto path = (std::filesystem::temp_directory_path() / "mos6502_gdb_test.sock").string();
+
+    reset();
+    PC = 0x0200;
+    AC = 0x12;
+    stop_on_break(true);
+    // LDA #$42; STA $10; NOP; BRK
+    const std::array<Byte, 6> program{0xa9, 0x42, 0x85, 0x10, 0xea, 0x00};
+    memory.load(PC, program);
+
+    GdbServer server(*this);
+    EXPECT_FALSE(server.listen_unix(std::string(200, 'x')).has_value());
+    ASSERT_TRUE(server.listen_unix(path).has_value());
+    std::thread serving([&server]() { ASSERT_TRUE(server.serve().has_value()); });
+
+    {
+        GdbClient client(path);
+        EXPECT_EQ(client.request("?"), "S05");
+        const Byte status = SR.to_byte();
+        const auto registers = std::vformat("12{:02x}{:02x}{:02x}{:02x}0002", std::make_format_args(X, Y, SP, status));
+        EXPECT_EQ(client.request("g"), registers);
+        EXPECT_EQ(client.request("m0200,3"), "a94285");
+
+        EXPECT_EQ(client.request("s"), "S05");
+        EXPECT_EQ(client.request("p0"), "42");
+        EXPECT_EQ(client.request("p5"), "0202");
+
+        EXPECT_EQ(client.request("Z2,10,1"), "OK");
+        EXPECT_EQ(client.request("c"), "T05watch:0010;");
+        EXPECT_EQ(client.request("m10,1"), "42");
+        EXPECT_EQ(client.request("z2,10,1"), "OK");
+
+        EXPECT_EQ(client.request("Z0,205,1"), "OK");
+        EXPECT_EQ(client.request("c"), "T05swbreak:;");
+        EXPECT_EQ(client.request("p5"), "0502");
+        EXPECT_EQ(client.request("z0,205,1"), "OK");
+
+        EXPECT_EQ(client.request("M10,2:abcd"), "OK");
+        EXPECT_EQ(client.request("m10,2"), "abcd");
+        EXPECT_EQ(client.request("P0=7f"), "OK");
+        EXPECT_EQ(AC, 0x7f);
+
+        EXPECT_EQ(client.request("c"), "S05");
+        EXPECT_EQ(client.request("vUnknownPacket"), "");
+        EXPECT_EQ(client.request("D"), "OK");
+    }
+    serving.join();
+}
+#endif
 
 Byte &MOS6502_TestFixture::operator[](const Location &address) {
     if (const auto memoryAddress = std::get_if<Word>(&address)) return memory[*memoryAddress];
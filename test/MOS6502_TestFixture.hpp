@@ -7,6 +7,7 @@
 
 #include <concepts>
 #include <functional>
+#include <map>
 
 #include <gtest/gtest.h>
 
@@ -14,6 +15,7 @@
 #include "Addressing.hpp"
 #include "MOS6502_helpers.hpp"
 #include "helpers.hpp"
+#include "TimingAnalyzer.hpp"
 
 
 
@@ -89,6 +91,86 @@ public:
     void test_nop();
 
     void test_return_from_interrupt(Word previousPC, Byte previousSR);
+
+    void test_metrics(Word initialPC, Word address, Byte index);
+
+    void test_unknown_operation_metrics(Byte opCode);
+
+    void test_breakpoint(Word initialPC, Word offset, bool conditionHolds);
+
+    void test_watchpoint(Word initialPC, Byte address, Access access);
+
+    void test_recorder(size_t snapshotInterval, size_t maxSnapshots);
+
+    /// takes save-states every few commands of a program, expecting the later ones to store only the pages it writes
+    void test_save_states();
+
+    /// executes a single command of the program and compares the registers, the cycle and the given memory
+    void test_illegal_operation(const std::vector<Byte> &program,
+                                const State &initial, const std::map<Word, Byte> &initialMemory,
+                                const State &expected, const std::map<Word, Byte> &expectedMemory);
+
+    void test_jam(Word initialPC, Byte opCode);
+
+    /// runs the same program with every cycle accounting, comparing the registers and the number of counted cycles
+    void test_cycle_accounting();
+
+    /// checks the behaviour differing between the NMOS and the CMOS processors
+    void test_variants();
+
+    /// checks ADC and SBC in the decimal mode on both NMOS and CMOS
+    void test_decimal_mode();
+
+    /// checks the opcode table against the operations and the descriptions generated from it
+    void test_opcode_table();
+
+    /**
+     * Executes the command with the given opcode and compares its duration with the published one.
+     * The command is placed at the given address, with both index registers and the status register set to the given values.
+     */
+    void test_exact_timing(Byte opCode, Word initialPC, Byte index, Byte status);
+
+    /// executes the command with the given opcode, set up as by test_exact_timing, by both engines and compares the results
+    void test_cycle_stepper(Byte opCode, Word initialPC, Byte index, Byte status);
+
+    /// checks the accesses made by the cycle-stepped engine on every cycle of a few commands
+    void test_cycle_stepper_bus();
+
+    void test_cycle_stepper_interrupts();
+
+    /**
+     * Runs the program placed at 0x0200 for the given number of commands with idle loops executed and skipped,
+     *  expecting the same final state and metrics. Cycles must be skipped only if the program is an idle loop.
+     */
+    void test_idle_loop(const std::vector<Byte> &program, size_t commands, bool idle);
+
+    /**
+     * Runs the program placed at 0x0200 with both index registers set to the given value, with copy and fill loops
+     *  executed and accelerated, expecting the same final state, memory and metrics.
+     * The pointer at 0x10 points to 0x0380, which holds a different byte at every address, the pointer at 0x12 to 0x04C0.
+     */
+    void test_accelerated_loop(const std::vector<Byte> &program, Byte index, std::optional<size_t> commands, bool accelerated);
+
+    /**
+     * Runs the firmware from test/data for the given number of commands by the interpreter and by its recompiled code,
+     *  expecting the same result, final state, memory and metrics. The byte at the given address is patched beforehand.
+     */
+    void test_recompiled(std::optional<size_t> commands, std::optional<Word> patched = std::nullopt);
+
+    /**
+     * Analyzes the routine placed at 0x0200 with the given bounds of its loops, expecting the given range of cycles,
+     *  then calls it with each of the given values of AC, X and Y and checks that the cycles it takes are within the range.
+     */
+    void test_routine_timing(const std::vector<Byte> &routine, const std::map<Word, LoopBound> &bounds, CycleRange expected,
+                             const std::vector<std::array<Byte, 3>> &inputs);
+
+    /// runs the built-in multiplication program placed at 0x0200 and checks the product and the restored zero page
+    void test_multiplication(Byte a, Byte b);
+
+#ifndef _WIN32
+    /// drives a short program through a GdbServer on a Unix domain socket
+    void test_gdb_server();
+#endif
 };
 
 
@@ -0,0 +1,97 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "MOS6502_TestFixture.hpp"
+#include "Assembler.hpp"
+#include "FunctionalTest.hpp"
+
+using namespace Emulator;
+
+
+static ROM assembled_image(std::string_view source) {
+    ROM image{};
+    const auto result = Assembler::assemble(source, image);
+    EXPECT_TRUE(result.has_value());
+    return image;
+}
+
+
+TEST_F(MOS6502_TestFixture, TestFunctionalTestTraps) {
+    // checks in the style of the functional test, each trapping in place when it fails
+    const ROM image = assembled_image(R"(
+        .org $0400
+        LDX #$10
+        LDA #0
+loop:   CLC
+        ADC #3
+        DEX
+        BNE loop
+        CMP #48
+        BNE *                   ; the sum is wrong
+        JSR double
+        CMP #96
+        BNE *                   ; the subroutine is wrong
+        CPX #0
+        BNE *
+        TSX
+        CPX #$FF
+        BNE *                   ; the stack is unbalanced
+        JMP success
+double: ASL
+        RTS
+        .org $0500
+success:
+        JMP success
+)");
+
+    for (const auto engine: ENGINES) {
+        const auto report = run_to_trap(engine, image, 0x0400, 100'000);
+        ASSERT_TRUE(report.has_value()) << to_string(engine);
+        EXPECT_EQ(report->trap, 0x0500) << to_string(engine);
+        EXPECT_GE(report->instructions, 60) << to_string(engine);
+        if (engine != Engine::NO_CYCLES) {
+            EXPECT_GT(report->cycles, 0) << to_string(engine);
+        }
+    }
+}
+
+TEST_F(MOS6502_TestFixture, TestFunctionalTestFailures) {
+    const ROM failing = assembled_image(".org $0400\nLDA #1\nCMP #2\nBNE *\nsuccess: JMP success");
+    const ROM jamming = assembled_image(".org $0400\nNOP\nJAM");
+    const ROM endless = assembled_image(".org $0400\nloop: INX\nJMP loop");
+
+    for (const auto engine: ENGINES) {
+        const auto failed = run_to_trap(engine, failing, 0x0400, 100'000);
+        ASSERT_TRUE(failed.has_value()) << to_string(engine);
+        EXPECT_EQ(failed->trap, 0x0404) << to_string(engine);
+
+        const auto jammed = run_to_trap(engine, jamming, 0x0400, 100'000);
+        ASSERT_FALSE(jammed.has_value()) << to_string(engine);
+        ASSERT_TRUE(std::holds_alternative<Halted>(jammed.error())) << to_string(engine);
+        EXPECT_EQ(std::get<Halted>(jammed.error()).address, 0x0401) << to_string(engine);
+
+        const auto running = run_to_trap(engine, endless, 0x0400, 100'000);
+        ASSERT_FALSE(running.has_value()) << to_string(engine);
+        EXPECT_TRUE(std::holds_alternative<NoTrap>(running.error())) << to_string(engine);
+    }
+}
+
+TEST_F(MOS6502_TestFixture, TestFunctionalTestImage) {
+    // the vendored image run by ctest is the assembled source next to it
+    std::ifstream sourceFile(FUNCTIONAL_TEST_SOURCE, std::ios::binary);
+    std::ifstream imageFile(FUNCTIONAL_TEST_IMAGE, std::ios::binary);
+    ASSERT_TRUE(sourceFile && imageFile);
+    const std::string source{std::istreambuf_iterator<char>(sourceFile), std::istreambuf_iterator<char>()};
+    const std::vector<Byte> image{std::istreambuf_iterator<char>(imageFile), std::istreambuf_iterator<char>()};
+    ASSERT_EQ(image.size(), 0x10000);
+
+    const ROM assembled = assembled_image(source);
+    for (size_t address = 0; address < image.size(); address++)
+        ASSERT_EQ(assembled[address], image[address]) << std::format("at {:#06x}", address);
+}
@@ -0,0 +1,14 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+
+#ifndef _WIN32
+TEST_F(MOS6502_TestFixture, TestGdbServer) {
+    test_gdb_server();
+}
+#endif
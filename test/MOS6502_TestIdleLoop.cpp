@@ -0,0 +1,35 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+// numbers of commands not divisible by the periods of the loops, so that the last iteration is executed partially
+static constexpr std::array<size_t, 3> testedCommands{1, 1'000, 100'001};
+
+
+TEST_F(MOS6502_TestFixture, TestIdleLoop) {
+    for (const auto commands: testedCommands) {
+        // loop: JMP loop
+        test_idle_loop({JMP_ABSOLUTE, 0x00, 0x02}, commands, commands > 2);
+        // loop: LDA $10; BEQ loop
+        test_idle_loop({LDA_ZERO_PAGE, 0x10, BEQ_RELATIVE, 0xFC}, commands, commands > 4);
+        // loop: LDA $0301,X; BIT $10; BEQ loop, reading across the page
+        test_idle_loop({LDA_ABSOLUTE_X, 0x01, 0x03, BIT_ZERO_PAGE, 0x10, BEQ_RELATIVE, 0xF9}, commands, commands > 6);
+        // loop: PLA; TXS; BEQ loop, pulling the same byte again and again
+        test_idle_loop({PLA_IMPLICIT, TXS_IMPLICIT, BEQ_RELATIVE, 0xFC}, commands, commands > 6);
+    }
+}
+
+TEST_F(MOS6502_TestFixture, TestBusyLoop) {
+    for (const auto commands: testedCommands) {
+        // loop: DEX; JMP loop changes a register
+        test_idle_loop({DEX_IMPLICIT, JMP_ABSOLUTE, 0x00, 0x02}, commands, false);
+        // loop: STA $10; JMP loop writes to the memory
+        test_idle_loop({STA_ZERO_PAGE, 0x10, JMP_ABSOLUTE, 0x00, 0x02}, commands, false);
+        // loop: PHA; PLA; JMP loop writes to the stack
+        test_idle_loop({PHA_IMPLICIT, PLA_IMPLICIT, JMP_ABSOLUTE, 0x00, 0x02}, commands, false);
+    }
+}
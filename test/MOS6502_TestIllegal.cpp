@@ -0,0 +1,120 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+static constexpr std::array<Byte, 12> jamOpCodes{0x02, 0x12, 0x22, 0x32, 0x42, 0x52, 0x62, 0x72, 0x92, 0xB2, 0xD2, 0xF2};
+
+
+static ProcessorStatus flags(std::initializer_list<Flag> setFlags) {
+    ProcessorStatus status;
+    for (const auto flag: setFlags) status[flag] = SET;
+    return status;
+}
+
+static MOS6502::State registers(Word PC, Byte AC, Byte X, Byte Y, ProcessorStatus SR, size_t cycle, Byte SP = 0xFF) {
+    return {.PC = PC, .AC = AC, .X = X, .Y = Y, .SR = SR, .SP = SP, .cycle = cycle};
+}
+
+
+TEST_F(MOS6502_TestFixture, TestIllegalReadModifyWrite) {
+    // SLO $10
+    test_illegal_operation({SLO_ZERO_PAGE, 0x10},
+                           registers(0x0200, 0x02, 0, 0, flags({}), 0), {{0x10, 0x81}},
+                           registers(0x0202, 0x02, 0, 0, flags({Flag::CARRY}), 5), {{0x10, 0x02}});
+    // SLO $02FF,X crossing the page takes no additional cycle
+    test_illegal_operation({SLO_ABSOLUTE_X, 0xFF, 0x02},
+                           registers(0x0200, 0x00, 1, 0, flags({}), 0), {{0x0300, 0x01}},
+                           registers(0x0203, 0x02, 1, 0, flags({}), 7), {{0x0300, 0x02}});
+    // RLA $0300,X
+    test_illegal_operation({RLA_ABSOLUTE_X, 0x00, 0x03},
+                           registers(0x0200, 0xFF, 1, 0, flags({Flag::CARRY}), 0), {{0x0301, 0x40}},
+                           registers(0x0203, 0x81, 1, 0, flags({Flag::NEGATIVE}), 7), {{0x0301, 0x81}});
+    // SRE $10,X
+    test_illegal_operation({SRE_ZERO_PAGE_X, 0x10},
+                           registers(0x0200, 0x01, 2, 0, flags({}), 0), {{0x12, 0x03}},
+                           registers(0x0202, 0x00, 2, 0, flags({Flag::CARRY, Flag::ZERO}), 6), {{0x12, 0x01}});
+    // RRA ($20),Y
+    test_illegal_operation({RRA_INDIRECT_Y, 0x20},
+                           registers(0x0200, 0x01, 0, 0x10, flags({Flag::CARRY}), 0), {{0x20, 0x00}, {0x21, 0x03}, {0x0310, 0x02}},
+                           registers(0x0202, 0x82, 0, 0x10, flags({Flag::NEGATIVE}), 8), {{0x0310, 0x81}});
+    // DCP $0300
+    test_illegal_operation({DCP_ABSOLUTE, 0x00, 0x03},
+                           registers(0x0200, 0x0F, 0, 0, flags({}), 0), {{0x0300, 0x10}},
+                           registers(0x0203, 0x0F, 0, 0, flags({Flag::CARRY, Flag::ZERO}), 6), {{0x0300, 0x0F}});
+    // ISC $02FF,Y
+    test_illegal_operation({ISC_ABSOLUTE_Y, 0xFF, 0x02},
+                           registers(0x0200, 0x10, 0, 1, flags({Flag::CARRY}), 0), {{0x0300, 0x04}},
+                           registers(0x0203, 0x0B, 0, 1, flags({Flag::CARRY}), 7), {{0x0300, 0x05}});
+}
+
+TEST_F(MOS6502_TestFixture, TestIllegalLoadStore) {
+    // SAX $30
+    test_illegal_operation({SAX_ZERO_PAGE, 0x30},
+                           registers(0x0200, 0xF0, 0x3C, 0, flags({}), 0), {},
+                           registers(0x0202, 0xF0, 0x3C, 0, flags({}), 3), {{0x30, 0x30}});
+    // LAX ($20),Y crossing the page
+    test_illegal_operation({LAX_INDIRECT_Y, 0x20},
+                           registers(0x0200, 0, 0, 1, flags({}), 0), {{0x20, 0xFF}, {0x21, 0x02}, {0x0300, 0x80}},
+                           registers(0x0202, 0x80, 0x80, 1, flags({Flag::NEGATIVE}), 6), {});
+    // LAS $0300,Y
+    test_illegal_operation({LAS_ABSOLUTE_Y, 0x00, 0x03},
+                           registers(0x0200, 0, 0, 0, flags({}), 0, 0x3F), {{0x0300, 0xF0}},
+                           registers(0x0203, 0x30, 0x30, 0, flags({}), 4, 0x30), {});
+    // SHX $0300,Y
+    test_illegal_operation({SHX_ABSOLUTE_Y, 0x00, 0x03},
+                           registers(0x0200, 0, 0xFF, 1, flags({}), 0), {},
+                           registers(0x0203, 0, 0xFF, 1, flags({}), 5), {{0x0301, 0x04}});
+    // SHX $10FF,Y crossing the page replaces the high byte of the target address with the stored value
+    test_illegal_operation({SHX_ABSOLUTE_Y, 0xFF, 0x10},
+                           registers(0x0400, 0, 0x30, 1, flags({}), 0), {},
+                           registers(0x0403, 0, 0x30, 1, flags({}), 5), {{0x1000, 0x10}, {0x1100, 0x00}});
+}
+
+TEST_F(MOS6502_TestFixture, TestIllegalImmediate) {
+    // ANC #$80
+    test_illegal_operation({ANC_IMMEDIATE_2B, 0x80},
+                           registers(0x0200, 0xFF, 0, 0, flags({}), 0), {},
+                           registers(0x0202, 0x80, 0, 0, flags({Flag::NEGATIVE, Flag::CARRY}), 2), {});
+    // ALR #$03
+    test_illegal_operation({ALR_IMMEDIATE, 0x03},
+                           registers(0x0200, 0xFF, 0, 0, flags({}), 0), {},
+                           registers(0x0202, 0x01, 0, 0, flags({Flag::CARRY}), 2), {});
+    // ARR #$FF
+    test_illegal_operation({ARR_IMMEDIATE, 0xFF},
+                           registers(0x0200, 0xC0, 0, 0, flags({Flag::CARRY}), 0), {},
+                           registers(0x0202, 0xE0, 0, 0, flags({Flag::NEGATIVE, Flag::CARRY}), 2), {});
+    // SBX #$02
+    test_illegal_operation({SBX_IMMEDIATE, 0x02},
+                           registers(0x0200, 0x0F, 0x05, 0, flags({}), 0), {},
+                           registers(0x0202, 0x0F, 0x03, 0, flags({Flag::CARRY}), 2), {});
+    // USBC #$01
+    test_illegal_operation({USBC_IMMEDIATE, 0x01},
+                           registers(0x0200, 0x05, 0, 0, flags({Flag::CARRY}), 0), {},
+                           registers(0x0202, 0x04, 0, 0, flags({Flag::CARRY}), 2), {});
+}
+
+TEST_F(MOS6502_TestFixture, TestIllegalNOP) {
+    test_illegal_operation({NOP_IMPLICIT_1A},
+                           registers(0x0200, 0, 0, 0, flags({}), 0), {},
+                           registers(0x0201, 0, 0, 0, flags({}), 2), {});
+    test_illegal_operation({NOP_IMMEDIATE_80, 0x12},
+                           registers(0x0200, 0, 0, 0, flags({}), 0), {},
+                           registers(0x0202, 0, 0, 0, flags({}), 2), {});
+    test_illegal_operation({NOP_ZERO_PAGE_X_14, 0x12},
+                           registers(0x0200, 0, 1, 0, flags({}), 0), {},
+                           registers(0x0202, 0, 1, 0, flags({}), 4), {});
+    test_illegal_operation({NOP_ABSOLUTE_X_1C, 0xFF, 0x02},
+                           registers(0x0200, 0, 1, 0, flags({}), 0), {},
+                           registers(0x0203, 0, 1, 0, flags({}), 5), {});
+}
+
+TEST_F(MOS6502_TestFixture, TestJAM) {
+    for (const auto opCode: jamOpCodes) {
+        test_jam(0x0200, opCode);
+        test_jam(0xfff0, opCode);
+    }
+}
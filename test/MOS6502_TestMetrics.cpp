@@ -0,0 +1,25 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+static constexpr std::array<Word, 4> testedPCs{0, 0x0200, 0x02fa, 0x8000};
+static constexpr std::array<Word, 4> testedAddresses{0x0300, 0x03f0, 0x04ff, 0xfff0};
+static constexpr std::array<Byte, 4> testedIndices{0, 1, 0x10, 0xff};
+static constexpr std::array<Byte, 4> unknownOpCodes{0x02, 0x3f, 0x80, 0xff};
+
+
+TEST_F(MOS6502_TestFixture, TestMetrics) {
+    for (const auto initialPC: testedPCs)
+        for (const auto address: testedAddresses)
+            for (const auto index: testedIndices)
+                test_metrics(initialPC, address, index);
+}
+
+TEST_F(MOS6502_TestFixture, TestUnknownOperationMetrics) {
+    for (const auto opCode: unknownOpCodes)
+        test_unknown_operation_metrics(opCode);
+}
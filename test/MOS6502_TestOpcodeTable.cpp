@@ -0,0 +1,12 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+
+TEST_F(MOS6502_TestFixture, TestOpcodeTable) {
+    test_opcode_table();
+}
@@ -0,0 +1,16 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+
+TEST_F(MOS6502_TestFixture, TestCycleAccounting) {
+    test_cycle_accounting();
+}
+
+TEST_F(MOS6502_TestFixture, TestVariants) {
+    test_variants();
+}
@@ -0,0 +1,46 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <fstream>
+
+#include "MOS6502_TestFixture.hpp"
+#include "Recompiler.hpp"
+
+using namespace Emulator;
+
+
+TEST_F(MOS6502_TestFixture, TestRecompiledFirmware) {
+    // the firmware ends by overwriting its own code and then stops on BRK
+    test_recompiled(std::nullopt);
+    for (const size_t commands: {1, 2, 13, 100, 1000, 12345, 100000})
+        test_recompiled(commands);
+}
+
+TEST_F(MOS6502_TestFixture, TestRecompiledFirmwarePatched) {
+    // the memory does not hold the compiled code, so the interpreter runs it
+    test_recompiled(std::nullopt, 0xFF3C);
+    test_recompiled(1000, 0xFF3C);
+}
+
+TEST_F(MOS6502_TestFixture, TestRecompilerDiscovery) {
+    std::ifstream file(FIRMWARE_IMAGE, std::ios::binary);
+    ASSERT_TRUE(file);
+    ROM image{};
+    image.load(0xFF00, std::vector<Byte>{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+
+    Recompiler recompiler(image);
+    // reset, the subroutines called by it and the interrupt handler
+    EXPECT_TRUE(recompiler.commands().contains(0xFF00));
+    EXPECT_TRUE(recompiler.commands().contains(0xFF91));
+    EXPECT_TRUE(recompiler.commands().contains(0xFF9B));
+    // BRK is left to the interpreter, the command after it is not reached
+    EXPECT_FALSE(recompiler.commands().contains(0xFF8F));
+    EXPECT_FALSE(recompiler.commands().contains(0xFF90));
+    // reached by an indirect jump only
+    EXPECT_FALSE(recompiler.commands().contains(0xFF7E));
+
+    recompiler.add_entry(0xFF7E);
+    EXPECT_TRUE(recompiler.commands().contains(0xFF7E));
+    EXPECT_TRUE(recompiler.commands().contains(0xFF85));
+}
@@ -0,0 +1,17 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+static constexpr std::array<size_t, 4> testedIntervals{1, 7, 16, 1000};
+static constexpr std::array<size_t, 3> testedSnapshotLimits{1, 4, 1000};
+
+
+TEST_F(MOS6502_TestFixture, TestRecorder) {
+    for (const auto interval: testedIntervals)
+        for (const auto maxSnapshots: testedSnapshotLimits)
+            test_recorder(interval, maxSnapshots);
+}
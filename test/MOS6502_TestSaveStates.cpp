@@ -0,0 +1,45 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <utility>
+
+#include "MOS6502_TestFixture.hpp"
+
+using namespace Emulator;
+
+
+TEST_F(MOS6502_TestFixture, TestDirtyPages) {
+    ROM image{};
+    EXPECT_TRUE(image.collect_dirty_pages().none());
+
+    image.set_byte(0x1234, 1);
+    image.set_stack_byte(0x10, 2);
+    image.copy(0x4000, 0x0000, 0x0200);
+    image.fill(0x50FF, 3, 2);
+    // wraps around the end of the address space
+    image.load(0xFFFF, std::vector<Byte>{4, 5});
+    EXPECT_TRUE(image.is_dirty(0x12));
+    EXPECT_FALSE(image.is_dirty(0x13));
+
+    ROM::PageSet expected;
+    for (const size_t page: {0x12, 0x01, 0x40, 0x41, 0x50, 0x51, 0xFF, 0x00}) expected.set(page);
+    EXPECT_EQ(image.collect_dirty_pages(), expected);
+    EXPECT_TRUE(image.collect_dirty_pages().none());
+
+    // reading does not make a page dirty, writing through the subscript operator does
+    (void)std::as_const(image)[0x2000];
+    EXPECT_TRUE(image.collect_dirty_pages().none());
+    image[0x2000] = 6;
+    EXPECT_EQ(image.collect_dirty_pages(), ROM::PageSet{}.set(0x20));
+
+    // only the pages which differ are dirty after an assignment
+    ROM other = image;
+    other[0x7701] = 7;
+    image = other;
+    EXPECT_EQ(image.collect_dirty_pages(), ROM::PageSet{}.set(0x77));
+}
+
+TEST_F(MOS6502_TestFixture, TestSaveStates) {
+    test_save_states();
+}
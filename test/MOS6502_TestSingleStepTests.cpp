@@ -0,0 +1,122 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <sstream>
+#include <string>
+
+#include "MOS6502_TestFixture.hpp"
+#include "SingleStepTests.hpp"
+
+using namespace Emulator;
+
+
+/// cases in the layout of the suite: LDA #$ED, STA $1234 and INX, with a key the reader does not know
+static constexpr std::string_view CASES = R"([
+{ "name": "a9 ed 4d", "initial": { "pc": 30345, "s": 58, "a": 190, "x": 195, "y": 211, "p": 96, "ram": [ [30345, 169], [30346, 237], [30347, 77]]},
+  "final": { "pc": 30347, "s": 58, "a": 237, "x": 195, "y": 211, "p": 224, "ram": [ [30345, 169], [30346, 237], [30347, 77]]},
+  "cycles": [ [30345, 169, "read"], [30346, 237, "read"]] },
+{ "name": "8d 34 12", "initial": { "pc": 512, "s": 255, "a": 66, "x": 0, "y": 0, "p": 36, "ram": [ [512, 141], [513, 52], [514, 18], [4660, 0]]},
+  "final": { "pc": 515, "s": 255, "a": 66, "x": 0, "y": 0, "p": 36, "ram": [ [512, 141], [513, 52], [514, 18], [4660, 66]]},
+  "cycles": [ [512, 141, "read"], [513, 52, "read"], [514, 18, "read"], [4660, 66, "write"]], "comment": {"by": ["hand", 1.5e0, null]} },
+{ "name": "e8 \"x\"", "initial": { "pc": 1024, "s": 253, "a": 0, "x": 255, "y": 0, "p": 32, "ram": [ [1024, 232], [1025, 17]]},
+  "final": { "pc": 1025, "s": 253, "a": 0, "x": 0, "y": 0, "p": 34, "ram": [ [1024, 232], [1025, 17]]},
+  "cycles": [ [1024, 232, "read"], [1025, 17, "read"]] }
+])";
+
+
+static std::string lda_cases(size_t count, size_t wrongIndex) {
+    std::string json = "[";
+    for (size_t i = 0; i < count; i++) {
+        const Word pc = 0x0200 + i * 7 % 0x7000;
+        const Byte value = i * 13;
+        const Byte flags = 0x20 | (value == 0 ? 0x02 : 0) | (value & 0x80);
+        const Byte expected = i == wrongIndex ? value + 1 : value;
+        json += std::format(R"({}{{"name": "a9 {:02x}", "initial": {{"pc": {}, "s": 255, "a": 1, "x": 2, "y": 3, "p": 32, "ram": [[{}, 169], [{}, {}]]}},)"
+                            R"( "final": {{"pc": {}, "s": 255, "a": {}, "x": 2, "y": 3, "p": {}, "ram": [[{}, 169], [{}, {}]]}},)"
+                            R"( "cycles": [[{}, 169, "read"], [{}, {}, "read"]]}})" "\n",
+                            i == 0 ? "" : ",", value, pc, pc, pc + 1, value, pc + 2, expected, flags, pc, pc + 1, value,
+                            pc, pc + 1, value);
+    }
+    return json + "]";
+}
+
+
+TEST_F(MOS6502_TestFixture, TestSingleStepTestsReader) {
+    std::istringstream input{std::string(CASES)};
+    SingleStepReader reader(input);
+    SingleStepCase testCase;
+
+    ASSERT_TRUE(reader.next(testCase).value_or(false));
+    EXPECT_EQ(testCase.name, "a9 ed 4d");
+    EXPECT_EQ(testCase.initial.pc, 30345);
+    EXPECT_EQ(testCase.final.a, 237);
+    EXPECT_EQ(testCase.final.p, 224);
+    ASSERT_EQ(testCase.initial.ram.size(), 3);
+    EXPECT_EQ(testCase.initial.ram[1], (std::pair<Word, Byte>{30346, 237}));
+    ASSERT_EQ(testCase.cycles.size(), 2);
+    EXPECT_EQ(testCase.cycles[1], (CycleStepper::BusAccess{.cycle = 1, .address = 30346, .value = 237, .access = Access::READ}));
+
+    ASSERT_TRUE(reader.next(testCase).value_or(false));
+    EXPECT_EQ(testCase.cycles.back(), (CycleStepper::BusAccess{.cycle = 3, .address = 0x1234, .value = 66, .access = Access::WRITE}));
+    ASSERT_TRUE(reader.next(testCase).value_or(false));
+    EXPECT_EQ(testCase.name, "e8 \"x\"");
+    EXPECT_EQ(testCase.initial.ram.size(), 2);
+    EXPECT_FALSE(reader.next(testCase).value_or(true));
+    EXPECT_FALSE(reader.next(testCase).value_or(true));
+
+    for (const std::string_view invalid: {R"({"name": "a"})", R"([{"name": "a"}])", R"([{"name": "a", "initial": {"pc": 65536}}])",
+                                          R"([{"cycles": [[1, 2, "fetch"]]}])", R"([{"name": "a")"}) {
+        std::istringstream stream{std::string(invalid)};
+        SingleStepReader failing(stream);
+        const auto result = failing.next(testCase);
+        EXPECT_FALSE(result.has_value()) << invalid;
+    }
+}
+
+TEST_F(MOS6502_TestFixture, TestSingleStepTestsRunner) {
+    std::istringstream input{std::string(CASES)};
+    const auto report = run_single_step_tests(input, 2);
+    ASSERT_TRUE(report.has_value()) << report.error().to_string();
+    EXPECT_EQ(report->cases, 3);
+    EXPECT_EQ(report->interpreterFailures, 0);
+    EXPECT_EQ(report->stepperFailures, 0);
+
+    // a case run after a wrong one starts from a fresh state all the same
+    SingleStepRunner runner;
+    std::istringstream cases{lda_cases(2, 0)};
+    SingleStepReader reader(cases);
+    SingleStepCase wrong, right;
+    ASSERT_TRUE(reader.next(wrong).value_or(false));
+    ASSERT_TRUE(reader.next(right).value_or(false));
+    EXPECT_EQ(runner.run_interpreted(wrong), "A is 0x00, expected 0x01");
+    EXPECT_EQ(runner.run_stepped(wrong), "A is 0x00, expected 0x01");
+    EXPECT_EQ(runner.run_interpreted(right), std::nullopt);
+    EXPECT_EQ(runner.run_stepped(right), std::nullopt);
+
+    wrong = right;
+    wrong.cycles[1].address++;
+    EXPECT_EQ(runner.run_interpreted(wrong), std::nullopt);
+    EXPECT_EQ(runner.run_stepped(wrong), std::format("cycle 1 is read ${:04x} = 0x0d, expected read ${:04x} = 0x0d",
+                                                     right.cycles[1].address, wrong.cycles[1].address));
+}
+
+TEST_F(MOS6502_TestFixture, TestSingleStepTestsParallel) {
+    // more batches than threads, with a single wrong case far into the input
+    constexpr size_t CASES_COUNT = 5000, WRONG = 3210;
+    for (const unsigned threads: {1u, 4u}) {
+        std::istringstream input{lda_cases(CASES_COUNT, WRONG)};
+        const auto report = run_single_step_tests(input, threads);
+        ASSERT_TRUE(report.has_value()) << report.error().to_string();
+        EXPECT_EQ(report->cases, CASES_COUNT);
+        EXPECT_EQ(report->interpreterFailures, 1);
+        EXPECT_EQ(report->stepperFailures, 1);
+        ASSERT_EQ(report->failures.size(), 2);
+        EXPECT_EQ(report->failures[0].index, WRONG);
+        EXPECT_EQ(report->failures[0].name, std::format("a9 {:02x}", (Byte)(WRONG * 13)));
+        EXPECT_TRUE(report->failures[0].difference.starts_with("interpreter: A is"));
+    }
+
+    std::istringstream truncated{lda_cases(1000, 1000).substr(0, 50'000)};
+    EXPECT_FALSE(run_single_step_tests(truncated, 4).has_value());
+}
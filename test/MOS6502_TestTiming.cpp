@@ -0,0 +1,22 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+#include "OpcodeTable.hpp"
+
+using namespace Emulator;
+
+
+TEST_F(MOS6502_TestFixture, TestExactTiming) {
+    for (int opCode = 0; opCode <= UINT8_MAX; opCode++) {
+        // JAM never completes
+        if (OPCODES[opCode].mnemonic == "JAM") continue;
+
+        // the second initial PC makes taken branches cross the page
+        for (const Word initialPC: {0x0200, 0x02F0})
+            for (const Byte index: {0x00, 0xFF})
+                for (const Byte status: {0x00, 0xFF})
+                    test_exact_timing(opCode, initialPC, index, status);
+    }
+}
@@ -0,0 +1,113 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include "MOS6502_TestFixture.hpp"
+#include "TimingAnalyzer.hpp"
+
+using namespace Emulator;
+
+
+TEST_F(MOS6502_TestFixture, TestTimingWithoutLoops) {
+    //       CPX #$10
+    //       BCS skip
+    //       LDA $03F8,X
+    // skip: RTS
+    test_routine_timing({CPX_IMMEDIATE, 0x10, BCS_RELATIVE, 0x03, LDA_ABSOLUTE_X, 0xF8, 0x03, RTS_IMPLICIT},
+                        {}, {.best = 11, .worst = 15},
+                        {{0, 0x00, 0}, {0, 0x08, 0}, {0, 0x20, 0}});
+}
+
+TEST_F(MOS6502_TestFixture, TestTimingOfLoops) {
+    //       LDX #$05
+    // loop: DEX
+    //       BNE loop
+    //       RTS
+    test_routine_timing({LDX_IMMEDIATE, 0x05, DEX_IMPLICIT, BNE_RELATIVE, (Byte)-3, RTS_IMPLICIT},
+                        {{0x0202, {.minimum = 5, .maximum = 5}}}, {.best = 32, .worst = 32},
+                        {{0, 0, 0}});
+
+    // the same loop, counting down from X
+    test_routine_timing({DEX_IMPLICIT, BNE_RELATIVE, (Byte)-3, RTS_IMPLICIT},
+                        {{0x0200, {.minimum = 1, .maximum = 8}}}, {.best = 10, .worst = 45},
+                        {{0, 1, 0}, {0, 3, 0}, {0, 8, 0}});
+
+    //        LDY #$03
+    // outer: JSR inner
+    //        DEY
+    //        BNE outer
+    //        RTS
+    //        ...
+    // inner: LDX #$04
+    // loop:  DEX
+    //        BNE loop
+    //        RTS
+    test_routine_timing({LDY_IMMEDIATE, 0x03, JSR_ABSOLUTE, 0x10, 0x02, DEY_IMPLICIT, BNE_RELATIVE, (Byte)-6, RTS_IMPLICIT,
+                         NOP_IMPLICIT, NOP_IMPLICIT, NOP_IMPLICIT, NOP_IMPLICIT, NOP_IMPLICIT, NOP_IMPLICIT, NOP_IMPLICIT,
+                         LDX_IMMEDIATE, 0x04, DEX_IMPLICIT, BNE_RELATIVE, (Byte)-3, RTS_IMPLICIT},
+                        {{0x0202, {.minimum = 3, .maximum = 3}}, {0x0212, {.minimum = 4, .maximum = 4}}}, {.best = 121, .worst = 121},
+                        {{0, 0, 0}});
+
+    //       LDY #$00
+    // loop: LDA ($10),Y
+    //       BMI done
+    //       INY
+    //       CPY #$20
+    //       BNE loop
+    // done: RTS
+    test_routine_timing({LDY_IMMEDIATE, 0x00, LDA_INDIRECT_Y, 0x10, BMI_RELATIVE, 0x05, INY_IMPLICIT, CPY_IMMEDIATE, 0x20,
+                         BNE_RELATIVE, (Byte)-9, RTS_IMPLICIT},
+                        {{0x0202, {.minimum = 1, .maximum = 32}}}, {.best = 16, .worst = 487},
+                        {{0, 0, 0}});
+}
+
+TEST_F(MOS6502_TestFixture, TestTimingErrors) {
+    const auto analyze = [](const std::vector<Byte> &routine, const std::map<Word, LoopBound> &bounds = {}) {
+        ROM image{};
+        image.load(0x0200, routine);
+        TimingAnalyzer analyzer(image);
+        for (const auto &[header, bound]: bounds) analyzer.bound_loop(header, bound);
+        return analyzer.analyze(0x0200);
+    };
+
+    // loop: DEX; BNE loop; RTS
+    const std::vector<Byte> loop{DEX_IMPLICIT, BNE_RELATIVE, (Byte)-3, RTS_IMPLICIT};
+    auto result = analyze(loop);
+    ASSERT_FALSE(result.has_value());
+    ASSERT_TRUE(std::holds_alternative<UnboundedLoop>(result.error()));
+    EXPECT_EQ(std::get<UnboundedLoop>(result.error()).header, 0x0200);
+
+    result = analyze(loop, {{0x0200, {.minimum = 3, .maximum = 2}}});
+    ASSERT_FALSE(result.has_value());
+    EXPECT_TRUE(std::holds_alternative<InvalidLoop>(result.error()));
+
+    // loop: JMP loop
+    result = analyze({JMP_ABSOLUTE, 0x00, 0x02}, {{0x0200, {.minimum = 1, .maximum = 1}}});
+    ASSERT_FALSE(result.has_value());
+    EXPECT_TRUE(std::holds_alternative<NoExit>(result.error()));
+
+    result = analyze({INX_IMPLICIT, BRK_IMPLICIT});
+    ASSERT_FALSE(result.has_value());
+    ASSERT_TRUE(std::holds_alternative<UnknownControlFlow>(result.error()));
+    EXPECT_EQ(std::get<UnknownControlFlow>(result.error()).address, 0x0201);
+
+    // the pointer is written by the routine
+    result = analyze({STA_ZERO_PAGE, 0x30, JMP_INDIRECT, 0x30, 0x00});
+    ASSERT_FALSE(result.has_value());
+    EXPECT_TRUE(std::holds_alternative<UnknownControlFlow>(result.error()));
+
+    result = analyze({JSR_ABSOLUTE, 0x00, 0x02, RTS_IMPLICIT});
+    ASSERT_FALSE(result.has_value());
+    EXPECT_TRUE(std::holds_alternative<RecursiveCall>(result.error()));
+
+    //    BEQ b
+    // a: INX
+    //    JMP b
+    // b: DEX
+    //    BNE a
+    //    RTS
+    result = analyze({BEQ_RELATIVE, 0x04, INX_IMPLICIT, JMP_ABSOLUTE, 0x06, 0x02, DEX_IMPLICIT, BNE_RELATIVE, (Byte)-7, RTS_IMPLICIT},
+                     {{0x0202, {.minimum = 1, .maximum = 2}}, {0x0206, {.minimum = 1, .maximum = 2}}});
+    ASSERT_FALSE(result.has_value());
+    EXPECT_TRUE(std::holds_alternative<InvalidLoop>(result.error()));
+}
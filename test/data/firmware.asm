@@ -0,0 +1,97 @@
+; Listing of firmware.bin, loaded at $FF00, used to check the recompiled code against the interpreter.
+; The reset vector points to reset, the NMI and IRQ/BRK vectors to irq.
+;
+; The outer loop runs $20 times: it fills $0300-$03FF through a subroutine, copies the page to $0400,
+; then mixes the arithmetic, shift, stack and flag commands in all addressing modes. It continues
+; through an indirect jump, so that cont is reached by the interpreter only. Finally it overwrites
+; the operand of the subroutine value and calls it, then stops on BRK.
+
+FF00  reset:  LDX #$FF
+FF02          TXS
+FF03          CLD
+FF04          LDA #$00
+FF06          STA $10
+FF08          STA $11
+FF0A          LDA #$20
+FF0C          STA $40
+FF0E  outer:  LDY #$00
+FF10  fill:   TYA
+FF11          JSR mix
+FF14          EOR $10
+FF16          STA $10
+FF18          STA $0300,Y
+FF1B          INY
+FF1C          BNE fill
+FF1E          LDA #$00
+FF20          STA $20
+FF22          LDA #$03
+FF24          STA $21
+FF26          LDA #$00
+FF28          STA $22
+FF2A          LDA #$04
+FF2C          STA $23
+FF2E          LDY #$00
+FF30  copy:   LDA ($20),Y
+FF32          STA ($22),Y
+FF34          INY
+FF35          BNE copy
+FF37          LDX #$1F
+FF39  arith:  LDA $03F0,X
+FF3C          ASL A
+FF3D          ROL $11
+FF3F          ADC $10
+FF41          SBC #$03
+FF43          LSR A
+FF44          ROR $50,X
+FF46          STA $0500,X
+FF49          INC $13
+FF4B          DEC $0600,X
+FF4E          BIT $10
+FF50          CMP $0401,X
+FF53          CPX #$08
+FF55          CPY $14
+FF57          DEX
+FF58          BPL arith
+FF5A          PHA
+FF5B          PHP
+FF5C          PLP
+FF5D          PLA
+FF5E          LDA ($24,X)
+FF60          ORA #$01
+FF62          AND #$7F
+FF64          TAX
+FF65          TSX
+FF66          TXA
+FF67          TAY
+FF68          SEC
+FF69          CLC
+FF6A          SEI
+FF6B          CLI
+FF6C          CLV
+FF6D          NOP
+FF6E          JSR value
+FF71          STA $15
+FF73          LDA #<cont
+FF75          STA $30
+FF77          LDA #>cont
+FF79          STA $31
+FF7B          JMP ($0030)
+FF7E  cont:   DEC $40
+FF80          BEQ done
+FF82          JMP outer
+FF85  done:   LDA #$42
+FF87          STA value+1
+FF8A          JSR value
+FF8D          STA $16
+FF8F          BRK
+FF90          NOP
+FF91  mix:    ROL A
+FF92          EOR #$5A
+FF94          CLC
+FF95          ADC #$07
+FF97          RTS
+FF98  value:  LDA #$00
+FF9A          RTS
+FF9B  irq:    RTI
+
+FFFA  .word irq, reset, irq
@@ -0,0 +1,487 @@
+; Source of functional_test.bin, a conformance program in the style of Klaus Dormann's 6502 functional test,
+; written for the assembler of this project. The image is 64 KiB loaded at 0 and started at $0400.
+;
+; Every check traps in place on a branch to itself when it fails; when all of them pass, the program ends in
+; the trap at success, $3000. It checks the flags through PHP and PLP, the addressing modes, the stack, BRK
+; and RTI, the shifts and compares, then ADC and SBC in the binary mode with every operand and carry, including
+; the N, V, Z and C flags, and in the decimal mode with every valid BCD operand and carry, where only the
+; result and the carry are defined.
+
+A1      = $10           ; first operand
+A2      = $11           ; second operand
+CARRY   = $12           ; carry in, 0 or 1
+RESULT  = $13           ; expected result
+RCARRY  = $14           ; expected carry out
+FLAGS   = $15           ; expected status as pushed by PHP
+TMP     = $16
+PTR     = $18           ; and $19
+IRQ_A   = $1A
+IRQ_X   = $1B
+
+        .org $0400
+start:  CLD
+        LDX #$FF
+        TXS
+
+; every flag is set and cleared by PLP, tested by its branches, and pushed by PHP with the break and unused bits
+        LDA #$FF
+        PHA
+        PLP
+        BPL *
+        BVC *
+        BNE *
+        BCC *
+        PHP
+        PLA
+        CMP #$FF
+        BNE *
+        LDA #$00
+        PHA
+        PLP
+        BMI *
+        BVS *
+        BEQ *
+        BCS *
+        PHP
+        PLA
+        CMP #$30
+        BNE *
+
+; the flag commands
+        SEC
+        BCC *
+        CLC
+        BCS *
+        SED
+        PHP
+        PLA
+        AND #$08
+        BEQ *
+        CLD
+        PHP
+        PLA
+        AND #$08
+        BNE *
+        SEI
+        PHP
+        PLA
+        AND #$04
+        BEQ *
+        CLI
+        PHP
+        PLA
+        AND #$04
+        BNE *
+        LDA #$40
+        PHA
+        PLP
+        BVC *
+        CLV
+        BVS *
+
+; loads and stores in the addressing modes, and the transfers
+        LDA #$55
+        STA $0300
+        LDA #$00
+        LDA $0300
+        CMP #$55
+        BNE *
+        STA TMP
+        LDX TMP
+        CPX #$55
+        BNE *
+        LDX #$10
+        LDA #$AA
+        STA $0280,X
+        LDA $0290
+        CMP #$AA
+        BNE *
+        LDY #$20
+        LDA $0270,Y
+        CMP #$AA
+        BNE *
+        LDA #<$0290
+        STA PTR
+        LDA #>$0290
+        STA PTR+1
+        LDY #$00
+        LDA (PTR),Y
+        CMP #$AA
+        BNE *
+        LDX #$08
+        LDA (PTR-8,X)
+        CMP #$AA
+        BNE *
+        LDA #$80
+        TAX
+        BPL *
+        CPX #$80
+        BNE *
+        LDA #$00
+        TXA
+        CMP #$80
+        BNE *
+        LDA #$01
+        TAY
+        BMI *
+        CPY #$01
+        BNE *
+        TSX
+        CPX #$FF
+        BNE *
+
+; JSR pushes the address of its last byte, RTS returns behind it
+        JSR subroutine
+after:  TSX
+        CPX #$FF
+        BNE *
+
+; the shifts, the increments, BIT and the compares
+        LDA #$81
+        ASL
+        BCC *
+        CMP #$02
+        BNE *
+        LSR
+        BCS *
+        CMP #$01
+        BNE *
+        SEC
+        ROR
+        BCC *
+        CMP #$80
+        BNE *
+        CLC
+        ROL
+        BNE *
+        BCC *
+        LDA #$FF
+        STA TMP
+        INC TMP
+        BNE *
+        DEC TMP
+        BPL *
+        LDA #$C0
+        STA TMP
+        LDA #$00
+        BIT TMP
+        BPL *
+        BVC *
+        BNE *
+        LDA #$05
+        CMP #$06
+        BCS *
+        BPL *
+        CMP #$05
+        BNE *
+        BCC *
+        LDX #$10
+        CPX #$0F
+        BCC *
+        BEQ *
+        LDY #$10
+        CPY #$11
+        BCS *
+
+; BRK pushes the address behind its padding byte and the status with the break bit, and sets the interrupt disable
+        LDA #$00
+        PHA
+        LDA #'B'
+        LDX #'R'
+        LDY #'K'
+        PLP
+        BRK
+        .byte $EA
+brk_return:
+        PHP
+        CMP #'B' ^ $AA
+        BNE *
+        CPX #'R' + 1
+        BNE *
+        CPY #'K' - 3
+        BNE *
+        PLA
+        CMP #$30        ; the status before BRK, restored by RTI
+        BNE *
+        TSX
+        CPX #$FF
+        BNE *
+
+; binary ADC with every operand and carry
+        LDA #$00
+        STA CARRY
+add_carry:
+        LDA #$00
+        STA A1
+add_a1: LDA A1
+        STA RESULT
+        LDA #$00
+        STA RCARRY
+        LDA CARRY
+        BEQ add_start
+        INC RESULT
+        BNE add_start
+        INC RCARRY
+add_start:
+        LDA #$00
+        STA A2
+add_a2: JSR check_add
+        INC RESULT
+        BNE add_next
+        INC RCARRY
+add_next:
+        INC A2
+        BNE add_a2
+        INC A1
+        BNE add_a1
+        INC CARRY
+        LDA CARRY
+        CMP #$02
+        BNE add_carry
+
+; binary SBC with every operand and carry
+        LDA #$00
+        STA CARRY
+sub_carry:
+        LDA #$00
+        STA A1
+sub_a1: LDA A1
+        STA RESULT
+        LDA #$01
+        STA RCARRY
+        LDA CARRY
+        BNE sub_start
+        LDA RESULT
+        BNE sub_borrow
+        DEC RCARRY
+sub_borrow:
+        DEC RESULT
+sub_start:
+        LDA #$00
+        STA A2
+sub_a2: JSR check_sub
+        LDA RESULT
+        BNE sub_next
+        LDA #$00
+        STA RCARRY
+sub_next:
+        DEC RESULT
+        INC A2
+        BNE sub_a2
+        INC A1
+        BNE sub_a1
+        INC CARRY
+        LDA CARRY
+        CMP #$02
+        BNE sub_carry
+
+; decimal ADC with every valid BCD operand and carry, and SBC taking the sum back to the first operand
+        LDA #$00
+        STA CARRY
+dec_carry:
+        LDA #$00
+        STA A1
+dec_a1: LDA A1
+        STA RESULT
+        LDA #$00
+        STA RCARRY
+        LDA CARRY
+        BEQ dec_start
+        LDA RESULT
+        JSR bcd_inc
+        STA RESULT
+        ROL RCARRY
+dec_start:
+        LDA #$00
+        STA A2
+dec_a2: JSR check_decimal
+        LDA RESULT
+        JSR bcd_inc
+        STA RESULT
+        BCC dec_next
+        INC RCARRY
+dec_next:
+        LDA A2
+        JSR bcd_inc
+        STA A2
+        BCC dec_a2
+        LDA A1
+        JSR bcd_inc
+        STA A1
+        BCC dec_a1
+        INC CARRY
+        LDA CARRY
+        CMP #$02
+        BNE dec_carry
+
+        JMP success
+
+subroutine:
+        TSX
+        CPX #$FD
+        BNE *
+        LDA $01FF
+        CMP #>(after - 1)
+        BNE *
+        LDA $01FE
+        CMP #<(after - 1)
+        BNE *
+        RTS
+
+; FLAGS = the status expected with RESULT, RCARRY and the overflow in bit 7 of A
+expect: AND #$80
+        LSR
+        ORA #$30
+        ORA RCARRY
+        STA FLAGS
+        LDA RESULT
+        BNE expect_nonzero
+        LDA #$02
+        ORA FLAGS
+        STA FLAGS
+        RTS
+expect_nonzero:
+        AND #$80
+        ORA FLAGS
+        STA FLAGS
+        RTS
+
+; A1 + A2 + CARRY
+check_add:
+        LDA A1
+        EOR RESULT
+        STA TMP
+        LDA A2
+        EOR RESULT
+        AND TMP
+        JSR expect
+        LDA CARRY
+        LSR
+        LDA A1
+        ADC A2
+        PHP
+        CMP RESULT
+        BNE *
+        PLA
+        CMP FLAGS
+        BNE *
+        RTS
+
+; A1 - A2 - (1 - CARRY)
+check_sub:
+        LDA A1
+        EOR A2
+        STA TMP
+        LDA A1
+        EOR RESULT
+        AND TMP
+        JSR expect
+        LDA CARRY
+        LSR
+        LDA A1
+        SBC A2
+        PHP
+        CMP RESULT
+        BNE *
+        PLA
+        CMP FLAGS
+        BNE *
+        RTS
+
+; A1 + A2 + CARRY in BCD, then RESULT - A2 - CARRY, which borrows exactly when the sum carried
+check_decimal:
+        SED
+        LDA CARRY
+        LSR
+        LDA A1
+        ADC A2
+        CLD
+        BCS dec_carried
+        LDX RCARRY
+        BNE *
+        BEQ dec_sum
+dec_carried:
+        LDX RCARRY
+        BEQ *
+dec_sum:
+        CMP RESULT
+        BNE *
+        SED
+        LDA CARRY
+        EOR #$01
+        LSR
+        LDA RESULT
+        SBC A2
+        CLD
+        BCS dec_no_borrow
+        LDX RCARRY
+        BEQ *
+        BNE dec_difference
+dec_no_borrow:
+        LDX RCARRY
+        BNE *
+dec_difference:
+        CMP A1
+        BNE *
+        RTS
+
+; A = A + 1 in BCD, with the carry set when it wraps from $99 to $00
+bcd_inc:
+        CLC
+        ADC #$01
+        STA TMP
+        AND #$0F
+        CMP #$0A
+        LDA TMP
+        BCC bcd_inc_done
+        ADC #$05
+        CMP #$A0
+        BCC bcd_inc_done
+        LDA #$00
+bcd_inc_done:
+        RTS
+
+; the handler of BRK checks the registers and the stack, then returns with them changed and its status discarded
+irq:    PHP
+        CMP #'B'
+        BNE *
+        CPX #'R'
+        BNE *
+        CPY #'K'
+        BNE *
+        STA IRQ_A
+        STX IRQ_X
+        TSX
+        LDA $0102,X     ; the status pushed by BRK
+        CMP #$30
+        BNE *
+        PLA             ; the status in the handler
+        CMP #$34
+        BNE *
+        TSX
+        CPX #$FC
+        BNE *
+        LDA $01FF
+        CMP #>brk_return
+        BNE *
+        LDA $01FE
+        CMP #<brk_return
+        BNE *
+        LDA #$FF
+        PHA
+        LDX IRQ_X
+        INX
+        LDY #'K' - 3
+        LDA IRQ_A
+        EOR #$AA
+        PLP
+        RTI
+
+nmi:    JMP nmi
+
+        .org $3000
+success:
+        JMP success
+
+        .org $FFFA
+        .word nmi, start, irq
@@ -0,0 +1,105 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <utility>
+
+#include "disassemblymodel.hpp"
+#include "OpcodeTable.hpp"
+#include "Disassembler.hpp"
+
+
+DisassemblyModel::DisassemblyModel(const ROM &memory, MemoryModel &memoryModel, QObject *parent):
+        QAbstractTableModel(parent), m_memory{memory}, m_disassembly{memory} {
+    connect(&memoryModel, &MemoryModel::dataChanged, this, &DisassemblyModel::memory_changed);
+}
+
+int DisassemblyModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : (int)m_disassembly.size();
+}
+
+int DisassemblyModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : COLUMNS_COUNT;
+}
+
+QVariant DisassemblyModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || role != Qt::DisplayRole) return {};
+
+    const Word address = m_disassembly.address(index.row());
+    const Byte opCode = m_memory[address];
+    switch (index.column()) {
+        case BYTES: {
+            std::string bytes;
+            for (Word offset = 0; offset < OPCODES[opCode].length; offset++)
+                bytes += std::format("{:02X} ", m_memory[(Word)(address + offset)]);
+            return QString::fromStdString(bytes);
+        }
+        case COMMAND: {
+            const auto length = OPCODES[opCode].length;
+            const Word operand = length == 1 ? 0 : length == 2 ? m_memory[(Word)(address + 1)] : m_memory.get_word(address + 1);
+            char command[MAX_DESCRIPTION_LENGTH];
+            auto text = QString::fromLatin1(command, write_description(command, opCode, operand) - command);
+            if (m_disassembly.overlaps(address)) text += "  ; overlaps the next command";
+            return text;
+        }
+        default:
+            return {};
+    }
+}
+
+QVariant DisassemblyModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) return {};
+    if (orientation == Qt::Vertical)
+        return QString::fromStdString(std::format("0x{:04x}", m_disassembly.address(section)));
+
+    switch (section) {
+        case BYTES:   return "Bytes";
+        case COMMAND: return "Command";
+        default:      return {};
+    }
+}
+
+void DisassemblyModel::add_anchor(Word address) {
+    if (m_disassembly.is_anchor(address)) return;
+    apply(m_disassembly.anchored(address));
+    // the command cut short by the anchor is shown as overlapping it
+    const int previous = std::max(row_of(address) - 1, 0);
+    emit dataChanged(index(previous, COMMAND), index(previous, COMMAND), {Qt::DisplayRole});
+}
+
+void DisassemblyModel::memory_changed(const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+    // the memory model has a row per address
+    const int first = topLeft.row(), last = bottomRight.row();
+    if (last - first >= INCREMENTAL_LIMIT) {
+        beginResetModel();
+        m_disassembly.disassemble();
+        endResetModel();
+        return;
+    }
+
+    for (int address = first; address <= last; address++) apply(m_disassembly.affected(address));
+}
+
+void DisassemblyModel::apply(const Disassembly::Window &window) {
+    const int row = (int)window.row, removed = (int)window.removed, inserted = (int)window.inserted;
+    if (removed > inserted) {
+        beginRemoveRows({}, row + inserted, row + removed - 1);
+        m_disassembly.apply(window);
+        endRemoveRows();
+    }
+    else if (inserted > removed) {
+        beginInsertRows({}, row + removed, row + inserted - 1);
+        m_disassembly.apply(window);
+        endInsertRows();
+    }
+    else m_disassembly.apply(window);
+
+    // the rows both before and after the change show other commands now
+    const int changed = std::min(removed, inserted);
+    if (changed > 0) emit dataChanged(index(row, BYTES), index(row + changed - 1, COMMAND), {Qt::DisplayRole});
+    // the addresses in the vertical header move along with the rows
+    if (removed != inserted) emit headerDataChanged(Qt::Vertical, row, rowCount() - 1);
+}
@@ -0,0 +1,56 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_DISASSEMBLYMODEL_HPP
+#define EMULATOR_MOS6502_DISASSEMBLYMODEL_HPP
+
+#include <QAbstractTableModel>
+
+#include "Disassembly.hpp"
+#include "memorymodel.hpp"
+
+
+/**
+ * The memory as a table of commands, a row per command as decoded by a Disassembly.
+ *
+ * Follows the changes the memory model announces: a few changed bytes re-decode only the commands around them,
+ *  and the rows are removed, inserted or changed accordingly, while a larger change decodes everything anew.
+ */
+class DisassemblyModel : public QAbstractTableModel {
+Q_OBJECT
+
+public:
+    enum Column { BYTES, COMMAND, COLUMNS_COUNT };
+
+    DisassemblyModel(const ROM &memory, MemoryModel &memoryModel, QObject *parent = nullptr);
+
+    [[nodiscard]] int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    [[nodiscard]] int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    [[nodiscard]] QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /// row of the command containing the address
+    [[nodiscard]] int row_of(Word address) const noexcept { return (int)m_disassembly.row(address); }
+
+public slots:
+    /// a command starts at the address, whatever the commands before it are
+    void add_anchor(Word address);
+
+private slots:
+    void memory_changed(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+
+private:
+    /// changed bytes above this number are followed by decoding the whole memory
+    static constexpr int INCREMENTAL_LIMIT = 256;
+
+    /// applies the window, announcing the rows it removes, inserts and changes
+    void apply(const Disassembly::Window &window);
+
+    const ROM &m_memory;
+    Disassembly m_disassembly;
+};
+
+
+#endif //EMULATOR_MOS6502_DISASSEMBLYMODEL_HPP
@@ -0,0 +1,27 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <QHeaderView>
+
+#include "disassemblyview.hpp"
+
+
+DisassemblyView::DisassemblyView(DisassemblyModel &model, QWidget *parent): QTableView(parent), m_model{model} {
+    setModel(&model);
+
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setDefaultSectionSize(fontMetrics().height() + 6);
+    setColumnWidth(DisassemblyModel::BYTES, fontMetrics().averageCharWidth() * 12);
+    horizontalHeader()->setStretchLastSection(true);
+
+    setSelectionBehavior(QAbstractItemView::SelectRows);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setWordWrap(false);
+}
+
+void DisassemblyView::show_address(Word address) {
+    const auto command = model()->index(m_model.row_of(address), DisassemblyModel::COMMAND);
+    scrollTo(command, QAbstractItemView::PositionAtTop);
+    setCurrentIndex(command);
+}
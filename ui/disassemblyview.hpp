@@ -0,0 +1,28 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_DISASSEMBLYVIEW_HPP
+#define EMULATOR_MOS6502_DISASSEMBLYVIEW_HPP
+
+#include <QTableView>
+
+#include "disassemblymodel.hpp"
+
+
+/// a read-only table of the commands in memory, laid out like MemoryView
+class DisassemblyView : public QTableView {
+Q_OBJECT
+
+public:
+    explicit DisassemblyView(DisassemblyModel &model, QWidget *parent = nullptr);
+
+    /// scrolls to the command containing the address
+    void show_address(Word address);
+
+private:
+    DisassemblyModel &m_model;
+};
+
+
+#endif //EMULATOR_MOS6502_DISASSEMBLYVIEW_HPP
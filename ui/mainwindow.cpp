@@ -5,8 +5,8 @@
 // You may need to build the project (run Qt uic code generator) to get "ui_MainWindow.h" resolved
 
 #include <QInputDialog>
-#include <iostream>
 #include <QMessageBox>
+#include <QStatusBar>
 #include "mainwindow.hpp"
 #include "MOS6502.hpp"
 
@@ -14,48 +14,126 @@ using namespace Emulator;
 
 
 MainWindow::MainWindow(ROM &memory, QWidget* parent): QMainWindow(parent), memory(memory) {
+    memoryModel = std::make_unique<MemoryModel>(memory, this);
+
     mainWidget = std::make_unique<QWidget>(this);
 
     pageViewsLayout = std::make_unique<QHBoxLayout>(mainWidget.get());
     mainWidget->setLayout(pageViewsLayout.get());
     setCentralWidget(mainWidget.get());
 
+    // the handlers the vectors point to are surely code
+    disassemblyModel = std::make_unique<DisassemblyModel>(memory, *memoryModel, this);
+    for (const Word vector: {ROM::RESET_LOCATION, ROM::INTERRUPT_HANDLER, ROM::BRK_HANDLER})
+        disassemblyModel->add_anchor(memory.get_word(vector));
+    disassemblyView = std::make_unique<DisassemblyView>(*disassemblyModel, mainWidget.get());
+    pageViewsLayout->addWidget(disassemblyView.get());
+    disassemblyView->show_address(memory.get_word(ROM::RESET_LOCATION));
+
     execute = std::make_unique<QAction>("Execute", this);
     connect(execute.get(), &QAction::triggered, this, &MainWindow::execute_program);
 
     addPageView = std::make_unique<QAction>("Add page", this);
     connect(addPageView.get(), &QAction::triggered, this, &MainWindow::add_page_view);
 
+    addAnchor = std::make_unique<QAction>("Add disassembly anchor", this);
+    connect(addAnchor.get(), &QAction::triggered, this, &MainWindow::add_disassembly_anchor);
+
+    pause = std::make_unique<QAction>("Pause", this);
+    pause->setEnabled(false);
+    connect(pause.get(), &QAction::triggered, this, &MainWindow::toggle_pause);
+
+    stop = std::make_unique<QAction>("Stop", this);
+    stop->setEnabled(false);
+    connect(stop.get(), &QAction::triggered, this, &MainWindow::stop_program);
+
     fileMenu = std::unique_ptr<QMenu>(menuBar()->addMenu("File"));
     fileMenu->addAction(execute.get());
+    fileMenu->addAction(pause.get());
+    fileMenu->addAction(stop.get());
     fileMenu->addAction(addPageView.get());
+    fileMenu->addAction(addAnchor.get());
+
+    registersLabel = std::make_unique<QLabel>(this);
+    statusBar()->addWidget(registersLabel.get());
+
+    // 30 times a second is enough for the eye, the emulation publishes more often
+    refreshTimer = std::make_unique<QTimer>(this);
+    refreshTimer->setInterval(1000 / 30);
+    connect(refreshTimer.get(), &QTimer::timeout, this, &MainWindow::show_snapshot);
 }
 
 
 void MainWindow::add_page_view() {
     Byte page = QInputDialog::getInt(this, "Page", "Page index", 0, 0, UINT8_MAX);
 
-    auto scrollArea = std::make_unique<QScrollArea>(mainWidget.get());
+    auto memoryView = std::make_unique<MemoryView>(*memoryModel, mainWidget.get());
+    pageViewsLayout->addWidget(memoryView.get());
+    memoryView->show_page(page);
 
-    auto pageView = std::make_unique<PageView>(page, memory, scrollArea.get());
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setWidget(pageView.get());
+    memoryViews.push_back(std::move(memoryView));
+}
 
-    pageViewsLayout->addWidget(scrollArea.get());
+void MainWindow::add_disassembly_anchor() {
+    bool accepted = false;
+    const Word address = QInputDialog::getInt(this, "Anchor", "Address of a command", 0, 0, UINT16_MAX, 1, &accepted);
+    if (!accepted) return;
 
-    scrollAreas.push_back(std::move(scrollArea));
-    pageViews.push_back(std::move(pageView));
+    disassemblyModel->add_anchor(address);
+    disassemblyView->show_address(address);
 }
 
 void MainWindow::execute_program() {
-    MOS6502 cpu{};
-    cpu.burn(memory);
-    cpu.reset();
-    cpu.stop_on_break(true);
+    // the previous run, if any, is stopped and waited for
+    emulation = std::make_unique<Emulation>(memory);
+    pause->setText("Pause");
+    pause->setEnabled(true);
+    stop->setEnabled(true);
+    refreshTimer->start();
+}
+
+void MainWindow::toggle_pause() {
+    if (!emulation) return;
+    if (pause->text() == "Pause") {
+        emulation->pause();
+        pause->setText("Resume");
+    }
+    else {
+        emulation->resume();
+        pause->setText("Pause");
+    }
+}
 
-    auto executionStatus = cpu.execute();
+void MainWindow::stop_program() {
+    if (emulation) emulation->stop();
+}
 
-    if (!executionStatus.has_value()) {
+void MainWindow::show_snapshot() {
+    if (!emulation) return;
+
+    std::optional<Emulation::ExecutionResult> result;
+    emulation->read([&](const Emulation::Snapshot &snapshot) {
+        memory = snapshot.memory;
+        result = snapshot.result;
+
+        const auto &state = snapshot.state;
+        const Byte status = state.SR.to_byte();
+        const std::string paused = snapshot.paused ? "  (paused)" : "";
+        registersLabel->setText(QString::fromStdString(std::vformat(
+                "PC 0x{:04x}  A 0x{:02x}  X 0x{:02x}  Y 0x{:02x}  SP 0x{:02x}  SR 0x{:02x}  cycle {:d}  commands {:d}{}",
+                std::make_format_args(state.PC, state.AC, state.X, state.Y, state.SP, status, state.cycle,
+                                      snapshot.instructionsRetired, paused))));
+    });
+    // only the bytes changed since the previous snapshot are repainted
+    memoryModel->refresh();
+
+    if (!result.has_value()) return;
+    refreshTimer->stop();
+    pause->setEnabled(false);
+    stop->setEnabled(false);
+    emulation.reset();
+
+    if (!result->has_value()) {
         std::visit(Overload{
                 [this](MOS6502::UnknownOperation error) {
                     QMessageBox::warning(this,
@@ -63,10 +141,14 @@ void MainWindow::execute_program() {
                                          QString::fromStdString(std::vformat("Could not parse operation at 0x{:04x}",std::make_format_args(error.address)))
                                          );
                 },
+                [this](MOS6502::Jammed error) {
+                    QMessageBox::warning(this,
+                                         "Execution terminated unexpectedly",
+                                         QString::fromStdString(std::vformat("Processor jammed at 0x{:04x}",std::make_format_args(error.address)))
+                                         );
+                },
         },
-                executionStatus.error()
+                result->error()
                 );
     }
-
-    std::cout << cpu.dump(false) << '\n';
-};
+}
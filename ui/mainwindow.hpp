@@ -11,8 +11,11 @@
 #include <QScrollArea>
 #include <QMenu>
 #include <QMenuBar>
+#include <QTimer>
 
-#include "pageview.hpp"
+#include "memoryview.hpp"
+#include "disassemblyview.hpp"
+#include "Emulation.hpp"
 
 class MainWindow : public QMainWindow {
 Q_OBJECT
@@ -20,14 +23,25 @@ Q_OBJECT
 public:
     explicit MainWindow(ROM &memory, QWidget* parent = nullptr);
 
+    /// adds a view of the memory, scrolled to the page asked for
     void add_page_view();
 
+    /// makes the disassembly start a command at the address asked for
+    void add_disassembly_anchor();
+
 private slots:
+    /// starts the program in the memory over, in a thread of its own
     void execute_program();
+    void toggle_pause();
+    void stop_program();
+    /// shows the snapshot published last by the running program
+    void show_snapshot();
 
 private:
-    std::vector<std::unique_ptr<PageView>> pageViews;
-    std::vector<std::unique_ptr<QScrollArea>> scrollAreas;
+    std::unique_ptr<MemoryModel> memoryModel;
+    std::vector<std::unique_ptr<MemoryView>> memoryViews;
+    std::unique_ptr<DisassemblyModel> disassemblyModel;
+    std::unique_ptr<DisassemblyView> disassemblyView;
 
     std::unique_ptr<QWidget> mainWidget;
     std::unique_ptr<QHBoxLayout> pageViewsLayout;
@@ -35,6 +49,15 @@ private:
     std::unique_ptr<QMenu> fileMenu;
     std::unique_ptr<QAction> execute;
     std::unique_ptr<QAction> addPageView;
+    std::unique_ptr<QAction> addAnchor;
+    std::unique_ptr<QAction> pause;
+    std::unique_ptr<QAction> stop;
+
+    std::unique_ptr<QLabel> registersLabel;
+
+    std::unique_ptr<Emulation> emulation;
+    /// polls the snapshots of the emulation, which never notifies the GUI thread on its own
+    std::unique_ptr<QTimer> refreshTimer;
 
     ROM &memory;
 };
@@ -0,0 +1,106 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <format>
+#include <string>
+#include <utility>
+
+#include "memorymodel.hpp"
+#include "MOS6502_helpers.hpp"
+
+
+MemoryModel::MemoryModel(ROM &memory, QObject *parent): QAbstractTableModel(parent), m_memory{memory} {
+    for (size_t address = 0; address <= UINT16_MAX; address++) m_shown[address] = std::as_const(m_memory)[address];
+}
+
+int MemoryModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : UINT16_MAX + 1;
+}
+
+int MemoryModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : COLUMNS_COUNT;
+}
+
+QVariant MemoryModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::EditRole)) return {};
+
+    const Word address = index.row();
+    switch (index.column()) {
+        case VALUE:
+            return QString::fromStdString(std::format("{:d}", std::as_const(m_memory)[address]));
+        case DECODING:
+            return QString::fromStdString(byte_description(std::as_const(m_memory)[address]));
+        case COMMENT: {
+            const auto comment = m_comments.find(address);
+            return comment == m_comments.end() ? QString{} : comment->second;
+        }
+        default:
+            return {};
+    }
+}
+
+QVariant MemoryModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) return {};
+    if (orientation == Qt::Vertical) return QString::fromStdString(std::format("0x{:04x}", section));
+
+    switch (section) {
+        case VALUE:    return "Value";
+        case DECODING: return "Decoding";
+        case COMMENT:  return "Comment";
+        default:       return {};
+    }
+}
+
+Qt::ItemFlags MemoryModel::flags(const QModelIndex &index) const {
+    const auto flags = QAbstractTableModel::flags(index);
+    return index.column() == DECODING ? flags : flags | Qt::ItemIsEditable;
+}
+
+bool MemoryModel::setData(const QModelIndex &index, const QVariant &value, int role) {
+    if (!index.isValid() || role != Qt::EditRole) return false;
+
+    const Word address = index.row();
+    if (index.column() == COMMENT) {
+        m_comments[address] = value.toString();
+        emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+        return true;
+    }
+    if (index.column() != VALUE) return false;
+
+    const std::string text = value.toString().trimmed().toStdString();
+    int newValue;
+    try {
+        newValue = text.starts_with("0x") ? std::stoi(text.substr(2), nullptr, 16) : std::stoi(text, nullptr, 10);
+    }
+    catch (const std::logic_error &e) {
+        return false;
+    }
+    if (newValue < 0 || newValue > UINT8_MAX) return false;
+
+    m_memory[address] = newValue;
+    m_shown[address] = newValue;
+    emit dataChanged(this->index(address, VALUE), this->index(address, DECODING), {Qt::DisplayRole, Qt::EditRole});
+    return true;
+}
+
+void MemoryModel::refresh() {
+    // only the pages written since the previous refresh may differ from what is shown
+    const auto dirty = m_memory.collect_dirty_pages();
+    size_t address = 0;
+    while (address <= UINT16_MAX) {
+        if (!dirty[address / ROM::PAGE_SIZE]) {
+            address = (address / ROM::PAGE_SIZE + 1) * ROM::PAGE_SIZE;
+            continue;
+        }
+        if (m_shown[address] == std::as_const(m_memory)[address]) {
+            address++;
+            continue;
+        }
+
+        const size_t first = address;
+        for (; address <= UINT16_MAX && m_shown[address] != std::as_const(m_memory)[address]; address++)
+            m_shown[address] = std::as_const(m_memory)[address];
+        emit dataChanged(index((int)first, VALUE), index((int)address - 1, DECODING), {Qt::DisplayRole, Qt::EditRole});
+    }
+}
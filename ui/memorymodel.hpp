@@ -0,0 +1,59 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_MEMORYMODEL_HPP
+#define EMULATOR_MOS6502_MEMORYMODEL_HPP
+
+#include <array>
+#include <unordered_map>
+
+#include <QAbstractTableModel>
+#include <QString>
+
+#include "MOS6502_definitions.hpp"
+#include "ROM.hpp"
+
+using namespace Emulator;
+
+
+/**
+ * The whole address space as a table with a row per byte: its value, its decoding as an opcode and a comment.
+ * The value and the comment can be edited.
+ *
+ * Views only ask for the rows they show, so that no widget is created per byte. Changes made to the memory
+ *  other than through the model are shown by refresh(). The model is the consumer of the dirty pages of the memory.
+ */
+class MemoryModel : public QAbstractTableModel {
+Q_OBJECT
+
+public:
+    enum Column { VALUE, DECODING, COMMENT, COLUMNS_COUNT };
+
+    explicit MemoryModel(ROM &memory, QObject *parent = nullptr);
+
+    [[nodiscard]] int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    [[nodiscard]] int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    [[nodiscard]] QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    [[nodiscard]] Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    /// accepts a decimal value, or a hexadecimal one starting with 0x
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+
+public slots:
+    /// notifies the views of the bytes changed since the previous refresh, a signal per run of consecutive addresses;
+    ///  only the pages the memory reports as dirty are compared
+    void refresh();
+
+private:
+    ROM &m_memory;
+
+    /// the bytes as the views were last notified of them
+    std::array<Byte, UINT16_MAX + 1> m_shown;
+    std::unordered_map<Word, QString> m_comments;
+};
+
+
+#endif //EMULATOR_MOS6502_MEMORYMODEL_HPP
@@ -0,0 +1,33 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#include <QHeaderView>
+
+#include "memoryview.hpp"
+
+
+MemoryView::MemoryView(MemoryModel &model, QWidget *parent): QTableView(parent) {
+    setModel(&model);
+
+    // with fixed heights the view finds the visible rows without asking the model about the others
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setDefaultSectionSize(fontMetrics().height() + 6);
+    // sizing the columns to their contents would visit every row
+    setColumnWidth(MemoryModel::DECODING, fontMetrics().averageCharWidth() * 24);
+    horizontalHeader()->setStretchLastSection(true);
+
+    setSelectionBehavior(QAbstractItemView::SelectRows);
+    setEditTriggers(QAbstractItemView::DoubleClicked | QAbstractItemView::EditKeyPressed | QAbstractItemView::AnyKeyPressed);
+    setWordWrap(false);
+}
+
+void MemoryView::show_page(Byte pageIndex) {
+    WordToBytes address;
+    address.high = pageIndex;
+    address.low = 0;
+
+    const auto first = model()->index(address.word, MemoryModel::VALUE);
+    scrollTo(first, QAbstractItemView::PositionAtTop);
+    setCurrentIndex(first);
+}
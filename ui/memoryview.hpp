@@ -0,0 +1,25 @@
+//
+// Created by Mikhail on 19/10/2026.
+//
+
+#ifndef EMULATOR_MOS6502_MEMORYVIEW_HPP
+#define EMULATOR_MOS6502_MEMORYVIEW_HPP
+
+#include <QTableView>
+
+#include "memorymodel.hpp"
+
+
+/// a table of the whole memory with rows of the same height, so that only the visible rows are ever laid out and painted
+class MemoryView : public QTableView {
+Q_OBJECT
+
+public:
+    explicit MemoryView(MemoryModel &model, QWidget *parent = nullptr);
+
+    /// scrolls to the first byte of the page
+    void show_page(Byte pageIndex);
+};
+
+
+#endif //EMULATOR_MOS6502_MEMORYVIEW_HPP